@@ -0,0 +1,88 @@
+#ifndef LEO_ASSET_COOKER_H
+#define LEO_ASSET_COOKER_H
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace engine
+{
+
+class VFS;
+
+// Writes a ZIP archive with every entry stored uncompressed, so VFS mounts it like any other resource archive and
+// reads need no inflate. Each entry's data starts on a kPackAlignment boundary, padded with an alignment extra field
+// (the one zipalign uses), so cooked pixels read straight out of the archive stay aligned.
+class PackWriter
+{
+  public:
+    static constexpr size_t kPackAlignment = 16;
+
+    // Creates or truncates the file at path (a native path, not a VFS one). Throws if it cannot be opened.
+    explicit PackWriter(const char *path);
+    // An unfinished pack is closed without a directory and will not mount.
+    ~PackWriter();
+
+    PackWriter(const PackWriter &) = delete;
+    PackWriter &operator=(const PackWriter &) = delete;
+
+    // Throws on duplicate names, I/O errors, and past ZIP's 65535 entries or 4 GB.
+    void Add(const std::string &name, const void *data, size_t size);
+    bool Contains(const std::string &name) const;
+    // Writes the central directory and closes the file.
+    void Finish();
+
+    size_t GetEntryCount() const noexcept;
+
+  private:
+    struct Entry
+    {
+        std::string name;
+        Uint32 crc;
+        Uint32 size;
+        Uint32 offset;
+    };
+
+    void Write(const void *data, size_t size);
+
+    SDL_IOStream *io;
+    std::vector<Entry> entries;
+    std::unordered_set<std::string> names;
+    Uint64 offset;
+};
+
+struct CookOptions
+{
+    std::vector<int> font_sizes = {16, 24, 32}; // Atlas sizes baked for every font
+};
+
+struct CookStats
+{
+    size_t images = 0;
+    size_t fonts = 0; // Atlases, one per font and size
+    size_t maps = 0;
+    size_t copied = 0;
+};
+
+// Offline pass behind `leo-engine-runtime --cook`: writes the files under a directory of the mounted resources to
+// a pack that mounts in their place and loads faster. Images and .tmx maps are replaced by their cooked forms at the
+// same paths, and each font gains a pre-baked atlas for every size in the options. Everything else, the fonts
+// included, is copied as is.
+class AssetCooker
+{
+  public:
+    AssetCooker(VFS &vfs, const CookOptions &options);
+
+    // Files that fail to cook are copied unchanged and reported in failures. Throws if the pack cannot be written.
+    CookStats Cook(const char *vfs_dir, const char *pack_path, std::vector<std::string> &failures);
+
+  private:
+    VFS &vfs;
+    CookOptions options;
+};
+
+} // namespace engine
+
+#endif // LEO_ASSET_COOKER_H
@@ -0,0 +1,100 @@
+#ifndef LEO_ASSET_LOADER_H
+#define LEO_ASSET_LOADER_H
+
+#include "leo/job_system.h"
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine
+{
+
+enum class AssetStatus
+{
+    Pending,
+    Ready,
+    Failed
+};
+
+// Handle to one submitted load. Status and error only change on the thread that calls AssetLoader::Update or
+// Wait, so callers can poll them without locking.
+class AssetRequest
+{
+  public:
+    AssetStatus GetStatus() const noexcept;
+    bool IsDone() const noexcept;
+    const std::string &GetError() const noexcept;
+
+  private:
+    friend class AssetLoader;
+
+    enum class Stage
+    {
+        Queued,
+        Decoding,
+        Decoded,
+        Finished
+    };
+
+    std::function<void()> decode;
+    std::function<void()> finish;
+    Stage stage = Stage::Queued;
+    bool decode_failed = false;
+    AssetStatus status = AssetStatus::Pending;
+    std::string error;
+};
+
+// Splits asset loads into a decode step (VFS read, image/font/audio decode) that runs on worker threads and a
+// finish step (GPU upload, registration) that runs on the main thread from Update under a per-frame time budget.
+// With zero workers, decode steps run inline in Update and Wait, which keeps loads deterministic.
+class AssetLoader
+{
+  public:
+    explicit AssetLoader(Uint32 worker_count);
+    // Runs decode steps as jobs on a shared pool instead of owning threads. The JobSystem must outlive the loader.
+    explicit AssetLoader(JobSystem &job_system);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader &) = delete;
+    AssetLoader &operator=(const AssetLoader &) = delete;
+
+    // Exceptions thrown by either step mark the request as failed with the exception message.
+    std::shared_ptr<AssetRequest> Submit(std::function<void()> decode, std::function<void()> finish);
+
+    // Finishes decoded requests in submission order until budget_ns has elapsed; at least one request is finished
+    // per call if any is ready. Returns the number of requests completed.
+    size_t Update(Uint64 budget_ns);
+
+    // Blocks until the request is done, decoding it on the calling thread if no worker has picked it up yet.
+    void Wait(const std::shared_ptr<AssetRequest> &request);
+
+    size_t GetPendingCount() const;
+    Uint32 GetWorkerCount() const noexcept;
+
+  private:
+    void WorkerLoop();
+    void DecodeNext();
+    static void RunDecode(AssetRequest &request);
+    static void RunFinish(AssetRequest &request);
+
+    mutable std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::deque<std::shared_ptr<AssetRequest>> queued;
+    std::deque<std::shared_ptr<AssetRequest>> decoded;
+    size_t pending;
+    bool stopping;
+    std::vector<std::thread> workers;
+    JobSystem *jobs;
+    std::vector<JobHandle> decode_jobs;
+};
+
+} // namespace engine
+
+#endif // LEO_ASSET_LOADER_H
@@ -1,10 +1,42 @@
 #ifndef LEO_AUDIO_H
 #define LEO_AUDIO_H
 
+#include <SDL3/SDL_stdinc.h>
+#include <memory>
+
 namespace engine
 {
 
 class VFS;
+struct SoundSample;
+
+// What Sound::Play does when every voice in the shared pool is busy.
+enum class VoiceStealPolicy
+{
+    Oldest,
+    Quietest,
+    Skip
+};
+
+struct VoiceStats
+{
+    int voice_count;
+    int active_voices;
+    int cached_samples;
+    Uint64 stolen;
+    Uint64 skipped;
+};
+
+void SetVoiceStealPolicy(VoiceStealPolicy policy);
+VoiceStealPolicy GetVoiceStealPolicy() noexcept;
+VoiceStats GetVoiceStats();
+
+// Starts the shared audio engine if it is not running yet. Sound::Decode never starts it, so call this on the main
+// thread before handing decodes to another thread.
+void StartAudioEngine();
+
+// Sounds are decoded to PCM once per path and shared; each Play takes a voice from a fixed pool, so repeated
+// calls overlap instead of restarting. Pause, Stop and the setters apply to every voice the Sound is playing on.
 
 class Sound
 {
@@ -19,6 +51,12 @@ class Sound
 
     static Sound LoadFromVfs(VFS &vfs, const char *vfs_path);
 
+    // Decode touches no Sound or voice state and may run on a worker thread once StartAudioEngine has run; it
+    // throws if the engine is not started. FromSample must run on the thread that owns the Sounds and reuses a
+    // sample already cached for vfs_path.
+    static std::shared_ptr<SoundSample> Decode(VFS &vfs, const char *vfs_path);
+    static Sound FromSample(std::shared_ptr<SoundSample> sample, const char *vfs_path);
+
     bool IsReady() const noexcept;
     void Reset() noexcept;
 
@@ -31,9 +69,13 @@ class Sound
     void SetVolume(float volume);
     void SetPitch(float pitch);
 
+    // Caps how many voices this Sound may use at once; 0 means no limit beyond the pool. When the cap is
+    // reached, Play restarts the Sound's oldest voice.
+    void SetMaxVoices(int max_voices);
+    int GetMaxVoices() const noexcept;
+
   private:
     void *handle;
-    bool paused;
 };
 
 class Music
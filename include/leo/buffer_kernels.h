@@ -0,0 +1,44 @@
+#ifndef LEO_BUFFER_KERNELS_H
+#define LEO_BUFFER_KERNELS_H
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+
+namespace leo
+{
+namespace BufferKernels
+{
+
+// Whole-array operations behind leo.buffer. Structure-of-arrays layout: one array per component (xs, ys, ...), all
+// indexed by entity.
+
+// values[i] += rates[i] * dt
+void Integrate(float *values, const float *rates, size_t count, float dt);
+
+// Clamps every value into [min_value, max_value].
+void Clamp(float *values, size_t count, float min_value, float max_value);
+
+// Wraps every value into [min_value, max_value), e.g. for screen-wrapping positions. Does nothing if the range is
+// empty.
+void Wrap(float *values, size_t count, float min_value, float max_value);
+
+// out[i] = distance from (xs[i], ys[i]) to point. out may alias xs or ys.
+void DistanceToPoint(const float *xs, const float *ys, size_t count, SDL_FPoint point, float *out);
+
+// Index of the entry closest to point within max_distance, or count if there is none. Ties go to the lower index.
+size_t Nearest(const float *xs, const float *ys, size_t count, SDL_FPoint point, float max_distance,
+               float *out_distance);
+
+// Writes the indices of entries within radius of point (inclusive) to out_indices, in ascending order, stopping
+// after capacity entries. Returns the number written.
+size_t WithinRadius(const float *xs, const float *ys, size_t count, SDL_FPoint point, float radius,
+                    Sint32 *out_indices, size_t capacity);
+
+// Same as WithinRadius for entries whose w x h box at (xs[i], ys[i]) overlaps rect.
+size_t OverlapRect(const float *xs, const float *ys, size_t count, float w, float h, const SDL_FRect &rect,
+                   Sint32 *out_indices, size_t capacity);
+
+} // namespace BufferKernels
+} // namespace leo
+
+#endif // LEO_BUFFER_KERNELS_H
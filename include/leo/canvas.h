@@ -0,0 +1,45 @@
+#ifndef LEO_CANVAS_H
+#define LEO_CANVAS_H
+
+#include "leo/texture_loader.h"
+#include <SDL3/SDL.h>
+
+namespace engine
+{
+
+// Offscreen render target (an SDL_TEXTUREACCESS_TARGET texture) that is drawn like any other texture.
+//
+// GPU backends may drop render target contents (SDL_EVENT_RENDER_TARGETS_RESET) or the whole device
+// (SDL_EVENT_RENDER_DEVICE_RESET). A preserved canvas keeps a CPU copy of its pixels, taken by Snapshot() after each
+// time it is drawn into, and Restore() puts that copy back; other canvases come back cleared. The Texture object
+// stays the same across a restore, so references held elsewhere remain valid.
+class Canvas
+{
+  public:
+    Canvas(SDL_Renderer *renderer, int width, int height, bool preserve);
+    ~Canvas();
+
+    Canvas(const Canvas &) = delete;
+    Canvas &operator=(const Canvas &) = delete;
+
+    Texture &GetTexture() noexcept;
+    bool IsPreserved() const noexcept;
+
+    // Copies the current contents to the CPU copy. The canvas must be the current render target.
+    void Snapshot();
+    // Refills the texture from the CPU copy, first creating a new texture when recreate is set.
+    void Restore(bool recreate);
+
+  private:
+    SDL_Texture *CreateTarget() const;
+    bool Fill(SDL_Texture *source);
+
+    SDL_Renderer *renderer;
+    Texture texture;
+    SDL_Surface *pixels;
+    bool preserve;
+};
+
+} // namespace engine
+
+#endif // LEO_CANVAS_H
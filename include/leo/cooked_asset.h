@@ -0,0 +1,65 @@
+#ifndef LEO_COOKED_ASSET_H
+#define LEO_COOKED_ASSET_H
+
+#include <SDL3/SDL_stdinc.h>
+#include <string>
+#include <vector>
+
+namespace engine
+{
+
+// Binary forms written by `leo-engine-runtime cook` (see AssetCooker). A cooked file starts with a four-character
+// tag and kCookedVersion; loaders that find the tag read it directly instead of running the source format's
+// decoder. Values are little-endian.
+constexpr char kCookedImageTag[] = "LIMG";
+constexpr char kCookedFontTag[] = "LFNT";
+constexpr char kCookedMapTag[] = "LMAP";
+constexpr Uint32 kCookedVersion = 1;
+constexpr size_t kCookedHeaderSize = 8;
+
+class CookedWriter
+{
+  public:
+    explicit CookedWriter(const char *tag);
+
+    void WriteU32(Uint32 value);
+    void WriteI32(Sint32 value);
+    void WriteF32(float value);
+    // Length-prefixed, without a terminator.
+    void WriteString(const std::string &value);
+    void WriteBytes(const void *data, size_t size);
+
+    std::vector<unsigned char> &GetData() noexcept;
+
+  private:
+    std::vector<unsigned char> data;
+};
+
+// Bounds-checked reads over a cooked file; every read throws once the data runs out.
+class CookedReader
+{
+  public:
+    // Throws unless data starts with tag and the current version.
+    CookedReader(const void *data, size_t size, const char *tag);
+
+    static bool IsCooked(const void *data, size_t size, const char *tag) noexcept;
+
+    Uint32 ReadU32();
+    Sint32 ReadI32();
+    float ReadF32();
+    std::string ReadString();
+    // Returns a pointer into the data and skips size bytes.
+    const unsigned char *ReadBytes(size_t size);
+
+    size_t GetOffset() const noexcept;
+    size_t GetRemaining() const noexcept;
+
+  private:
+    const unsigned char *data;
+    size_t size;
+    size_t offset;
+};
+
+} // namespace engine
+
+#endif // LEO_COOKED_ASSET_H
@@ -13,6 +13,12 @@ enum class WindowMode
     BorderlessFullscreen
 };
 
+enum class GcMode
+{
+    Incremental = 0,
+    Generational
+};
+
 struct Config
 {
     const char *argv0;         // argv[0] from main
@@ -28,6 +34,23 @@ struct Config
     WindowMode window_mode;    // Window mode
     Sint32 tick_hz;            // Fixed update tick rate
     Uint32 NumFrameTicks;      // 0 = run until exit
+    Sint32 render_hz;          // Render rate cap (0 = same as tick_hz)
+    Uint32 max_catchup_ticks;  // Max fixed ticks per rendered frame (0 = default of 5)
+    Uint32 asset_budget_us;    // Main-thread time per frame for finishing async loads (0 = default of 2000)
+    Uint32 gc_budget_us;       // Lua GC time per frame, spent after present (0 = default of 1000)
+    GcMode gc_mode;            // Lua collector mode
+    Sint32 job_workers;        // Job system threads (0 = hardware threads - 1, <0 = run jobs inline)
+    bool disable_script_cache; // Always compile Lua from source instead of using cached bytecode
+
+    // Headless and benchmark runs
+    bool headless;              // Offscreen video, software renderer, dummy audio, no frame pacing
+    const char *benchmark_path; // Write frame timing JSON here on exit ("-" = stdout, nullptr = off)
+    const char *profile_path;   // Enable the profiler and write a Chrome trace here on exit (nullptr = off)
+    bool profile_overlay;       // Show the profiler overlay from the first frame
+
+    // Input recording and replay
+    const char *record_path; // Write every tick's InputFrame and the RNG seed here (nullptr = off)
+    const char *replay_path; // Drive ticks from this recording instead of devices, unpaced (nullptr = off)
 
     // Memory allocation functions (default to SDL3)
     void *(*malloc_fn)(size_t);          // Default: SDL_malloc
@@ -3,6 +3,7 @@
 
 #include "engine_config.h"
 #include "leo/gamepad.h"
+#include "leo/job_system.h"
 #include "leo/keyboard.h"
 #include "leo/mouse.h"
 #include "leo/vfs.h"
@@ -24,6 +25,7 @@ namespace Engine
 
 using Config = ::engine::Config;
 using WindowMode = ::engine::WindowMode;
+using GcMode = ::engine::GcMode;
 
 struct InputFrame
 {
@@ -39,6 +41,7 @@ struct Context
     SDL_Window *window;
     SDL_Renderer *renderer;
     ::engine::VFS *vfs;
+    ::engine::JobSystem *jobs;
     const Config *config;
     Uint32 frame_index;
 };
@@ -53,15 +56,17 @@ class Simulation
   private:
     void OnInit(Context &ctx);
     void OnUpdate(Context &ctx, const InputFrame &input, float dt);
-    void OnRender(Context &ctx);
+    void OnRender(Context &ctx, float alpha);
     void OnExit(Context &ctx);
 
     Config &config;
     ::engine::VFS vfs;
+    ::engine::JobSystem jobs;
     SDL_Window *window;
     SDL_Renderer *renderer;
     std::unique_ptr<::engine::LuaRuntime> lua;
     std::unique_ptr<::engine::SteamRuntime> steam;
+    Uint64 random_seed;
 };
 
 } // namespace Engine
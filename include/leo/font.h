@@ -3,10 +3,15 @@
 
 #include "leo/vfs.h"
 #include <SDL3/SDL.h>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 namespace engine
 {
 
+struct GlyphRunCache;
+
 struct TextDesc
 {
     const class Font *font;
@@ -16,6 +21,29 @@ struct TextDesc
     SDL_Color color;
 };
 
+// Glyph atlas baked on the CPU by Font::Bake. Baking does not touch the renderer, so it can run on a worker
+// thread; Font::FromBitmap then uploads the atlas on the render thread.
+struct FontBitmap
+{
+    unsigned char *rgba;
+    int width;
+    int height;
+    void *glyphs;
+    int pixel_size;
+    int line_height;
+
+    FontBitmap() noexcept;
+    ~FontBitmap();
+
+    FontBitmap(const FontBitmap &) = delete;
+    FontBitmap &operator=(const FontBitmap &) = delete;
+
+    FontBitmap(FontBitmap &&other) noexcept;
+    FontBitmap &operator=(FontBitmap &&other) noexcept;
+
+    void Reset() noexcept;
+};
+
 class Font
 {
   public:
@@ -28,14 +56,29 @@ class Font
     Font &operator=(const Font &) = delete;
 
     static Font LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path, int pixel_size);
+    // Rasterizes the font at pixel_size, or reads the atlas the cooker baked for that size when one is mounted at
+    // GetCookedPath(vfs_path, pixel_size).
+    static FontBitmap Bake(VFS &vfs, const char *vfs_path, int pixel_size);
+    static Font FromBitmap(SDL_Renderer *renderer, FontBitmap &&bitmap);
+
+    // Cooked form of a baked atlas: metrics, glyph records and one alpha byte per pixel.
+    static std::vector<unsigned char> Cook(const FontBitmap &bitmap);
+    static std::string GetCookedPath(const char *vfs_path, int pixel_size);
 
     int GetLineHeight() const noexcept;
     bool IsReady() const noexcept;
     void Reset() noexcept;
 
+    void DrawText(SDL_Renderer *renderer, const char *text, int pixel_size, SDL_FPoint position, SDL_Color color);
+    void SetRunCacheCapacity(size_t capacity);
+    size_t GetRunCacheCapacity() const noexcept;
+    size_t GetCachedRunCount() const noexcept;
+
   private:
     friend class Text;
 
+    template <typename Emit> void ForEachGlyph(const char *text, int pixel_size, Emit &&emit) const;
+
     SDL_Texture *atlas;
     void *glyphs;
     int atlas_width;
@@ -44,6 +87,7 @@ class Font
     int line_height;
     int first_codepoint;
     int glyph_count;
+    GlyphRunCache *runs;
 };
 
 class Text
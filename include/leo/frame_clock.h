@@ -0,0 +1,46 @@
+#ifndef LEO_FRAME_CLOCK_H
+#define LEO_FRAME_CLOCK_H
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine
+{
+
+// Fixed-step accumulator behind Simulation::Run. Wall time is added once per rendered frame; the clock hands out
+// the fixed ticks that time covers, the interpolation alpha for drawing, and when the next frame is due. It never
+// reads the system clock itself, so the loop's tick and render counts can be driven from synthetic frame times.
+class FrameClock
+{
+  public:
+    static constexpr Uint32 kDefaultMaxCatchupTicks = 5;
+
+    // A render_hz of 0 renders at tick_hz; a max_catchup_ticks of 0 uses kDefaultMaxCatchupTicks.
+    FrameClock(Uint32 tick_hz, Uint32 render_hz, Uint32 max_catchup_ticks);
+
+    // Adds wall time since the previous frame. Time past max_catchup_ticks is dropped, so a long stall slows the
+    // game down instead of triggering a burst of updates.
+    void AddElapsed(Uint64 elapsed_ns) noexcept;
+    // Adds exactly one tick, for runs that are not paced to wall time.
+    void AddTick() noexcept;
+    // Consumes one tick and returns true while a whole tick is due.
+    bool ConsumeTick() noexcept;
+
+    // Fraction of a tick left over after the due ticks are consumed, in [0, 1).
+    float GetAlpha() const noexcept;
+    // When a frame that started at frame_start_ns should end to hold render_hz.
+    Uint64 GetFrameDeadline(Uint64 frame_start_ns) const noexcept;
+
+    Uint64 GetTickNs() const noexcept;
+    Uint64 GetFrameNs() const noexcept;
+    Uint32 GetMaxCatchupTicks() const noexcept;
+
+  private:
+    Uint64 tick_ns;
+    Uint64 frame_ns;
+    Uint32 max_catchup_ticks;
+    Uint64 accumulator_ns;
+};
+
+} // namespace engine
+
+#endif // LEO_FRAME_CLOCK_H
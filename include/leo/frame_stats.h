@@ -0,0 +1,53 @@
+#ifndef LEO_FRAME_STATS_H
+#define LEO_FRAME_STATS_H
+
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace engine
+{
+
+enum class FramePhase
+{
+    Update = 0,
+    Draw,
+    Present,
+    Gc,
+    Count
+};
+
+// Per-frame timing samples collected by the runtime's benchmark mode. Phase times are accumulated into the
+// current frame and committed by EndFrame(); ToJson() summarizes the run with frame time percentiles.
+class FrameStats
+{
+  public:
+    FrameStats() noexcept;
+
+    void Reserve(size_t frames);
+    void AddPhase(FramePhase phase, Uint64 ns) noexcept;
+    void AddTicks(Uint32 count) noexcept;
+    void EndFrame(Uint64 frame_ns);
+    void SampleLuaMemory(size_t bytes) noexcept;
+    void Reset() noexcept;
+
+    size_t GetFrameCount() const noexcept;
+    Uint64 GetTickCount() const noexcept;
+    Uint64 GetPhaseTotalNs(FramePhase phase) const noexcept;
+    double GetFramePercentileMs(double percentile) const;
+    std::string ToJson() const;
+
+  private:
+    std::vector<Uint64> frame_ns;
+    Uint64 phase_total_ns[static_cast<int>(FramePhase::Count)];
+    Uint64 phase_max_ns[static_cast<int>(FramePhase::Count)];
+    Uint64 phase_frame_ns[static_cast<int>(FramePhase::Count)];
+    Uint64 tick_count;
+    size_t lua_memory_bytes;
+    size_t lua_memory_peak_bytes;
+};
+
+} // namespace engine
+
+#endif // LEO_FRAME_STATS_H
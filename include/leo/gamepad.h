@@ -184,6 +184,40 @@ class GamepadState
         axes[Index(axis)] = ClampAxis(axis, value);
     }
 
+    // Internal: axis value as of the previous tick (drives IsAxisPressed/IsAxisReleased).
+    float GetAxisPrevious(GamepadAxis axis) const noexcept
+    {
+        if (!IsValidAxis(axis))
+        {
+            return 0.0f;
+        }
+        return axes_prev[Index(axis)];
+    }
+
+    // Internal: overwrite one button's state, e.g. when replaying recorded input.
+    void SetButtonState(GamepadButton button, bool is_down, bool is_pressed, bool is_released) noexcept
+    {
+        if (!IsValidButton(button))
+        {
+            return;
+        }
+        size_t index = Index(button);
+        buttons_down[index] = is_down ? 1 : 0;
+        buttons_pressed[index] = is_pressed ? 1 : 0;
+        buttons_released[index] = is_released ? 1 : 0;
+    }
+
+    // Internal: overwrite an axis and its previous-tick value, e.g. when replaying recorded input.
+    void SetAxisState(GamepadAxis axis, float value, float previous) noexcept
+    {
+        if (!IsValidAxis(axis))
+        {
+            return;
+        }
+        axes[Index(axis)] = ClampAxis(axis, value);
+        axes_prev[Index(axis)] = ClampAxis(axis, previous);
+    }
+
   private:
     static constexpr size_t Index(GamepadButton button) noexcept
     {
@@ -230,15 +264,6 @@ class GamepadState
         return value;
     }
 
-    float GetAxisPrevious(GamepadAxis axis) const noexcept
-    {
-        if (!IsValidAxis(axis))
-        {
-            return 0.0f;
-        }
-        return axes_prev[Index(axis)];
-    }
-
     static float AxisValue(float value, AxisDirection direction) noexcept
     {
         return (direction == AxisDirection::Negative) ? -value : value;
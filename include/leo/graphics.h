@@ -1,6 +1,7 @@
 #ifndef LEO_GRAPHICS_H
 #define LEO_GRAPHICS_H
 
+#include "leo/sprite_batch.h"
 #include <SDL3/SDL.h>
 
 namespace leo
@@ -16,18 +17,22 @@ struct Color
     Uint8 a;
 };
 
-void DrawPixel(SDL_Renderer *renderer, float x, float y, Color color);
-void DrawLine(SDL_Renderer *renderer, float x1, float y1, float x2, float y2, Color color);
-void DrawCircleFilled(SDL_Renderer *renderer, float cx, float cy, float radius, Color color);
-void DrawCircleOutline(SDL_Renderer *renderer, float cx, float cy, float radius, Color color);
-void DrawRectangleFilled(SDL_Renderer *renderer, float x, float y, float w, float h, Color color);
-void DrawRectangleOutline(SDL_Renderer *renderer, float x, float y, float w, float h, Color color);
-void DrawRectangleRoundedFilled(SDL_Renderer *renderer, float x, float y, float w, float h, float radius, Color color);
-void DrawRectangleRoundedOutline(SDL_Renderer *renderer, float x, float y, float w, float h, float radius, Color color);
-void DrawTriangleFilled(SDL_Renderer *renderer, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color);
-void DrawTriangleOutline(SDL_Renderer *renderer, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color);
-void DrawPolyFilled(SDL_Renderer *renderer, const SDL_FPoint *points, int count, Color color);
-void DrawPolyOutline(SDL_Renderer *renderer, const SDL_FPoint *points, int count, Color color);
+// Shapes are tessellated into untextured triangles on the batch, so consecutive shapes are submitted together on
+// the next flush. Circles reuse cached unit-circle tables.
+void DrawPixel(engine::SpriteBatch &batch, float x, float y, Color color);
+void DrawLine(engine::SpriteBatch &batch, float x1, float y1, float x2, float y2, Color color);
+void DrawCircleFilled(engine::SpriteBatch &batch, float cx, float cy, float radius, Color color);
+void DrawCircleOutline(engine::SpriteBatch &batch, float cx, float cy, float radius, Color color);
+void DrawRectangleFilled(engine::SpriteBatch &batch, float x, float y, float w, float h, Color color);
+void DrawRectangleOutline(engine::SpriteBatch &batch, float x, float y, float w, float h, Color color);
+void DrawRectangleRoundedFilled(engine::SpriteBatch &batch, float x, float y, float w, float h, float radius,
+                                Color color);
+void DrawRectangleRoundedOutline(engine::SpriteBatch &batch, float x, float y, float w, float h, float radius,
+                                 Color color);
+void DrawTriangleFilled(engine::SpriteBatch &batch, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color);
+void DrawTriangleOutline(engine::SpriteBatch &batch, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color);
+void DrawPolyFilled(engine::SpriteBatch &batch, const SDL_FPoint *points, int count, Color color);
+void DrawPolyOutline(engine::SpriteBatch &batch, const SDL_FPoint *points, int count, Color color);
 
 } // namespace Graphics
 } // namespace leo
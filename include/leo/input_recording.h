@@ -0,0 +1,63 @@
+#ifndef LEO_INPUT_RECORDING_H
+#define LEO_INPUT_RECORDING_H
+
+#include "leo/engine_core.h"
+#include <SDL3/SDL_stdinc.h>
+#include <cstdio>
+#include <vector>
+
+namespace engine
+{
+
+// Input stream file layout (all integers little-endian):
+//   header: "LEOI", u32 version, u32 record size, u32 tick rate, u64 random seed
+//   one entry per tick: varint span count, then per span varint skip, varint length, length bytes
+// Each tick's InputFrame is flattened to a fixed-size record and only the byte spans that differ from the previous
+// tick are stored, so idle ticks cost a single byte.
+
+// Writes the InputFrame consumed by every tick to a host file.
+class InputRecorder
+{
+  public:
+    InputRecorder(const char *path, Uint32 tick_hz, Uint64 seed);
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder &) = delete;
+    InputRecorder &operator=(const InputRecorder &) = delete;
+
+    void Write(const ::leo::Engine::InputFrame &frame);
+    Uint32 GetFrameCount() const noexcept;
+
+  private:
+    std::FILE *file;
+    std::vector<Uint8> previous;
+    std::vector<Uint8> current;
+    std::vector<Uint8> encoded;
+    Uint32 frame_count;
+};
+
+// Reads an input stream written by InputRecorder back one tick at a time.
+class InputPlayback
+{
+  public:
+    explicit InputPlayback(const char *path);
+
+    // Fills frame with the next recorded tick. Returns false once the stream is exhausted.
+    bool Read(::leo::Engine::InputFrame &frame);
+
+    Uint32 GetTickHz() const noexcept;
+    Uint64 GetSeed() const noexcept;
+    Uint32 GetFrameCount() const noexcept;
+
+  private:
+    std::vector<Uint8> data;
+    size_t offset;
+    std::vector<Uint8> current;
+    Uint32 tick_hz;
+    Uint64 seed;
+    Uint32 frame_count;
+};
+
+} // namespace engine
+
+#endif // LEO_INPUT_RECORDING_H
@@ -0,0 +1,90 @@
+#ifndef LEO_JOB_SYSTEM_H
+#define LEO_JOB_SYSTEM_H
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace engine
+{
+
+struct JobState;
+
+// Completion handle for a scheduled job. Copyable; a default-constructed handle counts as done.
+class JobHandle
+{
+  public:
+    JobHandle() noexcept = default;
+
+    bool IsDone() const noexcept;
+
+  private:
+    friend class JobSystem;
+    explicit JobHandle(std::shared_ptr<JobState> state) noexcept;
+
+    std::shared_ptr<JobState> state;
+};
+
+// Work-stealing thread pool. Each worker pops its own deque from the back and steals from the front of the
+// others; jobs scheduled from outside the pool go through a shared injection queue. A job runs once all of its
+// dependencies have finished (whether or not they threw).
+//
+// With zero workers every job runs inline on the scheduling thread, in scheduling order, which gives tests and
+// tools a deterministic single-threaded fallback with the same API.
+class JobSystem
+{
+  public:
+    explicit JobSystem(Uint32 worker_count);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    // One worker per hardware thread, leaving one for the main thread.
+    static Uint32 GetDefaultWorkerCount() noexcept;
+
+    JobHandle Schedule(std::function<void()> job, std::span<const JobHandle> dependencies = {});
+    JobHandle Schedule(std::function<void()> job, std::initializer_list<JobHandle> dependencies);
+
+    // Blocks until the job has finished, running other queued jobs meanwhile. Rethrows the job's exception.
+    void Wait(const JobHandle &handle);
+
+    // Calls body(begin, end) over [0, count) in chunks of at most grain items, spread over the pool and the
+    // calling thread. Returns once every chunk has finished; rethrows the first exception thrown by a chunk.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)> &body);
+
+    Uint32 GetWorkerCount() const noexcept;
+
+  private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<JobState>> jobs;
+    };
+
+    void WorkerLoop(Uint32 index);
+    void Enqueue(std::shared_ptr<JobState> job);
+    std::shared_ptr<JobState> TakeJob();
+    void Run(const std::shared_ptr<JobState> &job);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::mutex inject_mutex;
+    std::deque<std::shared_ptr<JobState>> injected;
+    std::atomic<size_t> queued_count;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::vector<std::thread> threads;
+};
+
+} // namespace engine
+
+#endif // LEO_JOB_SYSTEM_H
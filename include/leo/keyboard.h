@@ -163,6 +163,19 @@ class KeyboardState
         released[index] = 1;
     }
 
+    // Internal: overwrite one key's state, e.g. when replaying recorded input.
+    void SetKeyState(Key key, bool is_down, bool is_pressed, bool is_released) noexcept
+    {
+        if (!IsValidKey(key))
+        {
+            return;
+        }
+        size_t index = Index(key);
+        down[index] = is_down ? 1 : 0;
+        pressed[index] = is_pressed ? 1 : 0;
+        released[index] = is_released ? 1 : 0;
+    }
+
   private:
     static constexpr size_t Index(Key key) noexcept
     {
@@ -0,0 +1,69 @@
+#ifndef LEO_LUA_ALLOCATOR_H
+#define LEO_LUA_ALLOCATOR_H
+
+#include "leo/engine_config.h"
+#include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <cstddef>
+
+namespace engine
+{
+
+struct LuaMemoryStats
+{
+    size_t live_bytes;       // Bytes currently held by the Lua state
+    size_t live_blocks;      // Blocks currently held by the Lua state
+    Uint64 allocation_count; // Blocks handed out since creation, including reallocs that move
+    Uint64 allocated_bytes;  // Bytes handed out since creation, counting only the growth of reallocs
+    size_t pool_bytes;       // Bytes reserved for small blocks, in use or not
+};
+
+// lua_Alloc implementation for the Lua state. Blocks up to kMaxPooledSize bytes come from per-size-class free lists
+// carved out of shared slabs, so the many small tables, closures and strings Lua creates never reach the general
+// heap. Larger blocks go to the Config realloc and free functions. Lua always passes the current size of a block,
+// so blocks carry no header. Slabs are kept until the allocator is destroyed.
+//
+// Not thread-safe; it belongs to a single lua_State.
+class LuaAllocator
+{
+  public:
+    static constexpr size_t kMaxPooledSize = 512;
+
+    explicit LuaAllocator(const Config &config) noexcept;
+    ~LuaAllocator();
+
+    LuaAllocator(const LuaAllocator &) = delete;
+    LuaAllocator &operator=(const LuaAllocator &) = delete;
+
+    // Pass to lua_newstate with the allocator as the user data.
+    static void *Allocate(void *user_data, void *ptr, size_t old_size, size_t new_size) noexcept;
+
+    LuaMemoryStats GetStats() const noexcept;
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    static constexpr size_t kGranularity = 16;
+    static constexpr size_t kClassCount = kMaxPooledSize / kGranularity;
+    static constexpr size_t kSlabSize = 64 * 1024;
+
+    void *Reallocate(void *ptr, size_t old_size, size_t new_size) noexcept;
+    void *AllocatePooled(size_t size_class) noexcept;
+    void FreePooled(void *ptr, size_t size_class) noexcept;
+
+    void *(*malloc_fn)(size_t);
+    void *(*realloc_fn)(void *, size_t);
+    void (*free_fn)(void *);
+    std::array<FreeBlock *, kClassCount> free_lists;
+    FreeBlock *slabs;
+    Uint8 *slab_cursor;
+    size_t slab_remaining;
+    LuaMemoryStats stats;
+};
+
+} // namespace engine
+
+#endif // LEO_LUA_ALLOCATOR_H
@@ -2,7 +2,12 @@
 #define LEO_LUA_RUNTIME_H
 
 #include "engine_config.h"
+#include "leo/lua_allocator.h"
+#include "leo/sprite_batch.h"
+#include "leo/task_scheduler.h"
 #include <SDL3/SDL.h>
+#include <memory>
+#include <vector>
 
 struct lua_State;
 
@@ -10,7 +15,12 @@ namespace engine
 {
 
 class VFS;
+class Canvas;
 class Font;
+class TextureCache;
+class AssetLoader;
+class JobSystem;
+class ScriptCache;
 
 } // namespace engine
 
@@ -37,6 +47,10 @@ struct InputFrame;
 namespace engine
 {
 
+// Parses a collector mode name as --gc-mode and leo.memory.setGcMode accept it: "incremental" or "generational",
+// in any case. Returns false for anything else.
+bool ParseGcMode(const char *name, GcMode *out_mode) noexcept;
+
 class LuaRuntime
 {
   public:
@@ -46,14 +60,28 @@ class LuaRuntime
     LuaRuntime(const LuaRuntime &) = delete;
     LuaRuntime &operator=(const LuaRuntime &) = delete;
 
-    void Init(VFS &vfs, SDL_Window *window, SDL_Renderer *renderer, const engine::Config &config);
+    void Init(VFS &vfs, SDL_Window *window, SDL_Renderer *renderer, const engine::Config &config,
+              JobSystem *jobs = nullptr);
     void LoadScript(const char *vfs_path);
+    // Compiles a chunk and pushes it like luaL_loadbuffer, going through the bytecode cache when it is enabled.
+    int LoadChunk(lua_State *state, const void *data, size_t size, const char *chunk_name);
+    // Reseeds math.random so a recorded session replays the same random sequence.
+    void SetRandomSeed(Uint64 seed);
 
     void SetFrameInfo(Uint32 tick_index, float tick_dt);
     void CallLoad();
     void CallUpdate(float dt, const ::leo::Engine::InputFrame &input);
-    void CallDraw();
+    void CallDraw(float alpha);
     void CallShutdown();
+    // Finishes asynchronous loads (GPU uploads) within the configured per-frame budget. When the config records or
+    // replays input, decodes run inline and every pending load is finished, so call it before each tick.
+    void UpdateAssets();
+    // Runs incremental GC steps for up to the configured budget, capped at slack_ns. The engine calls this after
+    // present; the first call holds Lua's allocation-driven collector back to twice the usual heap growth, so steps
+    // normally run only here but a frame that allocates heavily is still collected. Returns the time spent.
+    Uint64 CollectGarbage(Uint64 slack_ns);
+    // Closes the per-frame Lua allocation counters; call once per rendered frame.
+    void EndFrame();
 
     bool WantsQuit() const noexcept;
     void ClearQuitRequest() noexcept;
@@ -70,6 +98,15 @@ class LuaRuntime
     const engine::Config *GetConfig() const noexcept;
     Uint32 GetTickIndex() const noexcept;
     float GetTickDt() const noexcept;
+    float GetRenderAlpha() const noexcept;
+    size_t GetMemoryUsage() const noexcept;
+    LuaMemoryStats GetMemoryStats() const noexcept;
+    // Allocations and bytes allocated by the Lua state during the last completed frame.
+    Uint64 GetFrameAllocationCount() const noexcept;
+    Uint64 GetFrameAllocatedBytes() const noexcept;
+    Uint64 GetFrameGcNs() const noexcept;
+    GcMode GetGcMode() const noexcept;
+    void SetGcMode(GcMode mode);
     SDL_Color GetDrawColor() const noexcept;
     void SetDrawColor(const SDL_Color &color) noexcept;
     engine::Font *GetCurrentFont() const noexcept;
@@ -77,15 +114,44 @@ class LuaRuntime
     int GetCurrentFontRef() const noexcept;
     void SetCurrentFont(engine::Font *font, int pixel_size, int ref) noexcept;
     void ClearCurrentFontRef(lua_State *L);
+    SpriteBatch &GetSpriteBatch() noexcept;
+    TextureCache *GetTextureCache() const noexcept;
+    AssetLoader &GetAssetLoader() const;
+    // Engine job system, or nullptr when the runtime was initialized without one.
+    JobSystem *GetJobSystem() const noexcept;
+    // Creates an offscreen canvas; the returned texture keeps it alive and draws like any other texture.
+    std::shared_ptr<Texture> CreateCanvas(int width, int height, bool preserve);
+    // Redirects drawing into the canvas behind target, or back to the screen for nullptr. Throws if target is not a
+    // canvas texture.
+    void SetCanvas(const Texture *target);
+    // True while texture is the canvas that draws are going into.
+    bool IsCanvasTarget(const Texture &texture) const noexcept;
+    // Restores canvas contents after SDL reports lost render targets or a reset device.
+    void RestoreCanvases(bool device_reset);
+    TaskScheduler &GetTaskScheduler() noexcept;
+    // Id of the leo.task whose coroutine is thread, or 0 when thread is not the task being resumed right now.
+    TaskId GetRunningTask(const lua_State *thread) const noexcept;
+    // leo.profile zones. Scripts can only finish zones they began; EndScriptZone returns false when none is open.
+    bool BeginScriptZone(const char *name);
+    bool EndScriptZone();
+    void FlushSprites();
 
   private:
+    // Advances the leo.task clocks by dt and resumes every task that is due. Called at the end of CallUpdate.
+    void UpdateTasks(float dt);
+    // Ends the zones a script left open, e.g. after an error between begin and finish. Called whenever control
+    // returns from script code so script zones never outlive the call that opened them.
+    void CloseScriptZones();
+
     lua_State *L;
     VFS *vfs;
+    JobSystem *jobs;
     SDL_Window *window;
     SDL_Renderer *renderer;
     const engine::Config *config;
     Uint32 tick_index;
     float tick_dt;
+    float render_alpha;
     bool loaded;
     bool quit_requested;
     SDL_Color draw_color;
@@ -94,6 +160,28 @@ class LuaRuntime
     int current_font_ref;
     engine::Font *current_font_ptr;
     int current_font_size;
+    int input_frame_ref;
+    SpriteBatch sprite_batch;
+    std::unique_ptr<TextureCache> texture_cache;
+    std::unique_ptr<AssetLoader> asset_loader;
+    std::unique_ptr<ScriptCache> script_cache;
+    std::unique_ptr<LuaAllocator> allocator;
+    LuaMemoryStats frame_start_stats;
+    Uint64 frame_allocations;
+    Uint64 frame_allocated_bytes;
+    GcMode gc_mode;
+    bool gc_paced;
+    bool gc_idle;
+    size_t gc_trigger_bytes;
+    Uint64 frame_gc_ns;
+    TaskScheduler task_scheduler;
+    std::vector<TaskId> due_tasks;
+    TaskId running_task;
+    const lua_State *running_thread;
+    Uint32 script_zones;
+    std::vector<std::weak_ptr<Canvas>> canvases;
+    std::shared_ptr<Canvas> active_canvas;
+    const ::leo::Camera::Camera2D *screen_camera;
 };
 
 } // namespace engine
@@ -139,6 +139,19 @@ class MouseState
         buttons_released[index] = 1;
     }
 
+    // Internal: overwrite one button's state, e.g. when replaying recorded input.
+    void SetButtonState(MouseButton button, bool is_down, bool is_pressed, bool is_released) noexcept
+    {
+        if (!IsValidButton(button))
+        {
+            return;
+        }
+        size_t index = Index(button);
+        buttons_down[index] = is_down ? 1 : 0;
+        buttons_pressed[index] = is_pressed ? 1 : 0;
+        buttons_released[index] = is_released ? 1 : 0;
+    }
+
     // Internal: update pointer location and deltas.
     void SetPosition(float new_x, float new_y) noexcept
     {
@@ -0,0 +1,102 @@
+#ifndef LEO_PROFILER_H
+#define LEO_PROFILER_H
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace engine
+{
+
+struct ProfileEvent
+{
+    const char *name;
+    Uint64 start;
+    Uint64 end;
+    Uint32 depth;
+};
+
+struct ProfileZoneSummary
+{
+    const char *name;
+    Uint32 depth;
+    Uint32 calls;
+    double total_ms;
+};
+
+struct ProfileThreadBuffer;
+
+// Collects named zones into a fixed-size ring buffer per thread. Zones are timed with SDL_GetPerformanceCounter
+// and can be dumped as Chrome trace-event JSON (chrome://tracing, Perfetto) or summarized per frame for the
+// on-screen overlay. When disabled, Begin/End cost one atomic load.
+class Profiler
+{
+  public:
+    static constexpr size_t kRingCapacity = 1 << 16;
+    static constexpr Uint32 kMaxDepth = 64;
+
+    static Profiler &Get();
+
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    void SetEnabled(bool enabled) noexcept;
+    bool IsEnabled() const noexcept;
+    void SetOverlayVisible(bool visible) noexcept;
+    bool IsOverlayVisible() const noexcept;
+
+    // Zone names must outlive the profiler; use InternName for names that do not.
+    bool BeginZone(const char *name);
+    bool EndZone();
+    const char *InternName(std::string_view name);
+
+    // Called once per frame on the main thread to capture the summary shown by DrawOverlay.
+    void EndFrame();
+    void DrawOverlay(SDL_Renderer *renderer) const;
+    const std::vector<ProfileZoneSummary> &GetFrameSummary() const noexcept;
+
+    std::string ToChromeTrace() const;
+    void Clear();
+
+  private:
+    Profiler();
+    ~Profiler();
+
+    ProfileThreadBuffer &GetThreadBuffer();
+
+    std::atomic<bool> enabled;
+    std::atomic<bool> overlay_visible;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> buffers;
+    std::unordered_set<std::string> names;
+    std::vector<ProfileZoneSummary> frame_summary;
+    Uint64 frame_start;
+    double last_frame_ms;
+    Uint64 epoch;
+};
+
+class ProfileScope
+{
+  public:
+    explicit ProfileScope(const char *name) noexcept;
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+    bool active;
+};
+
+} // namespace engine
+
+#define LEO_PROFILE_CONCAT_INNER(a, b) a##b
+#define LEO_PROFILE_CONCAT(a, b) LEO_PROFILE_CONCAT_INNER(a, b)
+#define LEO_PROFILE_SCOPE(name) ::engine::ProfileScope LEO_PROFILE_CONCAT(leo_profile_scope_, __LINE__)(name)
+
+#endif // LEO_PROFILER_H
@@ -0,0 +1,59 @@
+#ifndef LEO_SCRIPT_CACHE_H
+#define LEO_SCRIPT_CACHE_H
+
+#include <SDL3/SDL_stdinc.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+namespace engine
+{
+
+class VFS;
+
+// Compiled Lua chunks stored in the write directory under cache/lua/. Entries are keyed by a SHA-256 digest of the
+// source text, the chunk name and the Lua release and number format, and each entry's header repeats the source
+// length and full digest, so an edited script or a different Lua build never picks up stale bytecode. Entries past
+// kMaxEntries are pruned oldest first when the cache is created, so edits do not grow the directory without bound.
+//
+// Lua does not verify bytecode: anyone who can write cache/lua/ can run native code in the game. Disable the cache
+// where the write directory is not trusted.
+class ScriptCache
+{
+  public:
+    static constexpr size_t kMaxEntries = 256;
+
+    explicit ScriptCache(VFS &vfs) noexcept;
+
+    ScriptCache(const ScriptCache &) = delete;
+    ScriptCache &operator=(const ScriptCache &) = delete;
+
+    // Loads source as a chunk and pushes it, like luaL_loadbuffer. Cached bytecode is used when present; otherwise
+    // the source is compiled and the result stored. Returns a Lua status code with the error message pushed on
+    // failure. Cache read and write failures only cost the parse.
+    int Load(lua_State *L, const void *source, size_t size, const char *chunk_name);
+
+    // Compiles every .lua file in the mounted resources into the cache without running it. Returns the number of
+    // scripts now cached; syntax errors are appended to failures.
+    size_t CompileAll(std::vector<std::string> &failures);
+
+    Uint64 GetHitCount() const noexcept;
+    Uint64 GetMissCount() const noexcept;
+
+    static std::string GetEntryPath(const void *source, size_t size, const char *chunk_name);
+
+  private:
+    void Store(lua_State *L, const std::string &path, const std::string &header);
+    void Prune();
+
+    VFS &vfs;
+    Uint64 hits;
+    Uint64 misses;
+    bool store_failed;
+};
+
+} // namespace engine
+
+#endif // LEO_SCRIPT_CACHE_H
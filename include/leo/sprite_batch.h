@@ -0,0 +1,65 @@
+#ifndef LEO_SPRITE_BATCH_H
+#define LEO_SPRITE_BATCH_H
+
+#include "leo/texture_loader.h"
+#include <SDL3/SDL.h>
+#include <vector>
+
+namespace engine
+{
+
+struct SpriteDesc
+{
+    SDL_FRect src;
+    SDL_FRect dst;
+    SDL_FPoint center;
+    double angle;
+    SDL_FlipMode flip;
+    SDL_Color color;
+};
+
+// Untextured vertices and indices reserved by SpriteBatch::AddGeometry. Indices are absolute: offset the shape's
+// own indices by first_vertex.
+struct GeometrySpan
+{
+    SDL_Vertex *vertices;
+    int *indices;
+    int first_vertex;
+};
+
+// Collects textured quads and submits consecutive quads that share a texture with one SDL_RenderGeometry call.
+// Untextured triangles (the leo::Graphics shapes) batch the same way, so a run of shapes is one call as well.
+// Anything that renders outside the batch must call Flush() first so draw order is preserved.
+class SpriteBatch
+{
+  public:
+    SpriteBatch() noexcept;
+    explicit SpriteBatch(SDL_Renderer *renderer) noexcept;
+
+    SpriteBatch(const SpriteBatch &) = delete;
+    SpriteBatch &operator=(const SpriteBatch &) = delete;
+
+    void SetRenderer(SDL_Renderer *renderer);
+    void Draw(const Texture &texture, const SpriteDesc &desc);
+    // Reserves room for one untextured shape. The caller fills every vertex position and color and every index
+    // before the next call; the pointers are invalidated by any later call on the batch.
+    GeometrySpan AddGeometry(int vertex_count, int index_count);
+    void Flush();
+    void Clear() noexcept;
+
+    int GetPendingSprites() const noexcept;
+    Uint32 GetFlushCount() const noexcept;
+    void ResetStats() noexcept;
+
+  private:
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    int pending_sprites;
+    Uint32 flush_count;
+};
+
+} // namespace engine
+
+#endif // LEO_SPRITE_BATCH_H
@@ -0,0 +1,95 @@
+#ifndef LEO_TASK_SCHEDULER_H
+#define LEO_TASK_SCHEDULER_H
+
+#include <SDL3/SDL_stdinc.h>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace engine
+{
+
+using TaskId = Uint32;
+
+// Wake-up bookkeeping for cooperative tasks (the Lua coroutines behind leo.task). The scheduler never runs anything
+// itself: Advance() moves the clock forward one tick and reports which tasks are due, and the owner resumes them.
+//
+// Sleeping tasks sit in min-heaps keyed by wake time or wake tick, so a tick costs nothing for tasks that are not
+// due. Only tasks waiting on a condition are polled every tick. Clocks are simulation time (the sum of the dt passed
+// to Advance), so schedules replay deterministically.
+class TaskScheduler
+{
+  public:
+    TaskScheduler() noexcept;
+
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+    // Creates a task that is due on the next Advance. Ids are never 0.
+    TaskId Spawn();
+
+    // Wait requests for a task that Advance just reported as due. Each replaces the task's running state until the
+    // next time it is reported.
+    void Sleep(TaskId id, double seconds);
+    void SleepTicks(TaskId id, Uint32 ticks);
+    void WaitUntil(TaskId id, std::function<bool()> condition);
+    // Call after resuming a task that yielded without a wait request; it becomes due again on the next tick.
+    void Suspend(TaskId id);
+
+    // Forgets the task; pending wake-ups are dropped. Returns false if the task was already gone.
+    bool Cancel(TaskId id);
+    bool IsAlive(TaskId id) const noexcept;
+
+    // Advances the clocks by one tick of dt seconds and appends every task due now to out: newly spawned tasks
+    // first, then timers in wake order, then tick waits, then satisfied conditions.
+    void Advance(double dt, std::vector<TaskId> &out);
+
+    size_t GetTaskCount() const noexcept;
+    double GetTime() const noexcept;
+    Uint64 GetTick() const noexcept;
+
+  private:
+    enum class TaskState
+    {
+        Ready,
+        Running,
+        Sleeping,
+        Waiting
+    };
+
+    struct Task
+    {
+        TaskState state;
+        std::function<bool()> condition;
+    };
+
+    struct TimeWake
+    {
+        double due;
+        Uint64 order;
+        TaskId id;
+    };
+
+    struct TickWake
+    {
+        Uint64 due;
+        Uint64 order;
+        TaskId id;
+    };
+
+    Task *FindRunning(TaskId id);
+
+    std::unordered_map<TaskId, Task> tasks;
+    std::vector<TaskId> ready;
+    std::vector<TimeWake> timers;
+    std::vector<TickWake> tick_waits;
+    std::vector<TaskId> waiting;
+    TaskId next_id;
+    Uint64 next_order;
+    double time;
+    Uint64 tick;
+};
+
+} // namespace engine
+
+#endif // LEO_TASK_SCHEDULER_H
@@ -0,0 +1,80 @@
+#ifndef LEO_TEXTURE_ATLAS_H
+#define LEO_TEXTURE_ATLAS_H
+
+#include "leo/texture_loader.h"
+#include <SDL3/SDL.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine
+{
+
+class JobSystem;
+
+// Skyline bottom-left rectangle packer. The skyline is the top edge of everything placed so far, kept as a list of
+// horizontal segments; each rectangle goes where its bottom would sit lowest, ties going to the leftmost spot.
+class SkylinePacker
+{
+  public:
+    SkylinePacker(int width, int height);
+
+    // Places a w x h rectangle and stores its top-left corner in out. Returns false if it does not fit.
+    bool Insert(int w, int h, SDL_Point *out);
+
+  private:
+    struct Segment
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    bool Fit(size_t index, int w, int h, int *out_y) const;
+
+    std::vector<Segment> skyline;
+    int width;
+    int height;
+};
+
+struct TextureAtlasOptions
+{
+    int page_size = 2048; // Pages are at most page_size square; each is trimmed to the area it uses
+    int padding = 1;      // Border around every image, filled with its edge pixels so filtering does not bleed
+};
+
+// Packs many images onto a few page textures so sprites drawn from different images still batch together. Every
+// image becomes a sub-image Texture that shares its page's handle and keeps the page alive; draw it like any other
+// texture.
+class TextureAtlas
+{
+  public:
+    TextureAtlas() noexcept;
+
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+    TextureAtlas(TextureAtlas &&other) noexcept = default;
+    TextureAtlas &operator=(TextureAtlas &&other) noexcept = default;
+
+    // Decodes the images (on the job system when one is given), packs them tallest first and uploads the pages.
+    // Repeated paths are packed once. Throws if an image fails to load or is larger than a page.
+    static TextureAtlas Build(VFS &vfs, SDL_Renderer *renderer, const std::vector<std::string> &vfs_paths,
+                              const TextureAtlasOptions &options = {}, JobSystem *jobs = nullptr);
+    // Image files (by extension) anywhere under vfs_dir, sorted so atlases build the same way every run.
+    static std::vector<std::string> ListImages(VFS &vfs, const char *vfs_dir);
+
+    // Sub-image packed from vfs_path, or nullptr if the path is not in the atlas.
+    std::shared_ptr<Texture> Find(const char *vfs_path) const;
+    const std::unordered_map<std::string, std::shared_ptr<Texture>> &GetImages() const noexcept;
+    const std::vector<std::shared_ptr<Texture>> &GetPages() const noexcept;
+
+  private:
+    std::vector<std::shared_ptr<Texture>> pages;
+    std::unordered_map<std::string, std::shared_ptr<Texture>> images;
+};
+
+} // namespace engine
+
+#endif // LEO_TEXTURE_ATLAS_H
@@ -0,0 +1,55 @@
+#ifndef LEO_TEXTURE_CACHE_H
+#define LEO_TEXTURE_CACHE_H
+
+#include "leo/texture_loader.h"
+#include <SDL3/SDL.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace engine
+{
+
+struct TextureCacheStats
+{
+    size_t entries;
+    size_t unused_entries;
+    size_t bytes;
+    Uint64 hits;
+    Uint64 misses;
+};
+
+// Shares one GPU texture per VFS path. Handles are reference counted; the cache keeps its own reference until
+// Purge() drops entries nobody else holds.
+class TextureCache
+{
+  public:
+    TextureCache(VFS &vfs, SDL_Renderer *renderer);
+    ~TextureCache();
+
+    TextureCache(const TextureCache &) = delete;
+    TextureCache &operator=(const TextureCache &) = delete;
+
+    std::shared_ptr<Texture> Acquire(const char *vfs_path);
+    // Stores a texture loaded elsewhere (e.g. asynchronously) under vfs_path. If the path was cached in the
+    // meantime, the existing entry wins and texture is released.
+    std::shared_ptr<Texture> Adopt(const char *vfs_path, Texture texture);
+    // Makes texture the entry for vfs_path, replacing any cached one; handles already given out keep theirs.
+    // TextureAtlas uses this so later loads of a packed path get the atlas sub-image.
+    void Insert(const char *vfs_path, std::shared_ptr<Texture> texture);
+    bool Contains(const char *vfs_path) const;
+    size_t Purge();
+    void Clear() noexcept;
+    TextureCacheStats GetStats() const noexcept;
+
+  private:
+    VFS &vfs;
+    SDL_Renderer *renderer;
+    std::unordered_map<std::string, std::shared_ptr<Texture>> entries;
+    Uint64 hits;
+    Uint64 misses;
+};
+
+} // namespace engine
+
+#endif // LEO_TEXTURE_CACHE_H
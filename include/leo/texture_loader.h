@@ -3,18 +3,27 @@
 
 #include "leo/vfs.h"
 #include <SDL3/SDL.h>
+#include <memory>
+#include <vector>
 
 namespace engine
 {
 
+// A GPU texture, or a sub-image of one. Sub-images (see TextureAtlas) borrow the handle of a shared page texture and
+// sit at (x, y) on it; width and height are always the image's own size, so callers address pixels the same way in
+// both cases and convert to texture coordinates with ToTexCoords.
 struct Texture
 {
     SDL_Texture *handle;
     int width;
     int height;
+    int x;
+    int y;
+    std::shared_ptr<Texture> page;
 
     Texture() noexcept;
     Texture(SDL_Texture *handle, int width, int height) noexcept;
+    Texture(std::shared_ptr<Texture> page, const SDL_Rect &region) noexcept;
     ~Texture();
 
     Texture(const Texture &) = delete;
@@ -24,17 +33,50 @@ struct Texture
     Texture &operator=(Texture &&other) noexcept;
 
     void Reset() noexcept;
+    // Normalized coordinates on handle for src, given in this texture's pixels. Requires a non-empty texture.
+    SDL_FRect ToTexCoords(const SDL_FRect &src) const noexcept;
 };
 
+// RGBA8 pixels decoded from an image file. Produced without touching the renderer, so it can be built on a
+// worker thread and uploaded later with TextureLoader::Upload.
+struct DecodedImage
+{
+    unsigned char *pixels;
+    int width;
+    int height;
+
+    DecodedImage() noexcept;
+    ~DecodedImage();
+
+    DecodedImage(const DecodedImage &) = delete;
+    DecodedImage &operator=(const DecodedImage &) = delete;
+
+    DecodedImage(DecodedImage &&other) noexcept;
+    DecodedImage &operator=(DecodedImage &&other) noexcept;
+
+    void Reset() noexcept;
+};
+
+class TextureCache;
+
 class TextureLoader
 {
   public:
-    TextureLoader(VFS &vfs, SDL_Renderer *renderer);
+    TextureLoader(VFS &vfs, SDL_Renderer *renderer, TextureCache *cache = nullptr);
     Texture Load(const char *vfs_path);
+    std::shared_ptr<Texture> Acquire(const char *vfs_path);
+
+    // Decodes any format stb_image reads, or a cooked image (see Cook) without decoding at all.
+    static DecodedImage Decode(VFS &vfs, const char *vfs_path);
+    Texture Upload(const DecodedImage &image);
+
+    // Cooked form of image: its RGBA8 pixels behind a kCookedImageTag header, ready to upload as read.
+    static std::vector<unsigned char> Cook(const DecodedImage &image);
 
   private:
     VFS &vfs;
     SDL_Renderer *renderer;
+    TextureCache *cache;
 };
 
 } // namespace engine
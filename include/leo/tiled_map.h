@@ -4,6 +4,7 @@
 #include "leo/texture_loader.h"
 #include <SDL3/SDL.h>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -20,6 +21,8 @@ namespace engine
 {
 
 class VFS;
+class TextureCache;
+class JobSystem;
 
 class TiledMap
 {
@@ -32,7 +35,13 @@ class TiledMap
     TiledMap(const TiledMap &) = delete;
     TiledMap &operator=(const TiledMap &) = delete;
 
-    static TiledMap LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path);
+    // Tile images are read and decoded on the job system when one is given; uploads stay on the calling thread.
+    // vfs_path may also hold a map written by Cook, which loads without parsing any XML.
+    static TiledMap LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path,
+                                TextureCache *cache = nullptr, JobSystem *jobs = nullptr);
+    // Cooked form of a .tmx map: its layers, tilesets and resolved image paths in a kCookedMapTag file. Images are
+    // still loaded by path, so they can be cooked separately.
+    static std::vector<unsigned char> Cook(VFS &vfs, const char *vfs_path);
 
     bool IsReady() const noexcept;
     void Reset() noexcept;
@@ -57,6 +66,18 @@ class TiledMap
         std::uint8_t flip_flags = 0;
     };
 
+    struct ChunkBatch
+    {
+        size_t texture_index = 0;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    struct Chunk
+    {
+        std::vector<ChunkBatch> batches;
+    };
+
     struct Layer
     {
         std::string name;
@@ -67,6 +88,9 @@ class TiledMap
         bool visible = true;
         float opacity = 1.0f;
         std::vector<Tile> tiles;
+        int chunk_cols = 0;
+        int chunk_rows = 0;
+        std::vector<Chunk> chunks;
     };
 
     struct TileDrawInfo
@@ -77,6 +101,8 @@ class TiledMap
         int draw_h = 0;
     };
 
+    struct Source;
+
     int map_width;
     int map_height;
     int tile_width;
@@ -84,8 +110,13 @@ class TiledMap
     bool ready;
 
     std::vector<Layer> layers;
-    std::vector<Texture> textures;
-    std::unordered_map<std::uint32_t, TileDrawInfo> tiles;
+    std::vector<std::shared_ptr<Texture>> textures;
+    mutable std::vector<SDL_Vertex> scratch_vertices;
+
+    static Source ReadSource(VFS &vfs, const char *vfs_path);
+    static TiledMap Build(VFS &vfs, SDL_Renderer *renderer, Source &&source, TextureCache *cache, JobSystem *jobs);
+    static void BuildChunks(Layer &layer, const std::unordered_map<std::uint32_t, TileDrawInfo> &tile_infos,
+                            const std::vector<std::shared_ptr<Texture>> &textures, int tile_width, int tile_height);
 };
 
 } // namespace engine
@@ -2,10 +2,67 @@
 #define LEO_VFS_H
 
 #include "engine_config.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace engine
 {
 
+// Incremental reader over a file in the mounted resources, for data that should not be read in one go
+// (e.g. streamed music). Move-only; the file is closed on destruction. A reader may be used from any thread,
+// but not from two threads at once.
+class VfsReader
+{
+  public:
+    VfsReader() noexcept;
+    ~VfsReader();
+    VfsReader(VfsReader &&other) noexcept;
+    VfsReader &operator=(VfsReader &&other) noexcept;
+
+    VfsReader(const VfsReader &) = delete;
+    VfsReader &operator=(const VfsReader &) = delete;
+
+    bool IsOpen() const noexcept;
+    void Close() noexcept;
+
+    // Read up to size bytes; returns the number read (0 at end of file). Throws on I/O errors.
+    size_t Read(void *dst, size_t size);
+    void Seek(Uint64 offset);
+    Uint64 Tell() const;
+    Uint64 GetLength() const;
+
+  private:
+    friend class VFS;
+    explicit VfsReader(void *file) noexcept;
+
+    void *file;
+};
+
+// Read-only bytes of a whole file in the mounted resources, from VFS::ReadView. Plain files in a directory mount and
+// stored (uncompressed) zip entries are memory-mapped, so reading them costs no allocation or copy; anything else is
+// read into a buffer. Copies share the bytes, which stay valid until the last copy is gone, on any thread.
+class VfsView
+{
+  public:
+    VfsView() noexcept;
+
+    const unsigned char *GetData() const noexcept;
+    size_t GetSize() const noexcept;
+    // True when the bytes are mapped from disk rather than a buffered copy.
+    bool IsMapped() const noexcept;
+    void Reset() noexcept;
+
+  private:
+    friend class VFS;
+
+    std::shared_ptr<const void> owner;
+    const unsigned char *data;
+    size_t size;
+    bool mapped;
+};
+
 class VFS
 {
   public:
@@ -23,6 +80,20 @@ class VFS
     // Read entire file into SDL-allocated buffer. Caller frees via SDL_free.
     void ReadAll(const char *vfs_path, void **out_data, size_t *out_size);
 
+    // True if a file or directory exists in the mounted resources.
+    bool Exists(const char *vfs_path) const noexcept;
+
+    // Read entire file, mapped from disk when possible (see VfsView). Throws like ReadAll. A mapped directory file
+    // must not be truncated while a view of it is alive.
+    VfsView ReadView(const char *vfs_path);
+
+    // Open a file from mounted resources for incremental reads. Throws if the file cannot be opened.
+    VfsReader OpenRead(const char *vfs_path);
+
+    // List files under a directory of the mounted resources ("" = everything), returning full VFS paths.
+    // Free with FreeList.
+    void ListFiles(const char *vfs_path, char ***out_entries);
+
     // Read file from write directory only. Caller frees via SDL_free.
     void ReadAllWriteDir(const char *vfs_path, void **out_data, size_t *out_size);
 
@@ -35,7 +106,7 @@ class VFS
     // List files under the write directory, returning full relative paths.
     void ListWriteDirFiles(char ***out_entries);
 
-    // Free a list returned by ListWriteDir or ListWriteDirFiles.
+    // Free a list returned by ListFiles, ListWriteDir or ListWriteDirFiles.
     void FreeList(char **entries) noexcept;
 
     // Delete a single file from the write directory.
@@ -45,8 +116,15 @@ class VFS
     void DeleteDirRecursive(const char *vfs_path);
 
   private:
+    struct ArchiveIndex;
+
     Config &config;
     bool initialized_physfs; // Track if this instance initialized PhysFS
+    std::mutex archives_mutex;
+    // Mapped zip archives by real path, built on first ReadView and rebuilt when the archive's size or mtime changes
+    std::unordered_map<std::string, std::shared_ptr<ArchiveIndex>> archives;
+
+    std::shared_ptr<ArchiveIndex> GetArchiveIndex(const char *archive_path);
 
     // Helper: Try to mount a path, returns true on success, false on failure
     // Does not throw
@@ -12,10 +12,11 @@ local world_w = 1280
 local world_h = 720
 
 local font = nil
+local sheet = nil
 
 local sprites = {}
 local max_sprites = nil
-local spawn_rate = 0.002
+local spawn_rate = 0.0005
 local spawn_accum = 0
 local delete_rate = 0.004
 local delete_accum = 0
@@ -30,15 +31,12 @@ local function rand_range(min, max)
 end
 
 local function spawn_sprite(x, y)
-  local anim = animation_api.newSheet({
-    path = "resources/images/animation_test.png",
-    frame_w = 64,
-    frame_h = 64,
-    frame_count = 3,
-    frame_time = rand_range(0.08, 0.18),
-    looping = true,
-    playing = true,
-  })
+  -- Every sprite shares one texture so consecutive draws land in the same sprite batch.
+  local anim = animation_api.newFromTexture(sheet, true, true)
+  local frame_time = rand_range(0.08, 0.18)
+  for i = 0, 2 do
+    anim:addFrame(i * 64, 0, 64, 64, frame_time)
+  end
 
   local tint_choice = math.random()
   local r, g, b = 255, 255, 255
@@ -125,6 +123,7 @@ end
 function leo.load()
   math.randomseed(os.time())
   font = font_api.new("resources/fonts/font.ttf", 18)
+  sheet = graphics.newImage("resources/images/animation_test.png")
   leo.mouse.setCursorVisible(false)
 end
 
@@ -0,0 +1,360 @@
+#include "leo/asset_cooker.h"
+#include "leo/font.h"
+#include "leo/profiler.h"
+#include "leo/texture_loader.h"
+#include "leo/tiled_map.h"
+#include "leo/vfs.h"
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+constexpr Uint32 kLocalHeaderSignature = 0x04034b50;
+constexpr Uint32 kCentralHeaderSignature = 0x02014b50;
+constexpr Uint32 kEndOfDirectorySignature = 0x06054b50;
+constexpr size_t kLocalHeaderSize = 30;
+constexpr Uint16 kVersionNeeded = 10;        // 1.0: stored entries only
+constexpr Uint16 kUtf8Flag = 0x0800;         // Names are UTF-8
+constexpr Uint16 kDosDate = 0x0021;          // 1980-01-01, so packs cook byte-identical every run
+constexpr Uint16 kAlignmentExtraId = 0xD935; // Alignment value, then zero padding
+constexpr size_t kMinAlignmentExtraSize = 6; // Header plus the alignment value
+constexpr size_t kMaxEntries = 65535;
+constexpr Uint64 kMaxPackSize = 0xFFFFFFFFu;
+
+void Put16(std::vector<unsigned char> &out, Uint16 value)
+{
+    out.push_back(static_cast<unsigned char>(value));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+}
+
+void Put32(std::vector<unsigned char> &out, Uint32 value)
+{
+    Put16(out, static_cast<Uint16>(value));
+    Put16(out, static_cast<Uint16>(value >> 16));
+}
+
+// CRC-32 as ZIP defines it (reflected 0xEDB88320, inverted in and out).
+Uint32 Crc32(const void *data, size_t size)
+{
+    static const std::array<Uint32, 256> table = [] {
+        std::array<Uint32, 256> result = {};
+        for (Uint32 i = 0; i < 256; ++i)
+        {
+            Uint32 c = i;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            result[i] = c;
+        }
+        return result;
+    }();
+
+    Uint32 crc = 0xFFFFFFFFu;
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool HasExtension(const std::string &path, std::initializer_list<const char *> extensions)
+{
+    const size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || path.find('/', dot) != std::string::npos)
+    {
+        return false;
+    }
+    for (const char *extension : extensions)
+    {
+        if (SDL_strcasecmp(path.c_str() + dot, extension) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IsImagePath(const std::string &path)
+{
+    return HasExtension(path, {".png", ".jpg", ".jpeg", ".bmp", ".tga"});
+}
+
+bool IsFontPath(const std::string &path)
+{
+    return HasExtension(path, {".ttf", ".otf"});
+}
+
+bool IsMapPath(const std::string &path)
+{
+    return HasExtension(path, {".tmx"});
+}
+
+} // namespace
+
+namespace engine
+{
+
+PackWriter::PackWriter(const char *path) : io(nullptr), entries(), names(), offset(0)
+{
+    if (!path || !*path)
+    {
+        throw std::runtime_error("PackWriter requires a non-empty path");
+    }
+    io = SDL_IOFromFile(path, "wb");
+    if (!io)
+    {
+        throw std::runtime_error(std::string("PackWriter failed to create '") + path + "': " + SDL_GetError());
+    }
+}
+
+PackWriter::~PackWriter()
+{
+    if (io)
+    {
+        SDL_CloseIO(io);
+    }
+}
+
+void PackWriter::Add(const std::string &name, const void *data, size_t size)
+{
+    if (!io)
+    {
+        throw std::runtime_error("PackWriter::Add called after Finish");
+    }
+    if (name.empty() || name.size() > 0xFFFF)
+    {
+        throw std::runtime_error("PackWriter::Add entry name length out of range");
+    }
+    if (names.count(name))
+    {
+        throw std::runtime_error("PackWriter::Add duplicate entry '" + name + "'");
+    }
+    if (entries.size() >= kMaxEntries)
+    {
+        throw std::runtime_error("PackWriter::Add pack has too many entries");
+    }
+
+    size_t padding = (kPackAlignment - (offset + kLocalHeaderSize + name.size()) % kPackAlignment) % kPackAlignment;
+    if (padding > 0 && padding < kMinAlignmentExtraSize)
+    {
+        padding += kPackAlignment;
+    }
+    if (offset + kLocalHeaderSize + name.size() + padding + size > kMaxPackSize)
+    {
+        throw std::runtime_error("PackWriter::Add pack would exceed 4 GB");
+    }
+
+    Entry entry = {name, Crc32(data, size), static_cast<Uint32>(size), static_cast<Uint32>(offset)};
+
+    std::vector<unsigned char> header;
+    header.reserve(kLocalHeaderSize + name.size() + padding);
+    Put32(header, kLocalHeaderSignature);
+    Put16(header, kVersionNeeded);
+    Put16(header, kUtf8Flag);
+    Put16(header, 0); // Stored
+    Put16(header, 0); // Time
+    Put16(header, kDosDate);
+    Put32(header, entry.crc);
+    Put32(header, entry.size);
+    Put32(header, entry.size);
+    Put16(header, static_cast<Uint16>(name.size()));
+    Put16(header, static_cast<Uint16>(padding));
+    header.insert(header.end(), name.begin(), name.end());
+    if (padding > 0)
+    {
+        Put16(header, kAlignmentExtraId);
+        Put16(header, static_cast<Uint16>(padding - 4));
+        Put16(header, static_cast<Uint16>(kPackAlignment));
+        header.resize(header.size() + padding - kMinAlignmentExtraSize, 0);
+    }
+
+    Write(header.data(), header.size());
+    Write(data, size);
+    entries.push_back(std::move(entry));
+    names.insert(name);
+}
+
+bool PackWriter::Contains(const std::string &name) const
+{
+    return names.count(name) != 0;
+}
+
+void PackWriter::Finish()
+{
+    if (!io)
+    {
+        throw std::runtime_error("PackWriter::Finish called twice");
+    }
+
+    const Uint64 directory_offset = offset;
+    std::vector<unsigned char> directory;
+    for (const Entry &entry : entries)
+    {
+        Put32(directory, kCentralHeaderSignature);
+        Put16(directory, kVersionNeeded); // Made by: MS-DOS host
+        Put16(directory, kVersionNeeded);
+        Put16(directory, kUtf8Flag);
+        Put16(directory, 0); // Stored
+        Put16(directory, 0); // Time
+        Put16(directory, kDosDate);
+        Put32(directory, entry.crc);
+        Put32(directory, entry.size);
+        Put32(directory, entry.size);
+        Put16(directory, static_cast<Uint16>(entry.name.size()));
+        Put16(directory, 0); // Extra field
+        Put16(directory, 0); // Comment
+        Put16(directory, 0); // Disk
+        Put16(directory, 0); // Internal attributes
+        Put32(directory, 0); // External attributes
+        Put32(directory, entry.offset);
+        directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+    }
+    if (directory_offset + directory.size() > kMaxPackSize)
+    {
+        throw std::runtime_error("PackWriter::Finish pack would exceed 4 GB");
+    }
+
+    const size_t directory_size = directory.size();
+    Put32(directory, kEndOfDirectorySignature);
+    Put16(directory, 0); // This disk
+    Put16(directory, 0); // Directory disk
+    Put16(directory, static_cast<Uint16>(entries.size()));
+    Put16(directory, static_cast<Uint16>(entries.size()));
+    Put32(directory, static_cast<Uint32>(directory_size));
+    Put32(directory, static_cast<Uint32>(directory_offset));
+    Put16(directory, 0); // Comment
+
+    Write(directory.data(), directory.size());
+    SDL_IOStream *closing = io;
+    io = nullptr;
+    if (!SDL_CloseIO(closing))
+    {
+        throw std::runtime_error(std::string("PackWriter::Finish failed to close pack: ") + SDL_GetError());
+    }
+}
+
+size_t PackWriter::GetEntryCount() const noexcept
+{
+    return entries.size();
+}
+
+void PackWriter::Write(const void *data, size_t size)
+{
+    if (size > 0 && SDL_WriteIO(io, data, size) != size)
+    {
+        throw std::runtime_error(std::string("PackWriter failed to write pack: ") + SDL_GetError());
+    }
+    offset += size;
+}
+
+AssetCooker::AssetCooker(VFS &vfs, const CookOptions &options) : vfs(vfs), options(options)
+{
+    for (int size : options.font_sizes)
+    {
+        if (size <= 0)
+        {
+            throw std::runtime_error("AssetCooker font sizes must be positive");
+        }
+    }
+}
+
+CookStats AssetCooker::Cook(const char *vfs_dir, const char *pack_path, std::vector<std::string> &failures)
+{
+    LEO_PROFILE_SCOPE("AssetCooker::Cook");
+    if (!vfs_dir)
+    {
+        throw std::runtime_error("AssetCooker::Cook requires a directory");
+    }
+
+    char **entries = nullptr;
+    vfs.ListFiles(vfs_dir, &entries);
+    std::vector<std::string> paths;
+    for (char **it = entries; it && *it; ++it)
+    {
+        paths.emplace_back(*it);
+    }
+    vfs.FreeList(entries);
+    // Sorted so a font comes before any atlas already cooked next to it, and packs come out the same every run.
+    std::sort(paths.begin(), paths.end());
+
+    PackWriter pack(pack_path);
+    CookStats stats;
+    for (const std::string &path : paths)
+    {
+        if (pack.Contains(path))
+        {
+            continue;
+        }
+
+        // Everything is cooked before anything is written, so a file that fails leaves nothing partial behind.
+        std::vector<unsigned char> cooked;
+        std::vector<std::pair<std::string, std::vector<unsigned char>>> atlases;
+        try
+        {
+            if (IsImagePath(path))
+            {
+                cooked = TextureLoader::Cook(TextureLoader::Decode(vfs, path.c_str()));
+            }
+            else if (IsMapPath(path))
+            {
+                cooked = TiledMap::Cook(vfs, path.c_str());
+            }
+            else if (IsFontPath(path))
+            {
+                for (int size : options.font_sizes)
+                {
+                    std::string cooked_path = Font::GetCookedPath(path.c_str(), size);
+                    if (!pack.Contains(cooked_path))
+                    {
+                        atlases.emplace_back(std::move(cooked_path), Font::Cook(Font::Bake(vfs, path.c_str(), size)));
+                    }
+                }
+            }
+        }
+        catch (const std::exception &e)
+        {
+            failures.push_back(path + ": " + e.what());
+            cooked.clear();
+            atlases.clear();
+        }
+
+        if (!cooked.empty())
+        {
+            pack.Add(path, cooked.data(), cooked.size());
+            (IsImagePath(path) ? stats.images : stats.maps)++;
+            continue;
+        }
+        for (const auto &[cooked_path, atlas] : atlases)
+        {
+            pack.Add(cooked_path, atlas.data(), atlas.size());
+            stats.fonts++;
+        }
+
+        void *data = nullptr;
+        size_t size = 0;
+        vfs.ReadAll(path.c_str(), &data, &size);
+        try
+        {
+            pack.Add(path, data, size);
+        }
+        catch (...)
+        {
+            SDL_free(data);
+            throw;
+        }
+        SDL_free(data);
+        stats.copied++;
+    }
+
+    pack.Finish();
+    return stats;
+}
+
+} // namespace engine
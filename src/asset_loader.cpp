@@ -0,0 +1,304 @@
+#include "leo/asset_loader.h"
+#include "leo/profiler.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace
+{
+
+bool RemoveRequest(std::deque<std::shared_ptr<engine::AssetRequest>> &list, const engine::AssetRequest *request)
+{
+    auto it = std::find_if(list.begin(), list.end(), [request](const std::shared_ptr<engine::AssetRequest> &entry) {
+        return entry.get() == request;
+    });
+    if (it == list.end())
+    {
+        return false;
+    }
+    list.erase(it);
+    return true;
+}
+
+} // namespace
+
+namespace engine
+{
+
+AssetStatus AssetRequest::GetStatus() const noexcept
+{
+    return status;
+}
+
+bool AssetRequest::IsDone() const noexcept
+{
+    return status != AssetStatus::Pending;
+}
+
+const std::string &AssetRequest::GetError() const noexcept
+{
+    return error;
+}
+
+AssetLoader::AssetLoader(Uint32 worker_count)
+    : mutex(), work_ready(), work_done(), queued(), decoded(), pending(0), stopping(false), workers(), jobs(nullptr),
+      decode_jobs()
+{
+    workers.reserve(worker_count);
+    for (Uint32 i = 0; i < worker_count; ++i)
+    {
+        workers.emplace_back(&AssetLoader::WorkerLoop, this);
+    }
+}
+
+AssetLoader::AssetLoader(JobSystem &job_system)
+    : mutex(), work_ready(), work_done(), queued(), decoded(), pending(0), stopping(false), workers(),
+      jobs(&job_system), decode_jobs()
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    // Jobs that start after this point see stopping and return; wait out any that are mid-decode.
+    for (const JobHandle &job : decode_jobs)
+    {
+        jobs->Wait(job);
+    }
+
+    // Requests that never finished are failed so futures held elsewhere do not wait forever.
+    for (std::deque<std::shared_ptr<AssetRequest>> *list : {&queued, &decoded})
+    {
+        for (const std::shared_ptr<AssetRequest> &request : *list)
+        {
+            request->decode = nullptr;
+            request->finish = nullptr;
+            request->stage = AssetRequest::Stage::Finished;
+            request->status = AssetStatus::Failed;
+            request->error = "AssetLoader shut down before the load finished";
+        }
+        list->clear();
+    }
+}
+
+std::shared_ptr<AssetRequest> AssetLoader::Submit(std::function<void()> decode, std::function<void()> finish)
+{
+    auto request = std::make_shared<AssetRequest>();
+    request->decode = std::move(decode);
+    request->finish = std::move(finish);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.push_back(request);
+        pending++;
+    }
+    work_ready.notify_one();
+
+    // Each job decodes whichever request is oldest, so the pool's own ordering does not reorder loads.
+    if (jobs)
+    {
+        std::erase_if(decode_jobs, [](const JobHandle &job) { return job.IsDone(); });
+        decode_jobs.push_back(jobs->Schedule([this]() { DecodeNext(); }));
+    }
+    return request;
+}
+
+size_t AssetLoader::Update(Uint64 budget_ns)
+{
+    Uint64 start_ns = SDL_GetTicksNS();
+    size_t completed = 0;
+    for (;;)
+    {
+        std::shared_ptr<AssetRequest> request;
+        bool decode_inline = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!decoded.empty())
+            {
+                request = std::move(decoded.front());
+                decoded.pop_front();
+            }
+            else if (!jobs && workers.empty() && !queued.empty())
+            {
+                request = std::move(queued.front());
+                queued.pop_front();
+                decode_inline = true;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (decode_inline)
+        {
+            RunDecode(*request);
+        }
+        RunFinish(*request);
+        completed++;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+        }
+
+        if (SDL_GetTicksNS() - start_ns >= budget_ns)
+        {
+            break;
+        }
+    }
+    return completed;
+}
+
+void AssetLoader::Wait(const std::shared_ptr<AssetRequest> &request)
+{
+    if (!request)
+    {
+        return;
+    }
+
+    bool decode_inline = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (request->stage == AssetRequest::Stage::Finished)
+        {
+            return;
+        }
+        if (request->stage == AssetRequest::Stage::Queued)
+        {
+            RemoveRequest(queued, request.get());
+            request->stage = AssetRequest::Stage::Decoding;
+            decode_inline = true;
+        }
+        else
+        {
+            work_done.wait(lock, [&request]() { return request->stage == AssetRequest::Stage::Decoded; });
+            RemoveRequest(decoded, request.get());
+        }
+    }
+
+    if (decode_inline)
+    {
+        RunDecode(*request);
+    }
+    RunFinish(*request);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending--;
+}
+
+size_t AssetLoader::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
+
+Uint32 AssetLoader::GetWorkerCount() const noexcept
+{
+    return jobs ? jobs->GetWorkerCount() : static_cast<Uint32>(workers.size());
+}
+
+void AssetLoader::WorkerLoop()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [this]() { return stopping || !queued.empty(); });
+            if (stopping)
+            {
+                return;
+            }
+        }
+        DecodeNext();
+    }
+}
+
+// Decodes the oldest queued request on the calling thread. Does nothing if Wait or another worker has already
+// taken every queued request.
+void AssetLoader::DecodeNext()
+{
+    std::shared_ptr<AssetRequest> request;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || queued.empty())
+        {
+            return;
+        }
+        request = std::move(queued.front());
+        queued.pop_front();
+        request->stage = AssetRequest::Stage::Decoding;
+    }
+
+    RunDecode(*request);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        request->stage = AssetRequest::Stage::Decoded;
+        decoded.push_back(std::move(request));
+    }
+    work_done.notify_all();
+}
+
+void AssetLoader::RunDecode(AssetRequest &request)
+{
+    LEO_PROFILE_SCOPE("AssetLoader::Decode");
+    try
+    {
+        if (request.decode)
+        {
+            request.decode();
+        }
+    }
+    catch (const std::exception &e)
+    {
+        request.decode_failed = true;
+        request.error = e.what();
+    }
+    catch (...)
+    {
+        request.decode_failed = true;
+        request.error = "unknown error";
+    }
+    request.decode = nullptr;
+}
+
+void AssetLoader::RunFinish(AssetRequest &request)
+{
+    LEO_PROFILE_SCOPE("AssetLoader::Finish");
+    if (request.decode_failed)
+    {
+        request.status = AssetStatus::Failed;
+    }
+    else
+    {
+        try
+        {
+            if (request.finish)
+            {
+                request.finish();
+            }
+            request.status = AssetStatus::Ready;
+        }
+        catch (const std::exception &e)
+        {
+            request.status = AssetStatus::Failed;
+            request.error = e.what();
+        }
+        catch (...)
+        {
+            request.status = AssetStatus::Failed;
+            request.error = "unknown error";
+        }
+    }
+    request.finish = nullptr;
+    request.stage = AssetRequest::Stage::Finished;
+}
+
+} // namespace engine
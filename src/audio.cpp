@@ -1,30 +1,195 @@
 #include "leo/audio.h"
+#include "leo/profiler.h"
 #include "leo/vfs.h"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <miniaudio.h>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine
+{
+
+// Interleaved f32 PCM in the engine's channel count and sample rate, decoded once and shared by every Sound
+// loaded from the same path.
+struct SoundSample
+{
+    float *frames = nullptr;
+    ma_uint64 frame_count = 0;
+    ma_uint32 channels = 0;
+
+    ~SoundSample();
+};
+
+} // namespace engine
 
 namespace
 {
 
-struct AudioHandle
+// Music streams keep about this much decoded audio buffered ahead of the mixer.
+constexpr ma_uint32 kStreamBufferMs = 500;
+constexpr ma_uint32 kStreamChunkFrames = 4096;
+constexpr std::chrono::milliseconds kStreamPollInterval(5);
+
+// Every Sound plays through this many preallocated voices.
+constexpr int kVoiceCount = 32;
+
+struct MusicStream;
+
+// miniaudio reads the data source through this struct, so the base must be its first member.
+struct StreamDataSource
 {
-    ma_sound sound;
+    ma_data_source_base base;
+    MusicStream *owner;
+};
+
+// Decodes a music file from the VFS on the stream feeder thread into a bounded PCM ring buffer that the audio
+// thread drains. Only the feeder touches the reader and decoder; the audio thread only reads the ring and sets
+// atomics.
+struct MusicStream
+{
+    StreamDataSource source;
+    engine::VfsReader reader;
     ma_decoder decoder;
     bool has_decoder;
-    void *encoded;
-    size_t encoded_size;
+    ma_pcm_rb ring;
+    bool has_ring;
+    bool has_source;
+    ma_format format;
+    ma_uint32 channels;
+    ma_uint32 sample_rate;
+    ma_uint32 bytes_per_frame;
+    std::atomic<bool> looping;
+    std::atomic<bool> seek_pending;
+    std::atomic<ma_uint64> seek_target;
+    std::atomic<bool> end_of_stream;
+    std::atomic<ma_uint64> cursor;
+    bool registered;
+    std::string path;
+};
+
+// One thread tops up every live MusicStream, so the number of Music objects does not multiply pollers. Streams
+// are serviced under the mutex, so once Remove returns the feeder is no longer touching that stream.
+struct StreamFeeder
+{
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<MusicStream *> streams;
+    std::thread worker;
+    bool stop = false;
+
+    ~StreamFeeder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_one();
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+};
+
+struct AudioHandle
+{
+    ma_sound sound;
+    MusicStream *stream;
+};
+
+using SampleData = engine::SoundSample;
+
+struct Voice;
+
+// miniaudio reads the data source through this struct, so the base must be its first member.
+struct VoiceDataSource
+{
+    ma_data_source_base base;
+    Voice *owner;
+};
+
+// A voice is a persistent ma_sound over its own data source. The main thread hands it a sample by publishing a
+// new generation; the audio thread picks the sample up on its next read and acknowledges the generation, and
+// reports the generation back once it has played to the end. Samples stay referenced in `retired` until the
+// audio thread has moved past them.
+struct Voice
+{
+    VoiceDataSource source;
+    ma_sound sound;
+    bool has_source = false;
+    bool has_sound = false;
+    ma_uint32 channels = 0;
+    ma_uint32 sample_rate = 0;
+
+    // Main thread only.
+    Uint64 owner_id = 0;
+    Uint64 start_order = 0;
+    float volume = 1.0f;
+    bool active = false;
+    bool paused = false;
+    Uint32 generation = 0;
+    std::vector<std::pair<Uint32, std::shared_ptr<SampleData>>> retired;
+
+    // Shared with the audio thread.
+    std::atomic<const SampleData *> pending_data{nullptr};
+    std::atomic<Uint32> posted_generation{0};
+    std::atomic<Uint32> acked_generation{0};
+    std::atomic<Uint32> finished_generation{0};
+    std::atomic<bool> looping{false};
+
+    // Audio thread only.
+    const SampleData *data = nullptr;
+    ma_uint64 cursor = 0;
+    Uint32 playing_generation = 0;
+};
+
+struct SoundState
+{
+    std::shared_ptr<SampleData> sample;
+    Uint64 id;
+    float volume;
+    float pitch;
+    bool looping;
+    bool paused;
+    int max_voices;
+};
+
+struct VoicePool
+{
+    std::unique_ptr<Voice> voices[kVoiceCount];
+    bool initialized = false;
+    engine::VoiceStealPolicy policy = engine::VoiceStealPolicy::Oldest;
+    std::unordered_map<std::string, std::weak_ptr<SampleData>> samples;
+    Uint64 next_sound_id = 0;
+    Uint64 start_counter = 0;
+    Uint64 stolen = 0;
+    Uint64 skipped = 0;
 };
 
+void ReleaseVoices(VoicePool &pool);
+
 struct AudioEngineState
 {
+    std::mutex init_mutex;
     ma_engine engine;
     bool initialized = false;
+    VoicePool pool;
 
     ~AudioEngineState()
     {
+        ReleaseVoices(pool);
         if (initialized)
         {
             ma_engine_uninit(&engine);
@@ -66,9 +231,16 @@ bool ShouldDisableAudioDevice()
     return value && *value && SDL_strcmp(value, "0") != 0;
 }
 
-ma_engine *GetAudioEngine()
+AudioEngineState &GetAudioState()
 {
     static AudioEngineState state;
+    return state;
+}
+
+ma_engine *GetAudioEngine()
+{
+    AudioEngineState &state = GetAudioState();
+    std::lock_guard<std::mutex> lock(state.init_mutex);
     if (!state.initialized)
     {
         ma_engine_config config = ma_engine_config_init();
@@ -89,51 +261,388 @@ ma_engine *GetAudioEngine()
     return &state.engine;
 }
 
-AudioHandle *LoadAudioHandle(engine::VFS &vfs, const char *vfs_path, ma_uint32 flags, const char *context)
+// Asset loader threads read the engine's output format to decode sounds, but starting the engine opens the audio
+// device, which belongs on the main thread.
+ma_engine *GetStartedAudioEngine(const char *context)
+{
+    AudioEngineState &state = GetAudioState();
+    std::lock_guard<std::mutex> lock(state.init_mutex);
+    if (!state.initialized)
+    {
+        throw std::runtime_error(std::string(context) + " requires the audio engine to be started first");
+    }
+    return &state.engine;
+}
+
+ma_result StreamReaderRead(ma_decoder *decoder, void *out, size_t bytes, size_t *bytes_read)
+{
+    MusicStream *stream = static_cast<MusicStream *>(decoder->pUserData);
+    try
+    {
+        *bytes_read = stream->reader.Read(out, bytes);
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Music stream '%s': %s", stream->path.c_str(), e.what());
+        *bytes_read = 0;
+        return MA_IO_ERROR;
+    }
+    return *bytes_read == 0 && bytes > 0 ? MA_AT_END : MA_SUCCESS;
+}
+
+ma_result StreamReaderSeek(ma_decoder *decoder, ma_int64 offset, ma_seek_origin origin)
+{
+    MusicStream *stream = static_cast<MusicStream *>(decoder->pUserData);
+    try
+    {
+        ma_int64 base = 0;
+        if (origin == ma_seek_origin_current)
+        {
+            base = static_cast<ma_int64>(stream->reader.Tell());
+        }
+        else if (origin == ma_seek_origin_end)
+        {
+            base = static_cast<ma_int64>(stream->reader.GetLength());
+        }
+        if (base + offset < 0)
+        {
+            return MA_BAD_SEEK;
+        }
+        stream->reader.Seek(static_cast<Uint64>(base + offset));
+    }
+    catch (const std::exception &)
+    {
+        return MA_BAD_SEEK;
+    }
+    return MA_SUCCESS;
+}
+
+// Decodes into the ring until it is full or the track ends. Runs on the feeder thread (and once on the loading
+// thread to prefill before the stream is handed to the feeder).
+void FillStream(MusicStream &stream)
+{
+    bool restarted = false;
+    while (!stream.end_of_stream.load(std::memory_order_relaxed))
+    {
+        ma_uint32 frames = std::min(ma_pcm_rb_available_write(&stream.ring), kStreamChunkFrames);
+        if (frames == 0)
+        {
+            return;
+        }
+
+        void *dst = nullptr;
+        if (ma_pcm_rb_acquire_write(&stream.ring, &frames, &dst) != MA_SUCCESS || frames == 0)
+        {
+            return;
+        }
+
+        ma_uint64 decoded = 0;
+        ma_result result = ma_decoder_read_pcm_frames(&stream.decoder, dst, frames, &decoded);
+        ma_pcm_rb_commit_write(&stream.ring, static_cast<ma_uint32>(decoded));
+        if (decoded > 0)
+        {
+            restarted = false;
+        }
+        if (result == MA_SUCCESS && decoded == frames)
+        {
+            continue;
+        }
+
+        if (result != MA_SUCCESS && result != MA_AT_END)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Music stream '%s' decode failed (miniaudio error %d)",
+                         stream.path.c_str(), result);
+        }
+        else if (stream.looping.load(std::memory_order_relaxed) && !restarted &&
+                 ma_decoder_seek_to_pcm_frame(&stream.decoder, 0) == MA_SUCCESS)
+        {
+            restarted = true;
+            continue;
+        }
+        stream.end_of_stream.store(true, std::memory_order_release);
+    }
+}
+
+void ServiceStream(MusicStream &stream)
+{
+    if (stream.seek_pending.load(std::memory_order_acquire))
+    {
+        // The audio thread stops reading the ring while a seek is pending, so it is safe to reset it here.
+        ma_uint64 target = stream.seek_target.load(std::memory_order_relaxed);
+        ma_decoder_seek_to_pcm_frame(&stream.decoder, target);
+        ma_pcm_rb_reset(&stream.ring);
+        stream.cursor.store(target, std::memory_order_relaxed);
+        stream.end_of_stream.store(false, std::memory_order_relaxed);
+        FillStream(stream);
+        stream.seek_pending.store(false, std::memory_order_release);
+        return;
+    }
+
+    FillStream(stream);
+}
+
+StreamFeeder &GetStreamFeeder()
+{
+    static StreamFeeder feeder;
+    return feeder;
+}
+
+void RunStreamFeeder(StreamFeeder *feeder)
+{
+    std::unique_lock<std::mutex> lock(feeder->mutex);
+    while (!feeder->stop)
+    {
+        for (MusicStream *stream : feeder->streams)
+        {
+            ServiceStream(*stream);
+        }
+        if (feeder->streams.empty())
+        {
+            feeder->wake.wait(lock, [feeder] { return feeder->stop || !feeder->streams.empty(); });
+        }
+        else
+        {
+            feeder->wake.wait_for(lock, kStreamPollInterval, [feeder] { return feeder->stop; });
+        }
+    }
+}
+
+void AddToStreamFeeder(MusicStream *stream)
+{
+    StreamFeeder &feeder = GetStreamFeeder();
+    {
+        std::lock_guard<std::mutex> lock(feeder.mutex);
+        feeder.streams.push_back(stream);
+        stream->registered = true;
+        if (!feeder.worker.joinable())
+        {
+            feeder.worker = std::thread(RunStreamFeeder, &feeder);
+        }
+    }
+    feeder.wake.notify_one();
+}
+
+void RemoveFromStreamFeeder(MusicStream *stream)
+{
+    StreamFeeder &feeder = GetStreamFeeder();
+    std::lock_guard<std::mutex> lock(feeder.mutex);
+    feeder.streams.erase(std::remove(feeder.streams.begin(), feeder.streams.end(), stream), feeder.streams.end());
+    stream->registered = false;
+}
+
+ma_result StreamSourceRead(ma_data_source *data_source, void *out, ma_uint64 frame_count, ma_uint64 *frames_read)
+{
+    MusicStream &stream = *static_cast<StreamDataSource *>(data_source)->owner;
+    unsigned char *dst = static_cast<unsigned char *>(out);
+    ma_uint64 total = 0;
+
+    if (!stream.seek_pending.load(std::memory_order_acquire))
+    {
+        // Sample end-of-stream before draining so frames committed before the flag are not left behind.
+        bool at_end = stream.end_of_stream.load(std::memory_order_acquire);
+        while (total < frame_count)
+        {
+            ma_uint32 frames = static_cast<ma_uint32>(std::min<ma_uint64>(frame_count - total, kStreamChunkFrames));
+            void *src = nullptr;
+            if (ma_pcm_rb_acquire_read(&stream.ring, &frames, &src) != MA_SUCCESS || frames == 0)
+            {
+                break;
+            }
+            size_t bytes = static_cast<size_t>(frames) * stream.bytes_per_frame;
+            std::memcpy(dst + total * stream.bytes_per_frame, src, bytes);
+            ma_pcm_rb_commit_read(&stream.ring, frames);
+            total += frames;
+        }
+        stream.cursor.fetch_add(total, std::memory_order_relaxed);
+
+        if (total < frame_count && at_end)
+        {
+            *frames_read = total;
+            return MA_AT_END;
+        }
+    }
+
+    // Underrun or pending seek: pad with silence so the sound keeps playing until the feeder catches up.
+    ma_silence_pcm_frames(dst + total * stream.bytes_per_frame, frame_count - total, stream.format, stream.channels);
+    *frames_read = frame_count;
+    return MA_SUCCESS;
+}
+
+ma_result StreamSourceSeek(ma_data_source *data_source, ma_uint64 frame_index)
+{
+    MusicStream &stream = *static_cast<StreamDataSource *>(data_source)->owner;
+    stream.seek_target.store(frame_index, std::memory_order_relaxed);
+    stream.seek_pending.store(true, std::memory_order_release);
+    return MA_SUCCESS;
+}
+
+ma_result StreamSourceGetDataFormat(ma_data_source *data_source, ma_format *format, ma_uint32 *channels,
+                                    ma_uint32 *sample_rate, ma_channel *channel_map, size_t channel_map_cap)
+{
+    (void)channel_map;
+    (void)channel_map_cap;
+    MusicStream &stream = *static_cast<StreamDataSource *>(data_source)->owner;
+    *format = stream.format;
+    *channels = stream.channels;
+    *sample_rate = stream.sample_rate;
+    return MA_SUCCESS;
+}
+
+ma_result StreamSourceGetCursor(ma_data_source *data_source, ma_uint64 *cursor)
+{
+    *cursor = static_cast<StreamDataSource *>(data_source)->owner->cursor.load(std::memory_order_relaxed);
+    return MA_SUCCESS;
+}
+
+ma_result StreamSourceSetLooping(ma_data_source *data_source, ma_bool32 is_looping)
+{
+    MusicStream &stream = *static_cast<StreamDataSource *>(data_source)->owner;
+    stream.looping.store(is_looping == MA_TRUE, std::memory_order_relaxed);
+    return MA_SUCCESS;
+}
+
+// Looping is handled by the feeder (it rewinds the decoder), so miniaudio must not manage loop points itself.
+const ma_data_source_vtable kStreamVTable = {.onRead = StreamSourceRead,
+                                             .onSeek = StreamSourceSeek,
+                                             .onGetDataFormat = StreamSourceGetDataFormat,
+                                             .onGetCursor = StreamSourceGetCursor,
+                                             .onGetLength = nullptr,
+                                             .onSetLooping = StreamSourceSetLooping,
+                                             .flags = MA_DATA_SOURCE_SELF_MANAGED_RANGE_AND_LOOP_POINT};
+
+void DestroyMusicStream(MusicStream *stream)
+{
+    if (!stream)
+    {
+        return;
+    }
+
+    if (stream->registered)
+    {
+        RemoveFromStreamFeeder(stream);
+    }
+    if (stream->has_source)
+    {
+        ma_data_source_uninit(&stream->source);
+    }
+    if (stream->has_ring)
+    {
+        ma_pcm_rb_uninit(&stream->ring);
+    }
+    if (stream->has_decoder)
+    {
+        ma_decoder_uninit(&stream->decoder);
+    }
+    delete stream;
+}
+
+MusicStream *CreateMusicStream(engine::VFS &vfs, const char *vfs_path, const char *context)
 {
     if (!vfs_path || !*vfs_path)
     {
         throw std::runtime_error(std::string(context) + " requires a non-empty path");
     }
 
-    void *data = nullptr;
-    size_t size = 0;
-    vfs.ReadAll(vfs_path, &data, &size);
-    if (!data || size == 0)
+    MusicStream *stream = new MusicStream();
+    stream->source.owner = stream;
+    stream->has_decoder = false;
+    stream->has_ring = false;
+    stream->has_source = false;
+    stream->looping = false;
+    stream->seek_pending = false;
+    stream->seek_target = 0;
+    stream->end_of_stream = false;
+    stream->cursor = 0;
+    stream->registered = false;
+    stream->path = vfs_path;
+
+    try
     {
-        if (data)
+        stream->reader = vfs.OpenRead(vfs_path);
+
+        ma_decoder_config decoder_config = ma_decoder_config_init(ma_format_f32, 0, 0);
+        decoder_config.allocationCallbacks = MakeAllocationCallbacks();
+        ma_result result =
+            ma_decoder_init(StreamReaderRead, StreamReaderSeek, stream, &decoder_config, &stream->decoder);
+        if (result != MA_SUCCESS)
         {
-            SDL_free(data);
+            throw std::runtime_error(std::string(context) + " failed to decode audio (miniaudio error " +
+                                     std::to_string(result) + ")");
         }
-        throw std::runtime_error(std::string(context) + " received empty data buffer");
+        stream->has_decoder = true;
+        stream->format = stream->decoder.outputFormat;
+        stream->channels = stream->decoder.outputChannels;
+        stream->sample_rate = stream->decoder.outputSampleRate;
+        stream->bytes_per_frame = ma_get_bytes_per_frame(stream->format, stream->channels);
+
+        ma_uint32 capacity = std::max(stream->sample_rate * kStreamBufferMs / 1000, kStreamChunkFrames * 2);
+        ma_allocation_callbacks callbacks = MakeAllocationCallbacks();
+        result = ma_pcm_rb_init(stream->format, stream->channels, capacity, nullptr, &callbacks, &stream->ring);
+        if (result != MA_SUCCESS)
+        {
+            throw std::runtime_error(std::string(context) + " failed to allocate stream buffer (miniaudio error " +
+                                     std::to_string(result) + ")");
+        }
+        stream->has_ring = true;
+
+        ma_data_source_config source_config = ma_data_source_config_init();
+        source_config.vtable = &kStreamVTable;
+        result = ma_data_source_init(&source_config, &stream->source.base);
+        if (result != MA_SUCCESS)
+        {
+            throw std::runtime_error(std::string(context) + " failed to init stream (miniaudio error " +
+                                     std::to_string(result) + ")");
+        }
+        stream->has_source = true;
+
+        // Prefill one chunk so playback can start immediately; the feeder tops up the rest.
+        {
+            void *dst = nullptr;
+            ma_uint32 frames = kStreamChunkFrames;
+            if (ma_pcm_rb_acquire_write(&stream->ring, &frames, &dst) == MA_SUCCESS)
+            {
+                ma_uint64 decoded = 0;
+                ma_decoder_read_pcm_frames(&stream->decoder, dst, frames, &decoded);
+                ma_pcm_rb_commit_write(&stream->ring, static_cast<ma_uint32>(decoded));
+            }
+        }
+
+        AddToStreamFeeder(stream);
+    }
+    catch (...)
+    {
+        DestroyMusicStream(stream);
+        throw;
     }
 
+    return stream;
+}
+
+AudioHandle *LoadMusicHandle(engine::VFS &vfs, const char *vfs_path, const char *context)
+{
+    MusicStream *stream = CreateMusicStream(vfs, vfs_path, context);
     AudioHandle *handle = static_cast<AudioHandle *>(SDL_calloc(1, sizeof(AudioHandle)));
     if (!handle)
     {
-        SDL_free(data);
+        DestroyMusicStream(stream);
         throw std::runtime_error(std::string(context) + " out of memory");
     }
+    handle->stream = stream;
 
-    ma_result result = ma_decoder_init_memory(data, size, nullptr, &handle->decoder);
-    if (result != MA_SUCCESS)
+    ma_result result = MA_SUCCESS;
+    try
+    {
+        result = ma_sound_init_from_data_source(GetAudioEngine(), &stream->source.base, 0, nullptr, &handle->sound);
+    }
+    catch (...)
     {
-        SDL_free(data);
+        DestroyMusicStream(stream);
         SDL_free(handle);
-        throw std::runtime_error(std::string(context) + " failed to decode audio (miniaudio error " +
-                                 std::to_string(result) + ")");
+        throw;
     }
-
-    handle->has_decoder = true;
-    handle->encoded = data;
-    handle->encoded_size = size;
-
-    ma_engine *engine = GetAudioEngine();
-    result = ma_sound_init_from_data_source(engine, &handle->decoder, flags, nullptr, &handle->sound);
     if (result != MA_SUCCESS)
     {
-        ma_decoder_uninit(&handle->decoder);
-        SDL_free(handle->encoded);
+        DestroyMusicStream(stream);
         SDL_free(handle);
         throw std::runtime_error(std::string(context) + " failed to init sound (miniaudio error " +
                                  std::to_string(result) + ")");
@@ -158,14 +667,7 @@ void ReleaseHandle(AudioHandle *handle)
         return;
     }
     ma_sound_uninit(&handle->sound);
-    if (handle->has_decoder)
-    {
-        ma_decoder_uninit(&handle->decoder);
-    }
-    if (handle->encoded)
-    {
-        SDL_free(handle->encoded);
-    }
+    DestroyMusicStream(handle->stream);
     SDL_free(handle);
 }
 
@@ -206,26 +708,370 @@ void StopPlayback(AudioHandle *handle, bool *paused)
     *paused = false;
 }
 
+// Volumes are 0..100 at the API and 0..1 in miniaudio.
+float ToGain(float volume)
+{
+    return std::clamp(volume, 0.0f, 100.0f) / 100.0f;
+}
+
+float ClampPitch(float pitch)
+{
+    return std::max(pitch, 0.01f);
+}
+
 void ApplyVolume(AudioHandle *handle, float volume)
 {
-    if (volume < 0.0f)
+    ma_sound_set_volume(&handle->sound, ToGain(volume));
+}
+
+void ApplyPitch(AudioHandle *handle, float pitch)
+{
+    ma_sound_set_pitch(&handle->sound, ClampPitch(pitch));
+}
+
+ma_result VoiceSourceRead(ma_data_source *data_source, void *out, ma_uint64 frame_count, ma_uint64 *frames_read)
+{
+    Voice &voice = *static_cast<VoiceDataSource *>(data_source)->owner;
+    Uint32 posted = voice.posted_generation.load(std::memory_order_acquire);
+    if (posted != voice.playing_generation)
+    {
+        voice.data = voice.pending_data.load(std::memory_order_acquire);
+        voice.cursor = 0;
+        voice.playing_generation = posted;
+        voice.acked_generation.store(posted, std::memory_order_release);
+    }
+
+    float *dst = static_cast<float *>(out);
+    ma_uint64 written = 0;
+    const SampleData *data = voice.data;
+    while (data && written < frame_count)
+    {
+        if (voice.cursor >= data->frame_count)
+        {
+            if (!voice.looping.load(std::memory_order_relaxed) || data->frame_count == 0)
+            {
+                voice.data = nullptr;
+                voice.finished_generation.store(voice.playing_generation, std::memory_order_release);
+                break;
+            }
+            voice.cursor = 0;
+        }
+
+        ma_uint64 count = std::min(frame_count - written, data->frame_count - voice.cursor);
+        std::memcpy(dst + written * voice.channels, data->frames + voice.cursor * voice.channels,
+                    static_cast<size_t>(count * voice.channels * sizeof(float)));
+        voice.cursor += count;
+        written += count;
+    }
+
+    // The voice's sound stays alive for the life of the pool, so it never reports the end of the data; an idle
+    // voice just mixes silence until the main thread stops it.
+    if (written < frame_count)
     {
-        volume = 0.0f;
+        ma_silence_pcm_frames(dst + written * voice.channels, frame_count - written, ma_format_f32, voice.channels);
     }
-    if (volume > 100.0f)
+    if (frames_read)
     {
-        volume = 100.0f;
+        *frames_read = frame_count;
     }
-    ma_sound_set_volume(&handle->sound, volume / 100.0f);
+    return MA_SUCCESS;
 }
 
-void ApplyPitch(AudioHandle *handle, float pitch)
+ma_result VoiceSourceSeek(ma_data_source *data_source, ma_uint64 frame_index)
+{
+    (void)data_source;
+    (void)frame_index;
+    return MA_SUCCESS;
+}
+
+ma_result VoiceSourceGetDataFormat(ma_data_source *data_source, ma_format *format, ma_uint32 *channels,
+                                   ma_uint32 *sample_rate, ma_channel *channel_map, size_t channel_map_cap)
+{
+    (void)channel_map;
+    (void)channel_map_cap;
+    const Voice &voice = *static_cast<VoiceDataSource *>(data_source)->owner;
+    *format = ma_format_f32;
+    *channels = voice.channels;
+    *sample_rate = voice.sample_rate;
+    return MA_SUCCESS;
+}
+
+ma_result VoiceSourceGetCursor(ma_data_source *data_source, ma_uint64 *cursor)
+{
+    (void)data_source;
+    *cursor = 0;
+    return MA_SUCCESS;
+}
+
+const ma_data_source_vtable kVoiceVTable = {.onRead = VoiceSourceRead,
+                                            .onSeek = VoiceSourceSeek,
+                                            .onGetDataFormat = VoiceSourceGetDataFormat,
+                                            .onGetCursor = VoiceSourceGetCursor,
+                                            .onGetLength = nullptr,
+                                            .onSetLooping = nullptr,
+                                            .flags = MA_DATA_SOURCE_SELF_MANAGED_RANGE_AND_LOOP_POINT};
+
+void ReleaseVoices(VoicePool &pool)
+{
+    for (std::unique_ptr<Voice> &voice : pool.voices)
+    {
+        if (!voice)
+        {
+            continue;
+        }
+        if (voice->has_sound)
+        {
+            ma_sound_uninit(&voice->sound);
+        }
+        if (voice->has_source)
+        {
+            ma_data_source_uninit(&voice->source.base);
+        }
+        voice.reset();
+    }
+    pool.initialized = false;
+}
+
+VoicePool &GetVoicePool()
+{
+    AudioEngineState &state = GetAudioState();
+    ma_engine *engine = GetAudioEngine();
+    VoicePool &pool = state.pool;
+    if (pool.initialized)
+    {
+        return pool;
+    }
+
+    ma_uint32 channels = ma_engine_get_channels(engine);
+    ma_uint32 sample_rate = ma_engine_get_sample_rate(engine);
+    for (std::unique_ptr<Voice> &voice : pool.voices)
+    {
+        voice = std::make_unique<Voice>();
+        voice->source.owner = voice.get();
+        voice->channels = channels;
+        voice->sample_rate = sample_rate;
+
+        ma_data_source_config config = ma_data_source_config_init();
+        config.vtable = &kVoiceVTable;
+        ma_result result = ma_data_source_init(&config, &voice->source.base);
+        if (result == MA_SUCCESS)
+        {
+            voice->has_source = true;
+            result = ma_sound_init_from_data_source(engine, &voice->source.base, MA_SOUND_FLAG_NO_SPATIALIZATION,
+                                                    nullptr, &voice->sound);
+        }
+        if (result != MA_SUCCESS)
+        {
+            ReleaseVoices(pool);
+            throw std::runtime_error("Audio voice pool init failed (miniaudio error " + std::to_string(result) + ")");
+        }
+        voice->has_sound = true;
+    }
+    pool.initialized = true;
+    return pool;
+}
+
+// Drops sample references the audio thread can no longer be reading.
+void PruneRetired(Voice &voice)
+{
+    Uint32 acked = voice.acked_generation.load(std::memory_order_acquire);
+    std::erase_if(voice.retired, [acked](const std::pair<Uint32, std::shared_ptr<SampleData>> &entry) {
+        return static_cast<Sint32>(entry.first - acked) < 0;
+    });
+}
+
+void PostSample(Voice &voice, const std::shared_ptr<SampleData> &sample, bool looping)
+{
+    voice.generation++;
+    if (sample)
+    {
+        voice.retired.emplace_back(voice.generation, sample);
+    }
+    voice.looping.store(looping, std::memory_order_relaxed);
+    voice.pending_data.store(sample.get(), std::memory_order_release);
+    voice.posted_generation.store(voice.generation, std::memory_order_release);
+    PruneRetired(voice);
+}
+
+void FreeVoice(Voice &voice)
+{
+    if (voice.active)
+    {
+        PostSample(voice, nullptr, false);
+        ma_sound_stop(&voice.sound);
+    }
+    voice.active = false;
+    voice.paused = false;
+    voice.owner_id = 0;
+}
+
+// Returns voices that played their sample to the end to the free list.
+void ReapVoices(VoicePool &pool)
+{
+    for (std::unique_ptr<Voice> &voice : pool.voices)
+    {
+        if (voice->active &&
+            voice->finished_generation.load(std::memory_order_acquire) == voice->generation)
+        {
+            ma_sound_stop(&voice->sound);
+            voice->active = false;
+            voice->paused = false;
+            voice->owner_id = 0;
+        }
+        PruneRetired(*voice);
+    }
+}
+
+Voice *AcquireVoice(VoicePool &pool, const SoundState &state)
+{
+    ReapVoices(pool);
+
+    Voice *own_oldest = nullptr;
+    int own_count = 0;
+    Voice *free_voice = nullptr;
+    Voice *oldest = nullptr;
+    Voice *quietest = nullptr;
+    for (std::unique_ptr<Voice> &entry : pool.voices)
+    {
+        Voice *voice = entry.get();
+        if (!voice->active)
+        {
+            free_voice = free_voice ? free_voice : voice;
+            continue;
+        }
+        if (voice->owner_id == state.id)
+        {
+            own_count++;
+            if (!own_oldest || voice->start_order < own_oldest->start_order)
+            {
+                own_oldest = voice;
+            }
+        }
+        if (!oldest || voice->start_order < oldest->start_order)
+        {
+            oldest = voice;
+        }
+        if (!quietest || voice->volume < quietest->volume ||
+            (voice->volume == quietest->volume && voice->start_order < quietest->start_order))
+        {
+            quietest = voice;
+        }
+    }
+
+    Voice *voice = nullptr;
+    if (state.max_voices > 0 && own_count >= state.max_voices)
+    {
+        voice = own_oldest;
+    }
+    else if (free_voice)
+    {
+        return free_voice;
+    }
+    else if (pool.policy == engine::VoiceStealPolicy::Oldest)
+    {
+        voice = oldest;
+    }
+    else if (pool.policy == engine::VoiceStealPolicy::Quietest)
+    {
+        voice = quietest;
+    }
+
+    if (!voice)
+    {
+        pool.skipped++;
+        return nullptr;
+    }
+    if (voice->owner_id != state.id)
+    {
+        pool.stolen++;
+    }
+    FreeVoice(*voice);
+    return voice;
+}
+
+std::shared_ptr<SampleData> FindSample(VoicePool &pool, const char *vfs_path)
+{
+    auto cached = pool.samples.find(vfs_path);
+    return cached != pool.samples.end() ? cached->second.lock() : nullptr;
+}
+
+// Touches neither the voice pool nor the sample cache, so it may run on any thread.
+std::shared_ptr<SampleData> DecodeSample(ma_engine *engine, engine::VFS &vfs, const char *vfs_path,
+                                         const char *context)
+{
+    if (!vfs_path || !*vfs_path)
+    {
+        throw std::runtime_error(std::string(context) + " requires a non-empty path");
+    }
+
+    ma_uint32 channels = ma_engine_get_channels(engine);
+    ma_uint32 sample_rate = ma_engine_get_sample_rate(engine);
+
+    void *data = nullptr;
+    size_t size = 0;
+    vfs.ReadAll(vfs_path, &data, &size);
+    if (!data || size == 0)
+    {
+        if (data)
+        {
+            SDL_free(data);
+        }
+        throw std::runtime_error(std::string(context) + " received empty data buffer");
+    }
+
+    auto sample = std::make_shared<SampleData>();
+    sample->channels = channels;
+    ma_decoder_config config = ma_decoder_config_init(ma_format_f32, channels, sample_rate);
+    config.allocationCallbacks = MakeAllocationCallbacks();
+    void *frames = nullptr;
+    ma_result result = ma_decode_memory(data, size, &config, &sample->frame_count, &frames);
+    SDL_free(data);
+    if (result != MA_SUCCESS)
+    {
+        throw std::runtime_error(std::string(context) + " failed to decode audio (miniaudio error " +
+                                 std::to_string(result) + ")");
+    }
+    sample->frames = static_cast<float *>(frames);
+    return sample;
+}
+
+// Returns the cached sample for vfs_path if one is still alive, otherwise caches and returns sample.
+std::shared_ptr<SampleData> RegisterSample(VoicePool &pool, const char *vfs_path, std::shared_ptr<SampleData> sample)
 {
-    if (pitch < 0.01f)
+    if (std::shared_ptr<SampleData> cached = FindSample(pool, vfs_path))
     {
-        pitch = 0.01f;
+        return cached;
+    }
+
+    // Expired entries are swept here so the cache only grows with the number of live samples.
+    std::erase_if(pool.samples, [](const auto &entry) { return entry.second.expired(); });
+    pool.samples[vfs_path] = sample;
+    return sample;
+}
+
+SoundState *RequireSound(void *handle, const char *context)
+{
+    if (!handle)
+    {
+        throw std::runtime_error(std::string(context) + " requires a loaded Sound");
+    }
+    return static_cast<SoundState *>(handle);
+}
+
+template <typename Fn> void ForEachSoundVoice(const SoundState &state, Fn &&fn)
+{
+    AudioEngineState &audio = GetAudioState();
+    if (!audio.pool.initialized)
+    {
+        return;
+    }
+    for (std::unique_ptr<Voice> &voice : audio.pool.voices)
+    {
+        if (voice->active && voice->owner_id == state.id)
+        {
+            fn(*voice);
+        }
     }
-    ma_sound_set_pitch(&handle->sound, pitch);
 }
 
 } // namespace
@@ -233,7 +1079,53 @@ void ApplyPitch(AudioHandle *handle, float pitch)
 namespace engine
 {
 
-Sound::Sound() noexcept : handle(nullptr), paused(false)
+SoundSample::~SoundSample()
+{
+    if (frames)
+    {
+        ma_allocation_callbacks callbacks = MakeAllocationCallbacks();
+        ma_free(frames, &callbacks);
+    }
+}
+
+void SetVoiceStealPolicy(VoiceStealPolicy policy)
+{
+    GetAudioState().pool.policy = policy;
+}
+
+VoiceStealPolicy GetVoiceStealPolicy() noexcept
+{
+    return GetAudioState().pool.policy;
+}
+
+VoiceStats GetVoiceStats()
+{
+    VoicePool &pool = GetAudioState().pool;
+    VoiceStats stats = {};
+    stats.voice_count = kVoiceCount;
+    stats.stolen = pool.stolen;
+    stats.skipped = pool.skipped;
+    if (pool.initialized)
+    {
+        ReapVoices(pool);
+        for (const std::unique_ptr<Voice> &voice : pool.voices)
+        {
+            stats.active_voices += voice->active ? 1 : 0;
+        }
+    }
+    for (const auto &entry : pool.samples)
+    {
+        stats.cached_samples += entry.second.expired() ? 0 : 1;
+    }
+    return stats;
+}
+
+void StartAudioEngine()
+{
+    GetAudioEngine();
+}
+
+Sound::Sound() noexcept : handle(nullptr)
 {
 }
 
@@ -242,10 +1134,9 @@ Sound::~Sound()
     Reset();
 }
 
-Sound::Sound(Sound &&other) noexcept : handle(other.handle), paused(other.paused)
+Sound::Sound(Sound &&other) noexcept : handle(other.handle)
 {
     other.handle = nullptr;
-    other.paused = false;
 }
 
 Sound &Sound::operator=(Sound &&other) noexcept
@@ -257,17 +1148,39 @@ Sound &Sound::operator=(Sound &&other) noexcept
 
     Reset();
     handle = other.handle;
-    paused = other.paused;
     other.handle = nullptr;
-    other.paused = false;
     return *this;
 }
 
 Sound Sound::LoadFromVfs(VFS &vfs, const char *vfs_path)
 {
+    LEO_PROFILE_SCOPE("Sound::LoadFromVfs");
+    VoicePool &pool = GetVoicePool();
+    std::shared_ptr<SampleData> sample = vfs_path ? FindSample(pool, vfs_path) : nullptr;
+    if (!sample)
+    {
+        sample = DecodeSample(GetAudioEngine(), vfs, vfs_path, "Sound::LoadFromVfs");
+    }
+    return FromSample(std::move(sample), vfs_path);
+}
+
+std::shared_ptr<SoundSample> Sound::Decode(VFS &vfs, const char *vfs_path)
+{
+    LEO_PROFILE_SCOPE("Sound::Decode");
+    return DecodeSample(GetStartedAudioEngine("Sound::Decode"), vfs, vfs_path, "Sound::Decode");
+}
+
+Sound Sound::FromSample(std::shared_ptr<SoundSample> sample, const char *vfs_path)
+{
+    if (!sample || !vfs_path || !*vfs_path)
+    {
+        throw std::runtime_error("Sound::FromSample requires a decoded sample and its path");
+    }
+
+    VoicePool &pool = GetVoicePool();
     Sound sound;
-    sound.handle = LoadAudioHandle(vfs, vfs_path, MA_SOUND_FLAG_DECODE, "Sound::LoadFromVfs");
-    sound.paused = false;
+    sound.handle = new SoundState{RegisterSample(pool, vfs_path, std::move(sample)), ++pool.next_sound_id, 100.0f,
+                                  1.0f, false, false, 0};
     return sound;
 }
 
@@ -280,28 +1193,80 @@ void Sound::Reset() noexcept
 {
     if (handle)
     {
-        ReleaseHandle(static_cast<AudioHandle *>(handle));
+        SoundState *state = static_cast<SoundState *>(handle);
+        ForEachSoundVoice(*state, [](Voice &voice) { FreeVoice(voice); });
+        delete state;
         handle = nullptr;
     }
-    paused = false;
 }
 
 void Sound::Play()
 {
-    AudioHandle *impl = RequireHandle(handle, "Sound::Play", "Sound");
-    StartPlayback(impl, &paused, "Sound::Play");
+    SoundState *state = RequireSound(handle, "Sound::Play");
+    if (state->paused)
+    {
+        bool resumed = false;
+        ForEachSoundVoice(*state, [&resumed](Voice &voice) {
+            if (voice.paused)
+            {
+                voice.paused = false;
+                ma_sound_start(&voice.sound);
+                resumed = true;
+            }
+        });
+        if (resumed)
+        {
+            state->paused = false;
+            return;
+        }
+    }
+
+    VoicePool &pool = GetVoicePool();
+    Voice *voice = AcquireVoice(pool, *state);
+    if (!voice)
+    {
+        return;
+    }
+
+    PostSample(*voice, state->sample, state->looping);
+    voice->owner_id = state->id;
+    voice->start_order = ++pool.start_counter;
+    voice->volume = ToGain(state->volume);
+    voice->active = true;
+    voice->paused = state->paused;
+    ma_sound_set_volume(&voice->sound, voice->volume);
+    ma_sound_set_pitch(&voice->sound, ClampPitch(state->pitch));
+    if (voice->paused)
+    {
+        // Paused with nothing to resume: the voice waits, holding the sample, for the next Play.
+        return;
+    }
+    ma_result result = ma_sound_start(&voice->sound);
+    if (result != MA_SUCCESS)
+    {
+        FreeVoice(*voice);
+        throw std::runtime_error("Sound::Play failed to start (miniaudio error " + std::to_string(result) + ")");
+    }
 }
 
 void Sound::Pause()
 {
-    AudioHandle *impl = RequireHandle(handle, "Sound::Pause", "Sound");
-    PausePlayback(impl, &paused);
+    SoundState *state = RequireSound(handle, "Sound::Pause");
+    state->paused = true;
+    ForEachSoundVoice(*state, [](Voice &voice) {
+        if (!voice.paused)
+        {
+            ma_sound_stop(&voice.sound);
+            voice.paused = true;
+        }
+    });
 }
 
 void Sound::Stop()
 {
-    AudioHandle *impl = RequireHandle(handle, "Sound::Stop", "Sound");
-    StopPlayback(impl, &paused);
+    SoundState *state = RequireSound(handle, "Sound::Stop");
+    ForEachSoundVoice(*state, [](Voice &voice) { FreeVoice(voice); });
+    state->paused = false;
 }
 
 bool Sound::IsPlaying() const noexcept
@@ -310,25 +1275,52 @@ bool Sound::IsPlaying() const noexcept
     {
         return false;
     }
-    return ma_sound_is_playing(&static_cast<AudioHandle *>(handle)->sound) == MA_TRUE;
+
+    AudioEngineState &audio = GetAudioState();
+    if (audio.pool.initialized)
+    {
+        ReapVoices(audio.pool);
+    }
+    bool playing = false;
+    ForEachSoundVoice(*static_cast<SoundState *>(handle), [&playing](Voice &voice) { playing |= !voice.paused; });
+    return playing;
 }
 
 void Sound::SetLooping(bool looping)
 {
-    AudioHandle *impl = RequireHandle(handle, "Sound::SetLooping", "Sound");
-    ma_sound_set_looping(&impl->sound, looping ? MA_TRUE : MA_FALSE);
+    SoundState *state = RequireSound(handle, "Sound::SetLooping");
+    state->looping = looping;
+    ForEachSoundVoice(*state, [looping](Voice &voice) { voice.looping.store(looping, std::memory_order_relaxed); });
 }
 
 void Sound::SetVolume(float volume)
 {
-    AudioHandle *impl = RequireHandle(handle, "Sound::SetVolume", "Sound");
-    ApplyVolume(impl, volume);
+    SoundState *state = RequireSound(handle, "Sound::SetVolume");
+    state->volume = volume;
+    float gain = ToGain(volume);
+    ForEachSoundVoice(*state, [gain](Voice &voice) {
+        voice.volume = gain;
+        ma_sound_set_volume(&voice.sound, gain);
+    });
 }
 
 void Sound::SetPitch(float pitch)
 {
-    AudioHandle *impl = RequireHandle(handle, "Sound::SetPitch", "Sound");
-    ApplyPitch(impl, pitch);
+    SoundState *state = RequireSound(handle, "Sound::SetPitch");
+    state->pitch = pitch;
+    float clamped = ClampPitch(pitch);
+    ForEachSoundVoice(*state, [clamped](Voice &voice) { ma_sound_set_pitch(&voice.sound, clamped); });
+}
+
+void Sound::SetMaxVoices(int max_voices)
+{
+    SoundState *state = RequireSound(handle, "Sound::SetMaxVoices");
+    state->max_voices = std::clamp(max_voices, 0, kVoiceCount);
+}
+
+int Sound::GetMaxVoices() const noexcept
+{
+    return handle ? static_cast<SoundState *>(handle)->max_voices : 0;
 }
 
 Music::Music() noexcept : handle(nullptr), paused(false)
@@ -363,8 +1355,9 @@ Music &Music::operator=(Music &&other) noexcept
 
 Music Music::LoadFromVfs(VFS &vfs, const char *vfs_path)
 {
+    LEO_PROFILE_SCOPE("Music::LoadFromVfs");
     Music music;
-    music.handle = LoadAudioHandle(vfs, vfs_path, MA_SOUND_FLAG_STREAM, "Music::LoadFromVfs");
+    music.handle = LoadMusicHandle(vfs, vfs_path, "Music::LoadFromVfs");
     music.paused = false;
     return music;
 }
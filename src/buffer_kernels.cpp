@@ -0,0 +1,118 @@
+#include "leo/buffer_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace leo
+{
+namespace BufferKernels
+{
+
+void Integrate(float *values, const float *rates, size_t count, float dt)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] += rates[i] * dt;
+    }
+}
+
+void Clamp(float *values, size_t count, float min_value, float max_value)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] = std::min(std::max(values[i], min_value), max_value);
+    }
+}
+
+void Wrap(float *values, size_t count, float min_value, float max_value)
+{
+    const float range = max_value - min_value;
+    if (!(range > 0.0f))
+    {
+        return;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        float value = values[i];
+        if (value >= min_value && value < max_value)
+        {
+            continue;
+        }
+        float wrapped = std::fmod(value - min_value, range);
+        if (wrapped < 0.0f)
+        {
+            wrapped += range;
+        }
+        // fmod of a value just below a multiple of range can round up to range itself.
+        values[i] = wrapped >= range ? min_value : min_value + wrapped;
+    }
+}
+
+void DistanceToPoint(const float *xs, const float *ys, size_t count, SDL_FPoint point, float *out)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        float dx = xs[i] - point.x;
+        float dy = ys[i] - point.y;
+        out[i] = std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+size_t Nearest(const float *xs, const float *ys, size_t count, SDL_FPoint point, float max_distance,
+               float *out_distance)
+{
+    size_t best = count;
+    float best_squared = max_distance * max_distance;
+    for (size_t i = 0; i < count; ++i)
+    {
+        float dx = xs[i] - point.x;
+        float dy = ys[i] - point.y;
+        float squared = dx * dx + dy * dy;
+        if (squared < best_squared || (best == count && squared == best_squared))
+        {
+            best = i;
+            best_squared = squared;
+        }
+    }
+    if (out_distance)
+    {
+        *out_distance = best < count ? std::sqrt(best_squared) : 0.0f;
+    }
+    return best;
+}
+
+size_t WithinRadius(const float *xs, const float *ys, size_t count, SDL_FPoint point, float radius,
+                    Sint32 *out_indices, size_t capacity)
+{
+    const float radius_squared = radius * radius;
+    size_t found = 0;
+    for (size_t i = 0; i < count && found < capacity; ++i)
+    {
+        float dx = xs[i] - point.x;
+        float dy = ys[i] - point.y;
+        if (dx * dx + dy * dy <= radius_squared)
+        {
+            out_indices[found++] = static_cast<Sint32>(i);
+        }
+    }
+    return found;
+}
+
+size_t OverlapRect(const float *xs, const float *ys, size_t count, float w, float h, const SDL_FRect &rect,
+                   Sint32 *out_indices, size_t capacity)
+{
+    const float right = rect.x + rect.w;
+    const float bottom = rect.y + rect.h;
+    size_t found = 0;
+    for (size_t i = 0; i < count && found < capacity; ++i)
+    {
+        if (xs[i] < right && xs[i] + w > rect.x && ys[i] < bottom && ys[i] + h > rect.y)
+        {
+            out_indices[found++] = static_cast<Sint32>(i);
+        }
+    }
+    return found;
+}
+
+} // namespace BufferKernels
+} // namespace leo
@@ -0,0 +1,136 @@
+#include "leo/canvas.h"
+#include <stdexcept>
+#include <string>
+
+namespace engine
+{
+
+Canvas::Canvas(SDL_Renderer *renderer, int width, int height, bool preserve)
+    : renderer(renderer), texture(), pixels(nullptr), preserve(preserve)
+{
+    if (!renderer)
+    {
+        throw std::runtime_error("Canvas requires a renderer");
+    }
+    if (width <= 0 || height <= 0)
+    {
+        throw std::runtime_error("Canvas requires positive dimensions");
+    }
+
+    texture.width = width;
+    texture.height = height;
+    texture.handle = CreateTarget();
+    // Target textures start with undefined contents.
+    if (!Fill(nullptr))
+    {
+        throw std::runtime_error(std::string("Canvas failed to clear render target: ") + SDL_GetError());
+    }
+}
+
+Canvas::~Canvas()
+{
+    if (pixels)
+    {
+        SDL_DestroySurface(pixels);
+        pixels = nullptr;
+    }
+}
+
+Texture &Canvas::GetTexture() noexcept
+{
+    return texture;
+}
+
+bool Canvas::IsPreserved() const noexcept
+{
+    return preserve;
+}
+
+void Canvas::Snapshot()
+{
+    // Read the whole canvas even if a viewport is set on it.
+    SDL_Rect viewport = {0, 0, 0, 0};
+    const bool has_viewport = SDL_RenderViewportSet(renderer);
+    SDL_GetRenderViewport(renderer, &viewport);
+    SDL_SetRenderViewport(renderer, nullptr);
+    SDL_Surface *copy = SDL_RenderReadPixels(renderer, nullptr);
+    SDL_SetRenderViewport(renderer, has_viewport ? &viewport : nullptr);
+    if (!copy)
+    {
+        throw std::runtime_error(std::string("Canvas failed to read back pixels: ") + SDL_GetError());
+    }
+
+    if (pixels)
+    {
+        SDL_DestroySurface(pixels);
+    }
+    pixels = copy;
+}
+
+void Canvas::Restore(bool recreate)
+{
+    if (recreate)
+    {
+        SDL_Texture *target = CreateTarget();
+        SDL_DestroyTexture(texture.handle);
+        texture.handle = target;
+    }
+
+    SDL_Texture *source = nullptr;
+    if (pixels)
+    {
+        source = SDL_CreateTextureFromSurface(renderer, pixels);
+        if (!source)
+        {
+            throw std::runtime_error(std::string("Canvas failed to upload saved pixels: ") + SDL_GetError());
+        }
+    }
+    const bool filled = Fill(source);
+    if (source)
+    {
+        SDL_DestroyTexture(source);
+    }
+    if (!filled)
+    {
+        throw std::runtime_error(std::string("Canvas failed to restore render target: ") + SDL_GetError());
+    }
+}
+
+SDL_Texture *Canvas::CreateTarget() const
+{
+    SDL_Texture *target =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, texture.width, texture.height);
+    if (!target)
+    {
+        throw std::runtime_error(std::string("Canvas failed to create render target: ") + SDL_GetError());
+    }
+    SDL_SetTextureBlendMode(target, SDL_BLENDMODE_BLEND);
+    return target;
+}
+
+// Clears the canvas to transparent and copies source over all of it, leaving the render target and draw color as
+// they were.
+bool Canvas::Fill(SDL_Texture *source)
+{
+    SDL_Texture *previous = SDL_GetRenderTarget(renderer);
+    if (!SDL_SetRenderTarget(renderer, texture.handle))
+    {
+        return false;
+    }
+
+    SDL_Color color = {0, 0, 0, 0};
+    SDL_GetRenderDrawColor(renderer, &color.r, &color.g, &color.b, &color.a);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    bool ok = SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    if (ok && source)
+    {
+        SDL_SetTextureBlendMode(source, SDL_BLENDMODE_NONE);
+        ok = SDL_RenderTexture(renderer, source, nullptr, nullptr);
+    }
+
+    SDL_SetRenderTarget(renderer, previous);
+    return ok;
+}
+
+} // namespace engine
@@ -0,0 +1,119 @@
+#include "leo/cooked_asset.h"
+#include <SDL3/SDL.h>
+#include <stdexcept>
+#include <string>
+
+namespace engine
+{
+
+CookedWriter::CookedWriter(const char *tag) : data()
+{
+    WriteBytes(tag, 4);
+    WriteU32(kCookedVersion);
+}
+
+void CookedWriter::WriteU32(Uint32 value)
+{
+    const Uint32 little = SDL_Swap32LE(value);
+    WriteBytes(&little, sizeof(little));
+}
+
+void CookedWriter::WriteI32(Sint32 value)
+{
+    WriteU32(static_cast<Uint32>(value));
+}
+
+void CookedWriter::WriteF32(float value)
+{
+    Uint32 bits = 0;
+    SDL_memcpy(&bits, &value, sizeof(bits));
+    WriteU32(bits);
+}
+
+void CookedWriter::WriteString(const std::string &value)
+{
+    WriteU32(static_cast<Uint32>(value.size()));
+    WriteBytes(value.data(), value.size());
+}
+
+void CookedWriter::WriteBytes(const void *bytes, size_t count)
+{
+    const unsigned char *begin = static_cast<const unsigned char *>(bytes);
+    data.insert(data.end(), begin, begin + count);
+}
+
+std::vector<unsigned char> &CookedWriter::GetData() noexcept
+{
+    return data;
+}
+
+CookedReader::CookedReader(const void *data, size_t size, const char *tag)
+    : data(static_cast<const unsigned char *>(data)), size(size), offset(0)
+{
+    if (!IsCooked(data, size, tag))
+    {
+        throw std::runtime_error(std::string("CookedReader expected a cooked '") + tag + "' asset");
+    }
+    offset = 4;
+    Uint32 version = ReadU32();
+    if (version != kCookedVersion)
+    {
+        throw std::runtime_error("CookedReader found cooked asset version " + std::to_string(version) +
+                                 ", expected " + std::to_string(kCookedVersion) + "; cook the resources again");
+    }
+}
+
+bool CookedReader::IsCooked(const void *data, size_t size, const char *tag) noexcept
+{
+    return data && size >= kCookedHeaderSize && SDL_memcmp(data, tag, 4) == 0;
+}
+
+Uint32 CookedReader::ReadU32()
+{
+    Uint32 little = 0;
+    SDL_memcpy(&little, ReadBytes(sizeof(little)), sizeof(little));
+    return SDL_Swap32LE(little);
+}
+
+Sint32 CookedReader::ReadI32()
+{
+    return static_cast<Sint32>(ReadU32());
+}
+
+float CookedReader::ReadF32()
+{
+    Uint32 bits = ReadU32();
+    float value = 0.0f;
+    SDL_memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string CookedReader::ReadString()
+{
+    Uint32 length = ReadU32();
+    const unsigned char *bytes = ReadBytes(length);
+    return std::string(reinterpret_cast<const char *>(bytes), length);
+}
+
+const unsigned char *CookedReader::ReadBytes(size_t count)
+{
+    if (count > size - offset)
+    {
+        throw std::runtime_error("CookedReader ran past the end of a cooked asset");
+    }
+    const unsigned char *bytes = data + offset;
+    offset += count;
+    return bytes;
+}
+
+size_t CookedReader::GetOffset() const noexcept
+{
+    return offset;
+}
+
+size_t CookedReader::GetRemaining() const noexcept
+{
+    return size - offset;
+}
+
+} // namespace engine
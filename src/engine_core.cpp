@@ -1,9 +1,16 @@
 #include "leo/engine_core.h"
+#include "leo/frame_clock.h"
+#include "leo/frame_stats.h"
+#include "leo/input_recording.h"
 #include "leo/lua_runtime.h"
+#include "leo/profiler.h"
 #include "leo/steam_runtime.h"
 #include <atomic>
 #include <memory>
 #include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 #if defined(_WIN32)
 #include <windows.h>
@@ -376,6 +383,89 @@ void CloseGamepads()
     }
 }
 
+// Folds a keyboard, mouse or gamepad event into the input state the next tick reads.
+void ApplyDeviceEvent(const SDL_Event &event, engine::KeyboardState &keyboard, engine::MouseState &mouse)
+{
+    if (event.type == SDL_EVENT_KEY_DOWN)
+    {
+        engine::Key key = MapScancode(event.key.scancode);
+        keyboard.SetKeyDown(key);
+    }
+    else if (event.type == SDL_EVENT_KEY_UP)
+    {
+        engine::Key key = MapScancode(event.key.scancode);
+        keyboard.SetKeyUp(key);
+    }
+    else if (event.type == SDL_EVENT_MOUSE_MOTION)
+    {
+        mouse.SetPosition(event.motion.x, event.motion.y);
+        mouse.AddDelta(event.motion.xrel, event.motion.yrel);
+    }
+    else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN)
+    {
+        engine::MouseButton button = MapMouseButton(event.button.button);
+        mouse.SetButtonDown(button);
+        mouse.SetPosition(event.button.x, event.button.y);
+    }
+    else if (event.type == SDL_EVENT_MOUSE_BUTTON_UP)
+    {
+        engine::MouseButton button = MapMouseButton(event.button.button);
+        mouse.SetButtonUp(button);
+        mouse.SetPosition(event.button.x, event.button.y);
+    }
+    else if (event.type == SDL_EVENT_MOUSE_WHEEL)
+    {
+        float wheel_x = event.wheel.x;
+        float wheel_y = event.wheel.y;
+        if (event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED)
+        {
+            wheel_x = -wheel_x;
+            wheel_y = -wheel_y;
+        }
+        mouse.AddWheel(wheel_x, wheel_y);
+        mouse.SetPosition(event.wheel.mouse_x, event.wheel.mouse_y);
+    }
+    else if (event.type == SDL_EVENT_GAMEPAD_ADDED)
+    {
+        AttachGamepad(event.gdevice.which);
+    }
+    else if (event.type == SDL_EVENT_GAMEPAD_REMOVED)
+    {
+        DetachGamepad(event.gdevice.which);
+    }
+    else if (event.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN)
+    {
+        int slot = FindGamepadSlot(event.gbutton.which);
+        if (slot >= 0)
+        {
+            engine::GamepadButton button = MapGamepadButton(event.gbutton.button);
+            g_gamepads[slot].state.SetButtonDown(button);
+        }
+    }
+    else if (event.type == SDL_EVENT_GAMEPAD_BUTTON_UP)
+    {
+        int slot = FindGamepadSlot(event.gbutton.which);
+        if (slot >= 0)
+        {
+            engine::GamepadButton button = MapGamepadButton(event.gbutton.button);
+            g_gamepads[slot].state.SetButtonUp(button);
+        }
+    }
+    else if (event.type == SDL_EVENT_GAMEPAD_AXIS_MOTION)
+    {
+        int slot = FindGamepadSlot(event.gaxis.which);
+        if (slot >= 0)
+        {
+            engine::GamepadAxis axis = MapGamepadAxis(event.gaxis.axis);
+            if (axis != engine::GamepadAxis::Count)
+            {
+                float value = NormalizeAxis(axis, event.gaxis.value);
+                g_gamepads[slot].state.SetAxis(axis, value);
+            }
+        }
+    }
+}
+
 const char *GetWindowTitle(const leo::Engine::Config &config)
 {
     return config.window_title ? config.window_title : "Leo Engine";
@@ -394,9 +484,75 @@ Uint32 ResolveTickHz(const leo::Engine::Config &config)
     return config.tick_hz > 0 ? static_cast<Uint32>(config.tick_hz) : 60;
 }
 
-SDL_WindowFlags ResolveBaseWindowFlags()
+Uint32 ResolveJobWorkers(const leo::Engine::Config &config)
+{
+    if (config.job_workers < 0)
+    {
+        return 0;
+    }
+    if (config.job_workers == 0)
+    {
+        return engine::JobSystem::GetDefaultWorkerCount();
+    }
+    return static_cast<Uint32>(config.job_workers);
+}
+
+// Seed for math.random in recorded sessions: a SplitMix64 finalizer over the high-resolution clock.
+Uint64 MakeRandomSeed()
+{
+    Uint64 z = SDL_GetPerformanceCounter() + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return z != 0 ? z : 1;
+}
+
+// Sleeps for most of the wait, then spins on the nanosecond clock for the last stretch. This avoids the
+// oversleep that SDL_Delay's millisecond granularity and scheduler wake-up latency add to every frame.
+void WaitUntilNs(Uint64 target_ns)
+{
+    constexpr Uint64 kSpinWindowNs = 2 * SDL_NS_PER_MS;
+    for (;;)
+    {
+        Uint64 now = SDL_GetTicksNS();
+        if (now >= target_ns)
+        {
+            return;
+        }
+
+        Uint64 remaining = target_ns - now;
+        if (remaining > kSpinWindowNs)
+        {
+            SDL_DelayNS(remaining - kSpinWindowNs);
+        }
+    }
+}
+
+SDL_WindowFlags ResolveBaseWindowFlags(const leo::Engine::Config &config)
 {
-    return SDL_WINDOW_RESIZABLE;
+    return config.headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_RESIZABLE;
+}
+
+// Writes a report to a host path ("-" = stdout). Failures are logged rather than thrown so a finished run
+// still shuts down cleanly.
+void WriteReport(const char *path, const std::string &contents, const char *label)
+{
+    if (std::strcmp(path, "-") == 0)
+    {
+        std::fputs(contents.c_str(), stdout);
+        std::fflush(stdout);
+        return;
+    }
+
+    std::FILE *file = std::fopen(path, "wb");
+    if (!file)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s output: %s", label, path);
+        return;
+    }
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s written to %s", label, path);
 }
 
 const SDL_DisplayMode *GetDesktopDisplayMode(SDL_Window *window)
@@ -499,7 +655,8 @@ namespace Engine
 {
 
 Simulation::Simulation(Config &config)
-    : config(config), vfs(config), window(nullptr), renderer(nullptr), lua(nullptr), steam(nullptr)
+    : config(config), vfs(config), jobs(ResolveJobWorkers(config)), window(nullptr), renderer(nullptr), lua(nullptr),
+      steam(nullptr), random_seed(0)
 {
 }
 
@@ -514,6 +671,31 @@ int Simulation::Run()
     SetConsoleCtrlHandler(ConsoleCtrlHandler, TRUE);
 #endif
 
+    // Open input streams before SDL starts so a bad path fails cleanly. A replay brings its own tick rate and seed.
+    std::unique_ptr<engine::InputPlayback> playback;
+    if (config.replay_path && *config.replay_path)
+    {
+        playback = std::make_unique<engine::InputPlayback>(config.replay_path);
+    }
+    const Uint32 tick_hz = playback ? playback->GetTickHz() : ResolveTickHz(config);
+    random_seed = playback ? playback->GetSeed() : 0;
+    std::unique_ptr<engine::InputRecorder> recorder;
+    if (config.record_path && *config.record_path)
+    {
+        if (random_seed == 0)
+        {
+            random_seed = MakeRandomSeed();
+        }
+        recorder = std::make_unique<engine::InputRecorder>(config.record_path, tick_hz, random_seed);
+    }
+
+    if (config.headless)
+    {
+        // No display or sound device is needed; render offscreen so CI machines without a GPU can run scripts.
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
+
     if (!SDL_Init(SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_HAPTIC | SDL_INIT_GAMEPAD))
     {
         throw std::runtime_error(SDL_GetError());
@@ -525,7 +707,7 @@ int Simulation::Run()
     int height = 0;
     ResolveWindowSize(config, &width, &height);
 
-    window = SDL_CreateWindow(GetWindowTitle(config), width, height, ResolveBaseWindowFlags());
+    window = SDL_CreateWindow(GetWindowTitle(config), width, height, ResolveBaseWindowFlags(config));
     if (!window)
     {
         SDL_Quit();
@@ -536,7 +718,10 @@ int Simulation::Run()
 
     try
     {
-        ApplyWindowMode(window, config);
+        if (!config.headless)
+        {
+            ApplyWindowMode(window, config);
+        }
     }
     catch (...)
     {
@@ -545,7 +730,7 @@ int Simulation::Run()
         throw;
     }
 
-    renderer = SDL_CreateRenderer(window, nullptr);
+    renderer = SDL_CreateRenderer(window, config.headless ? SDL_SOFTWARE_RENDERER : nullptr);
     if (!renderer)
     {
         SDL_DestroyWindow(window);
@@ -559,17 +744,40 @@ int Simulation::Run()
     ctx.window = window;
     ctx.renderer = renderer;
     ctx.vfs = &vfs;
+    ctx.jobs = &jobs;
     ctx.config = &config;
     ctx.frame_index = 0;
 
+    engine::Profiler &profiler = engine::Profiler::Get();
+    const bool profile = config.profile_path && *config.profile_path;
+    if (profile)
+    {
+        profiler.Clear();
+        profiler.SetEnabled(true);
+    }
+    profiler.SetOverlayVisible(config.profile_overlay);
+
     OnInit(ctx);
 
     bool running = true;
     Uint32 frame_ticks = 0;
-    Uint32 tick_hz = ResolveTickHz(config);
-    float tick_dt = tick_hz > 0 ? 1.0f / static_cast<float>(tick_hz) : 0.0f;
-    Uint32 tick_delay_ms = tick_hz > 0 ? 1000 / tick_hz : 0;
-    bool throttle = (config.NumFrameTicks == 0);
+    float tick_dt = 1.0f / static_cast<float>(tick_hz);
+    engine::FrameClock clock(tick_hz, config.render_hz > 0 ? static_cast<Uint32>(config.render_hz) : 0,
+                             config.max_catchup_ticks);
+    bool throttle = (config.NumFrameTicks == 0 && !config.headless && !playback);
+    const bool replayable = recorder || playback;
+    if (playback)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Replaying input from %s at %u Hz", config.replay_path, tick_hz);
+    }
+    Uint64 previous_ns = SDL_GetTicksNS();
+
+    const bool benchmark = config.benchmark_path && *config.benchmark_path;
+    engine::FrameStats stats;
+    if (benchmark)
+    {
+        stats.Reserve(config.NumFrameTicks > 0 ? config.NumFrameTicks : 60 * 60);
+    }
 
     SDL_Event event;
     engine::KeyboardState keyboard_state;
@@ -584,149 +792,193 @@ int Simulation::Run()
     }
     while (running)
     {
-        Uint32 frame_start = SDL_GetTicks();
-        InputFrame input = {};
-        input.quit_requested = false;
-        input.frame_index = frame_ticks;
-        keyboard_state.BeginFrame();
-        mouse_state.BeginFrame();
-        for (int i = 0; i < kMaxGamepads; ++i)
+        Uint64 frame_start_ns = SDL_GetTicksNS();
+        if (throttle)
         {
-            g_gamepads[i].state.BeginFrame();
+            clock.AddElapsed(frame_start_ns - previous_ns);
         }
+        else
+        {
+            clock.AddTick();
+        }
+        previous_ns = frame_start_ns;
 
+        bool quit_requested = false;
         while (SDL_PollEvent(&event))
         {
             if (event.type == SDL_EVENT_QUIT)
             {
-                input.quit_requested = true;
+                quit_requested = true;
                 running = false;
             }
-            else if (event.type == SDL_EVENT_KEY_DOWN)
+            else if (event.type == SDL_EVENT_RENDER_TARGETS_RESET || event.type == SDL_EVENT_RENDER_DEVICE_RESET)
             {
-                engine::Key key = MapScancode(event.key.scancode);
-                keyboard_state.SetKeyDown(key);
+                if (lua)
+                {
+                    lua->RestoreCanvases(event.type == SDL_EVENT_RENDER_DEVICE_RESET);
+                }
             }
-            else if (event.type == SDL_EVENT_KEY_UP)
+            else if (!playback)
             {
-                engine::Key key = MapScancode(event.key.scancode);
-                keyboard_state.SetKeyUp(key);
+                // A replay takes its input from the recording; live devices are ignored.
+                ApplyDeviceEvent(event, keyboard_state, mouse_state);
             }
-            else if (event.type == SDL_EVENT_MOUSE_MOTION)
+        }
+
+        // Finish async loads (GPU uploads) before the ticks so scripts see completed futures this frame. Recorded
+        // and replayed runs finish them before every tick instead, since their frames hold different tick counts.
+        if (lua && !replayable)
+        {
+            lua->UpdateAssets();
+        }
+
+        // Run as many fixed ticks as the elapsed time covers. Input edges (pressed/released, deltas) are only
+        // cleared once a tick has consumed them, so events that arrive between ticks are never lost.
+        Uint32 ticks_this_frame = 0;
+        Uint64 update_start_ns = SDL_GetTicksNS();
+        while (running && clock.ConsumeTick())
+        {
+            InputFrame input = {};
+            if (playback)
             {
-                mouse_state.SetPosition(event.motion.x, event.motion.y);
-                mouse_state.AddDelta(event.motion.xrel, event.motion.yrel);
+                if (!playback->Read(input))
+                {
+                    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Replay finished after %u ticks",
+                                playback->GetFrameCount());
+                    running = false;
+                    break;
+                }
+                input.frame_index = frame_ticks;
             }
-            else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN)
+            else
             {
-                engine::MouseButton button = MapMouseButton(event.button.button);
-                mouse_state.SetButtonDown(button);
-                mouse_state.SetPosition(event.button.x, event.button.y);
+                input.quit_requested = quit_requested;
+                input.frame_index = frame_ticks;
+                input.keyboard = keyboard_state;
+                input.mouse = mouse_state;
+                for (int i = 0; i < kMaxGamepads; ++i)
+                {
+                    input.gamepads[i] = g_gamepads[i].state;
+                }
             }
-            else if (event.type == SDL_EVENT_MOUSE_BUTTON_UP)
+            if (recorder)
             {
-                engine::MouseButton button = MapMouseButton(event.button.button);
-                mouse_state.SetButtonUp(button);
-                mouse_state.SetPosition(event.button.x, event.button.y);
+                recorder->Write(input);
             }
-            else if (event.type == SDL_EVENT_MOUSE_WHEEL)
+            ctx.frame_index = frame_ticks;
+            if (lua)
             {
-                float wheel_x = event.wheel.x;
-                float wheel_y = event.wheel.y;
-                if (event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED)
+                if (replayable)
                 {
-                    wheel_x = -wheel_x;
-                    wheel_y = -wheel_y;
+                    lua->UpdateAssets();
                 }
-                mouse_state.AddWheel(wheel_x, wheel_y);
-                mouse_state.SetPosition(event.wheel.mouse_x, event.wheel.mouse_y);
+                lua->SetFrameInfo(frame_ticks, tick_dt);
             }
-            else if (event.type == SDL_EVENT_GAMEPAD_ADDED)
-            {
-                AttachGamepad(event.gdevice.which);
-            }
-            else if (event.type == SDL_EVENT_GAMEPAD_REMOVED)
+            OnUpdate(ctx, input, tick_dt);
+
+            keyboard_state.BeginFrame();
+            mouse_state.BeginFrame();
+            for (int i = 0; i < kMaxGamepads; ++i)
             {
-                DetachGamepad(event.gdevice.which);
+                g_gamepads[i].state.BeginFrame();
             }
-            else if (event.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN)
+
+            if (steam && steam->ConsumeShutdownRequested())
             {
-                int slot = FindGamepadSlot(event.gbutton.which);
-                if (slot >= 0)
-                {
-                    engine::GamepadButton button = MapGamepadButton(event.gbutton.button);
-                    g_gamepads[slot].state.SetButtonDown(button);
-                }
+                running = false;
             }
-            else if (event.type == SDL_EVENT_GAMEPAD_BUTTON_UP)
+            if (lua && lua->WantsQuit())
             {
-                int slot = FindGamepadSlot(event.gbutton.which);
-                if (slot >= 0)
-                {
-                    engine::GamepadButton button = MapGamepadButton(event.gbutton.button);
-                    g_gamepads[slot].state.SetButtonUp(button);
-                }
+                running = false;
             }
-            else if (event.type == SDL_EVENT_GAMEPAD_AXIS_MOTION)
+
+            frame_ticks++;
+            ticks_this_frame++;
+            if (config.NumFrameTicks > 0 && frame_ticks >= config.NumFrameTicks)
             {
-                int slot = FindGamepadSlot(event.gaxis.which);
-                if (slot >= 0)
-                {
-                    engine::GamepadAxis axis = MapGamepadAxis(event.gaxis.axis);
-                    if (axis != engine::GamepadAxis::Count)
-                    {
-                        float value = NormalizeAxis(axis, event.gaxis.value);
-                        g_gamepads[slot].state.SetAxis(axis, value);
-                    }
-                }
+                running = false;
             }
         }
 
-        input.keyboard = keyboard_state;
-        input.mouse = mouse_state;
-        for (int i = 0; i < kMaxGamepads; ++i)
+        if (g_external_quit_requested.load())
         {
-            input.gamepads[i] = g_gamepads[i].state;
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "External termination requested; exiting");
+            running = false;
         }
-        ctx.frame_index = frame_ticks;
-        if (lua)
+
+        const float alpha = clock.GetAlpha();
+        Uint64 draw_start_ns = SDL_GetTicksNS();
+        OnRender(ctx, alpha);
+        profiler.DrawOverlay(renderer);
+        Uint64 present_start_ns = SDL_GetTicksNS();
         {
-            lua->SetFrameInfo(frame_ticks, tick_dt);
+            LEO_PROFILE_SCOPE("SDL_RenderPresent");
+            SDL_RenderPresent(renderer);
         }
-        OnUpdate(ctx, input, tick_dt);
-        if (steam && steam->ConsumeShutdownRequested())
+        // Lua GC runs here, in the slack before the next frame, instead of wherever allocation debt triggers it.
+        Uint64 gc_start_ns = SDL_GetTicksNS();
+        Uint64 gc_ns = 0;
+        if (lua)
         {
-            running = false;
+            Uint64 frame_deadline_ns = clock.GetFrameDeadline(frame_start_ns);
+            Uint64 slack_ns = std::numeric_limits<Uint64>::max();
+            if (throttle)
+            {
+                slack_ns = frame_deadline_ns > gc_start_ns ? frame_deadline_ns - gc_start_ns : 0;
+            }
+            gc_ns = lua->CollectGarbage(slack_ns);
         }
-        if (g_external_quit_requested.load())
+        profiler.EndFrame();
+        if (lua)
         {
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "External termination requested; exiting");
-            running = false;
+            lua->EndFrame();
         }
-        OnRender(ctx);
         if (lua && lua->WantsQuit())
         {
             running = false;
         }
 
-        frame_ticks++;
-        if (config.NumFrameTicks > 0 && frame_ticks >= config.NumFrameTicks)
+        if (benchmark)
         {
-            running = false;
+            Uint64 frame_end_ns = SDL_GetTicksNS();
+            stats.AddTicks(ticks_this_frame);
+            stats.AddPhase(engine::FramePhase::Update, draw_start_ns - update_start_ns);
+            stats.AddPhase(engine::FramePhase::Draw, present_start_ns - draw_start_ns);
+            stats.AddPhase(engine::FramePhase::Present, gc_start_ns - present_start_ns);
+            stats.AddPhase(engine::FramePhase::Gc, gc_ns);
+            if (lua)
+            {
+                stats.SampleLuaMemory(lua->GetMemoryUsage());
+            }
+            stats.EndFrame(frame_end_ns - frame_start_ns);
         }
 
-        if (throttle && tick_delay_ms > 0)
+        if (throttle && running)
         {
-            Uint32 frame_ms = SDL_GetTicks() - frame_start;
-            if (frame_ms < tick_delay_ms)
-            {
-                SDL_Delay(tick_delay_ms - frame_ms);
-            }
+            WaitUntilNs(clock.GetFrameDeadline(frame_start_ns));
         }
     }
 
     OnExit(ctx);
 
+    if (profile)
+    {
+        profiler.SetEnabled(false);
+        WriteReport(config.profile_path, profiler.ToChromeTrace(), "Profiler trace");
+    }
+
+    if (benchmark)
+    {
+        WriteReport(config.benchmark_path, stats.ToJson(), "Benchmark report");
+    }
+
+    if (recorder)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Input recording written to %s (%u ticks)", config.record_path,
+                    recorder->GetFrameCount());
+        recorder.reset();
+    }
+
     CloseGamepads();
 
     SDL_DestroyRenderer(renderer);
@@ -753,13 +1005,18 @@ void Simulation::OnInit(Context &ctx)
     }
 
     lua = std::make_unique<engine::LuaRuntime>();
-    lua->Init(*ctx.vfs, ctx.window, ctx.renderer, config);
+    lua->Init(*ctx.vfs, ctx.window, ctx.renderer, config, ctx.jobs);
+    if (random_seed != 0)
+    {
+        lua->SetRandomSeed(random_seed);
+    }
     lua->LoadScript(config.script_path);
     lua->CallLoad();
 }
 
 void Simulation::OnUpdate(Context &ctx, const InputFrame &input, float dt)
 {
+    LEO_PROFILE_SCOPE("Simulation::OnUpdate");
     (void)ctx;
     if (steam)
     {
@@ -772,17 +1029,16 @@ void Simulation::OnUpdate(Context &ctx, const InputFrame &input, float dt)
     }
 }
 
-void Simulation::OnRender(Context &ctx)
+void Simulation::OnRender(Context &ctx, float alpha)
 {
+    LEO_PROFILE_SCOPE("Simulation::OnRender");
     SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
     SDL_RenderClear(ctx.renderer);
 
     if (lua)
     {
-        lua->CallDraw();
+        lua->CallDraw(alpha);
     }
-
-    SDL_RenderPresent(ctx.renderer);
 }
 
 void Simulation::OnExit(Context &ctx)
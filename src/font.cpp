@@ -1,8 +1,17 @@
 #include "leo/font.h"
+#include "leo/cooked_asset.h"
+#include "leo/profiler.h"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_stdinc.h>
+#include <functional>
+#include <iterator>
+#include <list>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <stb_truetype.h>
 
@@ -12,6 +21,7 @@ namespace
 constexpr int kFirstCodepoint = 32;
 constexpr int kDefaultGlyphCount = 95;
 constexpr int kMaxAtlasAttempts = 3;
+constexpr size_t kDefaultRunCapacity = 256;
 
 struct FontGlyphs
 {
@@ -34,14 +44,119 @@ char *DuplicateString(const char *text)
     return copy;
 }
 
+// White RGBA with the coverage in alpha, so the atlas can be tinted with a texture color mod.
+unsigned char *ExpandAlpha(const unsigned char *alpha, int width, int height)
+{
+    unsigned char *rgba = static_cast<unsigned char *>(SDL_malloc(static_cast<size_t>(width * height * 4)));
+    if (!rgba)
+    {
+        return nullptr;
+    }
+    for (int i = 0; i < width * height; ++i)
+    {
+        rgba[4 * i + 0] = 255;
+        rgba[4 * i + 1] = 255;
+        rgba[4 * i + 2] = 255;
+        rgba[4 * i + 3] = alpha[i];
+    }
+    return rgba;
+}
+
+engine::FontBitmap BakeCooked(const void *data, size_t size)
+{
+    engine::CookedReader reader(data, size, engine::kCookedFontTag);
+    const Sint32 pixel_size = reader.ReadI32();
+    const Sint32 line_height = reader.ReadI32();
+    const Sint32 width = reader.ReadI32();
+    const Sint32 height = reader.ReadI32();
+    const Sint32 first_codepoint = reader.ReadI32();
+    const Sint32 glyph_count = reader.ReadI32();
+    if (pixel_size <= 0 || width <= 0 || height <= 0 || width > 16384 || height > 16384)
+    {
+        throw std::runtime_error("Font::Bake cooked font has an invalid size");
+    }
+    if (first_codepoint != kFirstCodepoint || glyph_count != kDefaultGlyphCount)
+    {
+        throw std::runtime_error("Font::Bake cooked font has an unsupported glyph range");
+    }
+
+    engine::FontBitmap result;
+    result.glyphs = SDL_malloc(sizeof(stbtt_bakedchar) * kDefaultGlyphCount);
+    if (!result.glyphs)
+    {
+        throw std::runtime_error("Font::Bake out of memory");
+    }
+    stbtt_bakedchar *baked = static_cast<stbtt_bakedchar *>(result.glyphs);
+    for (int i = 0; i < kDefaultGlyphCount; ++i)
+    {
+        baked[i].x0 = static_cast<unsigned short>(reader.ReadU32());
+        baked[i].y0 = static_cast<unsigned short>(reader.ReadU32());
+        baked[i].x1 = static_cast<unsigned short>(reader.ReadU32());
+        baked[i].y1 = static_cast<unsigned short>(reader.ReadU32());
+        baked[i].xoff = reader.ReadF32();
+        baked[i].yoff = reader.ReadF32();
+        baked[i].xadvance = reader.ReadF32();
+    }
+
+    const unsigned char *alpha = reader.ReadBytes(static_cast<size_t>(width) * static_cast<size_t>(height));
+    result.rgba = ExpandAlpha(alpha, width, height);
+    if (!result.rgba)
+    {
+        throw std::runtime_error("Font::Bake out of memory for atlas");
+    }
+    result.width = width;
+    result.height = height;
+    result.pixel_size = pixel_size;
+    result.line_height = line_height;
+    return result;
+}
+
+struct RunKey
+{
+    std::string_view text;
+    int pixel_size;
+
+    bool operator==(const RunKey &other) const noexcept
+    {
+        return pixel_size == other.pixel_size && text == other.text;
+    }
+};
+
+struct RunKeyHash
+{
+    size_t operator()(const RunKey &key) const noexcept
+    {
+        size_t hash = std::hash<std::string_view>{}(key.text);
+        return hash ^ (static_cast<size_t>(key.pixel_size) + 0x9e3779b9u + (hash << 6) + (hash >> 2));
+    }
+};
+
 } // namespace
 
 namespace engine
 {
 
+// Laid-out glyph quads for one (string, size) pair in run-local space, ready for a single SDL_RenderGeometry call.
+struct GlyphRun
+{
+    std::string text;
+    int pixel_size;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+// Most recently used runs live at the front of the list. Map keys view the strings owned by the list nodes.
+struct GlyphRunCache
+{
+    size_t capacity = kDefaultRunCapacity;
+    std::list<GlyphRun> runs;
+    std::unordered_map<RunKey, std::list<GlyphRun>::iterator, RunKeyHash> index;
+    std::vector<SDL_Vertex> scratch;
+};
+
 Font::Font() noexcept
     : atlas(nullptr), glyphs(nullptr), atlas_width(0), atlas_height(0), base_size(0), line_height(0),
-      first_codepoint(0), glyph_count(0)
+      first_codepoint(0), glyph_count(0), runs(nullptr)
 {
 }
 
@@ -53,8 +168,9 @@ Font::~Font()
 Font::Font(Font &&other) noexcept
     : atlas(other.atlas), glyphs(other.glyphs), atlas_width(other.atlas_width), atlas_height(other.atlas_height),
       base_size(other.base_size), line_height(other.line_height), first_codepoint(other.first_codepoint),
-      glyph_count(other.glyph_count)
+      glyph_count(other.glyph_count), runs(other.runs)
 {
+    other.runs = nullptr;
     other.atlas = nullptr;
     other.glyphs = nullptr;
     other.atlas_width = 0;
@@ -81,7 +197,9 @@ Font &Font::operator=(Font &&other) noexcept
     line_height = other.line_height;
     first_codepoint = other.first_codepoint;
     glyph_count = other.glyph_count;
+    runs = other.runs;
 
+    other.runs = nullptr;
     other.atlas = nullptr;
     other.glyphs = nullptr;
     other.atlas_width = 0;
@@ -95,6 +213,8 @@ Font &Font::operator=(Font &&other) noexcept
 
 void Font::Reset() noexcept
 {
+    delete runs;
+    runs = nullptr;
     if (atlas)
     {
         SDL_DestroyTexture(atlas);
@@ -115,45 +235,102 @@ void Font::Reset() noexcept
     glyph_count = 0;
 }
 
+FontBitmap::FontBitmap() noexcept
+    : rgba(nullptr), width(0), height(0), glyphs(nullptr), pixel_size(0), line_height(0)
+{
+}
+
+FontBitmap::~FontBitmap()
+{
+    Reset();
+}
+
+FontBitmap::FontBitmap(FontBitmap &&other) noexcept
+    : rgba(other.rgba), width(other.width), height(other.height), glyphs(other.glyphs),
+      pixel_size(other.pixel_size), line_height(other.line_height)
+{
+    other.rgba = nullptr;
+    other.glyphs = nullptr;
+    other.Reset();
+}
+
+FontBitmap &FontBitmap::operator=(FontBitmap &&other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    Reset();
+    rgba = other.rgba;
+    width = other.width;
+    height = other.height;
+    glyphs = other.glyphs;
+    pixel_size = other.pixel_size;
+    line_height = other.line_height;
+    other.rgba = nullptr;
+    other.glyphs = nullptr;
+    other.Reset();
+    return *this;
+}
+
+void FontBitmap::Reset() noexcept
+{
+    SDL_free(rgba);
+    SDL_free(glyphs);
+    rgba = nullptr;
+    glyphs = nullptr;
+    width = 0;
+    height = 0;
+    pixel_size = 0;
+    line_height = 0;
+}
+
 Font Font::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path, int pixel_size)
 {
+    LEO_PROFILE_SCOPE("Font::LoadFromVfs");
     if (!renderer)
     {
         throw std::runtime_error("Font::LoadFromVfs requires a valid SDL_Renderer");
     }
+    return FromBitmap(renderer, Bake(vfs, vfs_path, pixel_size));
+}
+
+FontBitmap Font::Bake(VFS &vfs, const char *vfs_path, int pixel_size)
+{
     if (!vfs_path || !*vfs_path)
     {
-        throw std::runtime_error("Font::LoadFromVfs requires a non-empty path");
+        throw std::runtime_error("Font::Bake requires a non-empty path");
     }
     if (pixel_size <= 0)
     {
-        throw std::runtime_error("Font::LoadFromVfs requires a positive pixel size");
+        throw std::runtime_error("Font::Bake requires a positive pixel size");
     }
 
-    void *data = nullptr;
-    size_t size = 0;
-    vfs.ReadAll(vfs_path, &data, &size);
-    if (!data || size == 0)
+    // stb_truetype only reads the font while baking, so a mapped view saves copying the whole file first.
+    const std::string cooked_path = GetCookedPath(vfs_path, pixel_size);
+    if (vfs.Exists(cooked_path.c_str()))
     {
-        if (data)
-        {
-            SDL_free(data);
-        }
-        throw std::runtime_error("Font::LoadFromVfs received empty data buffer");
+        VfsView cooked = vfs.ReadView(cooked_path.c_str());
+        return BakeCooked(cooked.GetData(), cooked.GetSize());
+    }
+
+    VfsView view = vfs.ReadView(vfs_path);
+    if (view.GetSize() == 0)
+    {
+        throw std::runtime_error("Font::Bake received empty data buffer");
     }
-    if (size > static_cast<size_t>(SDL_MAX_SINT32))
+    if (view.GetSize() > static_cast<size_t>(SDL_MAX_SINT32))
     {
-        SDL_free(data);
-        throw std::runtime_error("Font::LoadFromVfs font data too large");
+        throw std::runtime_error("Font::Bake font data too large");
     }
 
-    const unsigned char *ttf = static_cast<const unsigned char *>(data);
+    const unsigned char *ttf = view.GetData();
     stbtt_fontinfo info = {};
     int font_offset = stbtt_GetFontOffsetForIndex(ttf, 0);
     if (font_offset < 0 || !stbtt_InitFont(&info, ttf, font_offset))
     {
-        SDL_free(data);
-        throw std::runtime_error("Font::LoadFromVfs failed to init font");
+        throw std::runtime_error("Font::Bake failed to init font");
     }
 
     int atlas_w = 512;
@@ -170,10 +347,9 @@ Font Font::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path, i
         baked = static_cast<stbtt_bakedchar *>(SDL_malloc(sizeof(stbtt_bakedchar) * kDefaultGlyphCount));
         if (!bitmap || !baked)
         {
-            SDL_free(data);
             SDL_free(bitmap);
             SDL_free(baked);
-            throw std::runtime_error("Font::LoadFromVfs out of memory");
+            throw std::runtime_error("Font::Bake out of memory");
         }
         SDL_memset(bitmap, 0, static_cast<size_t>(atlas_w * atlas_h));
 
@@ -190,10 +366,9 @@ Font Font::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path, i
 
     if (bake_result <= 0)
     {
-        SDL_free(data);
         SDL_free(bitmap);
         SDL_free(baked);
-        throw std::runtime_error("Font::LoadFromVfs failed to bake font atlas");
+        throw std::runtime_error("Font::Bake failed to bake font atlas");
     }
 
     int ascent = 0;
@@ -203,68 +378,113 @@ Font Font::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path, i
     const float vscale = stbtt_ScaleForPixelHeight(&info, static_cast<float>(pixel_size));
     const int line_height = static_cast<int>(SDL_floorf(((ascent - descent) + line_gap) * vscale + 0.5f));
 
-    unsigned char *rgba = static_cast<unsigned char *>(SDL_malloc(static_cast<size_t>(atlas_w * atlas_h * 4)));
+    unsigned char *rgba = ExpandAlpha(bitmap, atlas_w, atlas_h);
     if (!rgba)
     {
-        SDL_free(data);
         SDL_free(bitmap);
         SDL_free(baked);
-        throw std::runtime_error("Font::LoadFromVfs out of memory for atlas");
+        throw std::runtime_error("Font::Bake out of memory for atlas");
     }
-    for (int i = 0; i < atlas_w * atlas_h; ++i)
+
+    SDL_free(bitmap);
+
+    FontBitmap result;
+    result.rgba = rgba;
+    result.width = atlas_w;
+    result.height = atlas_h;
+    result.glyphs = baked;
+    result.pixel_size = pixel_size;
+    result.line_height = line_height;
+    return result;
+}
+
+std::vector<unsigned char> Font::Cook(const FontBitmap &bitmap)
+{
+    if (!bitmap.rgba || !bitmap.glyphs)
     {
-        unsigned char a = bitmap[i];
-        rgba[4 * i + 0] = 255;
-        rgba[4 * i + 1] = 255;
-        rgba[4 * i + 2] = 255;
-        rgba[4 * i + 3] = a;
+        throw std::runtime_error("Font::Cook requires a baked font bitmap");
+    }
+
+    CookedWriter writer(kCookedFontTag);
+    writer.WriteI32(bitmap.pixel_size);
+    writer.WriteI32(bitmap.line_height);
+    writer.WriteI32(bitmap.width);
+    writer.WriteI32(bitmap.height);
+    writer.WriteI32(kFirstCodepoint);
+    writer.WriteI32(kDefaultGlyphCount);
+    const stbtt_bakedchar *baked = static_cast<const stbtt_bakedchar *>(bitmap.glyphs);
+    for (int i = 0; i < kDefaultGlyphCount; ++i)
+    {
+        writer.WriteU32(baked[i].x0);
+        writer.WriteU32(baked[i].y0);
+        writer.WriteU32(baked[i].x1);
+        writer.WriteU32(baked[i].y1);
+        writer.WriteF32(baked[i].xoff);
+        writer.WriteF32(baked[i].yoff);
+        writer.WriteF32(baked[i].xadvance);
+    }
+
+    std::vector<unsigned char> &data = writer.GetData();
+    const size_t pixel_count = static_cast<size_t>(bitmap.width) * static_cast<size_t>(bitmap.height);
+    const size_t offset = data.size();
+    data.resize(offset + pixel_count);
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        data[offset + i] = bitmap.rgba[4 * i + 3];
+    }
+    return std::move(data);
+}
+
+std::string Font::GetCookedPath(const char *vfs_path, int pixel_size)
+{
+    return std::string(vfs_path ? vfs_path : "") + "@" + std::to_string(pixel_size);
+}
+
+Font Font::FromBitmap(SDL_Renderer *renderer, FontBitmap &&bitmap)
+{
+    if (!renderer)
+    {
+        throw std::runtime_error("Font::FromBitmap requires a valid SDL_Renderer");
+    }
+    if (!bitmap.rgba || !bitmap.glyphs)
+    {
+        throw std::runtime_error("Font::FromBitmap requires a baked font bitmap");
     }
 
     SDL_Texture *atlas =
-        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, atlas_w, atlas_h);
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, bitmap.width, bitmap.height);
     if (!atlas)
     {
-        SDL_free(data);
-        SDL_free(bitmap);
-        SDL_free(baked);
-        SDL_free(rgba);
-        throw std::runtime_error(std::string("Font::LoadFromVfs failed to create texture: ") + SDL_GetError());
+        throw std::runtime_error(std::string("Font::FromBitmap failed to create texture: ") + SDL_GetError());
     }
     SDL_SetTextureScaleMode(atlas, SDL_SCALEMODE_LINEAR);
     SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
 
-    if (!SDL_UpdateTexture(atlas, nullptr, rgba, atlas_w * 4))
+    if (!SDL_UpdateTexture(atlas, nullptr, bitmap.rgba, bitmap.width * 4))
     {
-        SDL_free(data);
-        SDL_free(bitmap);
-        SDL_free(baked);
-        SDL_free(rgba);
         SDL_DestroyTexture(atlas);
-        throw std::runtime_error(std::string("Font::LoadFromVfs failed to upload atlas: ") + SDL_GetError());
+        throw std::runtime_error(std::string("Font::FromBitmap failed to upload atlas: ") + SDL_GetError());
     }
 
-    SDL_free(data);
-    SDL_free(bitmap);
-    SDL_free(rgba);
-
     FontGlyphs *glyph_storage = static_cast<FontGlyphs *>(SDL_malloc(sizeof(FontGlyphs)));
     if (!glyph_storage)
     {
-        SDL_free(baked);
         SDL_DestroyTexture(atlas);
-        throw std::runtime_error("Font::LoadFromVfs out of memory for glyph storage");
+        throw std::runtime_error("Font::FromBitmap out of memory for glyph storage");
     }
-    glyph_storage->baked = baked;
+    glyph_storage->baked = static_cast<stbtt_bakedchar *>(bitmap.glyphs);
+    bitmap.glyphs = nullptr;
 
     Font font;
     font.atlas = atlas;
     font.glyphs = glyph_storage;
-    font.atlas_width = atlas_w;
-    font.atlas_height = atlas_h;
-    font.base_size = pixel_size;
-    font.line_height = line_height;
+    font.atlas_width = bitmap.width;
+    font.atlas_height = bitmap.height;
+    font.base_size = bitmap.pixel_size;
+    font.line_height = bitmap.line_height;
     font.first_codepoint = kFirstCodepoint;
     font.glyph_count = kDefaultGlyphCount;
+    bitmap.Reset();
     return font;
 }
 
@@ -278,6 +498,156 @@ bool Font::IsReady() const noexcept
     return atlas != nullptr && glyphs != nullptr && base_size > 0 && line_height > 0 && glyph_count > 0;
 }
 
+template <typename Emit> void Font::ForEachGlyph(const char *text, int pixel_size, Emit &&emit) const
+{
+    const FontGlyphs *glyph_storage = static_cast<const FontGlyphs *>(glyphs);
+    const stbtt_bakedchar *baked = glyph_storage ? glyph_storage->baked : nullptr;
+    if (!baked || !text || pixel_size <= 0)
+    {
+        return;
+    }
+
+    const float scale = static_cast<float>(pixel_size) / static_cast<float>(base_size);
+    const float line_advance = static_cast<float>(line_height);
+
+    float pen_x = 0.0f;
+    float pen_y = 0.0f;
+
+    for (const unsigned char *p = reinterpret_cast<const unsigned char *>(text); *p; ++p)
+    {
+        int ch = static_cast<int>(*p);
+        if (ch == '\n')
+        {
+            pen_x = 0.0f;
+            pen_y += line_advance;
+            continue;
+        }
+        if (ch < first_codepoint || ch >= first_codepoint + glyph_count)
+        {
+            continue;
+        }
+
+        stbtt_aligned_quad quad;
+        float qx = pen_x;
+        float qy = pen_y;
+        stbtt_GetBakedQuad(baked, atlas_width, atlas_height, ch - first_codepoint, &qx, &qy, &quad, 1);
+
+        float dx0 = quad.x0 * scale;
+        float dy0 = quad.y0 * scale;
+        float dx1 = quad.x1 * scale;
+        float dy1 = quad.y1 * scale;
+
+        float dst_w = dx1 - dx0;
+        float dst_h = dy1 - dy0;
+        if (dst_w > 0.0f && dst_h > 0.0f)
+        {
+            emit(quad, SDL_FRect{dx0, dy0, dst_w, dst_h});
+        }
+
+        pen_x = qx;
+        pen_y = qy;
+    }
+}
+
+void Font::DrawText(SDL_Renderer *renderer, const char *text, int pixel_size, SDL_FPoint position, SDL_Color color)
+{
+    if (!renderer || !text || !*text || pixel_size <= 0 || !IsReady())
+    {
+        return;
+    }
+
+    if (!runs)
+    {
+        runs = new GlyphRunCache();
+    }
+
+    GlyphRun *run = nullptr;
+    auto found = runs->index.find(RunKey{text, pixel_size});
+    if (found != runs->index.end())
+    {
+        runs->runs.splice(runs->runs.begin(), runs->runs, found->second);
+        run = &*found->second;
+    }
+    else
+    {
+        GlyphRun built;
+        built.text = text;
+        built.pixel_size = pixel_size;
+        ForEachGlyph(text, pixel_size, [&](const stbtt_aligned_quad &quad, const SDL_FRect &dst) {
+            const int base = static_cast<int>(built.vertices.size());
+            const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+            built.vertices.push_back({{dst.x, dst.y}, white, {quad.s0, quad.t0}});
+            built.vertices.push_back({{dst.x + dst.w, dst.y}, white, {quad.s1, quad.t0}});
+            built.vertices.push_back({{dst.x + dst.w, dst.y + dst.h}, white, {quad.s1, quad.t1}});
+            built.vertices.push_back({{dst.x, dst.y + dst.h}, white, {quad.s0, quad.t1}});
+            const int quad_indices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+            built.indices.insert(built.indices.end(), quad_indices, quad_indices + 6);
+        });
+
+        while (!runs->runs.empty() && runs->runs.size() >= runs->capacity)
+        {
+            const GlyphRun &oldest = runs->runs.back();
+            runs->index.erase(RunKey{oldest.text, oldest.pixel_size});
+            runs->runs.pop_back();
+        }
+
+        runs->runs.push_front(std::move(built));
+        run = &runs->runs.front();
+        runs->index.emplace(RunKey{run->text, run->pixel_size}, runs->runs.begin());
+    }
+
+    if (run->vertices.empty())
+    {
+        return;
+    }
+
+    constexpr float kInv255 = 1.0f / 255.0f;
+    const SDL_FColor tint = {static_cast<float>(color.r) * kInv255, static_cast<float>(color.g) * kInv255,
+                             static_cast<float>(color.b) * kInv255, static_cast<float>(color.a) * kInv255};
+    runs->scratch.resize(run->vertices.size());
+    for (size_t i = 0; i < run->vertices.size(); ++i)
+    {
+        SDL_Vertex vertex = run->vertices[i];
+        vertex.position.x += position.x;
+        vertex.position.y += position.y;
+        vertex.color = tint;
+        runs->scratch[i] = vertex;
+    }
+
+    SDL_RenderGeometry(renderer, atlas, runs->scratch.data(), static_cast<int>(runs->scratch.size()),
+                       run->indices.data(), static_cast<int>(run->indices.size()));
+}
+
+void Font::SetRunCacheCapacity(size_t capacity)
+{
+    if (capacity == 0)
+    {
+        throw std::runtime_error("Font::SetRunCacheCapacity requires a positive capacity");
+    }
+
+    if (!runs)
+    {
+        runs = new GlyphRunCache();
+    }
+    runs->capacity = capacity;
+    while (runs->runs.size() > capacity)
+    {
+        const GlyphRun &oldest = runs->runs.back();
+        runs->index.erase(RunKey{oldest.text, oldest.pixel_size});
+        runs->runs.pop_back();
+    }
+}
+
+size_t Font::GetRunCacheCapacity() const noexcept
+{
+    return runs ? runs->capacity : kDefaultRunCapacity;
+}
+
+size_t Font::GetCachedRunCount() const noexcept
+{
+    return runs ? runs->runs.size() : 0;
+}
+
 Text::Text() noexcept
     : font(nullptr), text(nullptr), pixel_size(0), position({0.0f, 0.0f}), color({255, 255, 255, 255}),
       src_quads(nullptr), dst_quads(nullptr), quad_count(0)
@@ -442,13 +812,6 @@ void Text::RebuildLayout()
         return;
     }
 
-    const FontGlyphs *glyph_storage = static_cast<const FontGlyphs *>(font->glyphs);
-    const stbtt_bakedchar *baked = glyph_storage->baked;
-    if (!baked)
-    {
-        return;
-    }
-
     int glyphs_needed = 0;
     for (const unsigned char *p = reinterpret_cast<const unsigned char *>(text); *p; ++p)
     {
@@ -477,51 +840,15 @@ void Text::RebuildLayout()
         throw std::runtime_error("Text::RebuildLayout out of memory");
     }
 
-    const float scale = static_cast<float>(pixel_size) / static_cast<float>(font->base_size);
-    const float line_advance = static_cast<float>(font->line_height);
-
-    float pen_x = 0.0f;
-    float pen_y = 0.0f;
+    const float atlas_w = static_cast<float>(font->atlas_width);
+    const float atlas_h = static_cast<float>(font->atlas_height);
     int quad_index = 0;
-
-    for (const unsigned char *p = reinterpret_cast<const unsigned char *>(text); *p; ++p)
-    {
-        int ch = static_cast<int>(*p);
-        if (ch == '\n')
-        {
-            pen_x = 0.0f;
-            pen_y += line_advance;
-            continue;
-        }
-        if (ch < font->first_codepoint || ch >= font->first_codepoint + font->glyph_count)
-        {
-            continue;
-        }
-
-        stbtt_aligned_quad quad;
-        float qx = pen_x;
-        float qy = pen_y;
-        stbtt_GetBakedQuad(baked, font->atlas_width, font->atlas_height, ch - font->first_codepoint, &qx, &qy, &quad,
-                           1);
-
-        float dx0 = quad.x0 * scale;
-        float dy0 = quad.y0 * scale;
-        float dx1 = quad.x1 * scale;
-        float dy1 = quad.y1 * scale;
-
-        float dst_w = dx1 - dx0;
-        float dst_h = dy1 - dy0;
-        if (dst_w > 0.0f && dst_h > 0.0f)
-        {
-            src_quads[quad_index] = {quad.s0 * font->atlas_width, quad.t0 * font->atlas_height,
-                                     (quad.s1 - quad.s0) * font->atlas_width, (quad.t1 - quad.t0) * font->atlas_height};
-            dst_quads[quad_index] = {dx0, dy0, dst_w, dst_h};
-            quad_index++;
-        }
-
-        pen_x = qx;
-        pen_y = qy;
-    }
+    font->ForEachGlyph(text, pixel_size, [&](const stbtt_aligned_quad &quad, const SDL_FRect &dst) {
+        src_quads[quad_index] = {quad.s0 * atlas_w, quad.t0 * atlas_h, (quad.s1 - quad.s0) * atlas_w,
+                                 (quad.t1 - quad.t0) * atlas_h};
+        dst_quads[quad_index] = dst;
+        quad_index++;
+    });
 
     quad_count = quad_index;
 }
@@ -0,0 +1,64 @@
+#include "leo/frame_clock.h"
+#include <SDL3/SDL_timer.h>
+
+namespace engine
+{
+
+FrameClock::FrameClock(Uint32 tick_hz, Uint32 render_hz, Uint32 max_catchup_ticks)
+    : tick_ns(SDL_NS_PER_SECOND / (tick_hz > 0 ? tick_hz : 60)),
+      frame_ns(render_hz > 0 ? SDL_NS_PER_SECOND / render_hz : tick_ns),
+      max_catchup_ticks(max_catchup_ticks > 0 ? max_catchup_ticks : kDefaultMaxCatchupTicks), accumulator_ns(0)
+{
+}
+
+void FrameClock::AddElapsed(Uint64 elapsed_ns) noexcept
+{
+    const Uint64 max_accumulated_ns = tick_ns * max_catchup_ticks;
+    accumulator_ns += elapsed_ns;
+    if (accumulator_ns > max_accumulated_ns)
+    {
+        accumulator_ns = max_accumulated_ns;
+    }
+}
+
+void FrameClock::AddTick() noexcept
+{
+    accumulator_ns += tick_ns;
+}
+
+bool FrameClock::ConsumeTick() noexcept
+{
+    if (accumulator_ns < tick_ns)
+    {
+        return false;
+    }
+    accumulator_ns -= tick_ns;
+    return true;
+}
+
+float FrameClock::GetAlpha() const noexcept
+{
+    return static_cast<float>(static_cast<double>(accumulator_ns % tick_ns) / static_cast<double>(tick_ns));
+}
+
+Uint64 FrameClock::GetFrameDeadline(Uint64 frame_start_ns) const noexcept
+{
+    return frame_start_ns + frame_ns;
+}
+
+Uint64 FrameClock::GetTickNs() const noexcept
+{
+    return tick_ns;
+}
+
+Uint64 FrameClock::GetFrameNs() const noexcept
+{
+    return frame_ns;
+}
+
+Uint32 FrameClock::GetMaxCatchupTicks() const noexcept
+{
+    return max_catchup_ticks;
+}
+
+} // namespace engine
@@ -0,0 +1,175 @@
+#include "leo/frame_stats.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+
+constexpr int kPhaseCount = static_cast<int>(engine::FramePhase::Count);
+constexpr const char *kPhaseNames[kPhaseCount] = {"update", "draw", "present", "gc"};
+
+double NsToMs(Uint64 ns)
+{
+    return static_cast<double>(ns) / 1000000.0;
+}
+
+// Nearest-rank percentile over an already sorted sample set.
+Uint64 SortedPercentile(const std::vector<Uint64> &sorted, double percentile)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    double clamped = std::clamp(percentile, 0.0, 100.0);
+    size_t rank = static_cast<size_t>(clamped / 100.0 * static_cast<double>(sorted.size()) + 0.5);
+    if (rank > 0)
+    {
+        rank--;
+    }
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void AppendFormat(std::string &out, const char *fmt, double value)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), fmt, value);
+    out += buffer;
+}
+
+} // namespace
+
+namespace engine
+{
+
+FrameStats::FrameStats() noexcept
+    : frame_ns(), phase_total_ns{}, phase_max_ns{}, phase_frame_ns{}, tick_count(0), lua_memory_bytes(0),
+      lua_memory_peak_bytes(0)
+{
+}
+
+void FrameStats::Reserve(size_t frames)
+{
+    frame_ns.reserve(frames);
+}
+
+void FrameStats::AddPhase(FramePhase phase, Uint64 ns) noexcept
+{
+    int index = static_cast<int>(phase);
+    if (index < 0 || index >= kPhaseCount)
+    {
+        return;
+    }
+
+    phase_frame_ns[index] += ns;
+}
+
+void FrameStats::AddTicks(Uint32 count) noexcept
+{
+    tick_count += count;
+}
+
+void FrameStats::EndFrame(Uint64 ns)
+{
+    frame_ns.push_back(ns);
+    for (int i = 0; i < kPhaseCount; ++i)
+    {
+        phase_total_ns[i] += phase_frame_ns[i];
+        phase_max_ns[i] = std::max(phase_max_ns[i], phase_frame_ns[i]);
+        phase_frame_ns[i] = 0;
+    }
+}
+
+void FrameStats::SampleLuaMemory(size_t bytes) noexcept
+{
+    lua_memory_bytes = bytes;
+    lua_memory_peak_bytes = std::max(lua_memory_peak_bytes, bytes);
+}
+
+void FrameStats::Reset() noexcept
+{
+    frame_ns.clear();
+    for (int i = 0; i < kPhaseCount; ++i)
+    {
+        phase_total_ns[i] = 0;
+        phase_max_ns[i] = 0;
+        phase_frame_ns[i] = 0;
+    }
+    tick_count = 0;
+    lua_memory_bytes = 0;
+    lua_memory_peak_bytes = 0;
+}
+
+size_t FrameStats::GetFrameCount() const noexcept
+{
+    return frame_ns.size();
+}
+
+Uint64 FrameStats::GetTickCount() const noexcept
+{
+    return tick_count;
+}
+
+Uint64 FrameStats::GetPhaseTotalNs(FramePhase phase) const noexcept
+{
+    int index = static_cast<int>(phase);
+    if (index < 0 || index >= kPhaseCount)
+    {
+        return 0;
+    }
+
+    return phase_total_ns[index];
+}
+
+double FrameStats::GetFramePercentileMs(double percentile) const
+{
+    std::vector<Uint64> sorted = frame_ns;
+    std::sort(sorted.begin(), sorted.end());
+    return NsToMs(SortedPercentile(sorted, percentile));
+}
+
+std::string FrameStats::ToJson() const
+{
+    std::vector<Uint64> sorted = frame_ns;
+    std::sort(sorted.begin(), sorted.end());
+
+    Uint64 total_ns = 0;
+    for (Uint64 ns : sorted)
+    {
+        total_ns += ns;
+    }
+    double frames = static_cast<double>(std::max<size_t>(sorted.size(), 1));
+
+    std::string out;
+    out += "{\n";
+    out += "  \"frames\": " + std::to_string(sorted.size()) + ",\n";
+    out += "  \"ticks\": " + std::to_string(tick_count) + ",\n";
+    AppendFormat(out, "  \"total_ms\": %.3f,\n", NsToMs(total_ns));
+    out += "  \"frame_ms\": {";
+    AppendFormat(out, "\"mean\": %.3f", NsToMs(total_ns) / frames);
+    AppendFormat(out, ", \"p50\": %.3f", NsToMs(SortedPercentile(sorted, 50.0)));
+    AppendFormat(out, ", \"p95\": %.3f", NsToMs(SortedPercentile(sorted, 95.0)));
+    AppendFormat(out, ", \"p99\": %.3f", NsToMs(SortedPercentile(sorted, 99.0)));
+    AppendFormat(out, ", \"max\": %.3f", NsToMs(sorted.empty() ? 0 : sorted.back()));
+    out += "},\n";
+    out += "  \"phases_ms\": {\n";
+    for (int i = 0; i < kPhaseCount; ++i)
+    {
+        out += "    \"";
+        out += kPhaseNames[i];
+        out += "\": {";
+        AppendFormat(out, "\"total\": %.3f", NsToMs(phase_total_ns[i]));
+        AppendFormat(out, ", \"mean\": %.3f", NsToMs(phase_total_ns[i]) / frames);
+        AppendFormat(out, ", \"max\": %.3f", NsToMs(phase_max_ns[i]));
+        out += i + 1 < kPhaseCount ? "},\n" : "}\n";
+    }
+    out += "  },\n";
+    out += "  \"lua_memory_kb\": {";
+    AppendFormat(out, "\"final\": %.1f", static_cast<double>(lua_memory_bytes) / 1024.0);
+    AppendFormat(out, ", \"peak\": %.1f", static_cast<double>(lua_memory_peak_bytes) / 1024.0);
+    out += "}\n";
+    out += "}\n";
+    return out;
+}
+
+} // namespace engine
@@ -2,34 +2,17 @@
 
 #include <algorithm>
 #include <cmath>
+#include <numbers>
 #include <vector>
 
 namespace
 {
 
 constexpr float kEpsilon = 1.0e-5f;
-
-struct ScopedRenderState
-{
-    SDL_Renderer *renderer;
-    SDL_Color prev_color;
-    SDL_BlendMode prev_blend;
-
-    ScopedRenderState(SDL_Renderer *renderer_ref, leo::Graphics::Color color)
-        : renderer(renderer_ref), prev_color({0, 0, 0, 0}), prev_blend(SDL_BLENDMODE_NONE)
-    {
-        SDL_GetRenderDrawColor(renderer, &prev_color.r, &prev_color.g, &prev_color.b, &prev_color.a);
-        SDL_GetRenderDrawBlendMode(renderer, &prev_blend);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    }
-
-    ~ScopedRenderState()
-    {
-        SDL_SetRenderDrawBlendMode(renderer, prev_blend);
-        SDL_SetRenderDrawColor(renderer, prev_color.r, prev_color.g, prev_color.b, prev_color.a);
-    }
-};
+// Largest gap, in pixels, between a true circle and the edges of its tessellation.
+constexpr float kCircleTolerance = 0.25f;
+constexpr int kMinCircleSegments = 8;
+constexpr int kMaxCircleSegments = 256;
 
 float Cross(const SDL_FPoint &a, const SDL_FPoint &b, const SDL_FPoint &c)
 {
@@ -229,123 +212,171 @@ SDL_FColor ToFColor(leo::Graphics::Color color)
     return result;
 }
 
-void RenderTriangleGeometry(SDL_Renderer *renderer, const SDL_FPoint &a, const SDL_FPoint &b, const SDL_FPoint &c,
-                            leo::Graphics::Color color)
+// Segment count for a circle of this radius. It is a multiple of four so each corner of a rounded rectangle gets a
+// whole quarter of the same table.
+int CircleSegments(float radius)
 {
-    SDL_Vertex verts[3];
-    verts[0].position = a;
-    verts[0].color = ToFColor(color);
-    verts[0].tex_coord = {0.0f, 0.0f};
-    verts[1].position = b;
-    verts[1].color = ToFColor(color);
-    verts[1].tex_coord = {0.0f, 0.0f};
-    verts[2].position = c;
-    verts[2].color = ToFColor(color);
-    verts[2].tex_coord = {0.0f, 0.0f};
-
-    int indices[3] = {0, 1, 2};
-    SDL_RenderGeometry(renderer, nullptr, verts, 3, indices, 3);
+    if (!(radius > kCircleTolerance))
+    {
+        return kMinCircleSegments;
+    }
+    const float step = 2.0f * std::acos(1.0f - kCircleTolerance / radius);
+    const float segments = std::ceil(2.0f * std::numbers::pi_v<float> / step);
+    const int count = static_cast<int>(std::min(segments, static_cast<float>(kMaxCircleSegments)));
+    return std::clamp((count + 3) & ~3, kMinCircleSegments, kMaxCircleSegments);
 }
 
-void DrawHorizontal(SDL_Renderer *renderer, float x1, float x2, float y)
+// Unit circle for a segment count, starting at +x and running clockwise on screen. Tables are built on first use
+// and kept; shapes are only drawn from the render thread.
+const SDL_FPoint *UnitCircle(int segments)
 {
-    SDL_RenderLine(renderer, x1, y, x2, y);
+    static std::vector<std::vector<SDL_FPoint>> tables(kMaxCircleSegments / 4 + 1);
+    std::vector<SDL_FPoint> &table = tables[static_cast<size_t>(segments / 4)];
+    if (table.empty())
+    {
+        table.resize(static_cast<size_t>(segments));
+        const float step = 2.0f * std::numbers::pi_v<float> / static_cast<float>(segments);
+        for (int i = 0; i < segments; ++i)
+        {
+            const float angle = step * static_cast<float>(i);
+            table[static_cast<size_t>(i)] = {std::cos(angle), std::sin(angle)};
+        }
+    }
+    return table.data();
 }
 
-void DrawCircleOutlinePoints(SDL_Renderer *renderer, float cx, float cy, int x, int y)
+// Closed outline made of four quarter arcs around the corner centres. The unit table's quadrants run bottom right,
+// bottom left, top left, top right. A circle has all four centres at one point, so it walks the table once instead.
+struct ArcPath
+{
+    float left;
+    float top;
+    float right;
+    float bottom;
+    const SDL_FPoint *unit;
+    int quarter;
+    bool circle;
+    int count;
+};
+
+ArcPath MakeCirclePath(float cx, float cy, float radius)
 {
-    SDL_RenderPoint(renderer, cx + x, cy + y);
-    SDL_RenderPoint(renderer, cx - x, cy + y);
-    SDL_RenderPoint(renderer, cx + x, cy - y);
-    SDL_RenderPoint(renderer, cx - x, cy - y);
-    SDL_RenderPoint(renderer, cx + y, cy + x);
-    SDL_RenderPoint(renderer, cx - y, cy + x);
-    SDL_RenderPoint(renderer, cx + y, cy - x);
-    SDL_RenderPoint(renderer, cx - y, cy - x);
+    const int segments = CircleSegments(radius);
+    return {cx, cy, cx, cy, UnitCircle(segments), segments / 4, true, segments};
 }
 
-enum class Quadrant
+ArcPath MakeRoundedPath(float left, float top, float right, float bottom, float radius)
 {
-    TopLeft,
-    TopRight,
-    BottomLeft,
-    BottomRight
-};
+    const int segments = CircleSegments(radius);
+    const int quarter = segments / 4;
+    return {left, top, right, bottom, UnitCircle(segments), quarter, false, 4 * (quarter + 1)};
+}
 
-void DrawQuarterOutlinePoints(SDL_Renderer *renderer, float cx, float cy, int x, int y, Quadrant quadrant)
+SDL_FPoint PathPoint(const ArcPath &path, int index, float radius)
 {
-    switch (quadrant)
+    if (path.circle)
     {
-    case Quadrant::TopLeft:
-        SDL_RenderPoint(renderer, cx - x, cy - y);
-        SDL_RenderPoint(renderer, cx - y, cy - x);
-        break;
-    case Quadrant::TopRight:
-        SDL_RenderPoint(renderer, cx + x, cy - y);
-        SDL_RenderPoint(renderer, cx + y, cy - x);
-        break;
-    case Quadrant::BottomLeft:
-        SDL_RenderPoint(renderer, cx - x, cy + y);
-        SDL_RenderPoint(renderer, cx - y, cy + x);
-        break;
-    case Quadrant::BottomRight:
-        SDL_RenderPoint(renderer, cx + x, cy + y);
-        SDL_RenderPoint(renderer, cx + y, cy + x);
-        break;
+        const SDL_FPoint &dir = path.unit[index];
+        return {path.left + dir.x * radius, path.top + dir.y * radius};
     }
+    // Each arc includes both of its end points; the straight edges run between neighbouring arcs.
+    const int corner = index / (path.quarter + 1);
+    const int step = index % (path.quarter + 1);
+    const SDL_FPoint &dir = path.unit[(corner * path.quarter + step) % (4 * path.quarter)];
+    const float cx = (corner == 0 || corner == 3) ? path.right : path.left;
+    const float cy = corner < 2 ? path.bottom : path.top;
+    return {cx + dir.x * radius, cy + dir.y * radius};
 }
 
-void DrawQuarterCircleOutline(SDL_Renderer *renderer, float cx, float cy, float radius, Quadrant quadrant)
+void AppendFan(engine::SpriteBatch &batch, const ArcPath &path, float radius, SDL_FColor color)
 {
-    int r = static_cast<int>(radius + 0.5f);
-    int x = 0;
-    int y = r;
-    int d = 1 - r;
-
-    while (y >= x)
+    const int count = path.count;
+    engine::GeometrySpan span = batch.AddGeometry(count + 1, count * 3);
+    span.vertices[0].position = {(path.left + path.right) * 0.5f, (path.top + path.bottom) * 0.5f};
+    span.vertices[0].color = color;
+    for (int i = 0; i < count; ++i)
     {
-        DrawQuarterOutlinePoints(renderer, cx, cy, x, y, quadrant);
-        if (d < 0)
-        {
-            d += 2 * x + 3;
-        }
-        else
-        {
-            d += 2 * (x - y) + 5;
-            --y;
-        }
-        ++x;
+        span.vertices[i + 1].position = PathPoint(path, i, radius);
+        span.vertices[i + 1].color = color;
+        int *triangle = span.indices + i * 3;
+        triangle[0] = span.first_vertex;
+        triangle[1] = span.first_vertex + 1 + i;
+        triangle[2] = span.first_vertex + 1 + (i + 1) % count;
+    }
+}
+
+void AppendRing(engine::SpriteBatch &batch, const ArcPath &path, float inner, float outer, SDL_FColor color)
+{
+    const int count = path.count;
+    engine::GeometrySpan span = batch.AddGeometry(count * 2, count * 6);
+    for (int i = 0; i < count; ++i)
+    {
+        span.vertices[i * 2].position = PathPoint(path, i, inner);
+        span.vertices[i * 2].color = color;
+        span.vertices[i * 2 + 1].position = PathPoint(path, i, outer);
+        span.vertices[i * 2 + 1].color = color;
+        const int a = span.first_vertex + i * 2;
+        const int b = span.first_vertex + ((i + 1) % count) * 2;
+        int *quad = span.indices + i * 6;
+        quad[0] = a;
+        quad[1] = a + 1;
+        quad[2] = b + 1;
+        quad[3] = a;
+        quad[4] = b + 1;
+        quad[5] = b;
     }
 }
 
-void DrawQuarterCircleFilled(SDL_Renderer *renderer, float cx, float cy, float radius, Quadrant quadrant)
+void AppendTriangles(engine::SpriteBatch &batch, const SDL_FPoint *points, int count, SDL_FColor color)
 {
-    if (radius <= 0.0f)
+    engine::GeometrySpan span = batch.AddGeometry(count, count);
+    for (int i = 0; i < count; ++i)
     {
-        return;
+        span.vertices[i].position = points[i];
+        span.vertices[i].color = color;
+        span.indices[i] = span.first_vertex + i;
     }
+}
 
-    float r2 = radius * radius;
-    int r = static_cast<int>(radius + 0.5f);
-    for (int y = 0; y <= r; ++y)
+void AppendQuad(engine::SpriteBatch &batch, const SDL_FPoint (&corners)[4], SDL_FColor color)
+{
+    engine::GeometrySpan span = batch.AddGeometry(4, 6);
+    for (int i = 0; i < 4; ++i)
     {
-        float x = std::sqrt(std::max(0.0f, r2 - static_cast<float>(y * y)));
-        switch (quadrant)
-        {
-        case Quadrant::TopLeft:
-            DrawHorizontal(renderer, cx - x, cx, cy - static_cast<float>(y));
-            break;
-        case Quadrant::TopRight:
-            DrawHorizontal(renderer, cx, cx + x, cy - static_cast<float>(y));
-            break;
-        case Quadrant::BottomLeft:
-            DrawHorizontal(renderer, cx - x, cx, cy + static_cast<float>(y));
-            break;
-        case Quadrant::BottomRight:
-            DrawHorizontal(renderer, cx, cx + x, cy + static_cast<float>(y));
-            break;
-        }
+        span.vertices[i].position = corners[i];
+        span.vertices[i].color = color;
     }
+    const int base = span.first_vertex;
+    const int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+    std::copy(quad, quad + 6, span.indices);
+}
+
+void AppendRect(engine::SpriteBatch &batch, float x, float y, float w, float h, SDL_FColor color)
+{
+    const SDL_FPoint corners[4] = {{x, y}, {x + w, y}, {x + w, y + h}, {x, y + h}};
+    AppendQuad(batch, corners, color);
+}
+
+// Coordinates name pixels, as with SDL_RenderLine: the stroke runs between pixel centres and is capped by half a
+// pixel so both end pixels are covered.
+void AppendLine(engine::SpriteBatch &batch, SDL_FPoint a, SDL_FPoint b, SDL_FColor color)
+{
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    float ux = 0.5f;
+    float uy = 0.0f;
+    if (length > kEpsilon)
+    {
+        ux = dx / length * 0.5f;
+        uy = dy / length * 0.5f;
+    }
+    const float ax = a.x + 0.5f - ux;
+    const float ay = a.y + 0.5f - uy;
+    const float bx = b.x + 0.5f + ux;
+    const float by = b.y + 0.5f + uy;
+    const SDL_FPoint corners[4] = {{ax - uy, ay + ux}, {bx - uy, by + ux}, {bx + uy, by - ux}, {ax + uy, ay - ux}};
+    AppendQuad(batch, corners, color);
 }
 
 } // namespace
@@ -355,200 +386,120 @@ namespace leo
 namespace Graphics
 {
 
-void DrawPixel(SDL_Renderer *renderer, float x, float y, Color color)
+void DrawPixel(engine::SpriteBatch &batch, float x, float y, Color color)
 {
-    if (!renderer)
-    {
-        return;
-    }
-    ScopedRenderState state(renderer, color);
-    SDL_RenderPoint(renderer, x, y);
+    AppendRect(batch, x, y, 1.0f, 1.0f, ToFColor(color));
 }
 
-void DrawLine(SDL_Renderer *renderer, float x1, float y1, float x2, float y2, Color color)
+void DrawLine(engine::SpriteBatch &batch, float x1, float y1, float x2, float y2, Color color)
 {
-    if (!renderer)
-    {
-        return;
-    }
-    ScopedRenderState state(renderer, color);
-    SDL_RenderLine(renderer, x1, y1, x2, y2);
+    AppendLine(batch, {x1, y1}, {x2, y2}, ToFColor(color));
 }
 
-void DrawCircleFilled(SDL_Renderer *renderer, float cx, float cy, float radius, Color color)
+// Circles keep the midpoint-circle convention: (cx, cy) names the centre pixel and the shape covers the pixels up
+// to radius away from it.
+void DrawCircleFilled(engine::SpriteBatch &batch, float cx, float cy, float radius, Color color)
 {
-    if (!renderer || radius <= 0.0f)
+    if (!(radius > 0.0f))
     {
         return;
     }
-    ScopedRenderState state(renderer, color);
-
-    int r = static_cast<int>(radius + 0.5f);
-    int x = 0;
-    int y = r;
-    int d = 1 - r;
-
-    while (y >= x)
-    {
-        DrawHorizontal(renderer, cx - x, cx + x, cy + y);
-        DrawHorizontal(renderer, cx - x, cx + x, cy - y);
-        DrawHorizontal(renderer, cx - y, cx + y, cy + x);
-        DrawHorizontal(renderer, cx - y, cx + y, cy - x);
-        if (d < 0)
-        {
-            d += 2 * x + 3;
-        }
-        else
-        {
-            d += 2 * (x - y) + 5;
-            --y;
-        }
-        ++x;
-    }
+    const float r = radius + 0.5f;
+    AppendFan(batch, MakeCirclePath(cx + 0.5f, cy + 0.5f, r), r, ToFColor(color));
 }
 
-void DrawCircleOutline(SDL_Renderer *renderer, float cx, float cy, float radius, Color color)
+void DrawCircleOutline(engine::SpriteBatch &batch, float cx, float cy, float radius, Color color)
 {
-    if (!renderer || radius <= 0.0f)
+    if (!(radius > 0.0f))
     {
         return;
     }
-    ScopedRenderState state(renderer, color);
-
-    int r = static_cast<int>(radius + 0.5f);
-    int x = 0;
-    int y = r;
-    int d = 1 - r;
-
-    while (y >= x)
-    {
-        DrawCircleOutlinePoints(renderer, cx, cy, x, y);
-        if (d < 0)
-        {
-            d += 2 * x + 3;
-        }
-        else
-        {
-            d += 2 * (x - y) + 5;
-            --y;
-        }
-        ++x;
-    }
+    const ArcPath path = MakeCirclePath(cx + 0.5f, cy + 0.5f, radius + 0.5f);
+    AppendRing(batch, path, std::max(radius - 0.5f, 0.0f), radius + 0.5f, ToFColor(color));
 }
 
-void DrawRectangleFilled(SDL_Renderer *renderer, float x, float y, float w, float h, Color color)
+void DrawRectangleFilled(engine::SpriteBatch &batch, float x, float y, float w, float h, Color color)
 {
-    if (!renderer || w <= 0.0f || h <= 0.0f)
+    if (w <= 0.0f || h <= 0.0f)
     {
         return;
     }
-    ScopedRenderState state(renderer, color);
-    SDL_FRect rect = {x, y, w, h};
-    SDL_RenderFillRect(renderer, &rect);
+    AppendRect(batch, x, y, w, h, ToFColor(color));
 }
 
-void DrawRectangleOutline(SDL_Renderer *renderer, float x, float y, float w, float h, Color color)
+// Outlines are one pixel wide and stay inside the rectangle, like SDL_RenderRect.
+void DrawRectangleOutline(engine::SpriteBatch &batch, float x, float y, float w, float h, Color color)
 {
-    if (!renderer || w <= 0.0f || h <= 0.0f)
+    if (w <= 0.0f || h <= 0.0f)
+    {
+        return;
+    }
+    const SDL_FColor fcolor = ToFColor(color);
+    if (w <= 2.0f || h <= 2.0f)
     {
+        AppendRect(batch, x, y, w, h, fcolor);
         return;
     }
-    ScopedRenderState state(renderer, color);
-    SDL_FRect rect = {x, y, w, h};
-    SDL_RenderRect(renderer, &rect);
+    AppendRect(batch, x, y, w, 1.0f, fcolor);
+    AppendRect(batch, x, y + h - 1.0f, w, 1.0f, fcolor);
+    AppendRect(batch, x, y + 1.0f, 1.0f, h - 2.0f, fcolor);
+    AppendRect(batch, x + w - 1.0f, y + 1.0f, 1.0f, h - 2.0f, fcolor);
 }
 
-void DrawRectangleRoundedFilled(SDL_Renderer *renderer, float x, float y, float w, float h, float radius, Color color)
+void DrawRectangleRoundedFilled(engine::SpriteBatch &batch, float x, float y, float w, float h, float radius,
+                                Color color)
 {
-    if (!renderer || w <= 0.0f || h <= 0.0f)
+    if (w <= 0.0f || h <= 0.0f)
     {
         return;
     }
 
     float r = std::min(radius, 0.5f * std::min(w, h));
-    if (r <= 0.0f)
+    if (!(r > 0.0f))
     {
-        DrawRectangleFilled(renderer, x, y, w, h, color);
+        DrawRectangleFilled(batch, x, y, w, h, color);
         return;
     }
 
-    ScopedRenderState state(renderer, color);
-
-    float right = x + w;
-    float bottom = y + h;
-
-    SDL_FRect center = {x + r, y, w - 2.0f * r, h};
-    SDL_RenderFillRect(renderer, &center);
-
-    SDL_FRect left = {x, y + r, r, h - 2.0f * r};
-    SDL_RenderFillRect(renderer, &left);
-
-    SDL_FRect right_rect = {right - r, y + r, r, h - 2.0f * r};
-    SDL_RenderFillRect(renderer, &right_rect);
-
-    DrawQuarterCircleFilled(renderer, x + r, y + r, r, Quadrant::TopLeft);
-    DrawQuarterCircleFilled(renderer, right - r, y + r, r, Quadrant::TopRight);
-    DrawQuarterCircleFilled(renderer, x + r, bottom - r, r, Quadrant::BottomLeft);
-    DrawQuarterCircleFilled(renderer, right - r, bottom - r, r, Quadrant::BottomRight);
+    AppendFan(batch, MakeRoundedPath(x + r, y + r, x + w - r, y + h - r, r), r, ToFColor(color));
 }
 
-void DrawRectangleRoundedOutline(SDL_Renderer *renderer, float x, float y, float w, float h, float radius, Color color)
+void DrawRectangleRoundedOutline(engine::SpriteBatch &batch, float x, float y, float w, float h, float radius,
+                                 Color color)
 {
-    if (!renderer || w <= 0.0f || h <= 0.0f)
+    if (w <= 0.0f || h <= 0.0f)
     {
         return;
     }
 
     float r = std::min(radius, 0.5f * std::min(w, h));
-    if (r <= 0.0f)
+    if (!(r > 0.0f))
     {
-        DrawRectangleOutline(renderer, x, y, w, h, color);
+        DrawRectangleOutline(batch, x, y, w, h, color);
         return;
     }
 
-    ScopedRenderState state(renderer, color);
-
-    float right = x + w;
-    float bottom = y + h;
-
-    SDL_RenderLine(renderer, x + r, y, right - r, y);
-    SDL_RenderLine(renderer, x + r, bottom, right - r, bottom);
-    SDL_RenderLine(renderer, x, y + r, x, bottom - r);
-    SDL_RenderLine(renderer, right, y + r, right, bottom - r);
-
-    DrawQuarterCircleOutline(renderer, x + r, y + r, r, Quadrant::TopLeft);
-    DrawQuarterCircleOutline(renderer, right - r, y + r, r, Quadrant::TopRight);
-    DrawQuarterCircleOutline(renderer, x + r, bottom - r, r, Quadrant::BottomLeft);
-    DrawQuarterCircleOutline(renderer, right - r, bottom - r, r, Quadrant::BottomRight);
+    const ArcPath path = MakeRoundedPath(x + r, y + r, x + w - r, y + h - r, r);
+    AppendRing(batch, path, std::max(r - 1.0f, 0.0f), r, ToFColor(color));
 }
 
-void DrawTriangleFilled(SDL_Renderer *renderer, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color)
+void DrawTriangleFilled(engine::SpriteBatch &batch, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color)
 {
-    if (!renderer)
-    {
-        return;
-    }
-
-    ScopedRenderState state(renderer, color);
-    RenderTriangleGeometry(renderer, a, b, c, color);
+    const SDL_FPoint points[3] = {a, b, c};
+    AppendTriangles(batch, points, 3, ToFColor(color));
 }
 
-void DrawTriangleOutline(SDL_Renderer *renderer, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color)
+void DrawTriangleOutline(engine::SpriteBatch &batch, SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, Color color)
 {
-    if (!renderer)
-    {
-        return;
-    }
-
-    ScopedRenderState state(renderer, color);
-    SDL_RenderLine(renderer, a.x, a.y, b.x, b.y);
-    SDL_RenderLine(renderer, b.x, b.y, c.x, c.y);
-    SDL_RenderLine(renderer, c.x, c.y, a.x, a.y);
+    const SDL_FColor fcolor = ToFColor(color);
+    AppendLine(batch, a, b, fcolor);
+    AppendLine(batch, b, c, fcolor);
+    AppendLine(batch, c, a, fcolor);
 }
 
-void DrawPolyFilled(SDL_Renderer *renderer, const SDL_FPoint *points, int count, Color color)
+void DrawPolyFilled(engine::SpriteBatch &batch, const SDL_FPoint *points, int count, Color color)
 {
-    if (!renderer || !points || count < 3)
+    if (!points || count < 3)
     {
         return;
     }
@@ -560,28 +511,26 @@ void DrawPolyFilled(SDL_Renderer *renderer, const SDL_FPoint *points, int count,
         return;
     }
 
-    ScopedRenderState state(renderer, color);
-    for (size_t i = 0; i + 2 < triangles.size(); i += 3)
-    {
-        RenderTriangleGeometry(renderer, triangles[i], triangles[i + 1], triangles[i + 2], color);
-    }
+    AppendTriangles(batch, triangles.data(), static_cast<int>(triangles.size() / 3 * 3), ToFColor(color));
 }
 
-void DrawPolyOutline(SDL_Renderer *renderer, const SDL_FPoint *points, int count, Color color)
+void DrawPolyOutline(engine::SpriteBatch &batch, const SDL_FPoint *points, int count, Color color)
 {
-    if (!renderer || !points || count < 2)
+    if (!points || count < 2)
     {
         return;
     }
 
-    std::vector<SDL_FPoint> line_points(points, points + count);
-    if (count >= 2)
+    const SDL_FColor fcolor = ToFColor(color);
+    for (int i = 0; i < count; ++i)
     {
-        line_points.push_back(points[0]);
+        // Two points are a single segment, not a closed loop drawn twice.
+        if (count == 2 && i == 1)
+        {
+            break;
+        }
+        AppendLine(batch, points[i], points[(i + 1) % count], fcolor);
     }
-
-    ScopedRenderState state(renderer, color);
-    SDL_RenderLines(renderer, line_points.data(), static_cast<int>(line_points.size()));
 }
 
 } // namespace Graphics
@@ -0,0 +1,405 @@
+#include "leo/input_recording.h"
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+
+using leo::Engine::InputFrame;
+
+constexpr char kMagic[4] = {'L', 'E', 'O', 'I'};
+constexpr Uint32 kVersion = 1;
+constexpr size_t kHeaderSize = sizeof(kMagic) + 3 * sizeof(Uint32) + sizeof(Uint64);
+
+// Unchanged runs this short are folded into the surrounding span; a new span header costs at least two bytes.
+constexpr size_t kMaxMergedGap = 2;
+
+constexpr Uint8 kStateDown = 1;
+constexpr Uint8 kStatePressed = 2;
+constexpr Uint8 kStateReleased = 4;
+
+constexpr size_t kGamepadSlots = std::extent_v<decltype(InputFrame::gamepads)>;
+constexpr size_t kKeyCount = static_cast<size_t>(engine::Key::Count);
+constexpr size_t kMouseButtonCount = static_cast<size_t>(engine::MouseButton::Count);
+constexpr size_t kGamepadButtonCount = static_cast<size_t>(engine::GamepadButton::Count);
+constexpr size_t kGamepadAxisCount = static_cast<size_t>(engine::GamepadAxis::Count);
+
+// Flattened layout: quit flag, key states, mouse button states, six mouse floats, then per gamepad slot the
+// connected flag, button states and each axis with its previous-tick value. Index 0 of the key and button enums is
+// Unknown and is skipped.
+constexpr size_t kRecordSize = 1 + (kKeyCount - 1) + (kMouseButtonCount - 1) + 6 * sizeof(float) +
+                               kGamepadSlots * (1 + (kGamepadButtonCount - 1) + kGamepadAxisCount * 2 * sizeof(float));
+
+Uint8 PackState(bool down, bool pressed, bool released)
+{
+    return static_cast<Uint8>((down ? kStateDown : 0) | (pressed ? kStatePressed : 0) |
+                              (released ? kStateReleased : 0));
+}
+
+void PutU32(std::vector<Uint8> &out, Uint32 value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        out.push_back(static_cast<Uint8>(value >> shift));
+    }
+}
+
+void PutU64(std::vector<Uint8> &out, Uint64 value)
+{
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        out.push_back(static_cast<Uint8>(value >> shift));
+    }
+}
+
+void PutFloat(std::vector<Uint8> &out, float value)
+{
+    PutU32(out, std::bit_cast<Uint32>(value));
+}
+
+void PutVarint(std::vector<Uint8> &out, size_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<Uint8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<Uint8>(value));
+}
+
+Uint32 GetU32(const Uint8 *bytes)
+{
+    Uint32 value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<Uint32>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+Uint64 GetU64(const Uint8 *bytes)
+{
+    Uint64 value = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        value |= static_cast<Uint64>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+float GetFloat(const Uint8 *bytes)
+{
+    return std::bit_cast<float>(GetU32(bytes));
+}
+
+bool GetVarint(const std::vector<Uint8> &data, size_t *offset, size_t *value)
+{
+    size_t result = 0;
+    for (int shift = 0; shift < 63; shift += 7)
+    {
+        if (*offset >= data.size())
+        {
+            return false;
+        }
+        Uint8 byte = data[(*offset)++];
+        result |= static_cast<size_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FlattenFrame(const InputFrame &frame, std::vector<Uint8> &out)
+{
+    out.clear();
+    out.push_back(frame.quit_requested ? 1 : 0);
+
+    for (size_t i = 1; i < kKeyCount; ++i)
+    {
+        engine::Key key = static_cast<engine::Key>(i);
+        out.push_back(PackState(frame.keyboard.IsDown(key), frame.keyboard.IsPressed(key),
+                                frame.keyboard.IsReleased(key)));
+    }
+
+    for (size_t i = 1; i < kMouseButtonCount; ++i)
+    {
+        engine::MouseButton button = static_cast<engine::MouseButton>(i);
+        out.push_back(PackState(frame.mouse.IsButtonDown(button), frame.mouse.IsButtonPressed(button),
+                                frame.mouse.IsButtonReleased(button)));
+    }
+    PutFloat(out, frame.mouse.GetX());
+    PutFloat(out, frame.mouse.GetY());
+    PutFloat(out, frame.mouse.GetDeltaX());
+    PutFloat(out, frame.mouse.GetDeltaY());
+    PutFloat(out, frame.mouse.GetWheelX());
+    PutFloat(out, frame.mouse.GetWheelY());
+
+    for (const engine::GamepadState &gamepad : frame.gamepads)
+    {
+        out.push_back(gamepad.IsConnected() ? 1 : 0);
+        for (size_t i = 1; i < kGamepadButtonCount; ++i)
+        {
+            engine::GamepadButton button = static_cast<engine::GamepadButton>(i);
+            out.push_back(PackState(gamepad.IsButtonDown(button), gamepad.IsButtonPressed(button),
+                                    gamepad.IsButtonReleased(button)));
+        }
+        for (size_t i = 0; i < kGamepadAxisCount; ++i)
+        {
+            engine::GamepadAxis axis = static_cast<engine::GamepadAxis>(i);
+            PutFloat(out, gamepad.GetAxis(axis));
+            PutFloat(out, gamepad.GetAxisPrevious(axis));
+        }
+    }
+}
+
+void RestoreFrame(const std::vector<Uint8> &record, InputFrame &frame)
+{
+    const Uint8 *cursor = record.data();
+    frame.quit_requested = *cursor++ != 0;
+
+    frame.keyboard.Reset();
+    for (size_t i = 1; i < kKeyCount; ++i)
+    {
+        Uint8 state = *cursor++;
+        frame.keyboard.SetKeyState(static_cast<engine::Key>(i), (state & kStateDown) != 0,
+                                   (state & kStatePressed) != 0, (state & kStateReleased) != 0);
+    }
+
+    frame.mouse.Reset();
+    for (size_t i = 1; i < kMouseButtonCount; ++i)
+    {
+        Uint8 state = *cursor++;
+        frame.mouse.SetButtonState(static_cast<engine::MouseButton>(i), (state & kStateDown) != 0,
+                                   (state & kStatePressed) != 0, (state & kStateReleased) != 0);
+    }
+    frame.mouse.SetPosition(GetFloat(cursor), GetFloat(cursor + 4));
+    frame.mouse.AddDelta(GetFloat(cursor + 8), GetFloat(cursor + 12));
+    frame.mouse.AddWheel(GetFloat(cursor + 16), GetFloat(cursor + 20));
+    cursor += 6 * sizeof(float);
+
+    for (engine::GamepadState &gamepad : frame.gamepads)
+    {
+        gamepad.Reset();
+        gamepad.SetConnected(*cursor++ != 0);
+        for (size_t i = 1; i < kGamepadButtonCount; ++i)
+        {
+            Uint8 state = *cursor++;
+            gamepad.SetButtonState(static_cast<engine::GamepadButton>(i), (state & kStateDown) != 0,
+                                   (state & kStatePressed) != 0, (state & kStateReleased) != 0);
+        }
+        for (size_t i = 0; i < kGamepadAxisCount; ++i)
+        {
+            gamepad.SetAxisState(static_cast<engine::GamepadAxis>(i), GetFloat(cursor), GetFloat(cursor + 4));
+            cursor += 2 * sizeof(float);
+        }
+    }
+}
+
+// Finds the next run of changed bytes at or after from, merging runs separated by short unchanged gaps.
+bool FindChangedSpan(const std::vector<Uint8> &previous, const std::vector<Uint8> &current, size_t from,
+                     size_t *begin, size_t *end)
+{
+    size_t size = current.size();
+    size_t i = from;
+    while (i < size && previous[i] == current[i])
+    {
+        ++i;
+    }
+    if (i == size)
+    {
+        return false;
+    }
+
+    *begin = i;
+    *end = i + 1;
+    for (;;)
+    {
+        size_t next = *end;
+        while (next < size && previous[next] == current[next])
+        {
+            ++next;
+        }
+        if (next == size || next - *end > kMaxMergedGap)
+        {
+            return true;
+        }
+        *end = next + 1;
+    }
+}
+
+} // namespace
+
+namespace engine
+{
+
+InputRecorder::InputRecorder(const char *path, Uint32 tick_hz, Uint64 seed)
+    : file(nullptr), previous(kRecordSize, 0), current(), encoded(), frame_count(0)
+{
+    if (!path || !*path)
+    {
+        throw std::runtime_error("InputRecorder requires a non-empty path");
+    }
+    file = std::fopen(path, "wb");
+    if (!file)
+    {
+        throw std::runtime_error(std::string("InputRecorder failed to open ") + path);
+    }
+
+    // The stream starts from a zeroed record, which is what a fresh InputFrame flattens to.
+    encoded.assign(kMagic, kMagic + sizeof(kMagic));
+    PutU32(encoded, kVersion);
+    PutU32(encoded, static_cast<Uint32>(kRecordSize));
+    PutU32(encoded, tick_hz);
+    PutU64(encoded, seed);
+    if (std::fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size())
+    {
+        std::fclose(file);
+        throw std::runtime_error(std::string("InputRecorder failed to write header to ") + path);
+    }
+    current.reserve(kRecordSize);
+}
+
+InputRecorder::~InputRecorder()
+{
+    if (file)
+    {
+        std::fclose(file);
+    }
+}
+
+void InputRecorder::Write(const ::leo::Engine::InputFrame &frame)
+{
+    FlattenFrame(frame, current);
+
+    size_t span_count = 0;
+    size_t begin = 0;
+    size_t end = 0;
+    for (size_t from = 0; FindChangedSpan(previous, current, from, &begin, &end); from = end)
+    {
+        span_count++;
+    }
+
+    encoded.clear();
+    PutVarint(encoded, span_count);
+    size_t position = 0;
+    for (size_t from = 0; FindChangedSpan(previous, current, from, &begin, &end); from = end)
+    {
+        PutVarint(encoded, begin - position);
+        PutVarint(encoded, end - begin);
+        encoded.insert(encoded.end(), current.begin() + static_cast<std::ptrdiff_t>(begin),
+                       current.begin() + static_cast<std::ptrdiff_t>(end));
+        position = end;
+    }
+
+    if (std::fwrite(encoded.data(), 1, encoded.size(), file) != encoded.size())
+    {
+        throw std::runtime_error("InputRecorder::Write failed to write to the input stream");
+    }
+    previous.swap(current);
+    frame_count++;
+}
+
+Uint32 InputRecorder::GetFrameCount() const noexcept
+{
+    return frame_count;
+}
+
+InputPlayback::InputPlayback(const char *path)
+    : data(), offset(kHeaderSize), current(kRecordSize, 0), tick_hz(0), seed(0), frame_count(0)
+{
+    if (!path || !*path)
+    {
+        throw std::runtime_error("InputPlayback requires a non-empty path");
+    }
+    std::FILE *file = std::fopen(path, "rb");
+    if (!file)
+    {
+        throw std::runtime_error(std::string("InputPlayback failed to open ") + path);
+    }
+    Uint8 chunk[4096];
+    size_t read = 0;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+
+    if (data.size() < kHeaderSize || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0)
+    {
+        throw std::runtime_error(std::string("InputPlayback: not an input recording: ") + path);
+    }
+    if (GetU32(data.data() + 4) != kVersion)
+    {
+        throw std::runtime_error(std::string("InputPlayback: unsupported recording version in ") + path);
+    }
+    if (GetU32(data.data() + 8) != kRecordSize)
+    {
+        throw std::runtime_error(std::string("InputPlayback: recording uses a different input layout: ") + path);
+    }
+    tick_hz = GetU32(data.data() + 12);
+    seed = GetU64(data.data() + 16);
+    if (tick_hz == 0)
+    {
+        throw std::runtime_error(std::string("InputPlayback: recording has no tick rate: ") + path);
+    }
+}
+
+bool InputPlayback::Read(::leo::Engine::InputFrame &frame)
+{
+    if (offset >= data.size())
+    {
+        return false;
+    }
+
+    size_t span_count = 0;
+    if (!GetVarint(data, &offset, &span_count))
+    {
+        throw std::runtime_error("InputPlayback::Read found a truncated tick");
+    }
+    size_t position = 0;
+    for (size_t i = 0; i < span_count; ++i)
+    {
+        size_t skip = 0;
+        size_t length = 0;
+        if (!GetVarint(data, &offset, &skip) || !GetVarint(data, &offset, &length))
+        {
+            throw std::runtime_error("InputPlayback::Read found a truncated tick");
+        }
+        position += skip;
+        if (position > kRecordSize || length > kRecordSize - position || length > data.size() - offset)
+        {
+            throw std::runtime_error("InputPlayback::Read found a corrupt tick");
+        }
+        std::memcpy(current.data() + position, data.data() + offset, length);
+        position += length;
+        offset += length;
+    }
+
+    RestoreFrame(current, frame);
+    frame.frame_index = frame_count;
+    frame_count++;
+    return true;
+}
+
+Uint32 InputPlayback::GetTickHz() const noexcept
+{
+    return tick_hz;
+}
+
+Uint64 InputPlayback::GetSeed() const noexcept
+{
+    return seed;
+}
+
+Uint32 InputPlayback::GetFrameCount() const noexcept
+{
+    return frame_count;
+}
+
+} // namespace engine
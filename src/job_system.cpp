@@ -0,0 +1,329 @@
+#include "leo/job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace engine
+{
+
+struct JobState
+{
+    std::function<void()> fn;
+    std::atomic<int> remaining{1};
+    std::atomic<bool> done{false};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::vector<std::shared_ptr<JobState>> dependents;
+    std::exception_ptr error;
+};
+
+} // namespace engine
+
+namespace
+{
+
+// Waiters re-check the queues at this interval so a blocked thread keeps helping with new work.
+constexpr std::chrono::milliseconds kWaitPollInterval(1);
+
+thread_local const engine::JobSystem *t_system = nullptr;
+thread_local Uint32 t_worker_index = 0;
+
+} // namespace
+
+namespace engine
+{
+
+bool JobHandle::IsDone() const noexcept
+{
+    return !state || state->done.load(std::memory_order_acquire);
+}
+
+JobHandle::JobHandle(std::shared_ptr<JobState> state) noexcept : state(std::move(state))
+{
+}
+
+JobSystem::JobSystem(Uint32 worker_count)
+    : queues(), inject_mutex(), injected(), queued_count(0), sleep_mutex(), wake(), stopping(false), threads()
+{
+    queues.reserve(worker_count);
+    for (Uint32 i = 0; i < worker_count; ++i)
+    {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    threads.reserve(worker_count);
+    for (Uint32 i = 0; i < worker_count; ++i)
+    {
+        threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+Uint32 JobSystem::GetDefaultWorkerCount() noexcept
+{
+    return static_cast<Uint32>(std::max(SDL_GetNumLogicalCPUCores() - 1, 1));
+}
+
+JobHandle JobSystem::Schedule(std::function<void()> job, std::span<const JobHandle> dependencies)
+{
+    auto state = std::make_shared<JobState>();
+    state->fn = std::move(job);
+    state->remaining.store(static_cast<int>(dependencies.size()) + 1, std::memory_order_relaxed);
+
+    for (const JobHandle &dependency : dependencies)
+    {
+        bool pending = false;
+        if (dependency.state)
+        {
+            std::lock_guard<std::mutex> lock(dependency.state->mutex);
+            if (!dependency.state->done.load(std::memory_order_relaxed))
+            {
+                dependency.state->dependents.push_back(state);
+                pending = true;
+            }
+        }
+        if (!pending)
+        {
+            state->remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    // Drop the scheduling reference; whoever brings the count to zero queues the job.
+    if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        if (threads.empty())
+        {
+            Run(state);
+        }
+        else
+        {
+            Enqueue(state);
+        }
+    }
+    return JobHandle(std::move(state));
+}
+
+JobHandle JobSystem::Schedule(std::function<void()> job, std::initializer_list<JobHandle> dependencies)
+{
+    return Schedule(std::move(job), std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+}
+
+void JobSystem::Wait(const JobHandle &handle)
+{
+    const std::shared_ptr<JobState> &state = handle.state;
+    if (!state)
+    {
+        return;
+    }
+
+    while (!state->done.load(std::memory_order_acquire))
+    {
+        if (std::shared_ptr<JobState> job = TakeJob())
+        {
+            Run(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait_for(lock, kWaitPollInterval,
+                                 [&state]() { return state->done.load(std::memory_order_acquire); });
+    }
+
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)> &body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    if (threads.empty() || count <= grain)
+    {
+        body(0, count);
+        return;
+    }
+
+    // The calling thread takes the first chunk itself.
+    std::vector<JobHandle> handles;
+    handles.reserve(count / grain);
+    for (size_t begin = grain; begin < count; begin += grain)
+    {
+        size_t end = std::min(begin + grain, count);
+        handles.push_back(Schedule([&body, begin, end]() { body(begin, end); }));
+    }
+
+    std::exception_ptr error;
+    try
+    {
+        body(0, grain);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    for (const JobHandle &handle : handles)
+    {
+        try
+        {
+            Wait(handle);
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+Uint32 JobSystem::GetWorkerCount() const noexcept
+{
+    return static_cast<Uint32>(threads.size());
+}
+
+void JobSystem::WorkerLoop(Uint32 index)
+{
+    t_system = this;
+    t_worker_index = index;
+    for (;;)
+    {
+        if (std::shared_ptr<JobState> job = TakeJob())
+        {
+            Run(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this]() { return stopping || queued_count.load(std::memory_order_acquire) > 0; });
+        if (stopping && queued_count.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+    }
+}
+
+void JobSystem::Enqueue(std::shared_ptr<JobState> job)
+{
+    if (t_system == this)
+    {
+        WorkerQueue &queue = *queues[t_worker_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(inject_mutex);
+        injected.push_back(std::move(job));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        queued_count.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+std::shared_ptr<JobState> JobSystem::TakeJob()
+{
+    std::shared_ptr<JobState> job;
+    size_t queue_count = queues.size();
+    bool on_worker = t_system == this;
+
+    // Newest job from our own deque first: it is the most likely to still be in cache.
+    if (on_worker)
+    {
+        WorkerQueue &own = *queues[t_worker_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+    if (!job)
+    {
+        std::lock_guard<std::mutex> lock(inject_mutex);
+        if (!injected.empty())
+        {
+            job = std::move(injected.front());
+            injected.pop_front();
+        }
+    }
+    // Steal the oldest job from another worker, starting with our neighbour.
+    for (size_t offset = 1; !job && offset <= queue_count; ++offset)
+    {
+        size_t victim = ((on_worker ? t_worker_index : 0) + offset) % queue_count;
+        WorkerQueue &queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+    }
+
+    if (job)
+    {
+        queued_count.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return job;
+}
+
+void JobSystem::Run(const std::shared_ptr<JobState> &job)
+{
+    try
+    {
+        job->fn();
+    }
+    catch (...)
+    {
+        job->error = std::current_exception();
+    }
+    job->fn = nullptr;
+
+    std::vector<std::shared_ptr<JobState>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done.store(true, std::memory_order_release);
+        dependents.swap(job->dependents);
+    }
+    job->finished.notify_all();
+
+    for (std::shared_ptr<JobState> &dependent : dependents)
+    {
+        if (dependent->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            if (threads.empty())
+            {
+                Run(dependent);
+            }
+            else
+            {
+                Enqueue(std::move(dependent));
+            }
+        }
+    }
+}
+
+} // namespace engine
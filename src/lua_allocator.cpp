@@ -0,0 +1,165 @@
+#include "leo/lua_allocator.h"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+constexpr size_t SizeClass(size_t size, size_t granularity) noexcept
+{
+    return (size - 1) / granularity;
+}
+
+} // namespace
+
+namespace engine
+{
+
+LuaAllocator::LuaAllocator(const Config &config) noexcept
+    : malloc_fn(config.malloc_fn ? config.malloc_fn : SDL_malloc),
+      realloc_fn(config.realloc_fn ? config.realloc_fn : SDL_realloc),
+      free_fn(config.free_fn ? config.free_fn : SDL_free), free_lists(), slabs(nullptr), slab_cursor(nullptr),
+      slab_remaining(0), stats()
+{
+    free_lists.fill(nullptr);
+}
+
+LuaAllocator::~LuaAllocator()
+{
+    while (slabs)
+    {
+        FreeBlock *next = slabs->next;
+        free_fn(slabs);
+        slabs = next;
+    }
+}
+
+void *LuaAllocator::Allocate(void *user_data, void *ptr, size_t old_size, size_t new_size) noexcept
+{
+    // For a new block Lua passes the object type in old_size rather than a size.
+    return static_cast<LuaAllocator *>(user_data)->Reallocate(ptr, ptr ? old_size : 0, new_size);
+}
+
+LuaMemoryStats LuaAllocator::GetStats() const noexcept
+{
+    return stats;
+}
+
+void *LuaAllocator::Reallocate(void *ptr, size_t old_size, size_t new_size) noexcept
+{
+    const bool old_pooled = ptr && old_size <= kMaxPooledSize;
+    if (new_size == 0)
+    {
+        if (ptr)
+        {
+            if (old_pooled)
+            {
+                FreePooled(ptr, SizeClass(old_size, kGranularity));
+            }
+            else
+            {
+                free_fn(ptr);
+            }
+            stats.live_bytes -= old_size;
+            stats.live_blocks--;
+        }
+        return nullptr;
+    }
+
+    void *result = nullptr;
+    const bool new_pooled = new_size <= kMaxPooledSize;
+    if (ptr && old_pooled && new_pooled &&
+        SizeClass(old_size, kGranularity) == SizeClass(new_size, kGranularity))
+    {
+        result = ptr;
+    }
+    else if (ptr && !old_pooled && !new_pooled)
+    {
+        result = realloc_fn(ptr, new_size);
+        if (!result)
+        {
+            return nullptr;
+        }
+    }
+    else
+    {
+        result = new_pooled ? AllocatePooled(SizeClass(new_size, kGranularity)) : malloc_fn(new_size);
+        if (!result)
+        {
+            return nullptr;
+        }
+        stats.allocation_count++;
+        if (ptr)
+        {
+            std::memcpy(result, ptr, std::min(old_size, new_size));
+            if (old_pooled)
+            {
+                FreePooled(ptr, SizeClass(old_size, kGranularity));
+            }
+            else
+            {
+                free_fn(ptr);
+            }
+        }
+    }
+
+    if (!ptr)
+    {
+        stats.live_blocks++;
+    }
+    if (new_size > old_size)
+    {
+        stats.allocated_bytes += new_size - old_size;
+    }
+    stats.live_bytes = stats.live_bytes - old_size + new_size;
+    return result;
+}
+
+void *LuaAllocator::AllocatePooled(size_t size_class) noexcept
+{
+    FreeBlock *block = free_lists[size_class];
+    if (block)
+    {
+        free_lists[size_class] = block->next;
+        return block;
+    }
+
+    const size_t block_size = (size_class + 1) * kGranularity;
+    if (slab_remaining < block_size)
+    {
+        Uint8 *slab = static_cast<Uint8 *>(malloc_fn(kSlabSize));
+        if (!slab)
+        {
+            return nullptr;
+        }
+        // Slabs are chained through their first block so the list needs no allocations of its own.
+        static_cast<FreeBlock *>(static_cast<void *>(slab))->next = slabs;
+        slabs = static_cast<FreeBlock *>(static_cast<void *>(slab));
+        // The tail of the previous slab is too small for this class; hand it to the classes it fits.
+        while (slab_remaining >= kGranularity)
+        {
+            size_t tail_class = std::min(SizeClass(slab_remaining, kGranularity), kClassCount - 1);
+            FreePooled(slab_cursor, tail_class);
+            slab_cursor += (tail_class + 1) * kGranularity;
+            slab_remaining -= (tail_class + 1) * kGranularity;
+        }
+        slab_cursor = slab + kGranularity;
+        slab_remaining = kSlabSize - kGranularity;
+        stats.pool_bytes += kSlabSize;
+    }
+
+    void *result = slab_cursor;
+    slab_cursor += block_size;
+    slab_remaining -= block_size;
+    return result;
+}
+
+void LuaAllocator::FreePooled(void *ptr, size_t size_class) noexcept
+{
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = free_lists[size_class];
+    free_lists[size_class] = block;
+}
+
+} // namespace engine
@@ -1,13 +1,21 @@
 #include "leo/lua_runtime.h"
+#include "leo/asset_loader.h"
 #include "leo/audio.h"
+#include "leo/buffer_kernels.h"
 #include "leo/camera.h"
+#include "leo/canvas.h"
 #include "leo/collision.h"
 #include "leo/engine_core.h"
 #include "leo/font.h"
 #include "leo/gamepad.h"
 #include "leo/graphics.h"
+#include "leo/job_system.h"
 #include "leo/keyboard.h"
 #include "leo/mouse.h"
+#include "leo/profiler.h"
+#include "leo/script_cache.h"
+#include "leo/texture_atlas.h"
+#include "leo/texture_cache.h"
 #include "leo/texture_loader.h"
 #include "leo/tiled_map.h"
 #include "leo/vfs.h"
@@ -15,6 +23,12 @@
 #include <SDL3/SDL_stdinc.h>
 #include <physfs.h>
 #include <lua.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -24,7 +38,12 @@ namespace
 {
 
 constexpr const char *kRuntimeRegistryKey = "leo.runtime";
+// Registry table of task id -> coroutine; it keeps every live leo.task reachable while it waits.
+constexpr const char *kTaskRegistryKey = "leo.tasks";
+constexpr const char *kModulePath = "?.lua;?/init.lua";
+constexpr const char *kLazyModuleField = "__module";
 constexpr const char *kTextureMeta = "leo.texture";
+constexpr const char *kAtlasMeta = "leo.atlas";
 constexpr const char *kFontMeta = "leo.font";
 constexpr const char *kSoundMeta = "leo.sound";
 constexpr const char *kMusicMeta = "leo.music";
@@ -34,6 +53,37 @@ constexpr const char *kGamepadMeta = "leo.gamepad";
 constexpr const char *kCameraMeta = "leo.camera";
 constexpr const char *kTiledMapMeta = "leo.tiled_map";
 constexpr const char *kAnimationMeta = "leo.animation";
+constexpr const char *kFutureMeta = "leo.future";
+constexpr const char *kBufferMeta = "leo.buffer";
+// Keeps the userdata size computation far from overflow; 256M elements is 1 GiB of data.
+constexpr lua_Integer kMaxBufferLength = lua_Integer(1) << 28;
+// Above what any current GPU accepts for a texture side; SDL reports the real limit when creation fails.
+constexpr lua_Integer kMaxCanvasSize = 16384;
+constexpr Uint64 kDefaultAssetBudgetUs = 2000;
+constexpr Uint64 kDefaultGcBudgetUs = 1000;
+// Heap growth, in percent of the live size after a collection, before the engine starts the next one. These match
+// Lua's defaults: a new incremental cycle once the heap doubles, a minor collection after 20% growth.
+constexpr size_t kGcIncrementalPausePercent = 100;
+constexpr size_t kGcGenerationalPausePercent = 20;
+// Once the engine paces collection, Lua's own allocation-driven collector only runs as a backstop, at twice the
+// engine's trigger, so a frame that allocates heavily cannot grow the heap without bound before the next step.
+// LUA_GCINC's pause is the heap size in percent of the live size; LUA_GCGEN's minor multiplier is the growth.
+constexpr int kGcBackstopIncrementalPause = static_cast<int>(2 * (100 + kGcIncrementalPausePercent));
+constexpr int kGcBackstopGenerationalMinor = static_cast<int>(2 * (100 + kGcGenerationalPausePercent) - 100);
+constexpr int kMaxAssetWorkers = 4;
+
+// Sets the collector mode, with Lua's default parameters or, once the engine paces collection, the backstop ones.
+void ApplyGcMode(lua_State *L, engine::GcMode mode, bool paced)
+{
+    if (mode == engine::GcMode::Generational)
+    {
+        lua_gc(L, LUA_GCGEN, paced ? kGcBackstopGenerationalMinor : 0, 0);
+    }
+    else
+    {
+        lua_gc(L, LUA_GCINC, paced ? kGcBackstopIncrementalPause : 0, 0, 0);
+    }
+}
 
 struct AnimationFrame
 {
@@ -46,9 +96,38 @@ struct AnimationFrame
 
 struct LuaTexture
 {
-    engine::Texture texture;
+    std::shared_ptr<engine::Texture> texture;
+};
+
+struct LuaAtlas
+{
+    engine::TextureAtlas atlas;
 };
 
+enum class BufferType
+{
+    Float,
+    Int
+};
+
+// Header of a leo.buffer userdata; length 32-bit elements follow it in the same allocation, so buffers need no
+// finalizer and cost the GC a single object.
+struct LuaBuffer
+{
+    BufferType type;
+    size_t length;
+};
+
+float *GetBufferFloats(LuaBuffer *buffer)
+{
+    return reinterpret_cast<float *>(buffer + 1);
+}
+
+Sint32 *GetBufferInts(LuaBuffer *buffer)
+{
+    return reinterpret_cast<Sint32 *>(buffer + 1);
+}
+
 struct LuaFont
 {
     engine::Font font;
@@ -65,6 +144,36 @@ struct LuaMusic
     engine::Music music;
 };
 
+// Intermediate and final state of one asynchronous load. The decode step fills the CPU-side fields on a worker
+// thread; the finish step turns them into the engine object on the main thread.
+struct AsyncAsset
+{
+    enum class Kind
+    {
+        Image,
+        Font,
+        Sound
+    };
+
+    Kind kind;
+    std::string path;
+    int font_size;
+    bool cached;
+    engine::DecodedImage image;
+    engine::FontBitmap bitmap;
+    std::shared_ptr<engine::SoundSample> sample;
+    std::shared_ptr<engine::Texture> texture;
+    engine::Font font;
+    engine::Sound sound;
+};
+
+struct LuaFuture
+{
+    std::shared_ptr<engine::AssetRequest> request;
+    std::shared_ptr<AsyncAsset> asset;
+    int value_ref;
+};
+
 struct LuaKeyboard
 {
     engine::KeyboardState state;
@@ -92,10 +201,7 @@ struct LuaTiledMap
 
 struct LuaAnimation
 {
-    engine::Texture texture;
-    engine::Texture *texture_ptr;
-    bool owns_texture;
-    int texture_ref;
+    std::shared_ptr<engine::Texture> texture;
     std::vector<AnimationFrame> frames;
     size_t frame_index;
     float frame_time;
@@ -104,6 +210,37 @@ struct LuaAnimation
     float speed;
 };
 
+// Leave a core for the main thread; asset decoding is bursty, so a few workers are plenty.
+Uint32 ResolveAssetWorkers()
+{
+    return static_cast<Uint32>(std::clamp(SDL_GetNumLogicalCPUCores() - 1, 1, kMaxAssetWorkers));
+}
+
+// Recorded and replayed runs must see every async load complete on the same tick, so their decodes run inline in
+// submission order and UpdateAssets finishes everything pending, with no worker timing or time budget involved.
+bool HasDeterministicAssets(const engine::Config &config)
+{
+    return (config.record_path && *config.record_path) || (config.replay_path && *config.replay_path);
+}
+
+// Takes the error a failed load, pcall or resume left on top of the stack. Scripts may raise any value, and
+// lua_tostring returns null for anything but strings and numbers, so other values are described by type as lua.c does.
+std::string PopError(lua_State *L)
+{
+    const char *message = lua_tostring(L, -1);
+    std::string error = message ? message : std::string("(error object is a ") + luaL_typename(L, -1) + " value)";
+    lua_pop(L, 1);
+    return error;
+}
+
+// lua_newstate installs no panic handler; log the error before Lua aborts.
+int LuaPanic(lua_State *L)
+{
+    const char *message = lua_tostring(L, -1);
+    SDL_LogCritical(SDL_LOG_CATEGORY_APPLICATION, "Unprotected Lua error: %s", message ? message : "(no message)");
+    return 0;
+}
+
 engine::LuaRuntime *GetRuntime(lua_State *L)
 {
     lua_getfield(L, LUA_REGISTRYINDEX, kRuntimeRegistryKey);
@@ -526,6 +663,38 @@ LuaTexture *CheckTexture(lua_State *L, int index)
     return static_cast<LuaTexture *>(luaL_checkudata(L, index, kTextureMeta));
 }
 
+LuaAtlas *CheckAtlas(lua_State *L, int index)
+{
+    return static_cast<LuaAtlas *>(luaL_checkudata(L, index, kAtlasMeta));
+}
+
+LuaBuffer *CheckBuffer(lua_State *L, int index)
+{
+    return static_cast<LuaBuffer *>(luaL_checkudata(L, index, kBufferMeta));
+}
+
+LuaBuffer *CheckFloatBuffer(lua_State *L, int index)
+{
+    LuaBuffer *buffer = CheckBuffer(L, index);
+    luaL_argcheck(L, buffer->type == BufferType::Float, index, "expected a float buffer");
+    return buffer;
+}
+
+LuaBuffer *CheckIntBuffer(lua_State *L, int index)
+{
+    LuaBuffer *buffer = CheckBuffer(L, index);
+    luaL_argcheck(L, buffer->type == BufferType::Int, index, "expected an int buffer");
+    return buffer;
+}
+
+// Element count for an optional count argument over data that holds available elements.
+size_t CheckBufferCount(lua_State *L, int index, size_t available)
+{
+    lua_Integer count = luaL_optinteger(L, index, static_cast<lua_Integer>(available));
+    luaL_argcheck(L, count >= 0 && static_cast<size_t>(count) <= available, index, "count exceeds the buffer length");
+    return static_cast<size_t>(count);
+}
+
 LuaAnimation *CheckAnimation(lua_State *L, int index)
 {
     return static_cast<LuaAnimation *>(luaL_checkudata(L, index, kAnimationMeta));
@@ -805,6 +974,11 @@ LuaSound *CheckSound(lua_State *L, int index)
     return static_cast<LuaSound *>(luaL_checkudata(L, index, kSoundMeta));
 }
 
+LuaFuture *CheckFuture(lua_State *L, int index)
+{
+    return static_cast<LuaFuture *>(luaL_checkudata(L, index, kFutureMeta));
+}
+
 LuaMusic *CheckMusic(lua_State *L, int index)
 {
     return static_cast<LuaMusic *>(luaL_checkudata(L, index, kMusicMeta));
@@ -832,9 +1006,45 @@ int LuaGraphicsNewImage(lua_State *L)
 
     try
     {
-        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer());
+        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer(), runtime->GetTextureCache());
+        std::shared_ptr<engine::Texture> texture = loader.Acquire(path);
+        LuaTexture *ud = static_cast<LuaTexture *>(lua_newuserdata(L, sizeof(LuaTexture)));
+        new (&ud->texture) std::shared_ptr<engine::Texture>(std::move(texture));
+        luaL_getmetatable(L, kTextureMeta);
+        lua_setmetatable(L, -2);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+}
+
+int LuaGraphicsNewCanvas(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    lua_Integer width = luaL_checkinteger(L, 1);
+    lua_Integer height = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, width > 0 && width <= kMaxCanvasSize, 1, "canvas width out of range");
+    luaL_argcheck(L, height > 0 && height <= kMaxCanvasSize, 2, "canvas height out of range");
+    bool preserve = false;
+    if (!lua_isnoneornil(L, 3))
+    {
+        luaL_checktype(L, 3, LUA_TTABLE);
+        lua_getfield(L, 3, "preserve");
+        if (!lua_isnil(L, -1))
+        {
+            preserve = lua_toboolean(L, -1);
+        }
+        lua_pop(L, 1);
+    }
+
+    try
+    {
+        std::shared_ptr<engine::Texture> texture =
+            runtime->CreateCanvas(static_cast<int>(width), static_cast<int>(height), preserve);
         LuaTexture *ud = static_cast<LuaTexture *>(lua_newuserdata(L, sizeof(LuaTexture)));
-        new (&ud->texture) engine::Texture(loader.Load(path));
+        new (&ud->texture) std::shared_ptr<engine::Texture>(std::move(texture));
         luaL_getmetatable(L, kTextureMeta);
         lua_setmetatable(L, -2);
         return 1;
@@ -845,10 +1055,116 @@ int LuaGraphicsNewImage(lua_State *L)
     }
 }
 
+int LuaGraphicsSetCanvas(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const engine::Texture *target = nullptr;
+    if (!lua_isnoneornil(L, 1))
+    {
+        LuaTexture *ud = CheckTexture(L, 1);
+        target = ud->texture.get();
+        if (!target)
+        {
+            return luaL_argerror(L, 1, "canvas has been released");
+        }
+    }
+
+    try
+    {
+        runtime->SetCanvas(target);
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+    return 0;
+}
+
+// newAtlas(dir | {path, ...} [, {page_size = 2048, padding = 1}])
+int LuaGraphicsNewAtlas(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    std::vector<std::string> paths;
+    const char *dir = nullptr;
+    if (lua_istable(L, 1))
+    {
+        lua_Integer count = static_cast<lua_Integer>(lua_rawlen(L, 1));
+        for (lua_Integer i = 1; i <= count; ++i)
+        {
+            lua_rawgeti(L, 1, i);
+            const char *path = lua_tostring(L, -1);
+            if (!path)
+            {
+                return luaL_error(L, "leo.graphics.newAtlas: paths[%d] is not a string", static_cast<int>(i));
+            }
+            paths.emplace_back(path);
+            lua_pop(L, 1);
+        }
+    }
+    else
+    {
+        dir = luaL_checkstring(L, 1);
+    }
+
+    engine::TextureAtlasOptions options;
+    if (!lua_isnoneornil(L, 2))
+    {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        options.page_size = GetTableIntFieldOpt(L, 2, "page_size", options.page_size);
+        options.padding = GetTableIntFieldOpt(L, 2, "padding", options.padding);
+    }
+
+    try
+    {
+        if (dir)
+        {
+            paths = engine::TextureAtlas::ListImages(runtime->GetVfs(), dir);
+            if (paths.empty())
+            {
+                return luaL_error(L, "leo.graphics.newAtlas: no images under '%s'", dir);
+            }
+        }
+
+        engine::TextureAtlas atlas = engine::TextureAtlas::Build(runtime->GetVfs(), runtime->GetRenderer(), paths,
+                                                                 options, runtime->GetJobSystem());
+        // Later newImage, animation and tileset loads of these paths get the sub-images. Replaced entries may be
+        // queued on the batch with no other owner.
+        if (engine::TextureCache *cache = runtime->GetTextureCache())
+        {
+            runtime->FlushSprites();
+            for (const auto &[path, texture] : atlas.GetImages())
+            {
+                cache->Insert(path.c_str(), texture);
+            }
+        }
+
+        LuaAtlas *ud = static_cast<LuaAtlas *>(lua_newuserdata(L, sizeof(LuaAtlas)));
+        new (&ud->atlas) engine::TextureAtlas(std::move(atlas));
+        luaL_getmetatable(L, kAtlasMeta);
+        lua_setmetatable(L, -2);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+}
+
+// SDL cannot sample the texture it is rendering into, so a canvas drawn into itself would draw garbage.
+void CheckNotCanvasTarget(lua_State *L, const engine::LuaRuntime *runtime,
+                          const std::shared_ptr<engine::Texture> &texture, const char *name)
+{
+    if (texture && runtime->IsCanvasTarget(*texture))
+    {
+        luaL_error(L, "%s cannot draw the active canvas into itself", name);
+    }
+}
+
 int LuaGraphicsDraw(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
     LuaTexture *ud = CheckTexture(L, 1);
+    CheckNotCanvasTarget(L, runtime, ud->texture, "leo.graphics.draw");
     double x = luaL_checknumber(L, 2);
     double y = luaL_checknumber(L, 3);
     double angle = luaL_optnumber(L, 4, 0.0);
@@ -857,7 +1173,7 @@ int LuaGraphicsDraw(lua_State *L)
     double ox = luaL_optnumber(L, 7, 0.0);
     double oy = luaL_optnumber(L, 8, 0.0);
 
-    if (!ud->texture.handle)
+    if (!ud->texture || !ud->texture->handle)
     {
         return 0;
     }
@@ -868,24 +1184,22 @@ int LuaGraphicsDraw(lua_State *L)
     double render_angle = ApplyCameraRotation(camera, static_cast<float>(angle));
 
     SDL_Color color = runtime->GetDrawColor();
-    SDL_SetTextureColorMod(ud->texture.handle, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(ud->texture.handle, color.a);
 
     float render_sx = static_cast<float>(sx) * zoom;
     float render_sy = static_cast<float>(sy) * zoom;
-    float w = static_cast<float>(ud->texture.width) * render_sx;
-    float h = static_cast<float>(ud->texture.height) * render_sy;
+    float w = static_cast<float>(ud->texture->width) * render_sx;
+    float h = static_cast<float>(ud->texture->height) * render_sy;
     SDL_FRect dst = {screen.x - static_cast<float>(ox * render_sx), screen.y - static_cast<float>(oy * render_sy), w,
                      h};
     SDL_FPoint center = {static_cast<float>(ox * render_sx), static_cast<float>(oy * render_sy)};
-    constexpr double kRadToDeg = 57.29577951308232;
-    double degrees = render_angle * kRadToDeg;
-
-    SDL_RenderTextureRotated(runtime->GetRenderer(), ud->texture.handle, nullptr, &dst, degrees, &center,
-                             SDL_FLIP_NONE);
-
-    SDL_SetTextureColorMod(ud->texture.handle, 255, 255, 255);
-    SDL_SetTextureAlphaMod(ud->texture.handle, 255);
+    SDL_FRect src = {0.0f, 0.0f, static_cast<float>(ud->texture->width), static_cast<float>(ud->texture->height)};
+
+    runtime->GetSpriteBatch().Draw(*ud->texture, {.src = src,
+                                                 .dst = dst,
+                                                 .center = center,
+                                                 .angle = render_angle,
+                                                 .flip = SDL_FLIP_NONE,
+                                                 .color = color});
     return 0;
 }
 
@@ -893,6 +1207,7 @@ int LuaGraphicsDrawEx(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
     LuaTexture *ud = CheckTexture(L, 1);
+    CheckNotCanvasTarget(L, runtime, ud->texture, "leo.graphics.drawEx");
     double src_x = luaL_checknumber(L, 2);
     double src_y = luaL_checknumber(L, 3);
     double src_w = luaL_checknumber(L, 4);
@@ -907,7 +1222,7 @@ int LuaGraphicsDrawEx(lua_State *L)
     bool flip_x = lua_toboolean(L, 13);
     bool flip_y = lua_toboolean(L, 14);
 
-    if (!ud->texture.handle || src_w <= 0.0 || src_h <= 0.0)
+    if (!ud->texture || !ud->texture->handle || src_w <= 0.0 || src_h <= 0.0)
     {
         return 0;
     }
@@ -935,9 +1250,6 @@ int LuaGraphicsDrawEx(lua_State *L)
         color = {clamp(r), clamp(g), clamp(b), clamp(a)};
     }
 
-    SDL_SetTextureColorMod(ud->texture.handle, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(ud->texture.handle, color.a);
-
     float render_sx = static_cast<float>(sx) * zoom;
     float render_sy = static_cast<float>(sy) * zoom;
     float w = static_cast<float>(src_w) * render_sx;
@@ -947,8 +1259,6 @@ int LuaGraphicsDrawEx(lua_State *L)
     SDL_FRect dst = {screen.x - static_cast<float>(ox * render_sx), screen.y - static_cast<float>(oy * render_sy), w,
                      h};
     SDL_FPoint center = {static_cast<float>(ox * render_sx), static_cast<float>(oy * render_sy)};
-    constexpr double kRadToDeg = 57.29577951308232;
-    double degrees = render_angle * kRadToDeg;
 
     SDL_FlipMode flip = SDL_FLIP_NONE;
     if (flip_x)
@@ -960,10 +1270,205 @@ int LuaGraphicsDrawEx(lua_State *L)
         flip = static_cast<SDL_FlipMode>(flip | SDL_FLIP_VERTICAL);
     }
 
-    SDL_RenderTextureRotated(runtime->GetRenderer(), ud->texture.handle, &src, &dst, degrees, &center, flip);
+    runtime->GetSpriteBatch().Draw(
+        *ud->texture, {.src = src, .dst = dst, .center = center, .angle = render_angle, .flip = flip, .color = color});
+    return 0;
+}
+
+// Instance layouts accepted by leo.graphics.drawBatch. Each extends the previous one; fields a layout leaves out take
+// the same defaults as leo.graphics.drawEx (whole texture, no rotation, unit scale, current draw color).
+constexpr int kBatchStridePosition = 2;   // x, y
+constexpr int kBatchStrideSource = 6;     // + srcX, srcY, srcW, srcH
+constexpr int kBatchStrideTransform = 11; // + angle, sx, sy, ox, oy
+constexpr int kBatchStrideColor = 15;     // + r, g, b, a
+
+bool IsBatchStride(lua_Integer stride)
+{
+    return stride == kBatchStridePosition || stride == kBatchStrideSource || stride == kBatchStrideTransform ||
+           stride == kBatchStrideColor;
+}
+
+Uint8 ClampColorChannel(float value)
+{
+    if (!(value > 0.0f))
+    {
+        return 0;
+    }
+    return value >= 255.0f ? 255 : static_cast<Uint8>(value);
+}
+
+// Transforms count instances through the active camera and queues them on the sprite batch, which submits runs on
+// the same texture as one geometry call. read(i, fields) fills the first stride fields of instance i.
+template <typename ReadInstance>
+void DrawSpriteInstances(engine::LuaRuntime *runtime, const engine::Texture &texture, int stride, size_t count,
+                         ReadInstance read)
+{
+    const leo::Camera::Camera2D *camera = runtime->GetActiveCamera();
+    const float zoom = camera ? camera->zoom : 1.0f;
+    const SDL_Color draw_color = runtime->GetDrawColor();
+    const float texture_w = static_cast<float>(texture.width);
+    const float texture_h = static_cast<float>(texture.height);
+    engine::SpriteBatch &batch = runtime->GetSpriteBatch();
+
+    float fields[kBatchStrideColor] = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        read(i, fields);
+
+        SDL_FRect src = {0.0f, 0.0f, texture_w, texture_h};
+        if (stride >= kBatchStrideSource)
+        {
+            src = {fields[2], fields[3], fields[4], fields[5]};
+            if (src.w <= 0.0f || src.h <= 0.0f)
+            {
+                continue;
+            }
+        }
+
+        float angle = 0.0f;
+        float sx = 1.0f;
+        float sy = 1.0f;
+        float ox = 0.0f;
+        float oy = 0.0f;
+        if (stride >= kBatchStrideTransform)
+        {
+            angle = fields[6];
+            sx = fields[7];
+            sy = fields[8];
+            ox = fields[9];
+            oy = fields[10];
+        }
+
+        SDL_Color color = draw_color;
+        if (stride >= kBatchStrideColor)
+        {
+            color = {ClampColorChannel(fields[11]), ClampColorChannel(fields[12]), ClampColorChannel(fields[13]),
+                     ClampColorChannel(fields[14])};
+        }
+
+        SDL_FPoint screen = ApplyCameraPoint(camera, {fields[0], fields[1]});
+        float render_sx = sx * zoom;
+        float render_sy = sy * zoom;
+        SDL_FPoint center = {ox * render_sx, oy * render_sy};
+        SDL_FRect dst = {screen.x - center.x, screen.y - center.y, src.w * render_sx, src.h * render_sy};
+        batch.Draw(texture, {.src = src,
+                             .dst = dst,
+                             .center = center,
+                             .angle = ApplyCameraRotation(camera, angle),
+                             .flip = SDL_FLIP_NONE,
+                             .color = color});
+    }
+}
+
+// drawBatch(texture, xs, ys [, count]): whole-texture sprites at positions held in two float buffers.
+int DrawBatchPositions(lua_State *L, engine::LuaRuntime *runtime, const LuaTexture *ud)
+{
+    LuaBuffer *xs = CheckFloatBuffer(L, 2);
+    LuaBuffer *ys = CheckFloatBuffer(L, 3);
+    size_t count = CheckBufferCount(L, 4, std::min(xs->length, ys->length));
+    if (!ud->texture || !ud->texture->handle || count == 0)
+    {
+        return 0;
+    }
+
+    const float *x_data = GetBufferFloats(xs);
+    const float *y_data = GetBufferFloats(ys);
+    DrawSpriteInstances(runtime, *ud->texture, kBatchStridePosition, count, [x_data, y_data](size_t i, float *fields) {
+        fields[0] = x_data[i];
+        fields[1] = y_data[i];
+    });
+    return 0;
+}
+
+// drawBatch(texture, buffer, stride [, count]): instances interleaved in one float buffer.
+int DrawBatchBuffer(lua_State *L, engine::LuaRuntime *runtime, const LuaTexture *ud, int stride)
+{
+    LuaBuffer *instances = CheckFloatBuffer(L, 2);
+    size_t count = CheckBufferCount(L, 4, instances->length / static_cast<size_t>(stride));
+    if (!ud->texture || !ud->texture->handle || count == 0)
+    {
+        return 0;
+    }
+
+    const float *data = GetBufferFloats(instances);
+    DrawSpriteInstances(runtime, *ud->texture, stride, count, [data, stride](size_t i, float *fields) {
+        std::copy_n(data + i * static_cast<size_t>(stride), stride, fields);
+    });
+    return 0;
+}
+
+int LuaGraphicsDrawBatch(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    LuaTexture *ud = CheckTexture(L, 1);
+    CheckNotCanvasTarget(L, runtime, ud->texture, "leo.graphics.drawBatch");
+    if (luaL_testudata(L, 3, kBufferMeta))
+    {
+        return DrawBatchPositions(L, runtime, ud);
+    }
+    if (luaL_testudata(L, 2, kBufferMeta))
+    {
+        lua_Integer buffer_stride = luaL_checkinteger(L, 3);
+        luaL_argcheck(L, IsBatchStride(buffer_stride), 3, "stride must be 2, 6, 11 or 15");
+        return DrawBatchBuffer(L, runtime, ud, static_cast<int>(buffer_stride));
+    }
+    luaL_checktype(L, 2, LUA_TTABLE);
+    lua_Integer stride = luaL_checkinteger(L, 3);
+    luaL_argcheck(L, IsBatchStride(stride), 3, "stride must be 2, 6, 11 or 15");
+    lua_Integer length = static_cast<lua_Integer>(lua_rawlen(L, 2));
+    lua_Integer count = luaL_optinteger(L, 4, length / stride);
+    luaL_argcheck(L, count >= 0 && count <= length / stride, 4, "count exceeds the instance data");
+
+    if (!ud->texture || !ud->texture->handle || count == 0)
+    {
+        return 0;
+    }
+
+    const int field_count = static_cast<int>(stride);
+    DrawSpriteInstances(runtime, *ud->texture, field_count, static_cast<size_t>(count),
+                        [L, field_count](size_t i, float *fields) {
+                            lua_Integer base = static_cast<lua_Integer>(i) * field_count;
+                            for (int k = 0; k < field_count; ++k)
+                            {
+                                lua_rawgeti(L, 2, base + k + 1);
+                                int is_number = 0;
+                                fields[k] = static_cast<float>(lua_tonumberx(L, -1, &is_number));
+                                lua_pop(L, 1);
+                                if (!is_number)
+                                {
+                                    luaL_error(L, "leo.graphics.drawBatch: instance data[%d] is not a number",
+                                               static_cast<int>(base + k + 1));
+                                }
+                            }
+                        });
+    return 0;
+}
+
+int LuaAnimationDrawBatch(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    LuaAnimation *ud = CheckAnimation(L, 1);
+    CheckNotCanvasTarget(L, runtime, ud->texture, "anim:drawBatch");
+    LuaBuffer *xs = CheckFloatBuffer(L, 2);
+    LuaBuffer *ys = CheckFloatBuffer(L, 3);
+    size_t count = CheckBufferCount(L, 4, std::min(xs->length, ys->length));
+    if (!ud->texture || !ud->texture->handle || ud->frames.empty() || count == 0)
+    {
+        return 0;
+    }
 
-    SDL_SetTextureColorMod(ud->texture.handle, 255, 255, 255);
-    SDL_SetTextureAlphaMod(ud->texture.handle, 255);
+    const AnimationFrame &frame = ud->frames[ud->frame_index];
+    const float *x_data = GetBufferFloats(xs);
+    const float *y_data = GetBufferFloats(ys);
+    DrawSpriteInstances(runtime, *ud->texture, kBatchStrideSource, count,
+                        [x_data, y_data, &frame](size_t i, float *fields) {
+                            fields[0] = x_data[i];
+                            fields[1] = y_data[i];
+                            fields[2] = frame.x;
+                            fields[3] = frame.y;
+                            fields[4] = frame.w;
+                            fields[5] = frame.h;
+                        });
     return 0;
 }
 
@@ -974,13 +1479,11 @@ int LuaAnimationNew(lua_State *L)
 
     try
     {
-        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer());
+        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer(), runtime->GetTextureCache());
+        std::shared_ptr<engine::Texture> texture = loader.Acquire(path);
         LuaAnimation *ud = static_cast<LuaAnimation *>(lua_newuserdata(L, sizeof(LuaAnimation)));
         new (ud) LuaAnimation{};
-        ud->texture = loader.Load(path);
-        ud->texture_ptr = &ud->texture;
-        ud->owns_texture = true;
-        ud->texture_ref = LUA_NOREF;
+        ud->texture = std::move(texture);
         InitAnimationState(ud);
         ApplyAnimationFlags(L, ud, 2, 3);
         luaL_getmetatable(L, kAnimationMeta);
@@ -998,15 +1501,10 @@ int LuaAnimationNewFromTexture(lua_State *L)
     LuaTexture *tex = CheckTexture(L, 1);
     LuaAnimation *ud = static_cast<LuaAnimation *>(lua_newuserdata(L, sizeof(LuaAnimation)));
     new (ud) LuaAnimation{};
-    ud->texture_ptr = &tex->texture;
-    ud->owns_texture = false;
-    ud->texture_ref = LUA_NOREF;
+    ud->texture = tex->texture;
     InitAnimationState(ud);
     ApplyAnimationFlags(L, ud, 2, 3);
 
-    lua_pushvalue(L, 1);
-    ud->texture_ref = luaL_ref(L, LUA_REGISTRYINDEX);
-
     luaL_getmetatable(L, kAnimationMeta);
     lua_setmetatable(L, -2);
     return 1;
@@ -1049,13 +1547,11 @@ int LuaAnimationNewSheet(lua_State *L)
 
     try
     {
-        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer());
+        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer(), runtime->GetTextureCache());
+        std::shared_ptr<engine::Texture> texture = loader.Acquire(path);
         LuaAnimation *ud = static_cast<LuaAnimation *>(lua_newuserdata(L, sizeof(LuaAnimation)));
         new (ud) LuaAnimation{};
-        ud->texture = loader.Load(path);
-        ud->texture_ptr = &ud->texture;
-        ud->owns_texture = true;
-        ud->texture_ref = LUA_NOREF;
+        ud->texture = std::move(texture);
         InitAnimationState(ud);
         ud->frames.reserve(static_cast<size_t>(frame_count));
         for (int i = 0; i < frame_count; ++i)
@@ -1139,13 +1635,11 @@ int LuaAnimationNewSheetEx(lua_State *L)
 
     try
     {
-        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer());
+        engine::TextureLoader loader(runtime->GetVfs(), runtime->GetRenderer(), runtime->GetTextureCache());
+        std::shared_ptr<engine::Texture> texture = loader.Acquire(path);
         LuaAnimation *ud = static_cast<LuaAnimation *>(lua_newuserdata(L, sizeof(LuaAnimation)));
         new (ud) LuaAnimation{};
-        ud->texture = loader.Load(path);
-        ud->texture_ptr = &ud->texture;
-        ud->owns_texture = true;
-        ud->texture_ref = LUA_NOREF;
+        ud->texture = std::move(texture);
         InitAnimationState(ud);
 
         const int stride_x = frame_w + pad_x;
@@ -1157,7 +1651,7 @@ int LuaAnimationNewSheetEx(lua_State *L)
 
         if (columns <= 0)
         {
-            int available_w = ud->texture.width - start_x;
+            int available_w = ud->texture->width - start_x;
             columns = available_w > 0 ? (available_w + pad_x) / stride_x : 0;
         }
 
@@ -1174,7 +1668,7 @@ int LuaAnimationNewSheetEx(lua_State *L)
             float x = static_cast<float>(start_x + col * stride_x);
             float y = static_cast<float>(start_y + row * stride_y);
 
-            if (x + frame_w > ud->texture.width || y + frame_h > ud->texture.height)
+            if (x + frame_w > ud->texture->width || y + frame_h > ud->texture->height)
             {
                 return luaL_error(L, "Animation sheet frame exceeds texture bounds");
             }
@@ -1310,6 +1804,7 @@ int LuaAnimationDraw(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
     LuaAnimation *ud = CheckAnimation(L, 1);
+    CheckNotCanvasTarget(L, runtime, ud->texture, "anim:draw");
     double x = 0.0;
     double y = 0.0;
     double angle = 0.0;
@@ -1371,7 +1866,7 @@ int LuaAnimationDraw(lua_State *L)
         flip_y = lua_toboolean(L, 10);
     }
 
-    if (!ud->texture_ptr || !ud->texture_ptr->handle || ud->frames.empty())
+    if (!ud->texture || !ud->texture->handle || ud->frames.empty())
     {
         return 0;
     }
@@ -1408,9 +1903,6 @@ int LuaAnimationDraw(lua_State *L)
         }
     }
 
-    SDL_SetTextureColorMod(ud->texture_ptr->handle, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(ud->texture_ptr->handle, color.a);
-
     float render_sx = static_cast<float>(sx) * zoom;
     float render_sy = static_cast<float>(sy) * zoom;
     float w = frame.w * render_sx;
@@ -1419,8 +1911,6 @@ int LuaAnimationDraw(lua_State *L)
     SDL_FRect dst = {screen.x - static_cast<float>(ox * render_sx), screen.y - static_cast<float>(oy * render_sy), w,
                      h};
     SDL_FPoint center = {static_cast<float>(ox * render_sx), static_cast<float>(oy * render_sy)};
-    constexpr double kRadToDeg = 57.29577951308232;
-    double degrees = render_angle * kRadToDeg;
 
     SDL_FlipMode flip = SDL_FLIP_NONE;
     if (flip_x)
@@ -1432,26 +1922,24 @@ int LuaAnimationDraw(lua_State *L)
         flip = static_cast<SDL_FlipMode>(flip | SDL_FLIP_VERTICAL);
     }
 
-    SDL_RenderTextureRotated(runtime->GetRenderer(), ud->texture_ptr->handle, &src, &dst, degrees, &center, flip);
-
-    SDL_SetTextureColorMod(ud->texture_ptr->handle, 255, 255, 255);
-    SDL_SetTextureAlphaMod(ud->texture_ptr->handle, 255);
+    runtime->GetSpriteBatch().Draw(*ud->texture, {.src = src,
+                                                      .dst = dst,
+                                                      .center = center,
+                                                      .angle = render_angle,
+                                                      .flip = flip,
+                                                      .color = color});
     return 0;
 }
 
 int LuaAnimationGc(lua_State *L)
 {
     LuaAnimation *ud = CheckAnimation(L, 1);
-    if (ud->owns_texture)
+    if (ud->texture)
     {
-        ud->texture.Reset();
+        GetRuntime(L)->FlushSprites();
+        ud->texture.reset();
     }
     std::vector<AnimationFrame>().swap(ud->frames);
-    if (ud->texture_ref != LUA_NOREF)
-    {
-        luaL_unref(L, LUA_REGISTRYINDEX, ud->texture_ref);
-        ud->texture_ref = LUA_NOREF;
-    }
     return 0;
 }
 
@@ -1478,6 +1966,7 @@ int LuaGraphicsSetColor(lua_State *L)
 int LuaGraphicsClear(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
+    runtime->FlushSprites();
     int r = static_cast<int>(luaL_optinteger(L, 1, 0));
     int g = static_cast<int>(luaL_optinteger(L, 2, 0));
     int b = static_cast<int>(luaL_optinteger(L, 3, 0));
@@ -1513,6 +2002,7 @@ int LuaGraphicsGetSize(lua_State *L)
 int LuaGraphicsBeginViewport(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
+    runtime->FlushSprites();
     int x = static_cast<int>(luaL_checkinteger(L, 1));
     int y = static_cast<int>(luaL_checkinteger(L, 2));
     int w = static_cast<int>(luaL_checkinteger(L, 3));
@@ -1529,6 +2019,7 @@ int LuaGraphicsBeginViewport(lua_State *L)
 int LuaGraphicsEndViewport(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
+    runtime->FlushSprites();
     SDL_SetRenderViewport(runtime->GetRenderer(), nullptr);
     return 0;
 }
@@ -1576,13 +2067,13 @@ int LuaGraphicsDrawGrid(lua_State *L)
     {
         SDL_FPoint p1 = ApplyCameraPoint(camera, {gx, y});
         SDL_FPoint p2 = ApplyCameraPoint(camera, {gx, y + h});
-        leo::Graphics::DrawLine(runtime->GetRenderer(), p1.x, p1.y, p2.x, p2.y, color);
+        leo::Graphics::DrawLine(runtime->GetSpriteBatch(), p1.x, p1.y, p2.x, p2.y, color);
     }
     for (float gy = y; gy <= y + h; gy += step)
     {
         SDL_FPoint p1 = ApplyCameraPoint(camera, {x, gy});
         SDL_FPoint p2 = ApplyCameraPoint(camera, {x + w, gy});
-        leo::Graphics::DrawLine(runtime->GetRenderer(), p1.x, p1.y, p2.x, p2.y, color);
+        leo::Graphics::DrawLine(runtime->GetSpriteBatch(), p1.x, p1.y, p2.x, p2.y, color);
     }
 
     return 0;
@@ -1674,7 +2165,7 @@ int LuaGraphicsDrawPixel(lua_State *L)
     }
     const leo::Camera::Camera2D *camera = runtime->GetActiveCamera();
     SDL_FPoint screen = ApplyCameraPoint(camera, point);
-    leo::Graphics::DrawPixel(runtime->GetRenderer(), screen.x, screen.y, color);
+    leo::Graphics::DrawPixel(runtime->GetSpriteBatch(), screen.x, screen.y, color);
     return 0;
 }
 
@@ -1700,7 +2191,7 @@ int LuaGraphicsDrawLine(lua_State *L)
     const leo::Camera::Camera2D *camera = runtime->GetActiveCamera();
     SDL_FPoint s1 = ApplyCameraPoint(camera, p1);
     SDL_FPoint s2 = ApplyCameraPoint(camera, p2);
-    leo::Graphics::DrawLine(runtime->GetRenderer(), s1.x, s1.y, s2.x, s2.y, color);
+    leo::Graphics::DrawLine(runtime->GetSpriteBatch(), s1.x, s1.y, s2.x, s2.y, color);
     return 0;
 }
 
@@ -1727,7 +2218,7 @@ int LuaGraphicsDrawCircleFilled(lua_State *L)
     const leo::Camera::Camera2D *camera = runtime->GetActiveCamera();
     SDL_FPoint screen = ApplyCameraPoint(camera, center);
     float scaled_radius = ApplyCameraScale(camera, radius);
-    leo::Graphics::DrawCircleFilled(runtime->GetRenderer(), screen.x, screen.y, scaled_radius, color);
+    leo::Graphics::DrawCircleFilled(runtime->GetSpriteBatch(), screen.x, screen.y, scaled_radius, color);
     return 0;
 }
 
@@ -1754,7 +2245,7 @@ int LuaGraphicsDrawCircleOutline(lua_State *L)
     const leo::Camera::Camera2D *camera = runtime->GetActiveCamera();
     SDL_FPoint screen = ApplyCameraPoint(camera, center);
     float scaled_radius = ApplyCameraScale(camera, radius);
-    leo::Graphics::DrawCircleOutline(runtime->GetRenderer(), screen.x, screen.y, scaled_radius, color);
+    leo::Graphics::DrawCircleOutline(runtime->GetSpriteBatch(), screen.x, screen.y, scaled_radius, color);
     return 0;
 }
 
@@ -1786,14 +2277,14 @@ int LuaGraphicsDrawRectangleFilled(lua_State *L)
         {
             corner = ApplyCameraPoint(camera, corner);
         }
-        leo::Graphics::DrawPolyFilled(runtime->GetRenderer(), corners, 4, color);
+        leo::Graphics::DrawPolyFilled(runtime->GetSpriteBatch(), corners, 4, color);
         return 0;
     }
 
     SDL_FPoint screen = ApplyCameraPoint(camera, {rect.x, rect.y});
     float w = ApplyCameraScale(camera, rect.w);
     float h = ApplyCameraScale(camera, rect.h);
-    leo::Graphics::DrawRectangleFilled(runtime->GetRenderer(), screen.x, screen.y, w, h, color);
+    leo::Graphics::DrawRectangleFilled(runtime->GetSpriteBatch(), screen.x, screen.y, w, h, color);
     return 0;
 }
 
@@ -1825,14 +2316,14 @@ int LuaGraphicsDrawRectangleOutline(lua_State *L)
         {
             corner = ApplyCameraPoint(camera, corner);
         }
-        leo::Graphics::DrawPolyOutline(runtime->GetRenderer(), corners, 4, color);
+        leo::Graphics::DrawPolyOutline(runtime->GetSpriteBatch(), corners, 4, color);
         return 0;
     }
 
     SDL_FPoint screen = ApplyCameraPoint(camera, {rect.x, rect.y});
     float w = ApplyCameraScale(camera, rect.w);
     float h = ApplyCameraScale(camera, rect.h);
-    leo::Graphics::DrawRectangleOutline(runtime->GetRenderer(), screen.x, screen.y, w, h, color);
+    leo::Graphics::DrawRectangleOutline(runtime->GetSpriteBatch(), screen.x, screen.y, w, h, color);
     return 0;
 }
 
@@ -1867,7 +2358,7 @@ int LuaGraphicsDrawRectangleRoundedFilled(lua_State *L)
         {
             corner = ApplyCameraPoint(camera, corner);
         }
-        leo::Graphics::DrawPolyFilled(runtime->GetRenderer(), corners, 4, color);
+        leo::Graphics::DrawPolyFilled(runtime->GetSpriteBatch(), corners, 4, color);
         return 0;
     }
 
@@ -1875,7 +2366,8 @@ int LuaGraphicsDrawRectangleRoundedFilled(lua_State *L)
     float w = ApplyCameraScale(camera, rect.w);
     float h = ApplyCameraScale(camera, rect.h);
     float scaled_radius = ApplyCameraScale(camera, radius);
-    leo::Graphics::DrawRectangleRoundedFilled(runtime->GetRenderer(), screen.x, screen.y, w, h, scaled_radius, color);
+    leo::Graphics::DrawRectangleRoundedFilled(runtime->GetSpriteBatch(), screen.x, screen.y, w, h, scaled_radius,
+                                              color);
     return 0;
 }
 
@@ -1910,7 +2402,7 @@ int LuaGraphicsDrawRectangleRoundedOutline(lua_State *L)
         {
             corner = ApplyCameraPoint(camera, corner);
         }
-        leo::Graphics::DrawPolyOutline(runtime->GetRenderer(), corners, 4, color);
+        leo::Graphics::DrawPolyOutline(runtime->GetSpriteBatch(), corners, 4, color);
         return 0;
     }
 
@@ -1918,7 +2410,8 @@ int LuaGraphicsDrawRectangleRoundedOutline(lua_State *L)
     float w = ApplyCameraScale(camera, rect.w);
     float h = ApplyCameraScale(camera, rect.h);
     float scaled_radius = ApplyCameraScale(camera, radius);
-    leo::Graphics::DrawRectangleRoundedOutline(runtime->GetRenderer(), screen.x, screen.y, w, h, scaled_radius, color);
+    leo::Graphics::DrawRectangleRoundedOutline(runtime->GetSpriteBatch(), screen.x, screen.y, w, h, scaled_radius,
+                                               color);
     return 0;
 }
 
@@ -1951,7 +2444,7 @@ int LuaGraphicsDrawTriangleFilled(lua_State *L)
     a = ApplyCameraPoint(camera, a);
     b = ApplyCameraPoint(camera, b);
     c = ApplyCameraPoint(camera, c);
-    leo::Graphics::DrawTriangleFilled(runtime->GetRenderer(), a, b, c, color);
+    leo::Graphics::DrawTriangleFilled(runtime->GetSpriteBatch(), a, b, c, color);
     return 0;
 }
 
@@ -1984,7 +2477,7 @@ int LuaGraphicsDrawTriangleOutline(lua_State *L)
     a = ApplyCameraPoint(camera, a);
     b = ApplyCameraPoint(camera, b);
     c = ApplyCameraPoint(camera, c);
-    leo::Graphics::DrawTriangleOutline(runtime->GetRenderer(), a, b, c, color);
+    leo::Graphics::DrawTriangleOutline(runtime->GetSpriteBatch(), a, b, c, color);
     return 0;
 }
 
@@ -2015,7 +2508,7 @@ int LuaGraphicsDrawPolyFilled(lua_State *L)
             point = ApplyCameraPoint(camera, point);
         }
     }
-    leo::Graphics::DrawPolyFilled(runtime->GetRenderer(), points.data(), static_cast<int>(points.size()), color);
+    leo::Graphics::DrawPolyFilled(runtime->GetSpriteBatch(), points.data(), static_cast<int>(points.size()), color);
     return 0;
 }
 
@@ -2046,7 +2539,7 @@ int LuaGraphicsDrawPolyOutline(lua_State *L)
             point = ApplyCameraPoint(camera, point);
         }
     }
-    leo::Graphics::DrawPolyOutline(runtime->GetRenderer(), points.data(), static_cast<int>(points.size()), color);
+    leo::Graphics::DrawPolyOutline(runtime->GetSpriteBatch(), points.data(), static_cast<int>(points.size()), color);
     return 0;
 }
 
@@ -2263,6 +2756,51 @@ int LuaCollisionCheckLines(lua_State *L)
     return 1;
 }
 
+// queryCircle(xs, ys, x, y, radius, out): writes the 1-based indices of points within radius into the int buffer out
+// and returns how many were written.
+int LuaCollisionQueryCircle(lua_State *L)
+{
+    LuaBuffer *xs = CheckFloatBuffer(L, 1);
+    LuaBuffer *ys = CheckFloatBuffer(L, 2);
+    SDL_FPoint point = ReadPointPair(L, 3);
+    float radius = static_cast<float>(luaL_checknumber(L, 5));
+    LuaBuffer *out = CheckIntBuffer(L, 6);
+
+    Sint32 *indices = GetBufferInts(out);
+    size_t found = leo::BufferKernels::WithinRadius(GetBufferFloats(xs), GetBufferFloats(ys),
+                                                    std::min(xs->length, ys->length), point, radius, indices,
+                                                    out->length);
+    for (size_t i = 0; i < found; ++i)
+    {
+        indices[i]++;
+    }
+    lua_pushinteger(L, static_cast<lua_Integer>(found));
+    return 1;
+}
+
+// queryRec(xs, ys, w, h, rx, ry, rw, rh, out): same as queryCircle for w x h boxes overlapping a rectangle.
+int LuaCollisionQueryRec(lua_State *L)
+{
+    LuaBuffer *xs = CheckFloatBuffer(L, 1);
+    LuaBuffer *ys = CheckFloatBuffer(L, 2);
+    float w = static_cast<float>(luaL_checknumber(L, 3));
+    float h = static_cast<float>(luaL_checknumber(L, 4));
+    SDL_FRect rect = {static_cast<float>(luaL_checknumber(L, 5)), static_cast<float>(luaL_checknumber(L, 6)),
+                      static_cast<float>(luaL_checknumber(L, 7)), static_cast<float>(luaL_checknumber(L, 8))};
+    LuaBuffer *out = CheckIntBuffer(L, 9);
+
+    Sint32 *indices = GetBufferInts(out);
+    size_t found = leo::BufferKernels::OverlapRect(GetBufferFloats(xs), GetBufferFloats(ys),
+                                                   std::min(xs->length, ys->length), w, h, rect, indices,
+                                                   out->length);
+    for (size_t i = 0; i < found; ++i)
+    {
+        indices[i]++;
+    }
+    lua_pushinteger(L, static_cast<lua_Integer>(found));
+    return 1;
+}
+
 int LuaCameraNew(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
@@ -2532,7 +3070,8 @@ int LuaTiledLoad(lua_State *L)
     try
     {
         LuaTiledMap *ud = static_cast<LuaTiledMap *>(lua_newuserdata(L, sizeof(LuaTiledMap)));
-        engine::TiledMap loaded = engine::TiledMap::LoadFromVfs(runtime->GetVfs(), runtime->GetRenderer(), path);
+        engine::TiledMap loaded = engine::TiledMap::LoadFromVfs(runtime->GetVfs(), runtime->GetRenderer(), path,
+                                                                   runtime->GetTextureCache(), runtime->GetJobSystem());
         new (&ud->map) engine::TiledMap(std::move(loaded));
         luaL_getmetatable(L, kTiledMapMeta);
         lua_setmetatable(L, -2);
@@ -2554,6 +3093,7 @@ int LuaTiledMapGc(lua_State *L)
 int LuaTiledMapDraw(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
+    runtime->FlushSprites();
     LuaTiledMap *ud = CheckTiledMap(L, 1);
     float x = 0.0f;
     float y = 0.0f;
@@ -2574,6 +3114,7 @@ int LuaTiledMapDraw(lua_State *L)
 int LuaTiledMapDrawLayer(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
+    runtime->FlushSprites();
     LuaTiledMap *ud = CheckTiledMap(L, 1);
     int layer_index = 0;
     float x = 0.0f;
@@ -2643,39 +3184,120 @@ int LuaTiledMapGetLayerName(lua_State *L)
 
 int LuaTextureGc(lua_State *L)
 {
+    engine::LuaRuntime *runtime = GetRuntime(L);
     LuaTexture *ud = CheckTexture(L, 1);
-    ud->texture.Reset();
+    runtime->FlushSprites();
+    ud->texture.reset();
     return 0;
 }
 
 int LuaTextureGetSize(lua_State *L)
 {
     LuaTexture *ud = CheckTexture(L, 1);
-    lua_pushinteger(L, ud->texture.width);
-    lua_pushinteger(L, ud->texture.height);
+    lua_pushinteger(L, ud->texture ? ud->texture->width : 0);
+    lua_pushinteger(L, ud->texture ? ud->texture->height : 0);
     return 2;
 }
 
-int LuaFontNew(lua_State *L)
+int LuaAtlasGc(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
-    const char *path = luaL_checkstring(L, 1);
-    int size = static_cast<int>(luaL_checkinteger(L, 2));
+    LuaAtlas *ud = CheckAtlas(L, 1);
+    runtime->FlushSprites();
+    ud->atlas = engine::TextureAtlas();
+    return 0;
+}
 
-    try
+int LuaAtlasGet(lua_State *L)
+{
+    LuaAtlas *ud = CheckAtlas(L, 1);
+    const char *path = luaL_checkstring(L, 2);
+    std::shared_ptr<engine::Texture> texture = ud->atlas.Find(path);
+    if (!texture)
     {
-        LuaFont *ud = static_cast<LuaFont *>(lua_newuserdata(L, sizeof(LuaFont)));
-        new (&ud->font) engine::Font(engine::Font::LoadFromVfs(runtime->GetVfs(), runtime->GetRenderer(), path, size));
-        ud->pixel_size = size;
-        luaL_getmetatable(L, kFontMeta);
-        lua_setmetatable(L, -2);
+        lua_pushnil(L);
         return 1;
     }
-    catch (const std::exception &e)
-    {
-        return luaL_error(L, "%s", e.what());
-    }
-}
+
+    LuaTexture *value = static_cast<LuaTexture *>(lua_newuserdata(L, sizeof(LuaTexture)));
+    new (&value->texture) std::shared_ptr<engine::Texture>(std::move(texture));
+    luaL_getmetatable(L, kTextureMeta);
+    lua_setmetatable(L, -2);
+    return 1;
+}
+
+int LuaAtlasGetImageCount(lua_State *L)
+{
+    LuaAtlas *ud = CheckAtlas(L, 1);
+    lua_pushinteger(L, static_cast<lua_Integer>(ud->atlas.GetImages().size()));
+    return 1;
+}
+
+int LuaAtlasGetPageCount(lua_State *L)
+{
+    LuaAtlas *ud = CheckAtlas(L, 1);
+    lua_pushinteger(L, static_cast<lua_Integer>(ud->atlas.GetPages().size()));
+    return 1;
+}
+
+int LuaGraphicsPurgeTextureCache(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    engine::TextureCache *cache = runtime->GetTextureCache();
+    if (!cache)
+    {
+        lua_pushinteger(L, 0);
+        return 1;
+    }
+
+    runtime->FlushSprites();
+    lua_pushinteger(L, static_cast<lua_Integer>(cache->Purge()));
+    return 1;
+}
+
+int LuaGraphicsGetTextureCacheStats(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    engine::TextureCacheStats stats = {};
+    if (runtime->GetTextureCache())
+    {
+        stats = runtime->GetTextureCache()->GetStats();
+    }
+
+    lua_createtable(L, 0, 5);
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.entries));
+    lua_setfield(L, -2, "entries");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.unused_entries));
+    lua_setfield(L, -2, "unused");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.bytes));
+    lua_setfield(L, -2, "bytes");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.hits));
+    lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.misses));
+    lua_setfield(L, -2, "misses");
+    return 1;
+}
+
+int LuaFontNew(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const char *path = luaL_checkstring(L, 1);
+    int size = static_cast<int>(luaL_checkinteger(L, 2));
+
+    try
+    {
+        LuaFont *ud = static_cast<LuaFont *>(lua_newuserdata(L, sizeof(LuaFont)));
+        new (&ud->font) engine::Font(engine::Font::LoadFromVfs(runtime->GetVfs(), runtime->GetRenderer(), path, size));
+        ud->pixel_size = size;
+        luaL_getmetatable(L, kFontMeta);
+        lua_setmetatable(L, -2);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+}
 
 int LuaFontGc(lua_State *L)
 {
@@ -2694,6 +3316,7 @@ int LuaFontGetLineHeight(lua_State *L)
 int LuaFontPrint(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
+    runtime->FlushSprites();
     LuaFont *ud = CheckFont(L, 1);
     const char *text = nullptr;
     float x = 0.0f;
@@ -2718,15 +3341,11 @@ int LuaFontPrint(lua_State *L)
         ReadColorArgsOptional(L, 6, &color);
     }
 
-    engine::TextDesc desc = {
-        .font = &ud->font,
-        .text = text,
-        .pixel_size = size,
-        .position = {x, y},
-        .color = {color.r, color.g, color.b, color.a},
-    };
-    engine::Text text_obj(desc);
-    text_obj.Draw(runtime->GetRenderer());
+    if (size <= 0)
+    {
+        return luaL_error(L, "font.print requires a positive size");
+    }
+    ud->font.DrawText(runtime->GetRenderer(), text, size, {x, y}, color);
     return 0;
 }
 
@@ -2745,6 +3364,7 @@ int LuaFontSet(lua_State *L)
 int LuaFontPrintCurrent(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
+    runtime->FlushSprites();
     SDL_Color color = runtime->GetDrawColor();
     LuaFont *ud = nullptr;
     engine::Font *font = nullptr;
@@ -2811,15 +3431,7 @@ int LuaFontPrintCurrent(lua_State *L)
     {
         pixel_size = font->GetLineHeight();
     }
-    engine::TextDesc desc = {
-        .font = font,
-        .text = text,
-        .pixel_size = pixel_size,
-        .position = {x, y},
-        .color = {color.r, color.g, color.b, color.a},
-    };
-    engine::Text text_obj(desc);
-    text_obj.Draw(runtime->GetRenderer());
+    font->DrawText(runtime->GetRenderer(), text, pixel_size, {x, y}, color);
     return 0;
 }
 
@@ -2972,212 +3584,653 @@ int LuaSoundSetPitch(lua_State *L)
     return 0;
 }
 
-int LuaMusicNew(lua_State *L)
+int LuaSoundSetMaxVoices(lua_State *L)
 {
-    engine::LuaRuntime *runtime = GetRuntime(L);
-    const char *path = nullptr;
-    bool apply_looping = false;
-    bool looping = false;
-    bool apply_volume = false;
-    float volume = 0.0f;
-    bool apply_pitch = false;
-    float pitch = 0.0f;
-    bool auto_play = false;
-
-    if (lua_istable(L, 1))
-    {
-        path = GetTableStringFieldReq(L, 1, "path", "leo.audio.newMusic");
-        if (TableHasField(L, 1, "looping"))
-        {
-            looping = GetTableBoolFieldReq(L, 1, "looping", "leo.audio.newMusic");
-            apply_looping = true;
-        }
-        if (TableHasField(L, 1, "volume"))
-        {
-            volume = GetTableFloatFieldOpt(L, 1, "volume", 0.0f);
-            apply_volume = true;
-        }
-        if (TableHasField(L, 1, "pitch"))
-        {
-            pitch = GetTableFloatFieldOpt(L, 1, "pitch", 0.0f);
-            apply_pitch = true;
-        }
-        auto_play = GetTableBoolFieldOpt(L, 1, "play", false) || GetTableBoolFieldOpt(L, 1, "playing", false);
-    }
-    else
-    {
-        path = luaL_checkstring(L, 1);
-    }
+    LuaSound *ud = CheckSound(L, 1);
+    lua_Integer max_voices = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, max_voices >= 0, 2, "max voices must be >= 0");
     try
     {
-        LuaMusic *ud = static_cast<LuaMusic *>(lua_newuserdata(L, sizeof(LuaMusic)));
-        new (&ud->music) engine::Music(engine::Music::LoadFromVfs(runtime->GetVfs(), path));
-        if (apply_looping)
-        {
-            ud->music.SetLooping(looping);
-        }
-        if (apply_volume)
-        {
-            ud->music.SetVolume(volume);
-        }
-        if (apply_pitch)
-        {
-            ud->music.SetPitch(pitch);
-        }
-        if (auto_play)
-        {
-            ud->music.Play();
-        }
-        luaL_getmetatable(L, kMusicMeta);
-        lua_setmetatable(L, -2);
-        return 1;
+        ud->sound.SetMaxVoices(static_cast<int>(std::min<lua_Integer>(max_voices, INT_MAX)));
     }
     catch (const std::exception &e)
     {
         return luaL_error(L, "%s", e.what());
     }
-}
-
-int LuaMusicGc(lua_State *L)
-{
-    LuaMusic *ud = CheckMusic(L, 1);
-    ud->music.Reset();
     return 0;
 }
 
-int LuaMusicPlay(lua_State *L)
+int LuaSoundGetMaxVoices(lua_State *L)
 {
-    LuaMusic *ud = CheckMusic(L, 1);
-    ud->music.Play();
-    return 0;
+    LuaSound *ud = CheckSound(L, 1);
+    lua_pushinteger(L, ud->sound.GetMaxVoices());
+    return 1;
 }
 
-int LuaMusicPause(lua_State *L)
+int LuaAudioSetVoiceStealPolicy(lua_State *L)
 {
-    LuaMusic *ud = CheckMusic(L, 1);
-    ud->music.Pause();
+    static const char *const kPolicies[] = {"oldest", "quietest", "skip", nullptr};
+    static const engine::VoiceStealPolicy kPolicyValues[] = {
+        engine::VoiceStealPolicy::Oldest, engine::VoiceStealPolicy::Quietest, engine::VoiceStealPolicy::Skip};
+    int index = luaL_checkoption(L, 1, nullptr, kPolicies);
+    engine::SetVoiceStealPolicy(kPolicyValues[index]);
     return 0;
 }
 
-int LuaMusicStop(lua_State *L)
+int LuaAudioGetVoiceStats(lua_State *L)
 {
-    LuaMusic *ud = CheckMusic(L, 1);
-    ud->music.Stop();
-    return 0;
-}
+    engine::VoiceStats stats = {};
+    try
+    {
+        stats = engine::GetVoiceStats();
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
 
-int LuaMusicIsPlaying(lua_State *L)
-{
-    LuaMusic *ud = CheckMusic(L, 1);
-    lua_pushboolean(L, ud->music.IsPlaying());
+    lua_createtable(L, 0, 5);
+    lua_pushinteger(L, stats.voice_count);
+    lua_setfield(L, -2, "voices");
+    lua_pushinteger(L, stats.active_voices);
+    lua_setfield(L, -2, "active");
+    lua_pushinteger(L, stats.cached_samples);
+    lua_setfield(L, -2, "samples");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.stolen));
+    lua_setfield(L, -2, "stolen");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.skipped));
+    lua_setfield(L, -2, "skipped");
     return 1;
 }
 
-int LuaMusicSetLooping(lua_State *L)
+int PushFuture(lua_State *L, std::shared_ptr<AsyncAsset> asset, std::function<void()> decode,
+               std::function<void()> finish)
 {
-    LuaMusic *ud = CheckMusic(L, 1);
-    bool looping = false;
-    if (lua_istable(L, 2))
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    try
     {
-        looping = GetTableBoolFieldReq(L, 2, "looping", "music.setLooping");
+        LuaFuture *ud = static_cast<LuaFuture *>(lua_newuserdata(L, sizeof(LuaFuture)));
+        new (ud) LuaFuture{nullptr, std::move(asset), LUA_NOREF};
+        luaL_getmetatable(L, kFutureMeta);
+        lua_setmetatable(L, -2);
+        ud->request = runtime->GetAssetLoader().Submit(std::move(decode), std::move(finish));
+        return 1;
     }
-    else
+    catch (const std::exception &e)
     {
-        looping = lua_toboolean(L, 2);
+        return luaL_error(L, "%s", e.what());
     }
-    ud->music.SetLooping(looping);
-    return 0;
 }
 
-int LuaMusicSetVolume(lua_State *L)
+int LuaGraphicsNewImageAsync(lua_State *L)
 {
-    LuaMusic *ud = CheckMusic(L, 1);
-    float volume = 0.0f;
-    if (lua_istable(L, 2))
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const char *path = luaL_checkstring(L, 1);
+    engine::VFS *vfs = &runtime->GetVfs();
+    SDL_Renderer *renderer = runtime->GetRenderer();
+    engine::TextureCache *cache = runtime->GetTextureCache();
+
+    auto asset = std::make_shared<AsyncAsset>();
+    asset->kind = AsyncAsset::Kind::Image;
+    asset->path = path;
+    asset->cached = cache && cache->Contains(path);
+    auto decode = [asset, vfs]() {
+        if (!asset->cached)
+        {
+            asset->image = engine::TextureLoader::Decode(*vfs, asset->path.c_str());
+        }
+    };
+    auto finish = [asset, vfs, renderer, cache]() {
+        // A path that was cached at submit time skipped the decode. If it has been purged since, Acquire loads
+        // it again here, synchronously, rather than uploading the empty image.
+        if (asset->cached || (cache && cache->Contains(asset->path.c_str())))
+        {
+            asset->texture = cache->Acquire(asset->path.c_str());
+            return;
+        }
+        engine::TextureLoader loader(*vfs, renderer, cache);
+        engine::Texture texture = loader.Upload(asset->image);
+        asset->image.Reset();
+        asset->texture = cache ? cache->Adopt(asset->path.c_str(), std::move(texture))
+                               : std::make_shared<engine::Texture>(std::move(texture));
+    };
+    return PushFuture(L, std::move(asset), std::move(decode), std::move(finish));
+}
+
+int LuaFontNewAsync(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const char *path = luaL_checkstring(L, 1);
+    int size = static_cast<int>(luaL_checkinteger(L, 2));
+    engine::VFS *vfs = &runtime->GetVfs();
+    SDL_Renderer *renderer = runtime->GetRenderer();
+
+    auto asset = std::make_shared<AsyncAsset>();
+    asset->kind = AsyncAsset::Kind::Font;
+    asset->path = path;
+    asset->font_size = size;
+    auto decode = [asset, vfs]() {
+        asset->bitmap = engine::Font::Bake(*vfs, asset->path.c_str(), asset->font_size);
+    };
+    auto finish = [asset, renderer]() { asset->font = engine::Font::FromBitmap(renderer, std::move(asset->bitmap)); };
+    return PushFuture(L, std::move(asset), std::move(decode), std::move(finish));
+}
+
+int LuaAudioNewSoundAsync(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const char *path = luaL_checkstring(L, 1);
+    engine::VFS *vfs = &runtime->GetVfs();
+    // The decode job reads the engine's output format; start the engine here so it is never opened off the main
+    // thread.
+    try
     {
-        volume = GetTableNumberFieldReq(L, 2, "volume", "music.setVolume");
+        engine::StartAudioEngine();
     }
-    else
+    catch (const std::exception &e)
     {
-        volume = static_cast<float>(luaL_checknumber(L, 2));
+        return luaL_error(L, "%s", e.what());
     }
-    ud->music.SetVolume(volume);
-    return 0;
+
+    auto asset = std::make_shared<AsyncAsset>();
+    asset->kind = AsyncAsset::Kind::Sound;
+    asset->path = path;
+    auto decode = [asset, vfs]() { asset->sample = engine::Sound::Decode(*vfs, asset->path.c_str()); };
+    auto finish = [asset]() {
+        asset->sound = engine::Sound::FromSample(std::move(asset->sample), asset->path.c_str());
+    };
+    return PushFuture(L, std::move(asset), std::move(decode), std::move(finish));
 }
 
-int LuaMusicSetPitch(lua_State *L)
+// Pushes the loaded object, creating its userdata on first use so every get/await returns the same value.
+void PushFutureValue(lua_State *L, LuaFuture *ud)
 {
-    LuaMusic *ud = CheckMusic(L, 1);
-    float pitch = 0.0f;
-    if (lua_istable(L, 2))
+    if (ud->value_ref != LUA_NOREF)
     {
-        pitch = GetTableNumberFieldReq(L, 2, "pitch", "music.setPitch");
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ud->value_ref);
+        return;
+    }
+
+    AsyncAsset &asset = *ud->asset;
+    if (asset.kind == AsyncAsset::Kind::Image)
+    {
+        LuaTexture *value = static_cast<LuaTexture *>(lua_newuserdata(L, sizeof(LuaTexture)));
+        new (&value->texture) std::shared_ptr<engine::Texture>(std::move(asset.texture));
+        luaL_getmetatable(L, kTextureMeta);
+    }
+    else if (asset.kind == AsyncAsset::Kind::Font)
+    {
+        LuaFont *value = static_cast<LuaFont *>(lua_newuserdata(L, sizeof(LuaFont)));
+        new (&value->font) engine::Font(std::move(asset.font));
+        value->pixel_size = asset.font_size;
+        luaL_getmetatable(L, kFontMeta);
     }
     else
     {
-        pitch = static_cast<float>(luaL_checknumber(L, 2));
+        LuaSound *value = static_cast<LuaSound *>(lua_newuserdata(L, sizeof(LuaSound)));
+        new (&value->sound) engine::Sound(std::move(asset.sound));
+        luaL_getmetatable(L, kSoundMeta);
     }
-    ud->music.SetPitch(pitch);
-    return 0;
+    lua_setmetatable(L, -2);
+    lua_pushvalue(L, -1);
+    ud->value_ref = luaL_ref(L, LUA_REGISTRYINDEX);
 }
 
-int LuaKeyboardIsDown(lua_State *L)
+int PushFutureResult(lua_State *L, LuaFuture *ud)
 {
-    LuaKeyboard *ud = CheckKeyboard(L, 1);
-    const char *name = luaL_checkstring(L, 2);
-    engine::Key key = ParseKey(name);
-    lua_pushboolean(L, ud->state.IsDown(key));
+    if (ud->request->GetStatus() == engine::AssetStatus::Failed)
+    {
+        lua_pushnil(L);
+        lua_pushstring(L, ud->request->GetError().c_str());
+        return 2;
+    }
+    if (ud->request->GetStatus() == engine::AssetStatus::Pending)
+    {
+        lua_pushnil(L);
+        return 1;
+    }
+    PushFutureValue(L, ud);
     return 1;
 }
 
-int LuaKeyboardIsPressed(lua_State *L)
+int LuaFutureGc(lua_State *L)
 {
-    LuaKeyboard *ud = CheckKeyboard(L, 1);
-    const char *name = luaL_checkstring(L, 2);
-    engine::Key key = ParseKey(name);
-    lua_pushboolean(L, ud->state.IsPressed(key));
-    return 1;
+    LuaFuture *ud = CheckFuture(L, 1);
+    if (ud->value_ref != LUA_NOREF)
+    {
+        luaL_unref(L, LUA_REGISTRYINDEX, ud->value_ref);
+    }
+    ud->~LuaFuture();
+    return 0;
 }
 
-int LuaKeyboardIsReleased(lua_State *L)
+int LuaFutureIsDone(lua_State *L)
 {
-    LuaKeyboard *ud = CheckKeyboard(L, 1);
-    const char *name = luaL_checkstring(L, 2);
-    engine::Key key = ParseKey(name);
-    lua_pushboolean(L, ud->state.IsReleased(key));
+    LuaFuture *ud = CheckFuture(L, 1);
+    lua_pushboolean(L, ud->request->IsDone());
     return 1;
 }
 
-int LuaMouseIsDown(lua_State *L)
+int LuaFutureIsReady(lua_State *L)
 {
-    LuaMouse *ud = CheckMouse(L, 1);
-    const char *name = luaL_checkstring(L, 2);
-    engine::MouseButton button = ParseMouseButton(name);
-    lua_pushboolean(L, ud->state.IsButtonDown(button));
+    LuaFuture *ud = CheckFuture(L, 1);
+    lua_pushboolean(L, ud->request->GetStatus() == engine::AssetStatus::Ready);
     return 1;
 }
 
-int LuaMouseIsPressed(lua_State *L)
+int LuaFutureGetError(lua_State *L)
 {
-    LuaMouse *ud = CheckMouse(L, 1);
-    const char *name = luaL_checkstring(L, 2);
-    engine::MouseButton button = ParseMouseButton(name);
-    lua_pushboolean(L, ud->state.IsButtonPressed(button));
+    LuaFuture *ud = CheckFuture(L, 1);
+    if (ud->request->GetStatus() != engine::AssetStatus::Failed)
+    {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushstring(L, ud->request->GetError().c_str());
     return 1;
 }
 
-int LuaMouseIsReleased(lua_State *L)
+int LuaFutureGet(lua_State *L)
 {
-    LuaMouse *ud = CheckMouse(L, 1);
-    const char *name = luaL_checkstring(L, 2);
-    engine::MouseButton button = ParseMouseButton(name);
-    lua_pushboolean(L, ud->state.IsButtonReleased(button));
-    return 1;
+    return PushFutureResult(L, CheckFuture(L, 1));
 }
 
-int LuaMouseSetCursorVisible(lua_State *L)
+int LuaFutureAwaitK(lua_State *L, int status, lua_KContext ctx);
+
+// Inside a coroutine, await yields until the load is done so the caller's scheduler can resume it on a later
+// frame. Outside one, it blocks and finishes the load immediately.
+int LuaFutureAwait(lua_State *L)
 {
-    int arg_index = 1;
+    LuaFuture *ud = CheckFuture(L, 1);
+    if (!ud->request->IsDone())
+    {
+        if (lua_isyieldable(L))
+        {
+            return lua_yieldk(L, 0, 0, LuaFutureAwaitK);
+        }
+        try
+        {
+            GetRuntime(L)->GetAssetLoader().Wait(ud->request);
+        }
+        catch (const std::exception &e)
+        {
+            return luaL_error(L, "%s", e.what());
+        }
+    }
+    return PushFutureResult(L, ud);
+}
+
+int LuaFutureAwaitK(lua_State *L, int status, lua_KContext ctx)
+{
+    (void)status;
+    (void)ctx;
+    lua_settop(L, 1);
+    return LuaFutureAwait(L);
+}
+
+// Task ids are Uint32; anything outside that range can never name a task.
+engine::TaskId ToTaskId(lua_Integer value)
+{
+    if (value <= 0 || value > static_cast<lua_Integer>(std::numeric_limits<engine::TaskId>::max()))
+    {
+        return 0;
+    }
+    return static_cast<engine::TaskId>(value);
+}
+
+engine::TaskId CheckRunningTask(lua_State *L, const char *name)
+{
+    engine::TaskId id = GetRuntime(L)->GetRunningTask(L);
+    if (id == 0)
+    {
+        luaL_error(L, "%s must be called from a leo.task", name);
+    }
+    return id;
+}
+
+void ForgetTask(lua_State *L, engine::TaskId id)
+{
+    lua_getfield(L, LUA_REGISTRYINDEX, kTaskRegistryKey);
+    lua_pushnil(L);
+    lua_rawseti(L, -2, static_cast<lua_Integer>(id));
+    lua_pop(L, 1);
+}
+
+int LuaTaskSpawn(lua_State *L)
+{
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+    int nargs = lua_gettop(L);
+    lua_State *co = lua_newthread(L);
+    for (int i = 1; i <= nargs; ++i)
+    {
+        lua_pushvalue(L, i);
+    }
+    lua_xmove(L, co, nargs);
+
+    engine::TaskId id = 0;
+    try
+    {
+        id = GetRuntime(L)->GetTaskScheduler().Spawn();
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+    lua_getfield(L, LUA_REGISTRYINDEX, kTaskRegistryKey);
+    lua_pushvalue(L, -2);
+    lua_rawseti(L, -2, static_cast<lua_Integer>(id));
+    lua_pop(L, 2);
+    lua_pushinteger(L, static_cast<lua_Integer>(id));
+    return 1;
+}
+
+int LuaTaskWait(lua_State *L)
+{
+    lua_Number seconds = luaL_optnumber(L, 1, 0.0);
+    luaL_argcheck(L, std::isfinite(seconds), 1, "seconds must be finite");
+    engine::TaskId id = CheckRunningTask(L, "leo.task.wait");
+    engine::TaskScheduler &scheduler = GetRuntime(L)->GetTaskScheduler();
+    try
+    {
+        // A task that cancelled itself still yields, but nothing resumes it again.
+        if (scheduler.IsAlive(id))
+        {
+            scheduler.Sleep(id, static_cast<double>(seconds));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+    return lua_yield(L, 0);
+}
+
+int LuaTaskWaitFrames(lua_State *L)
+{
+    lua_Integer frames = luaL_optinteger(L, 1, 1);
+    frames = std::clamp<lua_Integer>(frames, 1, std::numeric_limits<Uint32>::max());
+    engine::TaskId id = CheckRunningTask(L, "leo.task.waitFrames");
+    engine::TaskScheduler &scheduler = GetRuntime(L)->GetTaskScheduler();
+    try
+    {
+        if (scheduler.IsAlive(id))
+        {
+            scheduler.SleepTicks(id, static_cast<Uint32>(frames));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+    return lua_yield(L, 0);
+}
+
+int LuaTaskAwaitK(lua_State *L, int status, lua_KContext ctx)
+{
+    (void)status;
+    (void)ctx;
+    lua_settop(L, 1);
+    return PushFutureResult(L, CheckFuture(L, 1));
+}
+
+// Unlike future:await, which resumes the task every tick to poll, this parks the task on the scheduler's condition
+// list so only the request is checked until the load finishes.
+int LuaTaskAwait(lua_State *L)
+{
+    LuaFuture *ud = CheckFuture(L, 1);
+    engine::TaskId id = CheckRunningTask(L, "leo.task.await");
+    if (ud->request->IsDone())
+    {
+        return PushFutureResult(L, ud);
+    }
+    engine::TaskScheduler &scheduler = GetRuntime(L)->GetTaskScheduler();
+    try
+    {
+        if (scheduler.IsAlive(id))
+        {
+            std::shared_ptr<engine::AssetRequest> request = ud->request;
+            scheduler.WaitUntil(id, [request]() { return request->IsDone(); });
+        }
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+    lua_settop(L, 1);
+    return lua_yieldk(L, 0, 0, LuaTaskAwaitK);
+}
+
+int LuaTaskCancel(lua_State *L)
+{
+    engine::TaskId id = ToTaskId(luaL_checkinteger(L, 1));
+    bool cancelled = id != 0 && GetRuntime(L)->GetTaskScheduler().Cancel(id);
+    if (cancelled)
+    {
+        ForgetTask(L, id);
+    }
+    lua_pushboolean(L, cancelled);
+    return 1;
+}
+
+int LuaTaskIsAlive(lua_State *L)
+{
+    engine::TaskId id = ToTaskId(luaL_checkinteger(L, 1));
+    lua_pushboolean(L, id != 0 && GetRuntime(L)->GetTaskScheduler().IsAlive(id));
+    return 1;
+}
+
+int LuaTaskCount(lua_State *L)
+{
+    lua_pushinteger(L, static_cast<lua_Integer>(GetRuntime(L)->GetTaskScheduler().GetTaskCount()));
+    return 1;
+}
+
+int LuaMusicNew(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const char *path = nullptr;
+    bool apply_looping = false;
+    bool looping = false;
+    bool apply_volume = false;
+    float volume = 0.0f;
+    bool apply_pitch = false;
+    float pitch = 0.0f;
+    bool auto_play = false;
+
+    if (lua_istable(L, 1))
+    {
+        path = GetTableStringFieldReq(L, 1, "path", "leo.audio.newMusic");
+        if (TableHasField(L, 1, "looping"))
+        {
+            looping = GetTableBoolFieldReq(L, 1, "looping", "leo.audio.newMusic");
+            apply_looping = true;
+        }
+        if (TableHasField(L, 1, "volume"))
+        {
+            volume = GetTableFloatFieldOpt(L, 1, "volume", 0.0f);
+            apply_volume = true;
+        }
+        if (TableHasField(L, 1, "pitch"))
+        {
+            pitch = GetTableFloatFieldOpt(L, 1, "pitch", 0.0f);
+            apply_pitch = true;
+        }
+        auto_play = GetTableBoolFieldOpt(L, 1, "play", false) || GetTableBoolFieldOpt(L, 1, "playing", false);
+    }
+    else
+    {
+        path = luaL_checkstring(L, 1);
+    }
+    try
+    {
+        LuaMusic *ud = static_cast<LuaMusic *>(lua_newuserdata(L, sizeof(LuaMusic)));
+        new (&ud->music) engine::Music(engine::Music::LoadFromVfs(runtime->GetVfs(), path));
+        if (apply_looping)
+        {
+            ud->music.SetLooping(looping);
+        }
+        if (apply_volume)
+        {
+            ud->music.SetVolume(volume);
+        }
+        if (apply_pitch)
+        {
+            ud->music.SetPitch(pitch);
+        }
+        if (auto_play)
+        {
+            ud->music.Play();
+        }
+        luaL_getmetatable(L, kMusicMeta);
+        lua_setmetatable(L, -2);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+}
+
+int LuaMusicGc(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    ud->music.Reset();
+    return 0;
+}
+
+int LuaMusicPlay(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    ud->music.Play();
+    return 0;
+}
+
+int LuaMusicPause(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    ud->music.Pause();
+    return 0;
+}
+
+int LuaMusicStop(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    ud->music.Stop();
+    return 0;
+}
+
+int LuaMusicIsPlaying(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    lua_pushboolean(L, ud->music.IsPlaying());
+    return 1;
+}
+
+int LuaMusicSetLooping(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    bool looping = false;
+    if (lua_istable(L, 2))
+    {
+        looping = GetTableBoolFieldReq(L, 2, "looping", "music.setLooping");
+    }
+    else
+    {
+        looping = lua_toboolean(L, 2);
+    }
+    ud->music.SetLooping(looping);
+    return 0;
+}
+
+int LuaMusicSetVolume(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    float volume = 0.0f;
+    if (lua_istable(L, 2))
+    {
+        volume = GetTableNumberFieldReq(L, 2, "volume", "music.setVolume");
+    }
+    else
+    {
+        volume = static_cast<float>(luaL_checknumber(L, 2));
+    }
+    ud->music.SetVolume(volume);
+    return 0;
+}
+
+int LuaMusicSetPitch(lua_State *L)
+{
+    LuaMusic *ud = CheckMusic(L, 1);
+    float pitch = 0.0f;
+    if (lua_istable(L, 2))
+    {
+        pitch = GetTableNumberFieldReq(L, 2, "pitch", "music.setPitch");
+    }
+    else
+    {
+        pitch = static_cast<float>(luaL_checknumber(L, 2));
+    }
+    ud->music.SetPitch(pitch);
+    return 0;
+}
+
+int LuaKeyboardIsDown(lua_State *L)
+{
+    LuaKeyboard *ud = CheckKeyboard(L, 1);
+    const char *name = luaL_checkstring(L, 2);
+    engine::Key key = ParseKey(name);
+    lua_pushboolean(L, ud->state.IsDown(key));
+    return 1;
+}
+
+int LuaKeyboardIsPressed(lua_State *L)
+{
+    LuaKeyboard *ud = CheckKeyboard(L, 1);
+    const char *name = luaL_checkstring(L, 2);
+    engine::Key key = ParseKey(name);
+    lua_pushboolean(L, ud->state.IsPressed(key));
+    return 1;
+}
+
+int LuaKeyboardIsReleased(lua_State *L)
+{
+    LuaKeyboard *ud = CheckKeyboard(L, 1);
+    const char *name = luaL_checkstring(L, 2);
+    engine::Key key = ParseKey(name);
+    lua_pushboolean(L, ud->state.IsReleased(key));
+    return 1;
+}
+
+int LuaMouseIsDown(lua_State *L)
+{
+    LuaMouse *ud = CheckMouse(L, 1);
+    const char *name = luaL_checkstring(L, 2);
+    engine::MouseButton button = ParseMouseButton(name);
+    lua_pushboolean(L, ud->state.IsButtonDown(button));
+    return 1;
+}
+
+int LuaMouseIsPressed(lua_State *L)
+{
+    LuaMouse *ud = CheckMouse(L, 1);
+    const char *name = luaL_checkstring(L, 2);
+    engine::MouseButton button = ParseMouseButton(name);
+    lua_pushboolean(L, ud->state.IsButtonPressed(button));
+    return 1;
+}
+
+int LuaMouseIsReleased(lua_State *L)
+{
+    LuaMouse *ud = CheckMouse(L, 1);
+    const char *name = luaL_checkstring(L, 2);
+    engine::MouseButton button = ParseMouseButton(name);
+    lua_pushboolean(L, ud->state.IsButtonReleased(button));
+    return 1;
+}
+
+int LuaMouseSetCursorVisible(lua_State *L)
+{
+    int arg_index = 1;
     if (!lua_isboolean(L, 1))
     {
         if (lua_isboolean(L, 2))
@@ -3369,13 +4422,103 @@ int LuaTimeTickDelta(lua_State *L)
     return 1;
 }
 
-int LuaTimeNow(lua_State *L)
+int LuaTimeAlpha(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    lua_pushnumber(L, runtime->GetRenderAlpha());
+    return 1;
+}
+
+int LuaTimeNow(lua_State *L)
+{
+    Uint64 counter = SDL_GetPerformanceCounter();
+    Uint64 freq = SDL_GetPerformanceFrequency();
+    double seconds = freq > 0 ? static_cast<double>(counter) / static_cast<double>(freq) : 0.0;
+    lua_pushnumber(L, seconds);
+    return 1;
+}
+
+int LuaProfileBegin(lua_State *L)
+{
+    size_t length = 0;
+    const char *name = luaL_checklstring(L, 1, &length);
+    engine::Profiler &profiler = engine::Profiler::Get();
+    if (!profiler.IsEnabled())
+    {
+        return 0;
+    }
+
+    bool opened = false;
+    try
+    {
+        opened = GetRuntime(L)->BeginScriptZone(profiler.InternName(std::string_view(name, length)));
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+    if (!opened)
+    {
+        return luaL_error(L, "leo.profile.begin nested deeper than %d zones",
+                          static_cast<int>(engine::Profiler::kMaxDepth));
+    }
+    return 0;
+}
+
+int LuaProfileFinish(lua_State *L)
+{
+    if (!GetRuntime(L)->EndScriptZone() && engine::Profiler::Get().IsEnabled())
+    {
+        return luaL_error(L, "leo.profile.finish called without a matching leo.profile.begin");
+    }
+    return 0;
+}
+
+int LuaProfileSetEnabled(lua_State *L)
+{
+    engine::Profiler::Get().SetEnabled(lua_toboolean(L, 1));
+    return 0;
+}
+
+int LuaProfileIsEnabled(lua_State *L)
+{
+    lua_pushboolean(L, engine::Profiler::Get().IsEnabled());
+    return 1;
+}
+
+int LuaProfileSetOverlay(lua_State *L)
+{
+    engine::Profiler::Get().SetOverlayVisible(lua_toboolean(L, 1));
+    return 0;
+}
+
+int LuaProfileIsOverlayVisible(lua_State *L)
+{
+    lua_pushboolean(L, engine::Profiler::Get().IsOverlayVisible());
+    return 1;
+}
+
+int LuaProfileDump(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const char *path = luaL_checkstring(L, 1);
+    try
+    {
+        std::string trace = engine::Profiler::Get().ToChromeTrace();
+        runtime->GetVfs().WriteAll(path, trace.data(), trace.size());
+    }
+    catch (const std::exception &e)
+    {
+        return luaL_error(L, "%s", e.what());
+    }
+    return 0;
+}
+
+int LuaProfileClear(lua_State *L)
 {
-    Uint64 counter = SDL_GetPerformanceCounter();
-    Uint64 freq = SDL_GetPerformanceFrequency();
-    double seconds = freq > 0 ? static_cast<double>(counter) / static_cast<double>(freq) : 0.0;
-    lua_pushnumber(L, seconds);
-    return 1;
+    (void)L;
+    engine::Profiler::Get().Clear();
+    return 0;
 }
 
 int LuaFsRead(lua_State *L)
@@ -3611,6 +4754,229 @@ int LuaFsDeleteDir(lua_State *L)
     return 0;
 }
 
+int LuaBufferNew(lua_State *L)
+{
+    const char *type_name = luaL_checkstring(L, 1);
+    BufferType type = BufferType::Float;
+    if (SDL_strcasecmp(type_name, "int") == 0)
+    {
+        type = BufferType::Int;
+    }
+    else if (SDL_strcasecmp(type_name, "float") != 0)
+    {
+        return luaL_argerror(L, 1, "buffer type must be \"float\" or \"int\"");
+    }
+
+    bool from_table = lua_istable(L, 2);
+    lua_Integer length = from_table ? static_cast<lua_Integer>(lua_rawlen(L, 2)) : luaL_checkinteger(L, 2);
+    luaL_argcheck(L, length >= 0 && length <= kMaxBufferLength, 2, "buffer length out of range");
+
+    size_t data_size = static_cast<size_t>(length) * sizeof(float);
+    LuaBuffer *buffer = static_cast<LuaBuffer *>(lua_newuserdata(L, sizeof(LuaBuffer) + data_size));
+    buffer->type = type;
+    buffer->length = static_cast<size_t>(length);
+    SDL_memset(buffer + 1, 0, data_size);
+    luaL_getmetatable(L, kBufferMeta);
+    lua_setmetatable(L, -2);
+
+    if (from_table)
+    {
+        for (lua_Integer i = 0; i < length; ++i)
+        {
+            lua_rawgeti(L, 2, i + 1);
+            if (type == BufferType::Float)
+            {
+                GetBufferFloats(buffer)[i] = static_cast<float>(luaL_checknumber(L, -1));
+            }
+            else
+            {
+                GetBufferInts(buffer)[i] = static_cast<Sint32>(luaL_checkinteger(L, -1));
+            }
+            lua_pop(L, 1);
+        }
+    }
+    return 1;
+}
+
+size_t CheckBufferIndex(lua_State *L, const LuaBuffer *buffer, int arg)
+{
+    lua_Integer index = luaL_checkinteger(L, arg);
+    luaL_argcheck(L, index >= 1 && static_cast<size_t>(index) <= buffer->length, arg, "buffer index out of range");
+    return static_cast<size_t>(index - 1);
+}
+
+int LuaBufferGet(lua_State *L)
+{
+    LuaBuffer *buffer = CheckBuffer(L, 1);
+    size_t index = CheckBufferIndex(L, buffer, 2);
+    if (buffer->type == BufferType::Float)
+    {
+        lua_pushnumber(L, GetBufferFloats(buffer)[index]);
+    }
+    else
+    {
+        lua_pushinteger(L, GetBufferInts(buffer)[index]);
+    }
+    return 1;
+}
+
+int LuaBufferSet(lua_State *L)
+{
+    LuaBuffer *buffer = CheckBuffer(L, 1);
+    size_t index = CheckBufferIndex(L, buffer, 2);
+    if (buffer->type == BufferType::Float)
+    {
+        GetBufferFloats(buffer)[index] = static_cast<float>(luaL_checknumber(L, 3));
+    }
+    else
+    {
+        GetBufferInts(buffer)[index] = static_cast<Sint32>(luaL_checkinteger(L, 3));
+    }
+    return 0;
+}
+
+int LuaBufferFill(lua_State *L)
+{
+    LuaBuffer *buffer = CheckBuffer(L, 1);
+    if (buffer->type == BufferType::Float)
+    {
+        std::fill_n(GetBufferFloats(buffer), buffer->length, static_cast<float>(luaL_checknumber(L, 2)));
+    }
+    else
+    {
+        std::fill_n(GetBufferInts(buffer), buffer->length, static_cast<Sint32>(luaL_checkinteger(L, 2)));
+    }
+    return 0;
+}
+
+int LuaBufferGetType(lua_State *L)
+{
+    LuaBuffer *buffer = CheckBuffer(L, 1);
+    lua_pushstring(L, buffer->type == BufferType::Float ? "float" : "int");
+    return 1;
+}
+
+int LuaBufferLen(lua_State *L)
+{
+    LuaBuffer *buffer = CheckBuffer(L, 1);
+    lua_pushinteger(L, static_cast<lua_Integer>(buffer->length));
+    return 1;
+}
+
+int LuaBufferIntegrate(lua_State *L)
+{
+    LuaBuffer *values = CheckFloatBuffer(L, 1);
+    LuaBuffer *rates = CheckFloatBuffer(L, 2);
+    float dt = static_cast<float>(luaL_checknumber(L, 3));
+    size_t count = CheckBufferCount(L, 4, std::min(values->length, rates->length));
+    leo::BufferKernels::Integrate(GetBufferFloats(values), GetBufferFloats(rates), count, dt);
+    return 0;
+}
+
+int LuaBufferClamp(lua_State *L)
+{
+    LuaBuffer *values = CheckFloatBuffer(L, 1);
+    float min_value = static_cast<float>(luaL_checknumber(L, 2));
+    float max_value = static_cast<float>(luaL_checknumber(L, 3));
+    size_t count = CheckBufferCount(L, 4, values->length);
+    leo::BufferKernels::Clamp(GetBufferFloats(values), count, min_value, max_value);
+    return 0;
+}
+
+int LuaBufferWrap(lua_State *L)
+{
+    LuaBuffer *values = CheckFloatBuffer(L, 1);
+    float min_value = static_cast<float>(luaL_checknumber(L, 2));
+    float max_value = static_cast<float>(luaL_checknumber(L, 3));
+    size_t count = CheckBufferCount(L, 4, values->length);
+    leo::BufferKernels::Wrap(GetBufferFloats(values), count, min_value, max_value);
+    return 0;
+}
+
+int LuaBufferDistance(lua_State *L)
+{
+    LuaBuffer *xs = CheckFloatBuffer(L, 1);
+    LuaBuffer *ys = CheckFloatBuffer(L, 2);
+    SDL_FPoint point = ReadPointPair(L, 3);
+    LuaBuffer *out = CheckFloatBuffer(L, 5);
+    size_t count = std::min({xs->length, ys->length, out->length});
+    leo::BufferKernels::DistanceToPoint(GetBufferFloats(xs), GetBufferFloats(ys), count, point,
+                                        GetBufferFloats(out));
+    return 0;
+}
+
+int LuaBufferNearest(lua_State *L)
+{
+    LuaBuffer *xs = CheckFloatBuffer(L, 1);
+    LuaBuffer *ys = CheckFloatBuffer(L, 2);
+    SDL_FPoint point = ReadPointPair(L, 3);
+    float max_distance = static_cast<float>(luaL_optnumber(L, 5, std::numeric_limits<lua_Number>::infinity()));
+    size_t count = std::min(xs->length, ys->length);
+
+    float distance = 0.0f;
+    size_t index =
+        leo::BufferKernels::Nearest(GetBufferFloats(xs), GetBufferFloats(ys), count, point, max_distance, &distance);
+    if (index == count)
+    {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushinteger(L, static_cast<lua_Integer>(index + 1));
+    lua_pushnumber(L, distance);
+    return 2;
+}
+
+int LuaMemoryGetStats(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    engine::LuaMemoryStats stats = runtime->GetMemoryStats();
+    lua_createtable(L, 0, 8);
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.live_bytes));
+    lua_setfield(L, -2, "liveBytes");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.live_blocks));
+    lua_setfield(L, -2, "liveBlocks");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.allocation_count));
+    lua_setfield(L, -2, "allocations");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.allocated_bytes));
+    lua_setfield(L, -2, "allocatedBytes");
+    lua_pushinteger(L, static_cast<lua_Integer>(stats.pool_bytes));
+    lua_setfield(L, -2, "poolBytes");
+    lua_pushinteger(L, static_cast<lua_Integer>(runtime->GetFrameAllocationCount()));
+    lua_setfield(L, -2, "frameAllocations");
+    lua_pushinteger(L, static_cast<lua_Integer>(runtime->GetFrameAllocatedBytes()));
+    lua_setfield(L, -2, "frameAllocatedBytes");
+    lua_pushnumber(L, static_cast<lua_Number>(runtime->GetFrameGcNs()) / 1000000.0);
+    lua_setfield(L, -2, "frameGcMs");
+    return 1;
+}
+
+int LuaMemorySetGcMode(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    const char *name = luaL_checkstring(L, 1);
+    engine::GcMode mode = engine::GcMode::Incremental;
+    if (!engine::ParseGcMode(name, &mode))
+    {
+        return luaL_error(L, "Unknown GC mode: %s", name);
+    }
+    runtime->SetGcMode(mode);
+    return 0;
+}
+
+int LuaMemoryGetGcMode(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    lua_pushstring(L, runtime->GetGcMode() == engine::GcMode::Generational ? "generational" : "incremental");
+    return 1;
+}
+
+int LuaMemoryGetUsage(lua_State *L)
+{
+    engine::LuaRuntime *runtime = GetRuntime(L);
+    lua_pushinteger(L, static_cast<lua_Integer>(runtime->GetMemoryStats().live_bytes));
+    return 1;
+}
+
 int LuaQuit(lua_State *L)
 {
     engine::LuaRuntime *runtime = GetRuntime(L);
@@ -3618,6 +4984,191 @@ int LuaQuit(lua_State *L)
     return 0;
 }
 
+// Resolves name against the templates in package.path through the VFS, so modules load from mounted archives as well
+// as directories. Pushes the loader and the resolved path and returns 2, or pushes the paths tried and returns 1 like
+// the standard searchers. Returns -1 with the message pushed when a module is found but fails to load; the caller
+// raises it once the locals here are destroyed.
+int SearchVfsModule(lua_State *L, engine::LuaRuntime *runtime, const char *name)
+{
+    lua_getglobal(L, "package");
+    lua_getfield(L, -1, "path");
+    std::string templates = lua_isstring(L, -1) ? lua_tostring(L, -1) : "";
+    lua_pop(L, 2);
+
+    std::string module_path = name;
+    std::replace(module_path.begin(), module_path.end(), '.', '/');
+
+    std::string tried;
+    size_t start = 0;
+    while (start <= templates.size())
+    {
+        size_t end = templates.find(';', start);
+        if (end == std::string::npos)
+        {
+            end = templates.size();
+        }
+        std::string candidate = templates.substr(start, end - start);
+        start = end + 1;
+        if (candidate.empty())
+        {
+            continue;
+        }
+        for (size_t mark = candidate.find('?'); mark != std::string::npos; mark = candidate.find('?', mark))
+        {
+            candidate.replace(mark, 1, module_path);
+            mark += module_path.size();
+        }
+
+        if (!PHYSFS_exists(candidate.c_str()))
+        {
+            tried += tried.empty() ? "no file '" : "\n\tno file '";
+            tried += candidate;
+            tried += "'";
+            continue;
+        }
+
+        void *data = nullptr;
+        size_t size = 0;
+        try
+        {
+            runtime->GetVfs().ReadAll(candidate.c_str(), &data, &size);
+        }
+        catch (const std::exception &e)
+        {
+            lua_pushfstring(L, "error loading module '%s' from file '%s':\n\t%s", name, candidate.c_str(), e.what());
+            return -1;
+        }
+
+        std::string chunk_name = std::string("@") + candidate;
+        int status = runtime->LoadChunk(L, data ? data : "", size, chunk_name.c_str());
+        SDL_free(data);
+        if (status != LUA_OK)
+        {
+            lua_pushfstring(L, "error loading module '%s' from file '%s':\n\t%s", name, candidate.c_str(),
+                            lua_tostring(L, -1));
+            lua_remove(L, -2);
+            return -1;
+        }
+        lua_pushstring(L, candidate.c_str());
+        return 2;
+    }
+
+    lua_pushstring(L, tried.c_str());
+    return 1;
+}
+
+int LuaVfsSearcher(lua_State *L)
+{
+    const char *name = luaL_checkstring(L, 1);
+    int results = SearchVfsModule(L, GetRuntime(L), name);
+    if (results < 0)
+    {
+        return lua_error(L);
+    }
+    return results;
+}
+
+// Replaces the host filesystem Lua searcher with LuaVfsSearcher. package.preload and the C searchers stay in place.
+void InstallVfsSearcher(lua_State *L)
+{
+    lua_getglobal(L, "package");
+    lua_pushstring(L, kModulePath);
+    lua_setfield(L, -2, "path");
+    lua_getfield(L, -1, "searchers");
+    lua_pushcfunction(L, LuaVfsSearcher);
+    lua_rawseti(L, -2, 2);
+    lua_pop(L, 2);
+}
+
+// Leaves the module named by upvalue 1 on the stack, requiring it on first use. The result is kept in the proxy's
+// metatable so later accesses never go through require again, whatever the module returned. A table module also
+// becomes the proxy's __index and __newindex so accesses skip these functions entirely.
+void ResolveLazyModule(lua_State *L)
+{
+    const bool has_meta = lua_getmetatable(L, 1);
+    if (has_meta)
+    {
+        if (lua_getfield(L, -1, kLazyModuleField) != LUA_TNIL)
+        {
+            lua_remove(L, -2);
+            return;
+        }
+        lua_pop(L, 1);
+    }
+
+    lua_getglobal(L, "require");
+    lua_pushvalue(L, lua_upvalueindex(1));
+    lua_call(L, 1, 1);
+    if (!has_meta)
+    {
+        return;
+    }
+    lua_pushvalue(L, -1);
+    lua_setfield(L, -3, kLazyModuleField);
+    if (lua_istable(L, -1))
+    {
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, "__index");
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, "__newindex");
+    }
+    lua_remove(L, -2);
+}
+
+int LuaLazyModuleIndex(lua_State *L)
+{
+    ResolveLazyModule(L);
+    lua_pushvalue(L, 2);
+    lua_gettable(L, -2);
+    return 1;
+}
+
+int LuaLazyModuleNewIndex(lua_State *L)
+{
+    ResolveLazyModule(L);
+    lua_pushvalue(L, 2);
+    lua_pushvalue(L, 3);
+    lua_settable(L, -3);
+    return 0;
+}
+
+int LuaLazyModuleCall(lua_State *L)
+{
+    ResolveLazyModule(L);
+    lua_replace(L, 1);
+    lua_call(L, lua_gettop(L) - 1, LUA_MULTRET);
+    return lua_gettop(L);
+}
+
+int LuaLazyRequire(lua_State *L)
+{
+    luaL_checkstring(L, 1);
+    lua_settop(L, 1);
+
+    lua_getglobal(L, "package");
+    lua_getfield(L, -1, "loaded");
+    lua_getfield(L, -1, lua_tostring(L, 1));
+    if (!lua_isnil(L, -1))
+    {
+        return 1;
+    }
+    lua_pop(L, 3);
+
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushvalue(L, 1);
+    lua_pushcclosure(L, LuaLazyModuleIndex, 1);
+    lua_setfield(L, -2, "__index");
+    lua_pushvalue(L, 1);
+    lua_pushcclosure(L, LuaLazyModuleNewIndex, 1);
+    lua_setfield(L, -2, "__newindex");
+    lua_pushvalue(L, 1);
+    lua_pushcclosure(L, LuaLazyModuleCall, 1);
+    lua_setfield(L, -2, "__call");
+    lua_setmetatable(L, -2);
+    return 1;
+}
+
 void RegisterTextureMeta(lua_State *L)
 {
     luaL_newmetatable(L, kTextureMeta);
@@ -3631,6 +5182,23 @@ void RegisterTextureMeta(lua_State *L)
     lua_pop(L, 1);
 }
 
+void RegisterAtlasMeta(lua_State *L)
+{
+    luaL_newmetatable(L, kAtlasMeta);
+    lua_pushcfunction(L, LuaAtlasGc);
+    lua_setfield(L, -2, "__gc");
+
+    lua_newtable(L);
+    lua_pushcfunction(L, LuaAtlasGet);
+    lua_setfield(L, -2, "get");
+    lua_pushcfunction(L, LuaAtlasGetImageCount);
+    lua_setfield(L, -2, "getImageCount");
+    lua_pushcfunction(L, LuaAtlasGetPageCount);
+    lua_setfield(L, -2, "getPageCount");
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+}
+
 void RegisterTiledMapMeta(lua_State *L)
 {
     luaL_newmetatable(L, kTiledMapMeta);
@@ -3683,6 +5251,8 @@ void RegisterAnimationMeta(lua_State *L)
     lua_setfield(L, -2, "update");
     lua_pushcfunction(L, LuaAnimationDraw);
     lua_setfield(L, -2, "draw");
+    lua_pushcfunction(L, LuaAnimationDrawBatch);
+    lua_setfield(L, -2, "drawBatch");
     lua_setfield(L, -2, "__index");
     lua_pop(L, 1);
 }
@@ -3723,6 +5293,31 @@ void RegisterSoundMeta(lua_State *L)
     lua_setfield(L, -2, "setVolume");
     lua_pushcfunction(L, LuaSoundSetPitch);
     lua_setfield(L, -2, "setPitch");
+    lua_pushcfunction(L, LuaSoundSetMaxVoices);
+    lua_setfield(L, -2, "setMaxVoices");
+    lua_pushcfunction(L, LuaSoundGetMaxVoices);
+    lua_setfield(L, -2, "getMaxVoices");
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+}
+
+void RegisterFutureMeta(lua_State *L)
+{
+    luaL_newmetatable(L, kFutureMeta);
+    lua_pushcfunction(L, LuaFutureGc);
+    lua_setfield(L, -2, "__gc");
+
+    lua_newtable(L);
+    lua_pushcfunction(L, LuaFutureIsDone);
+    lua_setfield(L, -2, "isDone");
+    lua_pushcfunction(L, LuaFutureIsReady);
+    lua_setfield(L, -2, "isReady");
+    lua_pushcfunction(L, LuaFutureGetError);
+    lua_setfield(L, -2, "getError");
+    lua_pushcfunction(L, LuaFutureGet);
+    lua_setfield(L, -2, "get");
+    lua_pushcfunction(L, LuaFutureAwait);
+    lua_setfield(L, -2, "await");
     lua_setfield(L, -2, "__index");
     lua_pop(L, 1);
 }
@@ -3822,10 +5417,20 @@ void RegisterGraphics(lua_State *L)
     lua_newtable(L);
     lua_pushcfunction(L, LuaGraphicsNewImage);
     lua_setfield(L, -2, "newImage");
+    lua_pushcfunction(L, LuaGraphicsNewImageAsync);
+    lua_setfield(L, -2, "newImageAsync");
+    lua_pushcfunction(L, LuaGraphicsNewCanvas);
+    lua_setfield(L, -2, "newCanvas");
+    lua_pushcfunction(L, LuaGraphicsSetCanvas);
+    lua_setfield(L, -2, "setCanvas");
+    lua_pushcfunction(L, LuaGraphicsNewAtlas);
+    lua_setfield(L, -2, "newAtlas");
     lua_pushcfunction(L, LuaGraphicsDraw);
     lua_setfield(L, -2, "draw");
     lua_pushcfunction(L, LuaGraphicsDrawEx);
     lua_setfield(L, -2, "drawEx");
+    lua_pushcfunction(L, LuaGraphicsDrawBatch);
+    lua_setfield(L, -2, "drawBatch");
     lua_pushcfunction(L, LuaGraphicsSetColor);
     lua_setfield(L, -2, "setColor");
     lua_pushcfunction(L, LuaGraphicsClear);
@@ -3866,6 +5471,10 @@ void RegisterGraphics(lua_State *L)
     lua_setfield(L, -2, "beginCamera");
     lua_pushcfunction(L, LuaGraphicsEndCamera);
     lua_setfield(L, -2, "endCamera");
+    lua_pushcfunction(L, LuaGraphicsPurgeTextureCache);
+    lua_setfield(L, -2, "purgeTextureCache");
+    lua_pushcfunction(L, LuaGraphicsGetTextureCacheStats);
+    lua_setfield(L, -2, "getTextureCacheStats");
 }
 
 void RegisterWindow(lua_State *L)
@@ -3884,6 +5493,8 @@ void RegisterFont(lua_State *L)
     lua_newtable(L);
     lua_pushcfunction(L, LuaFontNew);
     lua_setfield(L, -2, "new");
+    lua_pushcfunction(L, LuaFontNewAsync);
+    lua_setfield(L, -2, "newAsync");
     lua_pushcfunction(L, LuaFontSet);
     lua_setfield(L, -2, "set");
     lua_pushcfunction(L, LuaFontPrintCurrent);
@@ -3895,8 +5506,14 @@ void RegisterAudio(lua_State *L)
     lua_newtable(L);
     lua_pushcfunction(L, LuaSoundNew);
     lua_setfield(L, -2, "newSound");
+    lua_pushcfunction(L, LuaAudioNewSoundAsync);
+    lua_setfield(L, -2, "newSoundAsync");
     lua_pushcfunction(L, LuaMusicNew);
     lua_setfield(L, -2, "newMusic");
+    lua_pushcfunction(L, LuaAudioSetVoiceStealPolicy);
+    lua_setfield(L, -2, "setVoiceStealPolicy");
+    lua_pushcfunction(L, LuaAudioGetVoiceStats);
+    lua_setfield(L, -2, "getVoiceStats");
 }
 
 void RegisterAnimation(lua_State *L)
@@ -3965,10 +5582,104 @@ void RegisterTime(lua_State *L)
     lua_setfield(L, -2, "ticks");
     lua_pushcfunction(L, LuaTimeTickDelta);
     lua_setfield(L, -2, "tickDelta");
+    lua_pushcfunction(L, LuaTimeAlpha);
+    lua_setfield(L, -2, "alpha");
     lua_pushcfunction(L, LuaTimeNow);
     lua_setfield(L, -2, "now");
 }
 
+void RegisterProfile(lua_State *L)
+{
+    lua_newtable(L);
+    lua_pushcfunction(L, LuaProfileBegin);
+    lua_setfield(L, -2, "begin");
+    lua_pushcfunction(L, LuaProfileFinish);
+    lua_setfield(L, -2, "finish");
+    lua_pushcfunction(L, LuaProfileSetEnabled);
+    lua_setfield(L, -2, "setEnabled");
+    lua_pushcfunction(L, LuaProfileIsEnabled);
+    lua_setfield(L, -2, "isEnabled");
+    lua_pushcfunction(L, LuaProfileSetOverlay);
+    lua_setfield(L, -2, "setOverlay");
+    lua_pushcfunction(L, LuaProfileIsOverlayVisible);
+    lua_setfield(L, -2, "isOverlayVisible");
+    lua_pushcfunction(L, LuaProfileDump);
+    lua_setfield(L, -2, "dump");
+    lua_pushcfunction(L, LuaProfileClear);
+    lua_setfield(L, -2, "clear");
+}
+
+void RegisterBufferMeta(lua_State *L)
+{
+    luaL_newmetatable(L, kBufferMeta);
+    lua_pushcfunction(L, LuaBufferLen);
+    lua_setfield(L, -2, "__len");
+
+    lua_newtable(L);
+    lua_pushcfunction(L, LuaBufferGet);
+    lua_setfield(L, -2, "get");
+    lua_pushcfunction(L, LuaBufferSet);
+    lua_setfield(L, -2, "set");
+    lua_pushcfunction(L, LuaBufferFill);
+    lua_setfield(L, -2, "fill");
+    lua_pushcfunction(L, LuaBufferGetType);
+    lua_setfield(L, -2, "getType");
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+}
+
+void RegisterBuffer(lua_State *L)
+{
+    lua_newtable(L);
+    lua_pushcfunction(L, LuaBufferNew);
+    lua_setfield(L, -2, "new");
+    lua_pushcfunction(L, LuaBufferIntegrate);
+    lua_setfield(L, -2, "integrate");
+    lua_pushcfunction(L, LuaBufferClamp);
+    lua_setfield(L, -2, "clamp");
+    lua_pushcfunction(L, LuaBufferWrap);
+    lua_setfield(L, -2, "wrap");
+    lua_pushcfunction(L, LuaBufferDistance);
+    lua_setfield(L, -2, "distance");
+    lua_pushcfunction(L, LuaBufferNearest);
+    lua_setfield(L, -2, "nearest");
+}
+
+void RegisterMemory(lua_State *L)
+{
+    lua_newtable(L);
+    lua_pushcfunction(L, LuaMemoryGetStats);
+    lua_setfield(L, -2, "getStats");
+    lua_pushcfunction(L, LuaMemoryGetUsage);
+    lua_setfield(L, -2, "getUsage");
+    lua_pushcfunction(L, LuaMemorySetGcMode);
+    lua_setfield(L, -2, "setGcMode");
+    lua_pushcfunction(L, LuaMemoryGetGcMode);
+    lua_setfield(L, -2, "getGcMode");
+}
+
+void RegisterTask(lua_State *L)
+{
+    lua_newtable(L);
+    lua_setfield(L, LUA_REGISTRYINDEX, kTaskRegistryKey);
+
+    lua_newtable(L);
+    lua_pushcfunction(L, LuaTaskSpawn);
+    lua_setfield(L, -2, "spawn");
+    lua_pushcfunction(L, LuaTaskWait);
+    lua_setfield(L, -2, "wait");
+    lua_pushcfunction(L, LuaTaskWaitFrames);
+    lua_setfield(L, -2, "waitFrames");
+    lua_pushcfunction(L, LuaTaskAwait);
+    lua_setfield(L, -2, "await");
+    lua_pushcfunction(L, LuaTaskCancel);
+    lua_setfield(L, -2, "cancel");
+    lua_pushcfunction(L, LuaTaskIsAlive);
+    lua_setfield(L, -2, "isAlive");
+    lua_pushcfunction(L, LuaTaskCount);
+    lua_setfield(L, -2, "count");
+}
+
 void RegisterFs(lua_State *L)
 {
     lua_newtable(L);
@@ -4055,64 +5766,91 @@ void RegisterCollision(lua_State *L)
     lua_pushcfunction(L, LuaCollisionCheckPointPoly);
     lua_setfield(L, -2, "checkPointPoly");
     lua_pushcfunction(L, LuaCollisionCheckLines);
-    lua_setfield(L, -2, "checkLines");
-}
-
-void PushKeyboard(lua_State *L, const engine::KeyboardState &state)
-{
-    LuaKeyboard *ud = static_cast<LuaKeyboard *>(lua_newuserdata(L, sizeof(LuaKeyboard)));
-    ud->state = state;
-    luaL_getmetatable(L, kKeyboardMeta);
-    lua_setmetatable(L, -2);
+    lua_setfield(L, -2, "checkLines");
+    lua_pushcfunction(L, LuaCollisionQueryCircle);
+    lua_setfield(L, -2, "queryCircle");
+    lua_pushcfunction(L, LuaCollisionQueryRec);
+    lua_setfield(L, -2, "queryRec");
 }
 
-void PushMouse(lua_State *L, const engine::MouseState &state)
+template <typename T> T *GetInputField(lua_State *L, int table_index, const char *field, const char *meta)
 {
-    LuaMouse *ud = static_cast<LuaMouse *>(lua_newuserdata(L, sizeof(LuaMouse)));
-    ud->state = state;
-    luaL_getmetatable(L, kMouseMeta);
-    lua_setmetatable(L, -2);
-}
+    lua_getfield(L, table_index, field);
+    T *ud = static_cast<T *>(luaL_testudata(L, -1, meta));
+    lua_pop(L, 1);
+    if (ud)
+    {
+        return ud;
+    }
 
-void PushGamepad(lua_State *L, const engine::GamepadState &state)
-{
-    LuaGamepad *ud = static_cast<LuaGamepad *>(lua_newuserdata(L, sizeof(LuaGamepad)));
-    ud->state = state;
-    luaL_getmetatable(L, kGamepadMeta);
+    // The script replaced or cleared the field; put a fresh object back so later ticks reuse it again.
+    table_index = lua_absindex(L, table_index);
+    ud = static_cast<T *>(lua_newuserdata(L, sizeof(T)));
+    new (ud) T{};
+    luaL_getmetatable(L, meta);
     lua_setmetatable(L, -2);
+    lua_setfield(L, table_index, field);
+    return ud;
 }
 
-void PushInputFrame(lua_State *L, const leo::Engine::InputFrame &input)
+// Pushes the input frame table. The table and its keyboard, mouse and gamepad userdata are created once and kept
+// in the registry; each tick only overwrites their state in place so steady-state updates allocate nothing.
+void PushInputFrame(lua_State *L, const leo::Engine::InputFrame &input, int &frame_ref)
 {
-    lua_newtable(L);
+    if (frame_ref == LUA_NOREF)
+    {
+        lua_newtable(L);
+        lua_createtable(L, 2, 0);
+        lua_setfield(L, -2, "gamepads");
+        frame_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, frame_ref);
     lua_pushboolean(L, input.quit_requested);
     lua_setfield(L, -2, "quit");
     lua_pushinteger(L, input.frame_index);
     lua_setfield(L, -2, "frame");
 
-    PushKeyboard(L, input.keyboard);
-    lua_setfield(L, -2, "keyboard");
+    GetInputField<LuaKeyboard>(L, -1, "keyboard", kKeyboardMeta)->state = input.keyboard;
+    GetInputField<LuaMouse>(L, -1, "mouse", kMouseMeta)->state = input.mouse;
 
-    PushMouse(L, input.mouse);
-    lua_setfield(L, -2, "mouse");
-
-    lua_newtable(L);
+    lua_getfield(L, -1, "gamepads");
+    if (!lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        lua_createtable(L, 2, 0);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, "gamepads");
+    }
     for (int i = 0; i < 2; ++i)
     {
-        PushGamepad(L, input.gamepads[i]);
-        lua_rawseti(L, -2, i + 1);
+        lua_rawgeti(L, -1, i + 1);
+        LuaGamepad *ud = static_cast<LuaGamepad *>(luaL_testudata(L, -1, kGamepadMeta));
+        lua_pop(L, 1);
+        if (!ud)
+        {
+            ud = static_cast<LuaGamepad *>(lua_newuserdata(L, sizeof(LuaGamepad)));
+            new (ud) LuaGamepad{};
+            luaL_getmetatable(L, kGamepadMeta);
+            lua_setmetatable(L, -2);
+            lua_rawseti(L, -2, i + 1);
+        }
+        ud->state = input.gamepads[i];
     }
-    lua_setfield(L, -2, "gamepads");
+    lua_pop(L, 1);
 }
 
 void RegisterLeo(lua_State *L)
 {
     RegisterTextureMeta(L);
+    RegisterAtlasMeta(L);
     RegisterTiledMapMeta(L);
     RegisterAnimationMeta(L);
     RegisterFontMeta(L);
     RegisterSoundMeta(L);
     RegisterMusicMeta(L);
+    RegisterFutureMeta(L);
+    RegisterBufferMeta(L);
     RegisterKeyboardMeta(L);
     RegisterMouseMeta(L);
     RegisterGamepadMeta(L);
@@ -4146,6 +5884,18 @@ void RegisterLeo(lua_State *L)
     RegisterTime(L);
     lua_setfield(L, -2, "time");
 
+    RegisterProfile(L);
+    lua_setfield(L, -2, "profile");
+
+    RegisterMemory(L);
+    lua_setfield(L, -2, "memory");
+
+    RegisterBuffer(L);
+    lua_setfield(L, -2, "buffer");
+
+    RegisterTask(L);
+    lua_setfield(L, -2, "task");
+
     RegisterFs(L);
     lua_setfield(L, -2, "fs");
 
@@ -4161,6 +5911,9 @@ void RegisterLeo(lua_State *L)
     lua_pushcfunction(L, LuaQuit);
     lua_setfield(L, -2, "quit");
 
+    lua_pushcfunction(L, LuaLazyRequire);
+    lua_setfield(L, -2, "lazyRequire");
+
     lua_setglobal(L, "leo");
 }
 
@@ -4169,15 +5922,37 @@ void RegisterLeo(lua_State *L)
 namespace engine
 {
 
+bool ParseGcMode(const char *name, GcMode *out_mode) noexcept
+{
+    if (SDL_strcasecmp(name, "incremental") == 0)
+    {
+        *out_mode = GcMode::Incremental;
+        return true;
+    }
+    if (SDL_strcasecmp(name, "generational") == 0)
+    {
+        *out_mode = GcMode::Generational;
+        return true;
+    }
+    return false;
+}
+
 LuaRuntime::LuaRuntime() noexcept
-    : L(nullptr), vfs(nullptr), window(nullptr), renderer(nullptr), config(nullptr), tick_index(0), tick_dt(0.0f),
-      loaded(false), quit_requested(false), draw_color({255, 255, 255, 255}), active_camera(nullptr),
-      window_mode(WindowMode::Windowed), current_font_ref(LUA_NOREF), current_font_ptr(nullptr), current_font_size(0)
+    : L(nullptr), vfs(nullptr), jobs(nullptr), window(nullptr), renderer(nullptr), config(nullptr), tick_index(0),
+      tick_dt(0.0f), render_alpha(0.0f), loaded(false), quit_requested(false), draw_color({255, 255, 255, 255}),
+      active_camera(nullptr), window_mode(WindowMode::Windowed), current_font_ref(LUA_NOREF), current_font_ptr(nullptr),
+      current_font_size(0), input_frame_ref(LUA_NOREF), sprite_batch(), texture_cache(), asset_loader(),
+      script_cache(), allocator(), frame_start_stats(), frame_allocations(0), frame_allocated_bytes(0),
+      gc_mode(GcMode::Incremental), gc_paced(false), gc_idle(false), gc_trigger_bytes(0), frame_gc_ns(0),
+      task_scheduler(), due_tasks(), running_task(0), running_thread(nullptr), script_zones(0), canvases(),
+      active_canvas(), screen_camera(nullptr)
 {
 }
 
 LuaRuntime::~LuaRuntime()
 {
+    // Stop the loader first so no worker is still decoding into assets the Lua state is about to release.
+    asset_loader.reset();
     if (L)
     {
         lua_close(L);
@@ -4185,21 +5960,52 @@ LuaRuntime::~LuaRuntime()
     }
 }
 
-void LuaRuntime::Init(VFS &vfs_ref, SDL_Window *window_ref, SDL_Renderer *renderer_ref, const engine::Config &cfg)
+void LuaRuntime::Init(VFS &vfs_ref, SDL_Window *window_ref, SDL_Renderer *renderer_ref, const engine::Config &cfg,
+                      JobSystem *jobs_ref)
 {
     vfs = &vfs_ref;
+    jobs = jobs_ref;
     window = window_ref;
     renderer = renderer_ref;
     config = &cfg;
     window_mode = cfg.window_mode;
+    input_frame_ref = LUA_NOREF;
+    sprite_batch.SetRenderer(renderer_ref);
+    if (renderer_ref)
+    {
+        texture_cache = std::make_unique<TextureCache>(vfs_ref, renderer_ref);
+    }
+    // Decodes share the engine's job workers when it has any, rather than a second pool on the same cores.
+    if (HasDeterministicAssets(cfg))
+    {
+        asset_loader = std::make_unique<AssetLoader>(0u);
+    }
+    else if (jobs_ref && jobs_ref->GetWorkerCount() > 0)
+    {
+        asset_loader = std::make_unique<AssetLoader>(*jobs_ref);
+    }
+    else
+    {
+        asset_loader = std::make_unique<AssetLoader>(ResolveAssetWorkers());
+    }
+    if (!cfg.disable_script_cache)
+    {
+        script_cache = std::make_unique<ScriptCache>(vfs_ref);
+    }
 
-    L = luaL_newstate();
+    allocator = std::make_unique<LuaAllocator>(cfg);
+    L = lua_newstate(LuaAllocator::Allocate, allocator.get());
     if (!L)
     {
         throw std::runtime_error("Failed to create Lua state");
     }
+    lua_atpanic(L, LuaPanic);
+    frame_start_stats = allocator->GetStats();
+    gc_paced = false;
+    SetGcMode(cfg.gc_mode);
 
     luaL_openlibs(L);
+    InstallVfsSearcher(L);
 
     lua_pushlightuserdata(L, this);
     lua_setfield(L, LUA_REGISTRYINDEX, kRuntimeRegistryKey);
@@ -4209,6 +6015,7 @@ void LuaRuntime::Init(VFS &vfs_ref, SDL_Window *window_ref, SDL_Renderer *render
 
 void LuaRuntime::LoadScript(const char *vfs_path)
 {
+    LEO_PROFILE_SCOPE("LuaRuntime::LoadScript");
     if (!vfs_path || !*vfs_path)
     {
         throw std::runtime_error("LuaRuntime requires a script path");
@@ -4226,26 +6033,63 @@ void LuaRuntime::LoadScript(const char *vfs_path)
         throw std::runtime_error("LuaRuntime received empty script buffer");
     }
 
+    // Modules next to the entry script resolve before those at the root of the mount.
+    std::string script_dir = vfs_path;
+    size_t slash = script_dir.find_last_of('/');
+    script_dir = slash == std::string::npos ? std::string() : script_dir.substr(0, slash + 1);
+    if (!script_dir.empty())
+    {
+        std::string module_path = script_dir + "?.lua;" + script_dir + "?/init.lua;" + kModulePath;
+        lua_getglobal(L, "package");
+        lua_pushstring(L, module_path.c_str());
+        lua_setfield(L, -2, "path");
+        lua_pop(L, 1);
+    }
+
     std::string chunk_name = std::string("@") + vfs_path;
-    int load_result = luaL_loadbuffer(L, static_cast<const char *>(data), size, chunk_name.c_str());
+    int load_result = LoadChunk(L, data, size, chunk_name.c_str());
     SDL_free(data);
     if (load_result != LUA_OK)
     {
-        std::string error = lua_tostring(L, -1);
-        lua_pop(L, 1);
-        throw std::runtime_error(error);
+        throw std::runtime_error(PopError(L));
     }
 
-    if (lua_pcall(L, 0, 0, 0) != LUA_OK)
+    int status = lua_pcall(L, 0, 0, 0);
+    CloseScriptZones();
+    if (status != LUA_OK)
     {
-        std::string error = lua_tostring(L, -1);
-        lua_pop(L, 1);
-        throw std::runtime_error(error);
+        throw std::runtime_error(PopError(L));
     }
 
     loaded = true;
 }
 
+int LuaRuntime::LoadChunk(lua_State *state, const void *data, size_t size, const char *chunk_name)
+{
+    if (script_cache)
+    {
+        return script_cache->Load(state, data, size, chunk_name);
+    }
+    return luaL_loadbuffer(state, static_cast<const char *>(data), size, chunk_name);
+}
+
+void LuaRuntime::SetRandomSeed(Uint64 seed)
+{
+    if (!L)
+    {
+        throw std::runtime_error("LuaRuntime::SetRandomSeed called before Init");
+    }
+
+    lua_getglobal(L, "math");
+    lua_getfield(L, -1, "randomseed");
+    lua_remove(L, -2);
+    lua_pushinteger(L, static_cast<lua_Integer>(seed));
+    if (lua_pcall(L, 1, 0, 0) != LUA_OK)
+    {
+        throw std::runtime_error(PopError(L));
+    }
+}
+
 void LuaRuntime::SetFrameInfo(Uint32 tick, float dt)
 {
     tick_index = tick;
@@ -4268,16 +6112,17 @@ void LuaRuntime::CallLoad()
     }
 
     lua_remove(L, -2);
-    if (lua_pcall(L, 0, 0, 0) != LUA_OK)
+    int status = lua_pcall(L, 0, 0, 0);
+    CloseScriptZones();
+    if (status != LUA_OK)
     {
-        std::string error = lua_tostring(L, -1);
-        lua_pop(L, 1);
-        throw std::runtime_error(error);
+        throw std::runtime_error(PopError(L));
     }
 }
 
 void LuaRuntime::CallUpdate(float dt, const ::leo::Engine::InputFrame &input)
 {
+    LEO_PROFILE_SCOPE("LuaRuntime::CallUpdate");
     if (!loaded)
     {
         return;
@@ -4285,30 +6130,96 @@ void LuaRuntime::CallUpdate(float dt, const ::leo::Engine::InputFrame &input)
 
     lua_getglobal(L, "leo");
     lua_getfield(L, -1, "update");
-    if (!lua_isfunction(L, -1))
+    lua_remove(L, -2);
+    if (lua_isfunction(L, -1))
+    {
+        lua_pushnumber(L, dt);
+        PushInputFrame(L, input, input_frame_ref);
+        int status = lua_pcall(L, 2, 0, 0);
+        CloseScriptZones();
+        if (status != LUA_OK)
+        {
+            throw std::runtime_error(PopError(L));
+        }
+    }
+    else
+    {
+        lua_pop(L, 1);
+    }
+
+    // Tasks spawned by this update start on the same tick.
+    UpdateTasks(dt);
+}
+
+void LuaRuntime::UpdateTasks(float dt)
+{
+    LEO_PROFILE_SCOPE("LuaRuntime::UpdateTasks");
+    due_tasks.clear();
+    task_scheduler.Advance(static_cast<double>(dt), due_tasks);
+    if (due_tasks.empty())
     {
-        lua_pop(L, 2);
         return;
     }
 
-    lua_remove(L, -2);
-    lua_pushnumber(L, dt);
-    PushInputFrame(L, input);
-    if (lua_pcall(L, 2, 0, 0) != LUA_OK)
+    lua_getfield(L, LUA_REGISTRYINDEX, kTaskRegistryKey);
+    for (TaskId id : due_tasks)
     {
-        std::string error = lua_tostring(L, -1);
+        // An earlier task in this tick may have cancelled this one.
+        if (!task_scheduler.IsAlive(id))
+        {
+            continue;
+        }
+        // The thread stays on the main stack while it runs so cancelling itself cannot let it be collected.
+        lua_rawgeti(L, -1, static_cast<lua_Integer>(id));
+        lua_State *co = lua_tothread(L, -1);
+        if (!co)
+        {
+            lua_pop(L, 1);
+            task_scheduler.Cancel(id);
+            continue;
+        }
+
+        // A task that has not started yet has its function and spawn arguments on its stack.
+        int nargs = lua_status(co) == LUA_OK ? lua_gettop(co) - 1 : 0;
+        int nresults = 0;
+        running_task = id;
+        running_thread = co;
+        int status = lua_resume(co, L, nargs, &nresults);
+        running_task = 0;
+        running_thread = nullptr;
+        CloseScriptZones();
+
+        if (status == LUA_YIELD)
+        {
+            // Plain coroutine.yield (or future:await) made no wait request; run the task again next tick.
+            lua_pop(co, nresults);
+            task_scheduler.Suspend(id);
+            lua_pop(L, 1);
+            continue;
+        }
+
+        task_scheduler.Cancel(id);
+        ForgetTask(L, id);
+        if (status != LUA_OK)
+        {
+            std::string error = PopError(co);
+            lua_pop(L, 2);
+            throw std::runtime_error(error);
+        }
         lua_pop(L, 1);
-        throw std::runtime_error(error);
     }
+    lua_pop(L, 1);
 }
 
-void LuaRuntime::CallDraw()
+void LuaRuntime::CallDraw(float alpha)
 {
+    LEO_PROFILE_SCOPE("LuaRuntime::CallDraw");
     if (!loaded)
     {
         return;
     }
 
+    render_alpha = alpha;
     lua_getglobal(L, "leo");
     lua_getfield(L, -1, "draw");
     if (!lua_isfunction(L, -1))
@@ -4318,11 +6229,18 @@ void LuaRuntime::CallDraw()
     }
 
     lua_remove(L, -2);
-    if (lua_pcall(L, 0, 0, 0) != LUA_OK)
+    lua_pushnumber(L, alpha);
+    int status = lua_pcall(L, 1, 0, 0);
+    CloseScriptZones();
+    sprite_batch.Flush();
+    // A canvas left bound would swallow the rest of the frame, including the overlay.
+    if (active_canvas)
     {
-        std::string error = lua_tostring(L, -1);
-        lua_pop(L, 1);
-        throw std::runtime_error(error);
+        SetCanvas(nullptr);
+    }
+    if (status != LUA_OK)
+    {
+        throw std::runtime_error(PopError(L));
     }
 }
 
@@ -4342,11 +6260,11 @@ void LuaRuntime::CallShutdown()
     }
 
     lua_remove(L, -2);
-    if (lua_pcall(L, 0, 0, 0) != LUA_OK)
+    int status = lua_pcall(L, 0, 0, 0);
+    CloseScriptZones();
+    if (status != LUA_OK)
     {
-        std::string error = lua_tostring(L, -1);
-        lua_pop(L, 1);
-        throw std::runtime_error(error);
+        throw std::runtime_error(PopError(L));
     }
 }
 
@@ -4420,6 +6338,64 @@ float LuaRuntime::GetTickDt() const noexcept
     return tick_dt;
 }
 
+float LuaRuntime::GetRenderAlpha() const noexcept
+{
+    return render_alpha;
+}
+
+size_t LuaRuntime::GetMemoryUsage() const noexcept
+{
+    if (!L)
+    {
+        return 0;
+    }
+
+    return static_cast<size_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 + static_cast<size_t>(lua_gc(L, LUA_GCCOUNTB, 0));
+}
+
+LuaMemoryStats LuaRuntime::GetMemoryStats() const noexcept
+{
+    if (!allocator)
+    {
+        return LuaMemoryStats{};
+    }
+    return allocator->GetStats();
+}
+
+Uint64 LuaRuntime::GetFrameAllocationCount() const noexcept
+{
+    return frame_allocations;
+}
+
+Uint64 LuaRuntime::GetFrameAllocatedBytes() const noexcept
+{
+    return frame_allocated_bytes;
+}
+
+Uint64 LuaRuntime::GetFrameGcNs() const noexcept
+{
+    return frame_gc_ns;
+}
+
+GcMode LuaRuntime::GetGcMode() const noexcept
+{
+    return gc_mode;
+}
+
+void LuaRuntime::SetGcMode(GcMode mode)
+{
+    if (!L)
+    {
+        throw std::runtime_error("LuaRuntime::SetGcMode called before Init");
+    }
+
+    ApplyGcMode(L, mode, gc_paced);
+    gc_mode = mode;
+    // Switching modes finishes any cycle in progress; measure the next trigger from here.
+    gc_idle = true;
+    gc_trigger_bytes = 0;
+}
+
 SDL_Color LuaRuntime::GetDrawColor() const noexcept
 {
     return draw_color;
@@ -4463,4 +6439,225 @@ void LuaRuntime::ClearCurrentFontRef(lua_State *state)
     current_font_size = 0;
 }
 
+SpriteBatch &LuaRuntime::GetSpriteBatch() noexcept
+{
+    return sprite_batch;
+}
+
+void LuaRuntime::FlushSprites()
+{
+    sprite_batch.Flush();
+}
+
+TextureCache *LuaRuntime::GetTextureCache() const noexcept
+{
+    return texture_cache.get();
+}
+
+AssetLoader &LuaRuntime::GetAssetLoader() const
+{
+    if (!asset_loader)
+    {
+        throw std::runtime_error("LuaRuntime asset loader is not initialized");
+    }
+    return *asset_loader;
+}
+
+JobSystem *LuaRuntime::GetJobSystem() const noexcept
+{
+    return jobs;
+}
+
+std::shared_ptr<Texture> LuaRuntime::CreateCanvas(int width, int height, bool preserve)
+{
+    if (!renderer)
+    {
+        throw std::runtime_error("LuaRuntime::CreateCanvas requires a renderer");
+    }
+
+    canvases.erase(std::remove_if(canvases.begin(), canvases.end(),
+                                  [](const std::weak_ptr<Canvas> &entry) { return entry.expired(); }),
+                   canvases.end());
+    std::shared_ptr<Canvas> canvas = std::make_shared<Canvas>(renderer, width, height, preserve);
+    canvases.push_back(canvas);
+    // The texture shares ownership of its canvas, so draws, animations and setCanvas all keep it alive.
+    return std::shared_ptr<Texture>(canvas, &canvas->GetTexture());
+}
+
+bool LuaRuntime::IsCanvasTarget(const Texture &texture) const noexcept
+{
+    return active_canvas && &active_canvas->GetTexture() == &texture;
+}
+
+void LuaRuntime::SetCanvas(const Texture *target)
+{
+    std::shared_ptr<Canvas> canvas;
+    if (target)
+    {
+        for (const std::weak_ptr<Canvas> &entry : canvases)
+        {
+            std::shared_ptr<Canvas> candidate = entry.lock();
+            if (candidate && &candidate->GetTexture() == target)
+            {
+                canvas = std::move(candidate);
+                break;
+            }
+        }
+        if (!canvas)
+        {
+            throw std::runtime_error("LuaRuntime::SetCanvas target is not a canvas");
+        }
+    }
+    if (canvas == active_canvas)
+    {
+        return;
+    }
+
+    sprite_batch.Flush();
+    if (active_canvas && active_canvas->IsPreserved())
+    {
+        active_canvas->Snapshot();
+    }
+    if (!SDL_SetRenderTarget(renderer, canvas ? canvas->GetTexture().handle : nullptr))
+    {
+        throw std::runtime_error(std::string("LuaRuntime::SetCanvas failed: ") + SDL_GetError());
+    }
+
+    // Canvases are drawn in their own pixel coordinates. The screen's camera is set aside while one is bound and
+    // comes back with the screen; viewports need no handling because SDL keeps one per render target.
+    if (!active_canvas)
+    {
+        screen_camera = active_camera;
+    }
+    active_camera = canvas ? nullptr : screen_camera;
+    active_canvas = std::move(canvas);
+}
+
+void LuaRuntime::RestoreCanvases(bool device_reset)
+{
+    sprite_batch.Flush();
+    for (const std::weak_ptr<Canvas> &entry : canvases)
+    {
+        if (std::shared_ptr<Canvas> canvas = entry.lock())
+        {
+            canvas->Restore(device_reset);
+        }
+    }
+}
+
+TaskScheduler &LuaRuntime::GetTaskScheduler() noexcept
+{
+    return task_scheduler;
+}
+
+bool LuaRuntime::BeginScriptZone(const char *name)
+{
+    if (!Profiler::Get().BeginZone(name))
+    {
+        return false;
+    }
+    script_zones++;
+    return true;
+}
+
+bool LuaRuntime::EndScriptZone()
+{
+    if (script_zones == 0)
+    {
+        return false;
+    }
+    script_zones--;
+    Profiler::Get().EndZone();
+    return true;
+}
+
+void LuaRuntime::CloseScriptZones()
+{
+    while (script_zones > 0)
+    {
+        EndScriptZone();
+    }
+}
+
+TaskId LuaRuntime::GetRunningTask(const lua_State *thread) const noexcept
+{
+    return thread && thread == running_thread ? running_task : 0;
+}
+
+void LuaRuntime::UpdateAssets()
+{
+    if (!asset_loader)
+    {
+        return;
+    }
+    LEO_PROFILE_SCOPE("LuaRuntime::UpdateAssets");
+    if (config && HasDeterministicAssets(*config))
+    {
+        asset_loader->Update(std::numeric_limits<Uint64>::max());
+        return;
+    }
+    Uint64 budget_us = config && config->asset_budget_us > 0 ? config->asset_budget_us : kDefaultAssetBudgetUs;
+    asset_loader->Update(budget_us * 1000);
+}
+
+Uint64 LuaRuntime::CollectGarbage(Uint64 slack_ns)
+{
+    frame_gc_ns = 0;
+    if (!L)
+    {
+        return 0;
+    }
+    LEO_PROFILE_SCOPE("LuaRuntime::CollectGarbage");
+    if (!gc_paced)
+    {
+        ApplyGcMode(L, gc_mode, true);
+        gc_paced = true;
+    }
+
+    size_t live_bytes = GetMemoryUsage();
+    if (gc_idle && live_bytes < gc_trigger_bytes)
+    {
+        return 0;
+    }
+    gc_idle = false;
+
+    Uint64 budget_us = config && config->gc_budget_us > 0 ? config->gc_budget_us : kDefaultGcBudgetUs;
+    Uint64 budget_ns = std::min(budget_us * 1000, slack_ns);
+    // Past twice the trigger the budget is not keeping up with the allocation rate; finish the cycle regardless.
+    bool behind = gc_trigger_bytes > 0 && live_bytes >= gc_trigger_bytes * 2;
+
+    Uint64 start_ns = SDL_GetTicksNS();
+    do
+    {
+        // A generational step is a whole minor collection; an incremental step reports the end of a cycle.
+        if (lua_gc(L, LUA_GCSTEP, 0) != 0 || gc_mode == GcMode::Generational)
+        {
+            gc_idle = true;
+            break;
+        }
+    } while (behind || SDL_GetTicksNS() - start_ns < budget_ns);
+
+    if (gc_idle)
+    {
+        size_t pause_percent =
+            gc_mode == GcMode::Generational ? kGcGenerationalPausePercent : kGcIncrementalPausePercent;
+        size_t collected_bytes = GetMemoryUsage();
+        gc_trigger_bytes = collected_bytes + collected_bytes / 100 * pause_percent;
+    }
+    frame_gc_ns = SDL_GetTicksNS() - start_ns;
+    return frame_gc_ns;
+}
+
+void LuaRuntime::EndFrame()
+{
+    if (!allocator)
+    {
+        return;
+    }
+    LuaMemoryStats stats = allocator->GetStats();
+    frame_allocations = stats.allocation_count - frame_start_stats.allocation_count;
+    frame_allocated_bytes = stats.allocated_bytes - frame_start_stats.allocated_bytes;
+    frame_start_stats = stats;
+}
+
 } // namespace engine
@@ -17,13 +17,21 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "leo/asset_cooker.h"
 #include "leo/engine_core.h"
+#include "leo/lua_runtime.h"
+#include "leo/script_cache.h"
+#include "leo/vfs.h"
 
 #include "version.h"
 
 namespace
 {
+// Past this the per-frame GC budget no longer paces anything, and the microsecond count would not fit a Uint32.
+constexpr double kMaxGcBudgetMs = 1000.0;
+
 struct ResourceConfig
 {
     std::string mount_path;
@@ -123,6 +131,45 @@ std::string NormalizeVfsPath(std::string path)
     std::replace(path.begin(), path.end(), '\\', '/');
     return path;
 }
+
+// Fills the Lua bytecode cache for every script in the mount so the next launch skips parsing.
+int CompileScripts(leo::Engine::Config &config)
+{
+    engine::VFS vfs(config);
+    engine::ScriptCache cache(vfs);
+    std::vector<std::string> failures;
+    size_t compiled = cache.CompileAll(failures);
+    for (const std::string &failure : failures)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", failure.c_str());
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Compiled %zu scripts (%llu already cached), %zu failed", compiled,
+                static_cast<unsigned long long>(cache.GetHitCount()), failures.size());
+    return failures.empty() ? 0 : 1;
+}
+
+// Writes the resources under prefix to a pack whose images, maps and font atlases load without decoding.
+int CookAssets(leo::Engine::Config &config, const std::string &prefix, const std::string &pack_path,
+               const std::vector<int> &font_sizes)
+{
+    engine::VFS vfs(config);
+    engine::CookOptions options;
+    if (!font_sizes.empty())
+    {
+        options.font_sizes = font_sizes;
+    }
+    engine::AssetCooker cooker(vfs, options);
+    std::vector<std::string> failures;
+    engine::CookStats stats = cooker.Cook(prefix.c_str(), pack_path.c_str(), failures);
+    for (const std::string &failure : failures)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", failure.c_str());
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                "Cooked %zu images, %zu maps and %zu font atlases into %s (%zu files copied), %zu failed",
+                stats.images, stats.maps, stats.fonts, pack_path.c_str(), stats.copied, failures.size());
+    return failures.empty() ? 0 : 1;
+}
 } // namespace
 
 int main(int argc, char *argv[])
@@ -140,7 +187,22 @@ int main(int argc, char *argv[])
     int logical_height = 720;
     std::string window_mode_str = "borderless-fullscreen";
     int tick_hz = 60;
+    int render_hz = 0;
+    int max_catchup_ticks = 0;
     int num_frame_ticks = 0;
+    bool headless = false;
+    bool benchmark = false;
+    std::string benchmark_output = "-";
+    std::string profile_path;
+    bool profile_overlay = false;
+    std::string record_path;
+    std::string replay_path;
+    bool compile_scripts = false;
+    bool no_script_cache = false;
+    std::string cook_path;
+    std::vector<int> cook_font_sizes;
+    std::string gc_mode_str = "incremental";
+    double gc_budget_ms = 1.0;
     std::string log_level = "info";
     app.add_flag("--version", show_version, "Show version information");
     app.add_option("-r,--resources,--resource", resource_path_arg, "Resource directory/archive to mount");
@@ -154,7 +216,22 @@ int main(int argc, char *argv[])
     app.add_option("--logical-height", logical_height, "Logical render height");
     app.add_option("--window-mode", window_mode_str, "Window mode: windowed, fullscreen, borderless-fullscreen");
     app.add_option("--tick-hz", tick_hz, "Fixed update tick rate");
+    app.add_option("--render-hz", render_hz, "Render rate cap (0 = same as tick rate)");
+    app.add_option("--max-catchup-ticks", max_catchup_ticks, "Max fixed ticks per rendered frame (0 = default of 5)");
     app.add_option("--frame-ticks,--num-frame-ticks", num_frame_ticks, "Number of frame ticks (0 = run until exit)");
+    app.add_flag("--headless", headless, "Run without a visible window, GPU or audio device");
+    app.add_flag("--benchmark", benchmark, "Headless run that reports frame timing as JSON on exit");
+    app.add_option("--benchmark-output", benchmark_output, "Benchmark JSON path (- = stdout)");
+    app.add_option("--profile", profile_path, "Enable the profiler and write a Chrome trace JSON on exit");
+    app.add_flag("--profile-overlay", profile_overlay, "Show the profiler overlay");
+    app.add_option("--record", record_path, "Record every tick's input and the RNG seed to a file");
+    app.add_option("--replay", replay_path, "Replay a recorded input file at uncapped speed, ignoring devices");
+    app.add_flag("--compile-scripts", compile_scripts, "Fill the Lua bytecode cache for every script and exit");
+    app.add_flag("--no-script-cache", no_script_cache, "Always compile Lua scripts from source");
+    app.add_option("--cook", cook_path, "Write the resources to a fast-loading pack archive and exit");
+    app.add_option("--cook-font-size", cook_font_sizes, "Font size to pre-bake when cooking (repeatable)");
+    app.add_option("--gc-mode", gc_mode_str, "Lua collector mode: incremental, generational");
+    app.add_option("--gc-budget-ms", gc_budget_ms, "Lua GC time per frame, spent after present");
     app.add_option("--log-level", log_level, "Log level: verbose, debug, info, warn, error, fatal");
 
     try
@@ -243,11 +320,29 @@ int main(int argc, char *argv[])
         {
             throw std::runtime_error("tick-hz must be positive");
         }
+        if (render_hz < 0)
+        {
+            throw std::runtime_error("render-hz must be >= 0");
+        }
+        if (max_catchup_ticks < 0)
+        {
+            throw std::runtime_error("max-catchup-ticks must be >= 0");
+        }
         if (num_frame_ticks < 0)
         {
             throw std::runtime_error("frame-ticks must be >= 0");
         }
 
+        leo::Engine::GcMode gc_mode = leo::Engine::GcMode::Incremental;
+        if (!engine::ParseGcMode(gc_mode_str.c_str(), &gc_mode))
+        {
+            throw std::runtime_error("Invalid GC mode: " + gc_mode_str);
+        }
+        if (!(gc_budget_ms > 0.0) || gc_budget_ms > kMaxGcBudgetMs)
+        {
+            throw std::runtime_error("gc-budget-ms must be positive and at most 1000");
+        }
+
         leo::Engine::Config config = {.argv0 = argv[0],
                                       .resource_path = resource_path.empty() ? nullptr : resource_path.c_str(),
                                       .script_path = script_path.c_str(),
@@ -261,26 +356,53 @@ int main(int argc, char *argv[])
                                       .window_mode = window_mode,
                                       .tick_hz = tick_hz,
                                       .NumFrameTicks = static_cast<Uint32>(num_frame_ticks),
+                                      .render_hz = render_hz,
+                                      .max_catchup_ticks = static_cast<Uint32>(max_catchup_ticks),
+                                      .gc_budget_us = static_cast<Uint32>(std::max(gc_budget_ms * 1000.0, 1.0)),
+                                      .gc_mode = gc_mode,
+                                      .disable_script_cache = no_script_cache,
+                                      .headless = headless || benchmark,
+                                      .benchmark_path = benchmark ? benchmark_output.c_str() : nullptr,
+                                      .profile_path = profile_path.empty() ? nullptr : profile_path.c_str(),
+                                      .profile_overlay = profile_overlay,
+                                      .record_path = record_path.empty() ? nullptr : record_path.c_str(),
+                                      .replay_path = replay_path.empty() ? nullptr : replay_path.c_str(),
                                       .malloc_fn = SDL_malloc,
                                       .realloc_fn = SDL_realloc,
                                       .free_fn = SDL_free};
 
         SDL_SetLogPriority(SDL_LOG_CATEGORY_APPLICATION, log_priority);
 
+        if (compile_scripts)
+        {
+            return CompileScripts(config);
+        }
+        if (!cook_path.empty())
+        {
+            return CookAssets(config, resource_config.prefix.empty() ? "resources" : resource_config.prefix,
+                              cook_path, cook_font_sizes);
+        }
+
         leo::Engine::Simulation game(config);
         return game.Run();
     }
     catch (const std::exception &e)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "%s", e.what());
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Leo Engine Error", e.what(), nullptr);
+        if (!headless && !benchmark && !compile_scripts && cook_path.empty())
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Leo Engine Error", e.what(), nullptr);
+        }
         return 1;
     }
     catch (...)
     {
         const char *message = "Unknown error";
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "%s", message);
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Leo Engine Error", message, nullptr);
+        if (!headless && !benchmark && !compile_scripts && cook_path.empty())
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Leo Engine Error", message, nullptr);
+        }
         return 1;
     }
 }
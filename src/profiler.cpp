@@ -0,0 +1,330 @@
+#include "leo/profiler.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+
+thread_local engine::ProfileThreadBuffer *t_buffer = nullptr;
+
+void AppendJsonString(std::string &out, const char *text)
+{
+    out += '"';
+    for (const char *p = text; *p; ++p)
+    {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += static_cast<char>(c);
+        }
+        else if (c < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        }
+        else
+        {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+namespace engine
+{
+
+struct ProfileThreadBuffer
+{
+    SDL_ThreadID thread_id;
+    Uint32 index;
+    std::mutex mutex;
+    std::vector<ProfileEvent> ring;
+    size_t head;
+    size_t count;
+    std::vector<ProfileEvent> open;
+};
+
+Profiler &Profiler::Get()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : enabled(false), overlay_visible(false), mutex(), buffers(), names(), frame_summary(),
+      frame_start(SDL_GetPerformanceCounter()), last_frame_ms(0.0), epoch(frame_start)
+{
+}
+
+Profiler::~Profiler() = default;
+
+void Profiler::SetEnabled(bool value) noexcept
+{
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled() const noexcept
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetOverlayVisible(bool visible) noexcept
+{
+    overlay_visible.store(visible, std::memory_order_relaxed);
+}
+
+bool Profiler::IsOverlayVisible() const noexcept
+{
+    return overlay_visible.load(std::memory_order_relaxed);
+}
+
+ProfileThreadBuffer &Profiler::GetThreadBuffer()
+{
+    if (t_buffer)
+    {
+        return *t_buffer;
+    }
+
+    auto buffer = std::make_unique<ProfileThreadBuffer>();
+    buffer->thread_id = SDL_GetCurrentThreadID();
+    buffer->ring.resize(kRingCapacity);
+    buffer->head = 0;
+    buffer->count = 0;
+    buffer->open.reserve(kMaxDepth);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    buffer->index = static_cast<Uint32>(buffers.size());
+    t_buffer = buffer.get();
+    buffers.push_back(std::move(buffer));
+    return *t_buffer;
+}
+
+bool Profiler::BeginZone(const char *name)
+{
+    if (!IsEnabled() || !name)
+    {
+        return false;
+    }
+
+    ProfileThreadBuffer &buffer = GetThreadBuffer();
+    if (buffer.open.size() >= kMaxDepth)
+    {
+        return false;
+    }
+
+    buffer.open.push_back({name, SDL_GetPerformanceCounter(), 0, static_cast<Uint32>(buffer.open.size())});
+    return true;
+}
+
+bool Profiler::EndZone()
+{
+    ProfileThreadBuffer *buffer = t_buffer;
+    if (!buffer || buffer->open.empty())
+    {
+        return false;
+    }
+
+    ProfileEvent event = buffer->open.back();
+    buffer->open.pop_back();
+    event.end = SDL_GetPerformanceCounter();
+
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->ring[buffer->head] = event;
+    buffer->head = (buffer->head + 1) % kRingCapacity;
+    buffer->count = std::min(buffer->count + 1, kRingCapacity);
+    return true;
+}
+
+const char *Profiler::InternName(std::string_view name)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.emplace(name).first->c_str();
+}
+
+void Profiler::EndFrame()
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 previous_start = frame_start;
+    frame_start = now;
+    last_frame_ms = static_cast<double>(now - previous_start) * 1000.0 /
+                    static_cast<double>(SDL_GetPerformanceFrequency());
+    frame_summary.clear();
+    if (!IsEnabled() || !t_buffer)
+    {
+        return;
+    }
+
+    // Walk this thread's ring from newest to oldest; events are stored in completion order.
+    struct Entry
+    {
+        ProfileZoneSummary summary;
+        Uint64 first_start;
+    };
+    std::vector<Entry> entries;
+    ProfileThreadBuffer &buffer = *t_buffer;
+    {
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        for (size_t i = 0; i < buffer.count; ++i)
+        {
+            const ProfileEvent &event = buffer.ring[(buffer.head + kRingCapacity - 1 - i) % kRingCapacity];
+            if (event.end < previous_start)
+            {
+                break;
+            }
+
+            auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry &entry) {
+                return entry.summary.name == event.name && entry.summary.depth == event.depth;
+            });
+            if (it == entries.end())
+            {
+                entries.push_back({{event.name, event.depth, 0, 0.0}, event.start});
+                it = entries.end() - 1;
+            }
+            it->summary.calls++;
+            it->summary.total_ms += static_cast<double>(event.end - event.start);
+            it->first_start = std::min(it->first_start, event.start);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.first_start != b.first_start ? a.first_start < b.first_start : a.summary.depth < b.summary.depth;
+    });
+    double ms_per_tick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    for (Entry &entry : entries)
+    {
+        entry.summary.total_ms *= ms_per_tick;
+        frame_summary.push_back(entry.summary);
+    }
+}
+
+void Profiler::DrawOverlay(SDL_Renderer *renderer) const
+{
+    if (!renderer || !IsOverlayVisible())
+    {
+        return;
+    }
+
+    constexpr float kCharSize = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    constexpr float kLineHeight = kCharSize + 2.0f;
+    constexpr float kMargin = 4.0f;
+    constexpr int kColumns = 48;
+
+    char line[128];
+    std::snprintf(line, sizeof(line), "frame %.2f ms%s", last_frame_ms, IsEnabled() ? "" : " (profiler off)");
+    size_t line_count = 1 + frame_summary.size();
+
+    Uint8 r = 0;
+    Uint8 g = 0;
+    Uint8 b = 0;
+    Uint8 a = 0;
+    SDL_BlendMode blend = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blend);
+
+    SDL_FRect background = {kMargin, kMargin, kColumns * kCharSize + 2.0f * kMargin,
+                            static_cast<float>(line_count) * kLineHeight + 2.0f * kMargin};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(renderer, &background);
+
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    float x = 2.0f * kMargin;
+    float y = 2.0f * kMargin;
+    SDL_RenderDebugText(renderer, x, y, line);
+    for (const ProfileZoneSummary &zone : frame_summary)
+    {
+        y += kLineHeight;
+        int indent = static_cast<int>(std::min<Uint32>(zone.depth, 8)) * 2;
+        std::snprintf(line, sizeof(line), "%*s%-*.*s %8.3f x%u", indent, "", 30 - indent, 30 - indent, zone.name,
+                      zone.total_ms, zone.calls);
+        SDL_RenderDebugText(renderer, x, y, line);
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, blend);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+const std::vector<ProfileZoneSummary> &Profiler::GetFrameSummary() const noexcept
+{
+    return frame_summary;
+}
+
+std::string Profiler::ToChromeTrace() const
+{
+    double us_per_tick = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    std::string out = "{\"traceEvents\":[\n";
+    bool first = true;
+    char number[96];
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::unique_ptr<ProfileThreadBuffer> &buffer : buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        if (!first)
+        {
+            out += ",\n";
+        }
+        first = false;
+        std::snprintf(number, sizeof(number), "%u", buffer->index);
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += number;
+        out += ",\"args\":{\"name\":";
+        std::string thread_name = buffer->index == 0 ? "main" : "thread " + std::to_string(buffer->index);
+        AppendJsonString(out, thread_name.c_str());
+        out += "}}";
+
+        size_t oldest = (buffer->head + kRingCapacity - buffer->count) % kRingCapacity;
+        for (size_t i = 0; i < buffer->count; ++i)
+        {
+            const ProfileEvent &event = buffer->ring[(oldest + i) % kRingCapacity];
+            out += ",\n{\"name\":";
+            AppendJsonString(out, event.name);
+            std::snprintf(number, sizeof(number), ",\"cat\":\"leo\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f",
+                          static_cast<double>(event.start - epoch) * us_per_tick,
+                          static_cast<double>(event.end - event.start) * us_per_tick);
+            out += number;
+            std::snprintf(number, sizeof(number), ",\"pid\":1,\"tid\":%u}", buffer->index);
+            out += number;
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+void Profiler::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::unique_ptr<ProfileThreadBuffer> &buffer : buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->head = 0;
+        buffer->count = 0;
+    }
+    frame_summary.clear();
+}
+
+ProfileScope::ProfileScope(const char *name) noexcept : active(false)
+{
+    try
+    {
+        active = Profiler::Get().BeginZone(name);
+    }
+    catch (...)
+    {
+        active = false;
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (active)
+    {
+        Profiler::Get().EndZone();
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,406 @@
+#include "leo/script_cache.h"
+#include "leo/profiler.h"
+#include "leo/vfs.h"
+#include <SDL3/SDL.h>
+#include <physfs.h>
+#include <lua.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+
+constexpr const char *kCacheDir = "cache/lua/";
+constexpr const char *kScriptExtension = ".lua";
+constexpr const char *kEntryExtension = ".luac";
+
+// Every entry starts with this header. Lua does not verify bytecode, so an entry is only loaded when its header
+// names the exact source it was compiled from.
+constexpr char kEntryMagic[4] = {'L', 'E', 'O', 'C'};
+constexpr Uint32 kEntryVersion = 1;
+constexpr size_t kDigestSize = 32;
+
+using Digest = std::array<unsigned char, kDigestSize>;
+
+// SHA-256 (FIPS 180-4), used so that two scripts never share an entry by accident.
+class Sha256
+{
+  public:
+    void Update(const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        total += size;
+        while (size > 0)
+        {
+            const size_t take = std::min(size, block.size() - used);
+            std::memcpy(block.data() + used, bytes, take);
+            used += take;
+            bytes += take;
+            size -= take;
+            if (used == block.size())
+            {
+                Transform();
+                used = 0;
+            }
+        }
+    }
+
+    Digest Finish()
+    {
+        const Uint64 bits = total * 8;
+        const unsigned char pad = 0x80;
+        Update(&pad, 1);
+        const unsigned char zero = 0;
+        while (used != 56)
+        {
+            Update(&zero, 1);
+        }
+        unsigned char length[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            length[i] = static_cast<unsigned char>(bits >> (56 - 8 * i));
+        }
+        Update(length, sizeof(length));
+
+        Digest digest;
+        for (size_t i = 0; i < kDigestSize; ++i)
+        {
+            digest[i] = static_cast<unsigned char>(state[i / 4] >> (24 - 8 * (i % 4)));
+        }
+        return digest;
+    }
+
+  private:
+    static Uint32 Rotr(Uint32 x, int n)
+    {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    void Transform()
+    {
+        static constexpr Uint32 kRounds[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+        Uint32 w[64];
+        for (int i = 0; i < 16; ++i)
+        {
+            w[i] = (Uint32(block[i * 4]) << 24) | (Uint32(block[i * 4 + 1]) << 16) | (Uint32(block[i * 4 + 2]) << 8) |
+                   Uint32(block[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; ++i)
+        {
+            const Uint32 s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const Uint32 s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        Uint32 a = state[0], b = state[1], c = state[2], d = state[3];
+        Uint32 e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i)
+        {
+            const Uint32 t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + kRounds[i] + w[i];
+            const Uint32 t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    Uint32 state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::array<unsigned char, 64> block = {};
+    size_t used = 0;
+    Uint64 total = 0;
+};
+
+// Bytecode depends on the Lua release and its number types as well as the source and its debug name.
+Digest DigestSource(const void *source, size_t size, const char *chunk_name)
+{
+    static const char kFormat[] = LUA_VERSION_RELEASE;
+    const unsigned char sizes[] = {static_cast<unsigned char>(sizeof(lua_Integer)),
+                                   static_cast<unsigned char>(sizeof(lua_Number)),
+                                   static_cast<unsigned char>(sizeof(void *))};
+
+    Sha256 sha;
+    sha.Update(kFormat, sizeof(kFormat));
+    sha.Update(sizes, sizeof(sizes));
+    sha.Update(chunk_name, std::strlen(chunk_name) + 1);
+    sha.Update(source, size);
+    return sha.Finish();
+}
+
+std::string GetDigestPath(const Digest &digest)
+{
+    // The name only spreads entries out; the header check decides whether an entry matches.
+    char name[32];
+    std::snprintf(name, sizeof(name), "%02x%02x%02x%02x%02x%02x%02x%02x.luac", digest[0], digest[1], digest[2],
+                  digest[3], digest[4], digest[5], digest[6], digest[7]);
+    return std::string(kCacheDir) + name;
+}
+
+void PutLittleEndian(std::string &out, Uint64 value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+    {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+std::string MakeEntryHeader(size_t source_size, const Digest &digest)
+{
+    std::string header(kEntryMagic, sizeof(kEntryMagic));
+    PutLittleEndian(header, kEntryVersion, 4);
+    PutLittleEndian(header, source_size, 8);
+    header.append(reinterpret_cast<const char *>(digest.data()), digest.size());
+    return header;
+}
+
+int WriteChunk(lua_State *L, const void *data, size_t size, void *user_data)
+{
+    (void)L;
+    std::string *out = static_cast<std::string *>(user_data);
+    out->append(static_cast<const char *>(data), size);
+    return 0;
+}
+
+bool HasExtension(const char *path, const char *extension)
+{
+    size_t length = std::strlen(path);
+    size_t extension_length = std::strlen(extension);
+    return length > extension_length && std::strcmp(path + length - extension_length, extension) == 0;
+}
+
+bool IsScriptPath(const char *path)
+{
+    return HasExtension(path, kScriptExtension);
+}
+
+} // namespace
+
+namespace engine
+{
+
+ScriptCache::ScriptCache(VFS &vfs) noexcept : vfs(vfs), hits(0), misses(0), store_failed(false)
+{
+    Prune();
+}
+
+int ScriptCache::Load(lua_State *L, const void *source, size_t size, const char *chunk_name)
+{
+    LEO_PROFILE_SCOPE("ScriptCache::Load");
+    const Digest digest = DigestSource(source, size, chunk_name);
+    const std::string header = MakeEntryHeader(size, digest);
+    const std::string path = GetDigestPath(digest);
+
+    // Entries live in the write dir, which is not mounted over the resources; the scoped read keeps it that way.
+    void *cached = nullptr;
+    size_t cached_size = 0;
+    try
+    {
+        vfs.ReadAllWriteDir(path.c_str(), &cached, &cached_size);
+    }
+    catch (const std::exception &)
+    {
+        cached = nullptr;
+    }
+    if (cached)
+    {
+        const char *bytes = static_cast<const char *>(cached);
+        int status = LUA_ERRSYNTAX;
+        if (cached_size > header.size() && std::memcmp(bytes, header.data(), header.size()) == 0)
+        {
+            status = luaL_loadbufferx(L, bytes + header.size(), cached_size - header.size(), chunk_name, "b");
+            if (status != LUA_OK)
+            {
+                lua_pop(L, 1);
+            }
+        }
+        SDL_free(cached);
+        if (status == LUA_OK)
+        {
+            hits++;
+            return LUA_OK;
+        }
+        // A truncated entry, one from another source, or a file that was not written by the cache; compile from
+        // source and overwrite it.
+    }
+
+    misses++;
+    int status = luaL_loadbuffer(L, static_cast<const char *>(source), size, chunk_name);
+    if (status == LUA_OK)
+    {
+        Store(L, path, header);
+    }
+    return status;
+}
+
+size_t ScriptCache::CompileAll(std::vector<std::string> &failures)
+{
+    char **entries = nullptr;
+    vfs.ListFiles("", &entries);
+
+    lua_State *L = luaL_newstate();
+    if (!L)
+    {
+        vfs.FreeList(entries);
+        throw std::runtime_error("ScriptCache::CompileAll failed to create Lua state");
+    }
+
+    size_t compiled = 0;
+    for (char **it = entries; *it; ++it)
+    {
+        const char *path = *it;
+        if (!IsScriptPath(path))
+        {
+            continue;
+        }
+
+        void *data = nullptr;
+        size_t size = 0;
+        try
+        {
+            vfs.ReadAll(path, &data, &size);
+        }
+        catch (const std::exception &e)
+        {
+            failures.push_back(std::string(path) + ": " + e.what());
+            continue;
+        }
+
+        // Same chunk name LuaRuntime uses, so the runtime finds these entries.
+        std::string chunk_name = std::string("@") + path;
+        int status = Load(L, data, size, chunk_name.c_str());
+        SDL_free(data);
+        if (status == LUA_OK)
+        {
+            compiled++;
+        }
+        else
+        {
+            const char *message = lua_tostring(L, -1);
+            failures.push_back(message ? message : std::string(path) + ": unknown error");
+        }
+        lua_settop(L, 0);
+    }
+
+    lua_close(L);
+    vfs.FreeList(entries);
+    return compiled;
+}
+
+Uint64 ScriptCache::GetHitCount() const noexcept
+{
+    return hits;
+}
+
+Uint64 ScriptCache::GetMissCount() const noexcept
+{
+    return misses;
+}
+
+std::string ScriptCache::GetEntryPath(const void *source, size_t size, const char *chunk_name)
+{
+    return GetDigestPath(DigestSource(source, size, chunk_name));
+}
+
+// Each edit to a script leaves its old entry behind. Keep the newest kMaxEntries; a live entry pruned here is
+// simply compiled and stored again on its next load.
+void ScriptCache::Prune()
+{
+    char **entries = nullptr;
+    try
+    {
+        vfs.ListWriteDir("cache/lua", &entries);
+    }
+    catch (const std::exception &)
+    {
+        // No cache directory yet.
+        return;
+    }
+
+    // The write dir is not mounted for reading, so entry ages come from the real files.
+    const std::filesystem::path write_dir = PHYSFS_getWriteDir() ? PHYSFS_getWriteDir() : "";
+    std::vector<std::pair<std::filesystem::file_time_type, std::string>> files;
+    for (char **it = entries; *it; ++it)
+    {
+        if (!HasExtension(*it, kEntryExtension))
+        {
+            continue;
+        }
+        std::string path = std::string(kCacheDir) + *it;
+        std::error_code ec;
+        std::filesystem::file_time_type modified = std::filesystem::last_write_time(write_dir / path, ec);
+        files.emplace_back(ec ? std::filesystem::file_time_type::min() : modified, std::move(path));
+    }
+    vfs.FreeList(entries);
+    if (files.size() <= kMaxEntries)
+    {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+    for (size_t i = kMaxEntries; i < files.size(); ++i)
+    {
+        try
+        {
+            vfs.DeleteFile(files[i].second.c_str());
+        }
+        catch (const std::exception &e)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to prune Lua bytecode cache: %s", e.what());
+            return;
+        }
+    }
+}
+
+void ScriptCache::Store(lua_State *L, const std::string &path, const std::string &header)
+{
+    if (store_failed)
+    {
+        return;
+    }
+
+    std::string entry = header;
+    if (lua_dump(L, WriteChunk, &entry, 0) != 0 || entry.size() == header.size())
+    {
+        return;
+    }
+
+    try
+    {
+        vfs.WriteAll(path.c_str(), entry.data(), entry.size());
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Lua bytecode cache disabled for this run: %s", e.what());
+        store_failed = true;
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,168 @@
+#include "leo/sprite_batch.h"
+#include <cmath>
+#include <utility>
+
+namespace
+{
+
+// Keeps a single submission well inside what every SDL backend accepts in one call.
+constexpr size_t kMaxBatchSprites = 4096;
+constexpr size_t kMaxBatchVertices = kMaxBatchSprites * 4;
+
+SDL_FColor ToVertexColor(SDL_Color color)
+{
+    constexpr float kInv255 = 1.0f / 255.0f;
+    return {static_cast<float>(color.r) * kInv255, static_cast<float>(color.g) * kInv255,
+            static_cast<float>(color.b) * kInv255, static_cast<float>(color.a) * kInv255};
+}
+
+} // namespace
+
+namespace engine
+{
+
+SpriteBatch::SpriteBatch() noexcept
+    : renderer(nullptr), texture(nullptr), vertices(), indices(), pending_sprites(0), flush_count(0)
+{
+}
+
+SpriteBatch::SpriteBatch(SDL_Renderer *renderer) noexcept
+    : renderer(renderer), texture(nullptr), vertices(), indices(), pending_sprites(0), flush_count(0)
+{
+}
+
+void SpriteBatch::SetRenderer(SDL_Renderer *renderer_ref)
+{
+    if (renderer_ref != renderer)
+    {
+        Flush();
+    }
+    renderer = renderer_ref;
+}
+
+void SpriteBatch::Draw(const Texture &tex, const SpriteDesc &desc)
+{
+    if (!renderer || !tex.handle || tex.width <= 0 || tex.height <= 0)
+    {
+        return;
+    }
+
+    if (texture != tex.handle || vertices.size() >= kMaxBatchVertices)
+    {
+        Flush();
+        texture = tex.handle;
+    }
+
+    const SDL_FRect uv = tex.ToTexCoords(desc.src);
+    float u0 = uv.x;
+    float v0 = uv.y;
+    float u1 = uv.x + uv.w;
+    float v1 = uv.y + uv.h;
+    if (desc.flip & SDL_FLIP_HORIZONTAL)
+    {
+        std::swap(u0, u1);
+    }
+    if (desc.flip & SDL_FLIP_VERTICAL)
+    {
+        std::swap(v0, v1);
+    }
+
+    // Corners relative to the pivot, in TL, TR, BR, BL order.
+    const float left = -desc.center.x;
+    const float top = -desc.center.y;
+    const float right = desc.dst.w - desc.center.x;
+    const float bottom = desc.dst.h - desc.center.y;
+    const SDL_FPoint corners[4] = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+    const SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    const float pivot_x = desc.dst.x + desc.center.x;
+    const float pivot_y = desc.dst.y + desc.center.y;
+    float cos_a = 1.0f;
+    float sin_a = 0.0f;
+    if (desc.angle != 0.0)
+    {
+        cos_a = static_cast<float>(std::cos(desc.angle));
+        sin_a = static_cast<float>(std::sin(desc.angle));
+    }
+
+    const SDL_FColor color = ToVertexColor(desc.color);
+    const int base = static_cast<int>(vertices.size());
+    for (int i = 0; i < 4; ++i)
+    {
+        SDL_Vertex vertex;
+        vertex.position = {pivot_x + corners[i].x * cos_a - corners[i].y * sin_a,
+                           pivot_y + corners[i].x * sin_a + corners[i].y * cos_a};
+        vertex.color = color;
+        vertex.tex_coord = uvs[i];
+        vertices.push_back(vertex);
+    }
+
+    const int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+    indices.insert(indices.end(), quad, quad + 6);
+    ++pending_sprites;
+}
+
+GeometrySpan SpriteBatch::AddGeometry(int vertex_count, int index_count)
+{
+    const size_t vertex_total = vertices.size() + static_cast<size_t>(vertex_count);
+    if (texture || (!vertices.empty() && vertex_total > kMaxBatchVertices))
+    {
+        Flush();
+    }
+
+    const size_t first_vertex = vertices.size();
+    const size_t first_index = indices.size();
+    vertices.resize(first_vertex + static_cast<size_t>(vertex_count));
+    indices.resize(first_index + static_cast<size_t>(index_count));
+    return {vertices.data() + first_vertex, indices.data() + first_index, static_cast<int>(first_vertex)};
+}
+
+void SpriteBatch::Flush()
+{
+    if (renderer && !vertices.empty())
+    {
+        if (texture)
+        {
+            SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()), indices.data(),
+                               static_cast<int>(indices.size()));
+        }
+        else
+        {
+            // Untextured geometry takes the renderer's draw blend mode; shapes always alpha-blend.
+            SDL_BlendMode previous = SDL_BLENDMODE_NONE;
+            SDL_GetRenderDrawBlendMode(renderer, &previous);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_RenderGeometry(renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()), indices.data(),
+                               static_cast<int>(indices.size()));
+            SDL_SetRenderDrawBlendMode(renderer, previous);
+        }
+        ++flush_count;
+    }
+
+    Clear();
+}
+
+void SpriteBatch::Clear() noexcept
+{
+    vertices.clear();
+    indices.clear();
+    pending_sprites = 0;
+    texture = nullptr;
+}
+
+int SpriteBatch::GetPendingSprites() const noexcept
+{
+    return pending_sprites;
+}
+
+Uint32 SpriteBatch::GetFlushCount() const noexcept
+{
+    return flush_count;
+}
+
+void SpriteBatch::ResetStats() noexcept
+{
+    flush_count = 0;
+}
+
+} // namespace engine
@@ -0,0 +1,166 @@
+#include "leo/task_scheduler.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+// Accumulated tick durations drift by a few ULPs; without the slack wait(1) at 60 Hz could take 61 ticks.
+constexpr double kTimeEpsilon = 1.0e-9;
+
+// std::push_heap builds a max-heap, so the later wake compares as smaller to keep the earliest one on top. Equal
+// wake times keep the order the waits were requested in.
+template <typename Wake> bool WakesLater(const Wake &a, const Wake &b)
+{
+    return a.due != b.due ? a.due > b.due : a.order > b.order;
+}
+
+} // namespace
+
+namespace engine
+{
+
+TaskScheduler::TaskScheduler() noexcept
+    : tasks(), ready(), timers(), tick_waits(), waiting(), next_id(1), next_order(0), time(0.0), tick(0)
+{
+}
+
+TaskId TaskScheduler::Spawn()
+{
+    TaskId id = next_id++;
+    if (next_id == 0)
+    {
+        next_id = 1;
+    }
+    tasks[id] = Task{TaskState::Ready, {}};
+    ready.push_back(id);
+    return id;
+}
+
+void TaskScheduler::Sleep(TaskId id, double seconds)
+{
+    Task *task = FindRunning(id);
+    task->state = TaskState::Sleeping;
+    timers.push_back({time + std::max(seconds, 0.0), next_order++, id});
+    std::push_heap(timers.begin(), timers.end(), WakesLater<TimeWake>);
+}
+
+void TaskScheduler::SleepTicks(TaskId id, Uint32 ticks)
+{
+    Task *task = FindRunning(id);
+    task->state = TaskState::Sleeping;
+    tick_waits.push_back({tick + std::max<Uint32>(ticks, 1), next_order++, id});
+    std::push_heap(tick_waits.begin(), tick_waits.end(), WakesLater<TickWake>);
+}
+
+void TaskScheduler::WaitUntil(TaskId id, std::function<bool()> condition)
+{
+    Task *task = FindRunning(id);
+    task->state = TaskState::Waiting;
+    task->condition = std::move(condition);
+    waiting.push_back(id);
+}
+
+void TaskScheduler::Suspend(TaskId id)
+{
+    auto it = tasks.find(id);
+    if (it != tasks.end() && it->second.state == TaskState::Running)
+    {
+        SleepTicks(id, 1);
+    }
+}
+
+bool TaskScheduler::Cancel(TaskId id)
+{
+    // Heap and list entries for the task are skipped once they surface.
+    return tasks.erase(id) > 0;
+}
+
+bool TaskScheduler::IsAlive(TaskId id) const noexcept
+{
+    return tasks.find(id) != tasks.end();
+}
+
+void TaskScheduler::Advance(double dt, std::vector<TaskId> &out)
+{
+    time += dt;
+    tick++;
+
+    auto wake = [this, &out](TaskId id, TaskState expected) {
+        auto it = tasks.find(id);
+        if (it != tasks.end() && it->second.state == expected)
+        {
+            it->second.state = TaskState::Running;
+            out.push_back(id);
+        }
+    };
+
+    std::vector<TaskId> spawned;
+    spawned.swap(ready);
+    for (TaskId id : spawned)
+    {
+        wake(id, TaskState::Ready);
+    }
+
+    while (!timers.empty() && timers.front().due <= time + kTimeEpsilon)
+    {
+        TaskId id = timers.front().id;
+        std::pop_heap(timers.begin(), timers.end(), WakesLater<TimeWake>);
+        timers.pop_back();
+        wake(id, TaskState::Sleeping);
+    }
+
+    while (!tick_waits.empty() && tick_waits.front().due <= tick)
+    {
+        TaskId id = tick_waits.front().id;
+        std::pop_heap(tick_waits.begin(), tick_waits.end(), WakesLater<TickWake>);
+        tick_waits.pop_back();
+        wake(id, TaskState::Sleeping);
+    }
+
+    size_t kept = 0;
+    for (TaskId id : waiting)
+    {
+        auto it = tasks.find(id);
+        if (it == tasks.end() || it->second.state != TaskState::Waiting)
+        {
+            continue;
+        }
+        if (it->second.condition && !it->second.condition())
+        {
+            waiting[kept++] = id;
+            continue;
+        }
+        it->second.condition = nullptr;
+        wake(id, TaskState::Waiting);
+    }
+    waiting.resize(kept);
+}
+
+size_t TaskScheduler::GetTaskCount() const noexcept
+{
+    return tasks.size();
+}
+
+double TaskScheduler::GetTime() const noexcept
+{
+    return time;
+}
+
+Uint64 TaskScheduler::GetTick() const noexcept
+{
+    return tick;
+}
+
+TaskScheduler::Task *TaskScheduler::FindRunning(TaskId id)
+{
+    auto it = tasks.find(id);
+    if (it == tasks.end() || it->second.state != TaskState::Running)
+    {
+        throw std::runtime_error("TaskScheduler wait requested for a task that is not running");
+    }
+    return &it->second;
+}
+
+} // namespace engine
@@ -0,0 +1,344 @@
+#include "leo/texture_atlas.h"
+#include "leo/job_system.h"
+#include "leo/profiler.h"
+#include "leo/vfs.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace
+{
+
+// Matches the largest texture side current GPUs accept; SDL reports the real limit when a page fails to upload.
+constexpr int kMaxPageSize = 16384;
+constexpr int kMaxPadding = 64;
+constexpr const char *kImageExtensions[] = {".png", ".jpg", ".jpeg", ".bmp", ".tga"};
+
+struct Placement
+{
+    size_t page;
+    SDL_Rect region; // The image itself, inside its padded cell
+};
+
+bool HasImageExtension(const char *path)
+{
+    const char *dot = SDL_strrchr(path, '.');
+    if (!dot || SDL_strchr(dot, '/'))
+    {
+        return false;
+    }
+    for (const char *extension : kImageExtensions)
+    {
+        if (SDL_strcasecmp(dot, extension) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Copies image into an RGBA8 page with its top-left at (x, y), then repeats its outermost rows and columns padding
+// times outwards so linear filtering at the edges samples the image rather than a neighbour.
+void BlitExtruded(const engine::DecodedImage &image, unsigned char *page, int page_width, int x, int y, int padding)
+{
+    const size_t row_bytes = static_cast<size_t>(image.width) * 4;
+    for (int row = -padding; row < image.height + padding; ++row)
+    {
+        const int src_row = std::clamp(row, 0, image.height - 1);
+        const unsigned char *src = image.pixels + static_cast<size_t>(src_row) * row_bytes;
+        unsigned char *dst = page + (static_cast<size_t>(y + row) * static_cast<size_t>(page_width) + x) * 4;
+        std::memcpy(dst, src, row_bytes);
+        for (int k = 1; k <= padding; ++k)
+        {
+            std::memcpy(dst - static_cast<size_t>(k) * 4, src, 4);
+            std::memcpy(dst + row_bytes + static_cast<size_t>(k - 1) * 4, src + row_bytes - 4, 4);
+        }
+    }
+}
+
+std::shared_ptr<engine::Texture> UploadPage(SDL_Renderer *renderer, const std::vector<unsigned char> &pixels, int width,
+                                            int height)
+{
+    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height);
+    if (!texture)
+    {
+        throw std::runtime_error(std::string("TextureAtlas::Build failed to create page: ") + SDL_GetError());
+    }
+    if (!SDL_UpdateTexture(texture, nullptr, pixels.data(), width * 4))
+    {
+        SDL_DestroyTexture(texture);
+        throw std::runtime_error(std::string("TextureAtlas::Build failed to upload page: ") + SDL_GetError());
+    }
+    return std::make_shared<engine::Texture>(texture, width, height);
+}
+
+} // namespace
+
+namespace engine
+{
+
+SkylinePacker::SkylinePacker(int width, int height) : skyline(), width(width), height(height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        throw std::runtime_error("SkylinePacker requires a positive size");
+    }
+    skyline.push_back({0, 0, width});
+}
+
+bool SkylinePacker::Insert(int w, int h, SDL_Point *out)
+{
+    if (w <= 0 || h <= 0 || w > width || h > height)
+    {
+        return false;
+    }
+
+    size_t best_index = skyline.size();
+    int best_y = 0;
+    for (size_t i = 0; i < skyline.size(); ++i)
+    {
+        int y = 0;
+        if (Fit(i, w, h, &y) && (best_index == skyline.size() || y < best_y))
+        {
+            best_index = i;
+            best_y = y;
+        }
+    }
+    if (best_index == skyline.size())
+    {
+        return false;
+    }
+
+    const int x = skyline[best_index].x;
+    skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(best_index), Segment{x, best_y + h, w});
+
+    // Trim the segments the new one now covers.
+    for (size_t i = best_index + 1; i < skyline.size();)
+    {
+        const int covered_to = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= covered_to)
+        {
+            break;
+        }
+        const int overlap = covered_to - skyline[i].x;
+        if (overlap < skyline[i].width)
+        {
+            skyline[i].x += overlap;
+            skyline[i].width -= overlap;
+            break;
+        }
+        skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    out->x = x;
+    out->y = best_y;
+    return true;
+}
+
+// A rectangle starting at segment index rests on the highest segment it spans.
+bool SkylinePacker::Fit(size_t index, int w, int h, int *out_y) const
+{
+    if (skyline[index].x + w > width)
+    {
+        return false;
+    }
+
+    int y = 0;
+    int remaining = w;
+    for (size_t i = index; remaining > 0; ++i)
+    {
+        y = std::max(y, skyline[i].y);
+        if (y + h > height)
+        {
+            return false;
+        }
+        remaining -= skyline[i].width;
+    }
+    *out_y = y;
+    return true;
+}
+
+TextureAtlas::TextureAtlas() noexcept : pages(), images()
+{
+}
+
+TextureAtlas TextureAtlas::Build(VFS &vfs, SDL_Renderer *renderer, const std::vector<std::string> &vfs_paths,
+                                 const TextureAtlasOptions &options, JobSystem *jobs)
+{
+    LEO_PROFILE_SCOPE("TextureAtlas::Build");
+    if (!renderer)
+    {
+        throw std::runtime_error("TextureAtlas::Build requires a valid SDL_Renderer");
+    }
+    if (options.page_size <= 0 || options.page_size > kMaxPageSize)
+    {
+        throw std::runtime_error("TextureAtlas::Build page size out of range");
+    }
+    if (options.padding < 0 || options.padding > kMaxPadding)
+    {
+        throw std::runtime_error("TextureAtlas::Build padding out of range");
+    }
+
+    std::vector<std::string> paths;
+    std::unordered_set<std::string> seen;
+    for (const std::string &path : vfs_paths)
+    {
+        if (seen.insert(path).second)
+        {
+            paths.push_back(path);
+        }
+    }
+
+    std::vector<DecodedImage> decoded(paths.size());
+    auto decode = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            try
+            {
+                decoded[i] = TextureLoader::Decode(vfs, paths[i].c_str());
+            }
+            catch (const std::exception &e)
+            {
+                throw std::runtime_error("TextureAtlas::Build failed to load '" + paths[i] + "': " + e.what());
+            }
+        }
+    };
+    if (jobs)
+    {
+        jobs->ParallelFor(paths.size(), 1, decode);
+    }
+    else
+    {
+        decode(0, paths.size());
+    }
+
+    // Tallest first keeps the skyline flat; the index breaks ties so packing does not depend on sort stability.
+    std::vector<size_t> order(paths.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [&decoded](size_t a, size_t b) {
+        if (decoded[a].height != decoded[b].height)
+        {
+            return decoded[a].height > decoded[b].height;
+        }
+        if (decoded[a].width != decoded[b].width)
+        {
+            return decoded[a].width > decoded[b].width;
+        }
+        return a < b;
+    });
+
+    const int padding = options.padding;
+    std::vector<SkylinePacker> packers;
+    std::vector<SDL_Point> extents;
+    std::vector<Placement> placements(paths.size());
+    for (size_t index : order)
+    {
+        const int cell_w = decoded[index].width + padding * 2;
+        const int cell_h = decoded[index].height + padding * 2;
+        if (cell_w > options.page_size || cell_h > options.page_size)
+        {
+            throw std::runtime_error("TextureAtlas::Build image '" + paths[index] + "' does not fit on a " +
+                                     std::to_string(options.page_size) + " page");
+        }
+
+        size_t page = 0;
+        SDL_Point cell = {0, 0};
+        while (page < packers.size() && !packers[page].Insert(cell_w, cell_h, &cell))
+        {
+            ++page;
+        }
+        if (page == packers.size())
+        {
+            packers.emplace_back(options.page_size, options.page_size);
+            extents.push_back({0, 0});
+            packers.back().Insert(cell_w, cell_h, &cell);
+        }
+
+        extents[page].x = std::max(extents[page].x, cell.x + cell_w);
+        extents[page].y = std::max(extents[page].y, cell.y + cell_h);
+        placements[index] = {page, {cell.x + padding, cell.y + padding, decoded[index].width, decoded[index].height}};
+    }
+
+    TextureAtlas atlas;
+    for (size_t page = 0; page < packers.size(); ++page)
+    {
+        const SDL_Point extent = extents[page];
+        std::vector<unsigned char> pixels(static_cast<size_t>(extent.x) * static_cast<size_t>(extent.y) * 4, 0);
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            if (placements[i].page == page)
+            {
+                BlitExtruded(decoded[i], pixels.data(), extent.x, placements[i].region.x, placements[i].region.y,
+                             padding);
+                decoded[i].Reset();
+            }
+        }
+        atlas.pages.push_back(UploadPage(renderer, pixels, extent.x, extent.y));
+    }
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        const Placement &placement = placements[i];
+        atlas.images.emplace(paths[i], std::make_shared<Texture>(atlas.pages[placement.page], placement.region));
+    }
+    return atlas;
+}
+
+std::vector<std::string> TextureAtlas::ListImages(VFS &vfs, const char *vfs_dir)
+{
+    char **entries = nullptr;
+    vfs.ListFiles(vfs_dir, &entries);
+    std::vector<std::string> paths;
+    if (entries)
+    {
+        for (int i = 0; entries[i]; ++i)
+        {
+            if (HasImageExtension(entries[i]))
+            {
+                paths.emplace_back(entries[i]);
+            }
+        }
+        vfs.FreeList(entries);
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+std::shared_ptr<Texture> TextureAtlas::Find(const char *vfs_path) const
+{
+    if (!vfs_path)
+    {
+        return nullptr;
+    }
+    auto it = images.find(vfs_path);
+    return it != images.end() ? it->second : nullptr;
+}
+
+const std::unordered_map<std::string, std::shared_ptr<Texture>> &TextureAtlas::GetImages() const noexcept
+{
+    return images;
+}
+
+const std::vector<std::shared_ptr<Texture>> &TextureAtlas::GetPages() const noexcept
+{
+    return pages;
+}
+
+} // namespace engine
@@ -0,0 +1,121 @@
+#include "leo/texture_cache.h"
+#include <stdexcept>
+#include <utility>
+
+namespace engine
+{
+
+TextureCache::TextureCache(VFS &vfs, SDL_Renderer *renderer) : vfs(vfs), renderer(renderer), hits(0), misses(0)
+{
+    if (!renderer)
+    {
+        throw std::runtime_error("TextureCache requires a valid SDL_Renderer");
+    }
+}
+
+TextureCache::~TextureCache()
+{
+    Clear();
+}
+
+std::shared_ptr<Texture> TextureCache::Acquire(const char *vfs_path)
+{
+    if (!vfs_path || !*vfs_path)
+    {
+        throw std::runtime_error("TextureCache::Acquire requires a non-empty path");
+    }
+
+    std::string key(vfs_path);
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        ++hits;
+        return it->second;
+    }
+
+    TextureLoader loader(vfs, renderer);
+    auto texture = std::make_shared<Texture>(loader.Load(vfs_path));
+    ++misses;
+    entries.emplace(std::move(key), texture);
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureCache::Adopt(const char *vfs_path, Texture texture)
+{
+    if (!vfs_path || !*vfs_path)
+    {
+        throw std::runtime_error("TextureCache::Adopt requires a non-empty path");
+    }
+
+    auto [it, inserted] = entries.try_emplace(vfs_path);
+    if (inserted)
+    {
+        ++misses;
+        it->second = std::make_shared<Texture>(std::move(texture));
+    }
+    else
+    {
+        ++hits;
+    }
+    return it->second;
+}
+
+void TextureCache::Insert(const char *vfs_path, std::shared_ptr<Texture> texture)
+{
+    if (!vfs_path || !*vfs_path || !texture)
+    {
+        throw std::runtime_error("TextureCache::Insert requires a non-empty path and a texture");
+    }
+    entries[vfs_path] = std::move(texture);
+}
+
+bool TextureCache::Contains(const char *vfs_path) const
+{
+    if (!vfs_path)
+    {
+        return false;
+    }
+    return entries.find(vfs_path) != entries.end();
+}
+
+size_t TextureCache::Purge()
+{
+    size_t purged = 0;
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            it = entries.erase(it);
+            ++purged;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return purged;
+}
+
+void TextureCache::Clear() noexcept
+{
+    entries.clear();
+}
+
+TextureCacheStats TextureCache::GetStats() const noexcept
+{
+    TextureCacheStats stats = {};
+    stats.entries = entries.size();
+    stats.hits = hits;
+    stats.misses = misses;
+    for (const auto &entry : entries)
+    {
+        if (entry.second.use_count() == 1)
+        {
+            ++stats.unused_entries;
+        }
+        stats.bytes += static_cast<size_t>(entry.second->width) * static_cast<size_t>(entry.second->height) * 4;
+    }
+    return stats;
+}
+
+} // namespace engine
@@ -1,18 +1,59 @@
 #include "leo/texture_loader.h"
+#include "leo/cooked_asset.h"
+#include "leo/profiler.h"
+#include "leo/texture_cache.h"
 #include <SDL3/SDL.h>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <stb_image.h>
 
+namespace
+{
+
+// The pixels are copied straight out of the view, which is usually a mapping of the pack, into the image.
+engine::DecodedImage DecodeCooked(const engine::VfsView &view)
+{
+    engine::CookedReader reader(view.GetData(), view.GetSize(), engine::kCookedImageTag);
+    const Sint32 width = reader.ReadI32();
+    const Sint32 height = reader.ReadI32();
+    if (width <= 0 || height <= 0 || width > 65536 || height > 65536 ||
+        reader.GetRemaining() != static_cast<size_t>(width) * static_cast<size_t>(height) * 4)
+    {
+        throw std::runtime_error("TextureLoader::Load cooked image has an invalid size");
+    }
+
+    const size_t size = reader.GetRemaining();
+    engine::DecodedImage image;
+    image.pixels = static_cast<unsigned char *>(SDL_malloc(size));
+    if (!image.pixels)
+    {
+        throw std::runtime_error("TextureLoader::Load out of memory for cooked image");
+    }
+    SDL_memcpy(image.pixels, reader.ReadBytes(size), size);
+    image.width = width;
+    image.height = height;
+    return image;
+}
+
+} // namespace
+
 namespace engine
 {
 
-Texture::Texture() noexcept : handle(nullptr), width(0), height(0)
+Texture::Texture() noexcept : handle(nullptr), width(0), height(0), x(0), y(0), page()
 {
 }
 
-Texture::Texture(SDL_Texture *handle, int width, int height) noexcept : handle(handle), width(width), height(height)
+Texture::Texture(SDL_Texture *handle, int width, int height) noexcept
+    : handle(handle), width(width), height(height), x(0), y(0), page()
+{
+}
+
+Texture::Texture(std::shared_ptr<Texture> page, const SDL_Rect &region) noexcept
+    : handle(page ? page->handle : nullptr), width(region.w), height(region.h), x(region.x), y(region.y),
+      page(std::move(page))
 {
 }
 
@@ -21,11 +62,15 @@ Texture::~Texture()
     Reset();
 }
 
-Texture::Texture(Texture &&other) noexcept : handle(other.handle), width(other.width), height(other.height)
+Texture::Texture(Texture &&other) noexcept
+    : handle(other.handle), width(other.width), height(other.height), x(other.x), y(other.y),
+      page(std::move(other.page))
 {
     other.handle = nullptr;
     other.width = 0;
     other.height = 0;
+    other.x = 0;
+    other.y = 0;
 }
 
 Texture &Texture::operator=(Texture &&other) noexcept
@@ -39,24 +84,87 @@ Texture &Texture::operator=(Texture &&other) noexcept
     handle = other.handle;
     width = other.width;
     height = other.height;
+    x = other.x;
+    y = other.y;
+    page = std::move(other.page);
     other.handle = nullptr;
     other.width = 0;
     other.height = 0;
+    other.x = 0;
+    other.y = 0;
     return *this;
 }
 
 void Texture::Reset() noexcept
 {
-    if (handle)
+    // A sub-image's handle belongs to its page; dropping the reference is enough.
+    if (handle && !page)
     {
         SDL_DestroyTexture(handle);
-        handle = nullptr;
+    }
+    handle = nullptr;
+    page.reset();
+    width = 0;
+    height = 0;
+    x = 0;
+    y = 0;
+}
+
+SDL_FRect Texture::ToTexCoords(const SDL_FRect &src) const noexcept
+{
+    const float inv_w = 1.0f / static_cast<float>(page ? page->width : width);
+    const float inv_h = 1.0f / static_cast<float>(page ? page->height : height);
+    return {(static_cast<float>(x) + src.x) * inv_w, (static_cast<float>(y) + src.y) * inv_h, src.w * inv_w,
+            src.h * inv_h};
+}
+
+DecodedImage::DecodedImage() noexcept : pixels(nullptr), width(0), height(0)
+{
+}
+
+DecodedImage::~DecodedImage()
+{
+    Reset();
+}
+
+DecodedImage::DecodedImage(DecodedImage &&other) noexcept
+    : pixels(other.pixels), width(other.width), height(other.height)
+{
+    other.pixels = nullptr;
+    other.width = 0;
+    other.height = 0;
+}
+
+DecodedImage &DecodedImage::operator=(DecodedImage &&other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    Reset();
+    pixels = other.pixels;
+    width = other.width;
+    height = other.height;
+    other.pixels = nullptr;
+    other.width = 0;
+    other.height = 0;
+    return *this;
+}
+
+void DecodedImage::Reset() noexcept
+{
+    if (pixels)
+    {
+        stbi_image_free(pixels);
+        pixels = nullptr;
     }
     width = 0;
     height = 0;
 }
 
-TextureLoader::TextureLoader(VFS &vfs, SDL_Renderer *renderer) : vfs(vfs), renderer(renderer)
+TextureLoader::TextureLoader(VFS &vfs, SDL_Renderer *renderer, TextureCache *cache)
+    : vfs(vfs), renderer(renderer), cache(cache)
 {
     if (!renderer)
     {
@@ -65,40 +173,43 @@ TextureLoader::TextureLoader(VFS &vfs, SDL_Renderer *renderer) : vfs(vfs), rende
 }
 
 Texture TextureLoader::Load(const char *vfs_path)
+{
+    LEO_PROFILE_SCOPE("TextureLoader::Load");
+    return Upload(Decode(vfs, vfs_path));
+}
+
+DecodedImage TextureLoader::Decode(VFS &vfs, const char *vfs_path)
 {
     if (!vfs_path || !*vfs_path)
     {
         throw std::runtime_error("TextureLoader::Load requires a non-empty path");
     }
 
-    void *data = nullptr;
-    size_t size = 0;
-    vfs.ReadAll(vfs_path, &data, &size);
-
-    if (!data || size == 0)
+    // Mapped when the file allows it, so stb_image reads the file's pages directly.
+    VfsView view = vfs.ReadView(vfs_path);
+    if (view.GetSize() == 0)
     {
-        if (data)
-        {
-            SDL_free(data);
-        }
         throw std::runtime_error("TextureLoader::Load received empty data buffer");
     }
 
-    if (size > static_cast<size_t>(SDL_MAX_SINT32))
+    if (view.GetSize() > static_cast<size_t>(SDL_MAX_SINT32))
     {
-        SDL_free(data);
         throw std::runtime_error("TextureLoader::Load image buffer too large");
     }
 
-    int width = 0;
-    int height = 0;
+    if (CookedReader::IsCooked(view.GetData(), view.GetSize(), kCookedImageTag))
+    {
+        return DecodeCooked(view);
+    }
+
+    // stbi_failure_reason is thread-local, so decoding on worker threads is safe.
+    DecodedImage image;
     int comp = 0;
-    stbi_uc *pixels =
-        stbi_load_from_memory(static_cast<const stbi_uc *>(data), static_cast<int>(size), &width, &height, &comp, 4);
-    SDL_free(data);
+    image.pixels = stbi_load_from_memory(view.GetData(), static_cast<int>(view.GetSize()), &image.width,
+                                         &image.height, &comp, 4);
     (void)comp;
 
-    if (!pixels)
+    if (!image.pixels)
     {
         const char *reason = stbi_failure_reason();
         if (!reason)
@@ -107,24 +218,54 @@ Texture TextureLoader::Load(const char *vfs_path)
         }
         throw std::runtime_error(std::string("TextureLoader::Load failed to decode image: ") + reason);
     }
+    return image;
+}
+
+Texture TextureLoader::Upload(const DecodedImage &image)
+{
+    if (!image.pixels)
+    {
+        throw std::runtime_error("TextureLoader::Upload requires decoded pixels");
+    }
 
-    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height);
+    SDL_Texture *texture =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, image.width, image.height);
     if (!texture)
     {
-        stbi_image_free(pixels);
         throw std::runtime_error(std::string("TextureLoader::Load failed to create texture: ") + SDL_GetError());
     }
 
-    const int pitch = width * 4;
-    if (!SDL_UpdateTexture(texture, nullptr, pixels, pitch))
+    const int pitch = image.width * 4;
+    if (!SDL_UpdateTexture(texture, nullptr, image.pixels, pitch))
     {
-        stbi_image_free(pixels);
         SDL_DestroyTexture(texture);
         throw std::runtime_error(std::string("TextureLoader::Load failed to upload texture: ") + SDL_GetError());
     }
 
-    stbi_image_free(pixels);
-    return Texture(texture, width, height);
+    return Texture(texture, image.width, image.height);
+}
+
+std::vector<unsigned char> TextureLoader::Cook(const DecodedImage &image)
+{
+    if (!image.pixels)
+    {
+        throw std::runtime_error("TextureLoader::Cook requires decoded pixels");
+    }
+
+    CookedWriter writer(kCookedImageTag);
+    writer.WriteI32(image.width);
+    writer.WriteI32(image.height);
+    writer.WriteBytes(image.pixels, static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4);
+    return std::move(writer.GetData());
+}
+
+std::shared_ptr<Texture> TextureLoader::Acquire(const char *vfs_path)
+{
+    if (cache)
+    {
+        return cache->Acquire(vfs_path);
+    }
+    return std::make_shared<Texture>(Load(vfs_path));
 }
 
 } // namespace engine
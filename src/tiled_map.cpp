@@ -1,10 +1,15 @@
 #include "leo/tiled_map.h"
 
 #include "leo/camera.h"
+#include "leo/cooked_asset.h"
+#include "leo/job_system.h"
+#include "leo/profiler.h"
+#include "leo/texture_cache.h"
 #include "leo/vfs.h"
 #include <SDL3/SDL.h>
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <tmxlite/Layer.hpp>
@@ -12,7 +17,9 @@
 #include <tmxlite/Map.hpp>
 #include <tmxlite/TileLayer.hpp>
 #include <tmxlite/Tileset.hpp>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace
@@ -176,16 +183,70 @@ std::vector<std::string> BuildImageCandidates(const std::string &raw_path, const
     return candidates;
 }
 
-engine::Texture LoadTextureWithFallback(engine::TextureLoader &loader, SDL_Renderer *renderer,
-                                        const std::vector<std::string> &candidates, int fallback_w, int fallback_h,
-                                        SDL_Color fallback_color, const std::string &label,
-                                        std::unordered_set<std::string> *missing)
+// One tileset atlas or collection-tile image. Candidates are decoded off the main thread; the GPU upload happens
+// afterwards on the main thread.
+struct TileImageRequest
 {
-    for (const auto &candidate : candidates)
+    std::vector<std::string> candidates;
+    size_t resolved = SIZE_MAX; // Index of the candidate that loaded (SIZE_MAX = none)
+    bool cached = false;        // Resolved candidate is already in the texture cache
+    engine::DecodedImage image;
+    std::shared_ptr<engine::Texture> texture;
+};
+
+void DecodeTileImage(engine::VFS &vfs, const engine::TextureCache *cache, TileImageRequest &request)
+{
+    for (size_t i = 0; i < request.candidates.size(); ++i)
+    {
+        const char *path = request.candidates[i].c_str();
+        if (cache && cache->Contains(path))
+        {
+            request.resolved = i;
+            request.cached = true;
+            return;
+        }
+        try
+        {
+            request.image = engine::TextureLoader::Decode(vfs, path);
+            request.resolved = i;
+            return;
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+}
+
+std::shared_ptr<engine::Texture> LoadTextureWithFallback(engine::TextureLoader &loader, engine::TextureCache *cache,
+                                                         SDL_Renderer *renderer, TileImageRequest &request,
+                                                         int fallback_w, int fallback_h, SDL_Color fallback_color,
+                                                         const std::string &label,
+                                                         std::unordered_set<std::string> *missing)
+{
+    if (request.texture)
+    {
+        return request.texture;
+    }
+
+    if (request.resolved < request.candidates.size())
     {
+        const char *path = request.candidates[request.resolved].c_str();
         try
         {
-            return loader.Load(candidate.c_str());
+            if (request.cached)
+            {
+                request.texture = loader.Acquire(path);
+            }
+            else if (cache)
+            {
+                request.texture = cache->Adopt(path, loader.Upload(request.image));
+            }
+            else
+            {
+                request.texture = std::make_shared<engine::Texture>(loader.Upload(request.image));
+            }
+            request.image.Reset();
+            return request.texture;
         }
         catch (const std::exception &)
         {
@@ -198,25 +259,94 @@ engine::Texture LoadTextureWithFallback(engine::TextureLoader &loader, SDL_Rende
                     label.c_str());
     }
 
-    return CreateSolidTexture(renderer, fallback_w, fallback_h, fallback_color);
+    return std::make_shared<engine::Texture>(CreateSolidTexture(renderer, fallback_w, fallback_h, fallback_color));
 }
 
-SDL_FPoint ApplyCameraPoint(const leo::Camera::Camera2D *camera, SDL_FPoint point)
+constexpr int kChunkTiles = 32;
+// Layer offsets are drawn as floats; past 2^24 pixels they stop being exact and the chunk culling math overflows.
+constexpr int kMaxLayerOffset = 1 << 24;
+
+// Camera transform with the trig hoisted out so it can be applied per vertex.
+struct VertexTransform
 {
+    float scale = 1.0f;
+    float cos_r = 1.0f;
+    float sin_r = 0.0f;
+    SDL_FPoint origin = {0.0f, 0.0f};
+    SDL_FPoint offset = {0.0f, 0.0f};
+
+    SDL_FPoint Apply(SDL_FPoint point) const
+    {
+        float x = (point.x - origin.x) * scale;
+        float y = (point.y - origin.y) * scale;
+        return {x * cos_r - y * sin_r + offset.x, x * sin_r + y * cos_r + offset.y};
+    }
+};
+
+VertexTransform MakeVertexTransform(const leo::Camera::Camera2D *camera, float base_x, float base_y)
+{
+    VertexTransform xf;
     if (!camera)
     {
-        return point;
+        xf.offset = {base_x, base_y};
+        return xf;
     }
-    return leo::Camera::WorldToScreen(*camera, point);
+
+    xf.scale = camera->zoom;
+    xf.cos_r = std::cos(camera->rotation);
+    xf.sin_r = std::sin(camera->rotation);
+    xf.origin = {camera->position.x - base_x, camera->position.y - base_y};
+    xf.offset = camera->offset;
+    return xf;
 }
 
-float ApplyCameraScale(const leo::Camera::Camera2D *camera, float value)
+// Returns the renderer's visible area in world space as an axis-aligned rect.
+SDL_FRect GetVisibleWorldRect(SDL_Renderer *renderer, const leo::Camera::Camera2D *camera)
 {
+    int w = 0;
+    int h = 0;
+    SDL_RendererLogicalPresentation mode = SDL_LOGICAL_PRESENTATION_DISABLED;
+    SDL_Texture *target = SDL_GetRenderTarget(renderer);
+    if (target)
+    {
+        // A canvas is drawn in its own pixels, whatever the window's logical size.
+        float tw = 0.0f;
+        float th = 0.0f;
+        SDL_GetTextureSize(target, &tw, &th);
+        w = static_cast<int>(tw);
+        h = static_cast<int>(th);
+    }
+    else if (!SDL_GetRenderLogicalPresentation(renderer, &w, &h, &mode) || w <= 0 || h <= 0)
+    {
+        if (!SDL_GetCurrentRenderOutputSize(renderer, &w, &h))
+        {
+            w = 0;
+            h = 0;
+        }
+    }
+
+    const float fw = static_cast<float>(w);
+    const float fh = static_cast<float>(h);
     if (!camera)
     {
-        return value;
+        return {0.0f, 0.0f, fw, fh};
+    }
+
+    const SDL_FPoint corners[4] = {{0.0f, 0.0f}, {fw, 0.0f}, {fw, fh}, {0.0f, fh}};
+    SDL_FPoint first = leo::Camera::ScreenToWorld(*camera, corners[0]);
+    float min_x = first.x;
+    float min_y = first.y;
+    float max_x = first.x;
+    float max_y = first.y;
+    for (int i = 1; i < 4; ++i)
+    {
+        SDL_FPoint world = leo::Camera::ScreenToWorld(*camera, corners[i]);
+        min_x = std::min(min_x, world.x);
+        min_y = std::min(min_y, world.y);
+        max_x = std::max(max_x, world.x);
+        max_y = std::max(max_y, world.y);
     }
-    return value * camera->zoom;
+    return {min_x, min_y, max_x - min_x, max_y - min_y};
 }
 
 } // namespace
@@ -236,34 +366,44 @@ TiledMap::~TiledMap()
 TiledMap::TiledMap(TiledMap &&other) noexcept = default;
 TiledMap &TiledMap::operator=(TiledMap &&other) noexcept = default;
 
-TiledMap TiledMap::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path)
+// What a map file describes, before any image is loaded. Parsed from tmx, or read back from the cooked form, then
+// turned into a TiledMap by Build. Layers carry their tiles but no chunks yet.
+struct TiledMap::Source
 {
-    if (!renderer)
+    // One texture of the finished map: a tileset atlas or a collection tile image.
+    struct TextureSlot
     {
-        throw std::runtime_error("TiledMap::LoadFromVfs requires a valid SDL_Renderer");
-    }
-    if (!vfs_path || !*vfs_path)
-    {
-        throw std::runtime_error("TiledMap::LoadFromVfs requires a non-empty path");
-    }
-
-    void *data = nullptr;
-    size_t size = 0;
-    vfs.ReadAll(vfs_path, &data, &size);
+        size_t image = 0; // Index into images
+        int fallback_w = 0;
+        int fallback_h = 0;
+        SDL_Color fallback_color = {0, 0, 0, 255};
+        std::string label; // Path as written in the map, for the missing-image warning
+    };
 
-    if (!data || size == 0)
+    struct TileRef
     {
-        if (data)
-        {
-            SDL_free(data);
-        }
-        throw std::runtime_error("TiledMap::LoadFromVfs received empty map data");
-    }
-
-    std::string map_data(static_cast<const char *>(data), size);
-    SDL_free(data);
+        std::uint32_t gid = 0;
+        size_t slot = 0;
+        SDL_FRect src = {0.0f, 0.0f, 0.0f, 0.0f};
+        bool whole_image = false; // Collection tile: src is the loaded image's size
+    };
 
-    std::string map_dir = DirName(vfs_path);
+    int map_width = 0;
+    int map_height = 0;
+    int tile_width = 0;
+    int tile_height = 0;
+    std::vector<Layer> layers;
+    std::vector<std::vector<std::string>> images; // Candidate VFS paths for each distinct image
+    std::vector<TextureSlot> slots;
+    std::vector<TileRef> tiles;
+
+    static Source ParseTmx(const std::string &map_data, const std::string &map_dir);
+    static Source ReadCooked(const void *data, size_t size);
+    std::vector<unsigned char> Cook() const;
+};
+
+TiledMap::Source TiledMap::Source::ParseTmx(const std::string &map_data, const std::string &map_dir)
+{
     tmx::Map map;
     if (!map.loadFromString(map_data, map_dir))
     {
@@ -280,13 +420,13 @@ TiledMap TiledMap::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs
         throw std::runtime_error("TiledMap::LoadFromVfs does not support infinite maps yet");
     }
 
-    TiledMap result;
-    result.map_width = static_cast<int>(map.getTileCount().x);
-    result.map_height = static_cast<int>(map.getTileCount().y);
-    result.tile_width = static_cast<int>(map.getTileSize().x);
-    result.tile_height = static_cast<int>(map.getTileSize().y);
+    Source source;
+    source.map_width = static_cast<int>(map.getTileCount().x);
+    source.map_height = static_cast<int>(map.getTileCount().y);
+    source.tile_width = static_cast<int>(map.getTileSize().x);
+    source.tile_height = static_cast<int>(map.getTileSize().y);
 
-    if (result.map_width <= 0 || result.map_height <= 0 || result.tile_width <= 0 || result.tile_height <= 0)
+    if (source.map_width <= 0 || source.map_height <= 0 || source.tile_width <= 0 || source.tile_height <= 0)
     {
         throw std::runtime_error("TiledMap::LoadFromVfs map has invalid dimensions");
     }
@@ -305,8 +445,8 @@ TiledMap TiledMap::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs
                 const auto &tile_layer = layer->getLayerAs<tmx::TileLayer>();
                 Layer out = {};
                 out.name = layer->getName();
-                out.width = result.map_width;
-                out.height = result.map_height;
+                out.width = source.map_width;
+                out.height = source.map_height;
                 out.visible = layer->getVisible();
                 out.opacity = layer->getOpacity();
                 out.offset_x = layer->getOffset().x;
@@ -322,7 +462,7 @@ TiledMap TiledMap::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs
                     out.tiles.push_back(entry);
                 }
 
-                result.layers.push_back(std::move(out));
+                source.layers.push_back(std::move(out));
                 break;
             }
             case tmx::Layer::Type::Group: {
@@ -338,31 +478,27 @@ TiledMap TiledMap::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs
 
     collect_layers(map.getLayers(), collect_layers);
 
-    if (result.layers.empty())
-    {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TiledMap: map has no tile layers");
-    }
-
-    TextureLoader loader(vfs, renderer);
-    std::unordered_set<std::string> missing_images;
+    // Every distinct image path becomes one entry in images, so it is read and decoded once however many tiles use it.
+    std::unordered_map<std::string, size_t> image_indices;
+    auto add_slot = [&](const std::string &image_path, int fallback_w, int fallback_h, SDL_Color fallback_color) {
+        auto [it, inserted] = image_indices.try_emplace(image_path, source.images.size());
+        if (inserted)
+        {
+            source.images.push_back(BuildImageCandidates(image_path, map_dir));
+        }
+        source.slots.push_back({it->second, fallback_w, fallback_h, fallback_color, image_path});
+        return source.slots.size() - 1;
+    };
 
-    const auto &tilesets = map.getTilesets();
-    for (const auto &tileset : tilesets)
+    for (const auto &tileset : map.getTilesets())
     {
         const std::string &atlas_path = tileset.getImagePath();
         if (!atlas_path.empty())
         {
-            std::vector<std::string> candidates = BuildImageCandidates(atlas_path, map_dir);
-            SDL_Color fallback = ColorFromId(tileset.getFirstGID());
-            Texture texture = LoadTextureWithFallback(
-                loader, renderer, candidates, static_cast<int>(tileset.getTileSize().x),
-                static_cast<int>(tileset.getTileSize().y), fallback, atlas_path, &missing_images);
-
-            size_t texture_index = result.textures.size();
-            result.textures.push_back(std::move(texture));
-
             int tile_w = static_cast<int>(tileset.getTileSize().x);
             int tile_h = static_cast<int>(tileset.getTileSize().y);
+            size_t slot = add_slot(atlas_path, tile_w, tile_h, ColorFromId(tileset.getFirstGID()));
+
             int columns = static_cast<int>(tileset.getColumnCount());
             int spacing = static_cast<int>(tileset.getSpacing());
             int margin = static_cast<int>(tileset.getMargin());
@@ -375,47 +511,326 @@ TiledMap TiledMap::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs
                 float src_x = static_cast<float>(margin + col * (tile_w + spacing));
                 float src_y = static_cast<float>(margin + row * (tile_h + spacing));
 
-                TileDrawInfo info = {};
-                info.texture_index = texture_index;
-                info.src = {src_x, src_y, static_cast<float>(tile_w), static_cast<float>(tile_h)};
-                info.draw_w = result.tile_width;
-                info.draw_h = result.tile_height;
-                result.tiles[tileset.getFirstGID() + tile_id] = info;
+                TileRef ref = {};
+                ref.gid = tileset.getFirstGID() + tile_id;
+                ref.slot = slot;
+                ref.src = {src_x, src_y, static_cast<float>(tile_w), static_cast<float>(tile_h)};
+                source.tiles.push_back(ref);
             }
         }
         else
         {
-            const auto &tile_defs = tileset.getTiles();
-            for (const auto &tile : tile_defs)
+            for (const auto &tile : tileset.getTiles())
             {
-                std::string image_path = tile.imagePath;
-                std::vector<std::string> candidates = BuildImageCandidates(image_path, map_dir);
-                SDL_Color fallback = ColorFromId(tileset.getFirstGID() + tile.ID);
-
                 int fallback_w = static_cast<int>(tile.imageSize.x);
                 int fallback_h = static_cast<int>(tile.imageSize.y);
                 if (fallback_w <= 0 || fallback_h <= 0)
                 {
-                    fallback_w = result.tile_width;
-                    fallback_h = result.tile_height;
+                    fallback_w = source.tile_width;
+                    fallback_h = source.tile_height;
                 }
 
-                Texture texture = LoadTextureWithFallback(loader, renderer, candidates, fallback_w, fallback_h,
-                                                          fallback, image_path, &missing_images);
+                TileRef ref = {};
+                ref.gid = tileset.getFirstGID() + tile.ID;
+                ref.slot = add_slot(tile.imagePath, fallback_w, fallback_h, ColorFromId(ref.gid));
+                ref.whole_image = true;
+                source.tiles.push_back(ref);
+            }
+        }
+    }
 
-                size_t texture_index = result.textures.size();
-                result.textures.push_back(std::move(texture));
+    return source;
+}
 
-                TileDrawInfo info = {};
-                info.texture_index = texture_index;
-                info.src = {0.0f, 0.0f, static_cast<float>(result.textures.back().width),
-                            static_cast<float>(result.textures.back().height)};
-                info.draw_w = result.tile_width;
-                info.draw_h = result.tile_height;
-                result.tiles[tileset.getFirstGID() + tile.ID] = info;
+TiledMap::Source TiledMap::Source::ReadCooked(const void *data, size_t size)
+{
+    CookedReader reader(data, size, kCookedMapTag);
+    Source source;
+    source.map_width = reader.ReadI32();
+    source.map_height = reader.ReadI32();
+    source.tile_width = reader.ReadI32();
+    source.tile_height = reader.ReadI32();
+    if (source.map_width <= 0 || source.map_height <= 0 || source.tile_width <= 0 || source.tile_height <= 0)
+    {
+        throw std::runtime_error("TiledMap::LoadFromVfs map has invalid dimensions");
+    }
+
+    // Counts are checked against the bytes left so a damaged file cannot ask for a huge allocation.
+    auto read_count = [&reader](size_t min_entry_size) {
+        const Uint32 count = reader.ReadU32();
+        if (static_cast<size_t>(count) > reader.GetRemaining() / min_entry_size)
+        {
+            throw std::runtime_error("TiledMap::LoadFromVfs cooked map is truncated");
+        }
+        return static_cast<size_t>(count);
+    };
+
+    source.layers.resize(read_count(32));
+    for (Layer &layer : source.layers)
+    {
+        layer.name = reader.ReadString();
+        layer.width = reader.ReadI32();
+        layer.height = reader.ReadI32();
+        layer.offset_x = reader.ReadI32();
+        layer.offset_y = reader.ReadI32();
+        layer.visible = reader.ReadU32() != 0;
+        layer.opacity = reader.ReadF32();
+        layer.tiles.resize(read_count(5));
+        for (Tile &tile : layer.tiles)
+        {
+            tile.gid = reader.ReadU32();
+        }
+        const unsigned char *flips = reader.ReadBytes(layer.tiles.size());
+        for (size_t i = 0; i < layer.tiles.size(); ++i)
+        {
+            layer.tiles[i].flip_flags = flips[i];
+        }
+        // Chunk building indexes tiles by the layer size, and drawing shares the map's tile grid.
+        if (layer.width != source.map_width || layer.height != source.map_height ||
+            layer.tiles.size() != static_cast<size_t>(layer.width) * static_cast<size_t>(layer.height) ||
+            layer.offset_x < -kMaxLayerOffset || layer.offset_x > kMaxLayerOffset || layer.offset_y < -kMaxLayerOffset ||
+            layer.offset_y > kMaxLayerOffset)
+        {
+            throw std::runtime_error("TiledMap::LoadFromVfs cooked map has an invalid layer");
+        }
+    }
+
+    source.images.resize(read_count(4));
+    for (std::vector<std::string> &candidates : source.images)
+    {
+        candidates.resize(read_count(4));
+        for (std::string &candidate : candidates)
+        {
+            candidate = reader.ReadString();
+        }
+    }
+
+    source.slots.resize(read_count(20));
+    for (TextureSlot &slot : source.slots)
+    {
+        slot.image = reader.ReadU32();
+        slot.fallback_w = reader.ReadI32();
+        slot.fallback_h = reader.ReadI32();
+        const Uint32 color = reader.ReadU32();
+        slot.fallback_color = {static_cast<Uint8>(color >> 24), static_cast<Uint8>(color >> 16),
+                               static_cast<Uint8>(color >> 8), static_cast<Uint8>(color)};
+        slot.label = reader.ReadString();
+        if (slot.image >= source.images.size() || slot.fallback_w <= 0 || slot.fallback_h <= 0)
+        {
+            throw std::runtime_error("TiledMap::LoadFromVfs cooked map has an invalid texture");
+        }
+    }
+
+    source.tiles.resize(read_count(24));
+    for (TileRef &tile : source.tiles)
+    {
+        tile.gid = reader.ReadU32();
+        tile.slot = reader.ReadU32();
+        tile.whole_image = reader.ReadU32() != 0;
+        tile.src.x = reader.ReadF32();
+        tile.src.y = reader.ReadF32();
+        tile.src.w = reader.ReadF32();
+        tile.src.h = reader.ReadF32();
+        if (tile.slot >= source.slots.size())
+        {
+            throw std::runtime_error("TiledMap::LoadFromVfs cooked map has an invalid tile");
+        }
+    }
+
+    return source;
+}
+
+std::vector<unsigned char> TiledMap::Source::Cook() const
+{
+    CookedWriter writer(kCookedMapTag);
+    writer.WriteI32(map_width);
+    writer.WriteI32(map_height);
+    writer.WriteI32(tile_width);
+    writer.WriteI32(tile_height);
+
+    writer.WriteU32(static_cast<Uint32>(layers.size()));
+    for (const Layer &layer : layers)
+    {
+        writer.WriteString(layer.name);
+        writer.WriteI32(layer.width);
+        writer.WriteI32(layer.height);
+        writer.WriteI32(layer.offset_x);
+        writer.WriteI32(layer.offset_y);
+        writer.WriteU32(layer.visible ? 1u : 0u);
+        writer.WriteF32(layer.opacity);
+        writer.WriteU32(static_cast<Uint32>(layer.tiles.size()));
+        for (const Tile &tile : layer.tiles)
+        {
+            writer.WriteU32(tile.gid);
+        }
+        for (const Tile &tile : layer.tiles)
+        {
+            writer.WriteBytes(&tile.flip_flags, 1);
+        }
+    }
+
+    writer.WriteU32(static_cast<Uint32>(images.size()));
+    for (const std::vector<std::string> &candidates : images)
+    {
+        writer.WriteU32(static_cast<Uint32>(candidates.size()));
+        for (const std::string &candidate : candidates)
+        {
+            writer.WriteString(candidate);
+        }
+    }
+
+    writer.WriteU32(static_cast<Uint32>(slots.size()));
+    for (const TextureSlot &slot : slots)
+    {
+        writer.WriteU32(static_cast<Uint32>(slot.image));
+        writer.WriteI32(slot.fallback_w);
+        writer.WriteI32(slot.fallback_h);
+        const SDL_Color color = slot.fallback_color;
+        writer.WriteU32((static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) |
+                        (static_cast<Uint32>(color.b) << 8) | static_cast<Uint32>(color.a));
+        writer.WriteString(slot.label);
+    }
+
+    writer.WriteU32(static_cast<Uint32>(tiles.size()));
+    for (const TileRef &tile : tiles)
+    {
+        writer.WriteU32(tile.gid);
+        writer.WriteU32(static_cast<Uint32>(tile.slot));
+        writer.WriteU32(tile.whole_image ? 1u : 0u);
+        writer.WriteF32(tile.src.x);
+        writer.WriteF32(tile.src.y);
+        writer.WriteF32(tile.src.w);
+        writer.WriteF32(tile.src.h);
+    }
+    return std::move(writer.GetData());
+}
+
+TiledMap TiledMap::LoadFromVfs(VFS &vfs, SDL_Renderer *renderer, const char *vfs_path, TextureCache *cache,
+                               JobSystem *jobs)
+{
+    LEO_PROFILE_SCOPE("TiledMap::LoadFromVfs");
+    if (!renderer)
+    {
+        throw std::runtime_error("TiledMap::LoadFromVfs requires a valid SDL_Renderer");
+    }
+    return Build(vfs, renderer, ReadSource(vfs, vfs_path), cache, jobs);
+}
+
+std::vector<unsigned char> TiledMap::Cook(VFS &vfs, const char *vfs_path)
+{
+    Source source = ReadSource(vfs, vfs_path);
+
+    // Keep only the candidate that exists, so loading the cooked map never probes paths that are not there.
+    for (std::vector<std::string> &candidates : source.images)
+    {
+        for (const std::string &candidate : candidates)
+        {
+            if (vfs.Exists(candidate.c_str()))
+            {
+                candidates = {candidate};
+                break;
             }
         }
     }
+    return source.Cook();
+}
+
+TiledMap::Source TiledMap::ReadSource(VFS &vfs, const char *vfs_path)
+{
+    if (!vfs_path || !*vfs_path)
+    {
+        throw std::runtime_error("TiledMap::LoadFromVfs requires a non-empty path");
+    }
+
+    VfsView view = vfs.ReadView(vfs_path);
+    if (view.GetSize() == 0)
+    {
+        throw std::runtime_error("TiledMap::LoadFromVfs received empty map data");
+    }
+
+    if (CookedReader::IsCooked(view.GetData(), view.GetSize(), kCookedMapTag))
+    {
+        return Source::ReadCooked(view.GetData(), view.GetSize());
+    }
+
+    std::string map_data(reinterpret_cast<const char *>(view.GetData()), view.GetSize());
+    view.Reset();
+    return Source::ParseTmx(map_data, DirName(vfs_path));
+}
+
+TiledMap TiledMap::Build(VFS &vfs, SDL_Renderer *renderer, Source &&source, TextureCache *cache, JobSystem *jobs)
+{
+    TiledMap result;
+    result.map_width = source.map_width;
+    result.map_height = source.map_height;
+    result.tile_width = source.tile_width;
+    result.tile_height = source.tile_height;
+    result.layers = std::move(source.layers);
+
+    if (result.layers.empty())
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TiledMap: map has no tile layers");
+    }
+
+    // The VFS reads and image decodes run on the job system; uploads stay on this thread.
+    std::vector<TileImageRequest> image_requests(source.images.size());
+    for (size_t i = 0; i < source.images.size(); ++i)
+    {
+        image_requests[i].candidates = std::move(source.images[i]);
+    }
+
+    auto decode_images = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            DecodeTileImage(vfs, cache, image_requests[i]);
+        }
+    };
+    if (jobs)
+    {
+        jobs->ParallelFor(image_requests.size(), 1, decode_images);
+    }
+    else
+    {
+        decode_images(0, image_requests.size());
+    }
+
+    TextureLoader loader(vfs, renderer, cache);
+    std::unordered_set<std::string> missing_images;
+    for (const Source::TextureSlot &slot : source.slots)
+    {
+        result.textures.push_back(LoadTextureWithFallback(loader, cache, renderer, image_requests[slot.image],
+                                                          slot.fallback_w, slot.fallback_h, slot.fallback_color,
+                                                          slot.label, &missing_images));
+    }
+
+    std::unordered_map<std::uint32_t, TileDrawInfo> tile_infos;
+    for (const Source::TileRef &tile : source.tiles)
+    {
+        const Texture &texture = *result.textures[tile.slot];
+        TileDrawInfo info = {};
+        info.texture_index = tile.slot;
+        info.src = tile.whole_image
+                       ? SDL_FRect{0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height)}
+                       : tile.src;
+        info.draw_w = result.tile_width;
+        info.draw_h = result.tile_height;
+        tile_infos[tile.gid] = info;
+    }
+
+    auto build_chunks = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            BuildChunks(result.layers[i], tile_infos, result.textures, result.tile_width, result.tile_height);
+        }
+    };
+    if (jobs)
+    {
+        jobs->ParallelFor(result.layers.size(), 1, build_chunks);
+    }
+    else
+    {
+        build_chunks(0, result.layers.size());
+    }
 
     result.ready = true;
     return result;
@@ -430,7 +845,7 @@ void TiledMap::Reset() noexcept
 {
     layers.clear();
     textures.clear();
-    tiles.clear();
+    scratch_vertices.clear();
     map_width = 0;
     map_height = 0;
     tile_width = 0;
@@ -493,6 +908,7 @@ void TiledMap::Draw(SDL_Renderer *renderer, float x, float y, const ::leo::Camer
 void TiledMap::DrawLayer(SDL_Renderer *renderer, int layer_index, float x, float y,
                          const ::leo::Camera::Camera2D *camera) const
 {
+    LEO_PROFILE_SCOPE("TiledMap::DrawLayer");
     if (!renderer || !ready)
     {
         return;
@@ -509,11 +925,76 @@ void TiledMap::DrawLayer(SDL_Renderer *renderer, int layer_index, float x, float
         return;
     }
 
+    if (layer.chunk_cols <= 0 || layer.chunk_rows <= 0)
+    {
+        return;
+    }
+
     const float base_x = x + static_cast<float>(layer.offset_x);
     const float base_y = y + static_cast<float>(layer.offset_y);
     const float opacity = std::clamp(layer.opacity, 0.0f, 1.0f);
 
-    bool warned_diagonal = false;
+    // Chunks sit on a regular grid in layer space, so the visible range falls out of the view rect directly.
+    SDL_FRect view = GetVisibleWorldRect(renderer, camera);
+    if (view.w <= 0.0f || view.h <= 0.0f)
+    {
+        return;
+    }
+
+    const float chunk_w = static_cast<float>(kChunkTiles * tile_width);
+    const float chunk_h = static_cast<float>(kChunkTiles * tile_height);
+    const int first_col = std::max(0, static_cast<int>(std::floor((view.x - base_x) / chunk_w)));
+    const int first_row = std::max(0, static_cast<int>(std::floor((view.y - base_y) / chunk_h)));
+    const int last_col =
+        std::min(layer.chunk_cols - 1, static_cast<int>(std::floor((view.x + view.w - base_x) / chunk_w)));
+    const int last_row =
+        std::min(layer.chunk_rows - 1, static_cast<int>(std::floor((view.y + view.h - base_y) / chunk_h)));
+    if (first_col > last_col || first_row > last_row)
+    {
+        return;
+    }
+
+    const VertexTransform xf = MakeVertexTransform(camera, base_x, base_y);
+
+    for (int chunk_row = first_row; chunk_row <= last_row; ++chunk_row)
+    {
+        for (int chunk_col = first_col; chunk_col <= last_col; ++chunk_col)
+        {
+            LEO_PROFILE_SCOPE("TiledMap::DrawChunk");
+            const Chunk &chunk =
+                layer.chunks[static_cast<size_t>(chunk_row) * static_cast<size_t>(layer.chunk_cols) +
+                             static_cast<size_t>(chunk_col)];
+            for (const ChunkBatch &batch : chunk.batches)
+            {
+                const Texture &texture = *textures[batch.texture_index];
+                if (!texture.handle || batch.vertices.empty())
+                {
+                    continue;
+                }
+
+                scratch_vertices.resize(batch.vertices.size());
+                for (size_t i = 0; i < batch.vertices.size(); ++i)
+                {
+                    SDL_Vertex vertex = batch.vertices[i];
+                    vertex.position = xf.Apply(vertex.position);
+                    vertex.color.a = opacity;
+                    scratch_vertices[i] = vertex;
+                }
+
+                SDL_RenderGeometry(renderer, texture.handle, scratch_vertices.data(),
+                                   static_cast<int>(scratch_vertices.size()), batch.indices.data(),
+                                   static_cast<int>(batch.indices.size()));
+            }
+        }
+    }
+}
+
+void TiledMap::BuildChunks(Layer &layer, const std::unordered_map<std::uint32_t, TileDrawInfo> &tile_infos,
+                           const std::vector<std::shared_ptr<Texture>> &textures, int tile_width, int tile_height)
+{
+    layer.chunk_cols = (layer.width + kChunkTiles - 1) / kChunkTiles;
+    layer.chunk_rows = (layer.height + kChunkTiles - 1) / kChunkTiles;
+    layer.chunks.assign(static_cast<size_t>(layer.chunk_cols) * static_cast<size_t>(layer.chunk_rows), Chunk{});
 
     for (int row = 0; row < layer.height; ++row)
     {
@@ -531,8 +1012,8 @@ void TiledMap::DrawLayer(SDL_Renderer *renderer, int layer_index, float x, float
                 continue;
             }
 
-            auto it = tiles.find(tile.gid);
-            if (it == tiles.end())
+            auto it = tile_infos.find(tile.gid);
+            if (it == tile_infos.end())
             {
                 continue;
             }
@@ -543,51 +1024,62 @@ void TiledMap::DrawLayer(SDL_Renderer *renderer, int layer_index, float x, float
                 continue;
             }
 
-            const Texture &texture = textures[info.texture_index];
-            if (!texture.handle)
+            const Texture &texture = *textures[info.texture_index];
+            if (!texture.handle || texture.width <= 0 || texture.height <= 0)
             {
                 continue;
             }
 
-            SDL_FRect dst = {base_x + static_cast<float>(col * tile_width),
-                             base_y + static_cast<float>(row * tile_height), static_cast<float>(info.draw_w),
-                             static_cast<float>(info.draw_h)};
-
-            SDL_FPoint screen = ApplyCameraPoint(camera, {dst.x, dst.y});
-            dst.x = screen.x;
-            dst.y = screen.y;
-            dst.w = ApplyCameraScale(camera, dst.w);
-            dst.h = ApplyCameraScale(camera, dst.h);
-
-            SDL_FlipMode flip = SDL_FLIP_NONE;
-            if (tile.flip_flags & tmx::TileLayer::FlipFlag::Horizontal)
-            {
-                flip = static_cast<SDL_FlipMode>(flip | SDL_FLIP_HORIZONTAL);
-            }
-            if (tile.flip_flags & tmx::TileLayer::FlipFlag::Vertical)
+            Chunk &chunk = layer.chunks[static_cast<size_t>(row / kChunkTiles) * static_cast<size_t>(layer.chunk_cols) +
+                                        static_cast<size_t>(col / kChunkTiles)];
+            // Tilesets packed onto the same atlas page share a handle, so they share a batch too.
+            auto batch_it = std::find_if(chunk.batches.begin(), chunk.batches.end(), [&](const ChunkBatch &batch) {
+                return textures[batch.texture_index]->handle == texture.handle;
+            });
+            if (batch_it == chunk.batches.end())
             {
-                flip = static_cast<SDL_FlipMode>(flip | SDL_FLIP_VERTICAL);
+                chunk.batches.push_back(ChunkBatch{});
+                batch_it = chunk.batches.end() - 1;
+                batch_it->texture_index = info.texture_index;
             }
-            if (tile.flip_flags & tmx::TileLayer::FlipFlag::Diagonal)
+
+            const float x0 = static_cast<float>(col * tile_width);
+            const float y0 = static_cast<float>(row * tile_height);
+            const float x1 = x0 + static_cast<float>(info.draw_w);
+            const float y1 = y0 + static_cast<float>(info.draw_h);
+            const SDL_FRect uv = texture.ToTexCoords(info.src);
+            const float u0 = uv.x;
+            const float v0 = uv.y;
+            const float u1 = uv.x + uv.w;
+            const float v1 = uv.y + uv.h;
+
+            const bool flip_h = (tile.flip_flags & tmx::TileLayer::FlipFlag::Horizontal) != 0;
+            const bool flip_v = (tile.flip_flags & tmx::TileLayer::FlipFlag::Vertical) != 0;
+            const bool flip_d = (tile.flip_flags & tmx::TileLayer::FlipFlag::Diagonal) != 0;
+
+            // Corners in TL, TR, BR, BL order. Tiled applies the flips as H, V, then an x/y swap for diagonal.
+            const SDL_FPoint positions[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+            const int corners[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+            const int base = static_cast<int>(batch_it->vertices.size());
+            for (int i = 0; i < 4; ++i)
             {
-                if (!warned_diagonal)
+                int cx = flip_h ? 1 - corners[i][0] : corners[i][0];
+                int cy = flip_v ? 1 - corners[i][1] : corners[i][1];
+                if (flip_d)
                 {
-                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TiledMap: diagonal flip not supported");
-                    warned_diagonal = true;
+                    std::swap(cx, cy);
                 }
-            }
 
-            if (opacity < 1.0f)
-            {
-                SDL_SetTextureAlphaMod(texture.handle, static_cast<Uint8>(opacity * 255.0f));
+                SDL_Vertex vertex = {};
+                vertex.position = positions[i];
+                vertex.color = {1.0f, 1.0f, 1.0f, 1.0f};
+                vertex.tex_coord = {cx ? u1 : u0, cy ? v1 : v0};
+                batch_it->vertices.push_back(vertex);
             }
 
-            SDL_RenderTextureRotated(renderer, texture.handle, &info.src, &dst, 0.0, nullptr, flip);
-
-            if (opacity < 1.0f)
-            {
-                SDL_SetTextureAlphaMod(texture.handle, 255);
-            }
+            const int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+            batch_it->indices.insert(batch_it->indices.end(), quad, quad + 6);
         }
     }
 }
@@ -1,12 +1,218 @@
 #include "leo/vfs.h"
 #include <SDL3/SDL.h>
+#include <cstdint>
 #include <filesystem>
 #include <physfs.h>
 #include <stdexcept>
+#include <string>
+#include <system_error>
+#if defined(_WIN32)
+#include <windows.h>
+#undef DeleteFile // windows.h maps it to DeleteFileA/W, which would rename VFS::DeleteFile here
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+// A whole native file mapped read-only.
+struct MappedFile
+{
+    const unsigned char *data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE mapping = nullptr;
+#endif
+
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile()
+    {
+#if defined(_WIN32)
+        if (data)
+        {
+            UnmapViewOfFile(data);
+        }
+        if (mapping)
+        {
+            CloseHandle(mapping);
+        }
+#else
+        if (data)
+        {
+            munmap(const_cast<unsigned char *>(data), size);
+        }
+#endif
+    }
+};
+
+struct StoredEntry
+{
+    size_t offset;
+    size_t size;
+};
+
+// Returns nullptr if the file cannot be mapped (missing, empty, not a regular file); callers fall back to reading.
+std::shared_ptr<MappedFile> MapNativeFile(const std::filesystem::path &path)
+{
+    auto mapped = std::make_shared<MappedFile>();
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+    LARGE_INTEGER length = {};
+    if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0 ||
+        static_cast<unsigned long long>(length.QuadPart) > SIZE_MAX)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+    mapped->mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapped->mapping)
+    {
+        return nullptr;
+    }
+    mapped->data = static_cast<const unsigned char *>(MapViewOfFile(mapped->mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!mapped->data)
+    {
+        return nullptr;
+    }
+    mapped->size = static_cast<size_t>(length.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    struct stat info = {};
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0 ||
+        static_cast<unsigned long long>(info.st_size) > SIZE_MAX)
+    {
+        close(fd);
+        return nullptr;
+    }
+    void *address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    mapped->data = static_cast<const unsigned char *>(address);
+    mapped->size = static_cast<size_t>(info.st_size);
+#endif
+    return mapped;
+}
+
+Uint16 ReadLE16(const unsigned char *p)
+{
+    return static_cast<Uint16>(p[0] | (p[1] << 8));
+}
+
+Uint32 ReadLE32(const unsigned char *p)
+{
+    return static_cast<Uint32>(ReadLE16(p)) | (static_cast<Uint32>(ReadLE16(p + 2)) << 16);
+}
+
+// Finds the data of every stored, unencrypted entry in a zip archive. Returns false if the file is not a zip this
+// can read (no end-of-directory record, ZIP64, damaged directory); compressed entries are simply left out.
+bool IndexStoredZipEntries(const MappedFile &file, std::unordered_map<std::string, StoredEntry> *out)
+{
+    constexpr size_t kEndRecordSize = 22;
+    constexpr size_t kMaxCommentSize = 65535;
+    const unsigned char *bytes = file.data;
+    if (file.size < kEndRecordSize)
+    {
+        return false;
+    }
+
+    size_t end_record = SIZE_MAX;
+    const size_t lowest =
+        file.size > kEndRecordSize + kMaxCommentSize ? file.size - kEndRecordSize - kMaxCommentSize : 0;
+    for (size_t pos = file.size - kEndRecordSize + 1; pos-- > lowest;)
+    {
+        if (ReadLE32(bytes + pos) == 0x06054b50)
+        {
+            end_record = pos;
+            break;
+        }
+    }
+    if (end_record == SIZE_MAX)
+    {
+        return false;
+    }
+
+    const size_t count = ReadLE16(bytes + end_record + 10);
+    const size_t directory_size = ReadLE32(bytes + end_record + 12);
+    const size_t directory_offset = ReadLE32(bytes + end_record + 16);
+    if (directory_offset == 0xFFFFFFFFu || directory_offset + directory_size > end_record)
+    {
+        return false;
+    }
+
+    const size_t directory_end = directory_offset + directory_size;
+    size_t pos = directory_offset;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (pos + 46 > directory_end || ReadLE32(bytes + pos) != 0x02014b50)
+        {
+            return false;
+        }
+        const Uint16 flags = ReadLE16(bytes + pos + 8);
+        const Uint16 method = ReadLE16(bytes + pos + 10);
+        const size_t compressed_size = ReadLE32(bytes + pos + 20);
+        const size_t size = ReadLE32(bytes + pos + 24);
+        const size_t name_length = ReadLE16(bytes + pos + 28);
+        const size_t extra_length = ReadLE16(bytes + pos + 30);
+        const size_t comment_length = ReadLE16(bytes + pos + 32);
+        const size_t local_header = ReadLE32(bytes + pos + 42);
+        if (pos + 46 + name_length > directory_end)
+        {
+            return false;
+        }
+        std::string name(reinterpret_cast<const char *>(bytes + pos + 46), name_length);
+        pos += 46 + name_length + extra_length + comment_length;
+
+        // Local headers carry their own name and extra lengths, which may differ from the directory's.
+        if (method != 0 || (flags & 0x1) || compressed_size != size || local_header + 30 > file.size ||
+            ReadLE32(bytes + local_header) != 0x04034b50)
+        {
+            continue;
+        }
+        const unsigned char *header = bytes + local_header;
+        const size_t data = local_header + 30 + ReadLE16(header + 26) + ReadLE16(header + 28);
+        if (data + size <= file.size)
+        {
+            out->emplace(std::move(name), StoredEntry{data, size});
+        }
+    }
+    return true;
+}
+
+} // namespace
 
 namespace engine
 {
 
+struct VFS::ArchiveIndex
+{
+    // The archive as it was when mapped; a rewritten archive gets a fresh index instead of the stale mapping.
+    std::uintmax_t size = 0;
+    std::filesystem::file_time_type mtime;
+    // Null when the archive cannot be mapped or is not a zip the index can read.
+    std::shared_ptr<MappedFile> file;
+    std::unordered_map<std::string, StoredEntry> entries;
+};
+
 static void *PHYSFS_Alloc(PHYSFS_uint64 size)
 {
     return SDL_malloc(static_cast<size_t>(size));
@@ -279,13 +485,14 @@ static bool AppendListEntry(char ***entries, size_t *count, size_t *capacity, ch
     return true;
 }
 
-static void ListWriteDirFilesRecursive(const char *dir, const char *write_dir, char ***entries, size_t *count,
-                                       size_t *capacity)
+// Appends every file under dir. With a write_dir, entries that do not live in the write directory are skipped.
+static void ListFilesRecursive(const char *dir, const char *write_dir, char ***entries, size_t *count,
+                               size_t *capacity)
 {
     char **list = PHYSFS_enumerateFiles(dir);
     if (!list)
     {
-        throw MakePhysfsError("Failed to enumerate write directory", dir);
+        throw MakePhysfsError("Failed to enumerate directory", dir);
     }
 
     for (char **it = list; *it; ++it)
@@ -294,10 +501,10 @@ static void ListWriteDirFilesRecursive(const char *dir, const char *write_dir, c
         if (!path)
         {
             PHYSFS_freeList(list);
-            throw std::runtime_error("ListWriteDirFiles failed to allocate path");
+            throw std::runtime_error("ListFiles failed to allocate path");
         }
 
-        if (!IsPathInWriteDir(path, write_dir))
+        if (write_dir && !IsPathInWriteDir(path, write_dir))
         {
             SDL_free(path);
             continue;
@@ -316,7 +523,7 @@ static void ListWriteDirFilesRecursive(const char *dir, const char *write_dir, c
         {
             try
             {
-                ListWriteDirFilesRecursive(path, write_dir, entries, count, capacity);
+                ListFilesRecursive(path, write_dir, entries, count, capacity);
             }
             catch (...)
             {
@@ -332,7 +539,7 @@ static void ListWriteDirFilesRecursive(const char *dir, const char *write_dir, c
         {
             SDL_free(path);
             PHYSFS_freeList(list);
-            throw std::runtime_error("ListWriteDirFiles failed to allocate list");
+            throw std::runtime_error("ListFiles failed to allocate list");
         }
     }
 
@@ -441,7 +648,7 @@ void VFS::Mount(const char *path)
     }
 }
 
-VFS::VFS(Config &cfg) : config(cfg), initialized_physfs(false)
+VFS::VFS(Config &cfg) : config(cfg), initialized_physfs(false), archives_mutex(), archives()
 {
     // Initialize PhysFS (skip if already initialized from previous test)
     if (!PHYSFS_isInit())
@@ -587,6 +794,108 @@ cleanup:
     ClosePhysfsFile(file);
 }
 
+bool VFS::Exists(const char *vfs_path) const noexcept
+{
+    return vfs_path && vfs_path[0] != '\0' && PHYSFS_exists(vfs_path) != 0;
+}
+
+VfsView VFS::ReadView(const char *vfs_path)
+{
+    if (vfs_path == nullptr)
+    {
+        throw std::runtime_error("ReadView requires a non-null path");
+    }
+
+    VfsView view;
+    PHYSFS_Stat stat;
+    const char *real_dir = PHYSFS_getRealDir(vfs_path);
+    if (real_dir && PHYSFS_stat(vfs_path, &stat) && stat.filetype == PHYSFS_FILETYPE_REGULAR && stat.filesize > 0)
+    {
+        // Resources are mounted at "/", so the VFS path is also the path inside the directory or archive.
+        const char *relative = vfs_path[0] == '/' ? vfs_path + 1 : vfs_path;
+        std::error_code ec;
+        if (std::filesystem::is_directory(real_dir, ec))
+        {
+            std::shared_ptr<MappedFile> file = MapNativeFile(std::filesystem::path(real_dir) / relative);
+            if (file && file->size == static_cast<Uint64>(stat.filesize))
+            {
+                view.data = file->data;
+                view.size = file->size;
+                view.owner = std::move(file);
+                view.mapped = true;
+                return view;
+            }
+        }
+        else if (std::shared_ptr<ArchiveIndex> archive = GetArchiveIndex(real_dir))
+        {
+            auto it = archive->entries.find(relative);
+            if (it != archive->entries.end())
+            {
+                view.data = archive->file->data + it->second.offset;
+                view.size = it->second.size;
+                view.owner = std::shared_ptr<const void>(archive->file, view.data);
+                view.mapped = true;
+                return view;
+            }
+        }
+    }
+
+    void *data = nullptr;
+    size_t size = 0;
+    ReadAll(vfs_path, &data, &size);
+    view.data = static_cast<const unsigned char *>(data);
+    view.size = size;
+    view.owner = std::shared_ptr<const void>(data, SDL_free);
+    return view;
+}
+
+std::shared_ptr<VFS::ArchiveIndex> VFS::GetArchiveIndex(const char *archive_path)
+{
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(archive_path, ec);
+    if (ec)
+    {
+        return nullptr;
+    }
+    const std::filesystem::file_time_type mtime = std::filesystem::last_write_time(archive_path, ec);
+    if (ec)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(archives_mutex);
+    std::shared_ptr<ArchiveIndex> &index = archives[archive_path];
+    if (!index || index->size != size || index->mtime != mtime)
+    {
+        // Views into the old mapping keep it alive; only new reads move to the rewritten archive.
+        index = std::make_shared<ArchiveIndex>();
+        index->size = size;
+        index->mtime = mtime;
+        index->file = MapNativeFile(archive_path);
+        if (!index->file || index->file->size != size || !IndexStoredZipEntries(*index->file, &index->entries))
+        {
+            index->file.reset();
+            index->entries.clear();
+        }
+    }
+    return index->file ? index : nullptr;
+}
+
+VfsReader VFS::OpenRead(const char *vfs_path)
+{
+    if (vfs_path == nullptr || vfs_path[0] == '\0')
+    {
+        throw std::runtime_error("OpenRead requires a non-empty path");
+    }
+
+    PHYSFS_File *file = PHYSFS_openRead(vfs_path);
+    if (!file)
+    {
+        throw MakePhysfsError("Failed to open", vfs_path);
+    }
+    return VfsReader(file);
+}
+
 void VFS::ReadAllWriteDir(const char *vfs_path, void **out_data, size_t *out_size)
 {
     if (vfs_path == nullptr || out_data == nullptr || out_size == nullptr)
@@ -682,6 +991,35 @@ error:
     throw MakePhysfsError(physfs_action, vfs_path);
 }
 
+void VFS::ListFiles(const char *vfs_path, char ***out_entries)
+{
+    if (vfs_path == nullptr || out_entries == nullptr)
+    {
+        throw std::runtime_error("ListFiles requires non-null arguments");
+    }
+
+    char **entries = static_cast<char **>(SDL_malloc(sizeof(char *)));
+    if (!entries)
+    {
+        throw std::runtime_error("ListFiles failed to allocate list");
+    }
+    entries[0] = nullptr;
+    size_t count = 0;
+    size_t capacity = 1;
+
+    try
+    {
+        ListFilesRecursive(vfs_path, nullptr, &entries, &count, &capacity);
+    }
+    catch (...)
+    {
+        FreeStringList(entries);
+        throw;
+    }
+
+    *out_entries = entries;
+}
+
 void VFS::ListWriteDir(const char *vfs_path, char ***out_entries)
 {
     if (vfs_path == nullptr || out_entries == nullptr)
@@ -735,7 +1073,7 @@ void VFS::ListWriteDirFiles(char ***out_entries)
 
     try
     {
-        ListWriteDirFilesRecursive("", write_dir, &entries, &count, &capacity);
+        ListFilesRecursive("", write_dir, &entries, &count, &capacity);
     }
     catch (...)
     {
@@ -809,4 +1147,132 @@ void VFS::FreeList(char **entries) noexcept
     }
 }
 
+VfsView::VfsView() noexcept : owner(), data(nullptr), size(0), mapped(false)
+{
+}
+
+const unsigned char *VfsView::GetData() const noexcept
+{
+    return data;
+}
+
+size_t VfsView::GetSize() const noexcept
+{
+    return size;
+}
+
+bool VfsView::IsMapped() const noexcept
+{
+    return mapped;
+}
+
+void VfsView::Reset() noexcept
+{
+    owner.reset();
+    data = nullptr;
+    size = 0;
+    mapped = false;
+}
+
+VfsReader::VfsReader() noexcept : file(nullptr)
+{
+}
+
+VfsReader::VfsReader(void *file_handle) noexcept : file(file_handle)
+{
+}
+
+VfsReader::~VfsReader()
+{
+    Close();
+}
+
+VfsReader::VfsReader(VfsReader &&other) noexcept : file(other.file)
+{
+    other.file = nullptr;
+}
+
+VfsReader &VfsReader::operator=(VfsReader &&other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    Close();
+    file = other.file;
+    other.file = nullptr;
+    return *this;
+}
+
+bool VfsReader::IsOpen() const noexcept
+{
+    return file != nullptr;
+}
+
+void VfsReader::Close() noexcept
+{
+    ClosePhysfsFile(static_cast<PHYSFS_File *>(file));
+    file = nullptr;
+}
+
+size_t VfsReader::Read(void *dst, size_t size)
+{
+    if (!file)
+    {
+        throw std::runtime_error("VfsReader::Read requires an open file");
+    }
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    PHYSFS_sint64 read = PHYSFS_readBytes(static_cast<PHYSFS_File *>(file), dst, size);
+    if (read < 0)
+    {
+        throw MakePhysfsError("Failed to read", nullptr);
+    }
+    return static_cast<size_t>(read);
+}
+
+void VfsReader::Seek(Uint64 offset)
+{
+    if (!file)
+    {
+        throw std::runtime_error("VfsReader::Seek requires an open file");
+    }
+    if (!PHYSFS_seek(static_cast<PHYSFS_File *>(file), offset))
+    {
+        throw MakePhysfsError("Failed to seek", nullptr);
+    }
+}
+
+Uint64 VfsReader::Tell() const
+{
+    if (!file)
+    {
+        throw std::runtime_error("VfsReader::Tell requires an open file");
+    }
+    PHYSFS_sint64 position = PHYSFS_tell(static_cast<PHYSFS_File *>(file));
+    if (position < 0)
+    {
+        throw MakePhysfsError("Failed to query position", nullptr);
+    }
+    return static_cast<Uint64>(position);
+}
+
+Uint64 VfsReader::GetLength() const
+{
+    if (!file)
+    {
+        throw std::runtime_error("VfsReader::GetLength requires an open file");
+    }
+    PHYSFS_sint64 length = PHYSFS_fileLength(static_cast<PHYSFS_File *>(file));
+    if (length < 0)
+    {
+        throw MakePhysfsError("Failed to get file length", nullptr);
+    }
+    return static_cast<Uint64>(length);
+}
+
 } // namespace engine
@@ -0,0 +1,232 @@
+#include "leo/asset_cooker.h"
+#include "leo/cooked_asset.h"
+#include "leo/engine_config.h"
+#include "leo/font.h"
+#include "leo/texture_loader.h"
+#include "leo/tiled_map.h"
+#include "leo/vfs.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct SDLVideoGuard
+{
+    SDLVideoGuard()
+    {
+        SDL_Init(SDL_INIT_VIDEO);
+    }
+
+    ~SDLVideoGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+engine::Config MakeConfig(const char *resource_path)
+{
+    return {.argv0 = "test",
+            .resource_path = resource_path,
+            .script_path = nullptr,
+            .organization = "bluesentinelsec",
+            .app_name = "leo-engine",
+            .malloc_fn = SDL_malloc,
+            .realloc_fn = SDL_realloc,
+            .free_fn = SDL_free};
+}
+
+std::vector<unsigned char> ReadFile(engine::VFS &vfs, const char *path)
+{
+    void *data = nullptr;
+    size_t size = 0;
+    vfs.ReadAll(path, &data, &size);
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    std::vector<unsigned char> result(bytes, bytes + size);
+    SDL_free(data);
+    return result;
+}
+
+// A cooked 2x2 map with one layer and no tilesets; the layer fields are written as given.
+std::vector<unsigned char> CookMapWithLayer(int width, int height, size_t tile_count, int offset_x)
+{
+    engine::CookedWriter writer(engine::kCookedMapTag);
+    writer.WriteI32(2);
+    writer.WriteI32(2);
+    writer.WriteI32(16);
+    writer.WriteI32(16);
+    writer.WriteU32(1);
+    writer.WriteString("ground");
+    writer.WriteI32(width);
+    writer.WriteI32(height);
+    writer.WriteI32(offset_x);
+    writer.WriteI32(0);
+    writer.WriteU32(1);
+    writer.WriteF32(1.0f);
+    writer.WriteU32(static_cast<Uint32>(tile_count));
+    for (size_t i = 0; i < tile_count; ++i)
+    {
+        writer.WriteU32(0);
+    }
+    const std::vector<unsigned char> flips(tile_count, 0);
+    writer.WriteBytes(flips.data(), flips.size());
+    writer.WriteU32(0); // images
+    writer.WriteU32(0); // texture slots
+    writer.WriteU32(0); // tiles
+    return std::move(writer.GetData());
+}
+
+void WriteBytes(const std::filesystem::path &path, const std::vector<unsigned char> &bytes)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+} // namespace
+
+TEST_CASE("AssetCooker pack mounts in place of the resources", "[asset_cooker]")
+{
+    SDLVideoGuard sdl;
+    const std::string pack_path = (std::filesystem::temp_directory_path() / "leo-cook-test.zip").string();
+    const char *image_path = "resources/images/hero_32x32.png";
+    const char *font_path = "resources/fonts/font.ttf";
+    const char *map_path = "resources/maps/map.tmx";
+
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    engine::DecodedImage source_image;
+    engine::FontBitmap source_font;
+    std::vector<unsigned char> script;
+    int layer_count = 0;
+    {
+        engine::Config config = MakeConfig(".");
+        engine::VFS vfs(config);
+        source_image = engine::TextureLoader::Decode(vfs, image_path);
+        source_font = engine::Font::Bake(vfs, font_path, 24);
+        script = ReadFile(vfs, "resources/scripts/game.lua");
+        layer_count = engine::TiledMap::LoadFromVfs(vfs, renderer, map_path).GetLayerCount();
+
+        engine::CookOptions options;
+        options.font_sizes = {24};
+        engine::AssetCooker cooker(vfs, options);
+        std::vector<std::string> failures;
+        engine::CookStats stats = cooker.Cook("resources", pack_path.c_str(), failures);
+        REQUIRE(failures.empty());
+        REQUIRE(stats.images > 0);
+        REQUIRE(stats.maps == 1);
+        REQUIRE(stats.fonts == 2); // resources/font and resources/fonts
+        REQUIRE(stats.copied > 0);
+    }
+
+    {
+        engine::Config config = MakeConfig(pack_path.c_str());
+        engine::VFS vfs(config);
+
+        // Stored pack entries are mapped in place, and cooked pixels start on an aligned boundary.
+        engine::VfsView view = vfs.ReadView(image_path);
+        REQUIRE(view.IsMapped());
+        REQUIRE(reinterpret_cast<std::uintptr_t>(view.GetData()) % engine::PackWriter::kPackAlignment == 0);
+        REQUIRE(vfs.ReadView(font_path).IsMapped());
+
+        // Images come back as the same pixels without going through stb_image.
+        REQUIRE(engine::CookedReader::IsCooked(ReadFile(vfs, image_path).data(), 16, engine::kCookedImageTag));
+        engine::DecodedImage image = engine::TextureLoader::Decode(vfs, image_path);
+        REQUIRE(image.width == source_image.width);
+        REQUIRE(image.height == source_image.height);
+        REQUIRE(std::memcmp(image.pixels, source_image.pixels, static_cast<size_t>(image.width * image.height * 4)) ==
+                0);
+
+        // The baked size loads from the cooked atlas; other sizes still rasterize from the copied font.
+        REQUIRE(vfs.Exists(engine::Font::GetCookedPath(font_path, 24).c_str()));
+        engine::FontBitmap font = engine::Font::Bake(vfs, font_path, 24);
+        REQUIRE(font.width == source_font.width);
+        REQUIRE(font.height == source_font.height);
+        REQUIRE(font.line_height == source_font.line_height);
+        REQUIRE(std::memcmp(font.rgba, source_font.rgba, static_cast<size_t>(font.width * font.height * 4)) == 0);
+        REQUIRE(engine::Font::Bake(vfs, font_path, 12).pixel_size == 12);
+
+        engine::TiledMap map = engine::TiledMap::LoadFromVfs(vfs, renderer, map_path);
+        REQUIRE(map.IsReady());
+        REQUIRE(map.GetWidth() == 130);
+        REQUIRE(map.GetHeight() == 80);
+        REQUIRE(map.GetLayerCount() == layer_count);
+
+        REQUIRE(ReadFile(vfs, "resources/scripts/game.lua") == script);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    std::filesystem::remove(pack_path);
+}
+
+TEST_CASE("Cooked assets reject damaged data", "[asset_cooker]")
+{
+    engine::DecodedImage image;
+    REQUIRE_THROWS_AS(engine::TextureLoader::Cook(image), std::runtime_error);
+
+    std::vector<unsigned char> pixels(4 * 4 * 4, 200);
+    image.pixels = static_cast<unsigned char *>(SDL_malloc(pixels.size()));
+    REQUIRE(image.pixels != nullptr);
+    std::memcpy(image.pixels, pixels.data(), pixels.size());
+    image.width = 4;
+    image.height = 4;
+    std::vector<unsigned char> cooked = engine::TextureLoader::Cook(image);
+    REQUIRE(cooked.size() == 16 + pixels.size());
+
+    engine::CookedReader reader(cooked.data(), cooked.size(), engine::kCookedImageTag);
+    REQUIRE(reader.ReadI32() == 4);
+    REQUIRE(reader.ReadI32() == 4);
+    REQUIRE_THROWS_AS(reader.ReadBytes(pixels.size() + 1), std::runtime_error);
+
+    REQUIRE_THROWS_AS(engine::CookedReader(cooked.data(), cooked.size(), engine::kCookedMapTag), std::runtime_error);
+    cooked[4] = static_cast<unsigned char>(engine::kCookedVersion + 1);
+    REQUIRE_THROWS_AS(engine::CookedReader(cooked.data(), cooked.size(), engine::kCookedImageTag), std::runtime_error);
+
+    const std::string pack_path = (std::filesystem::temp_directory_path() / "leo-pack-test.zip").string();
+    {
+        engine::PackWriter pack(pack_path.c_str());
+        pack.Add("a.bin", pixels.data(), pixels.size());
+        REQUIRE(pack.Contains("a.bin"));
+        REQUIRE_THROWS_AS(pack.Add("a.bin", pixels.data(), pixels.size()), std::runtime_error);
+        pack.Finish();
+        REQUIRE(pack.GetEntryCount() == 1);
+        REQUIRE_THROWS_AS(pack.Add("b.bin", pixels.data(), pixels.size()), std::runtime_error);
+    }
+    std::filesystem::remove(pack_path);
+
+    // Map layers must cover the map's tile grid exactly and sit at a drawable offset.
+    SDLVideoGuard sdl;
+    SDL_Surface *surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+    const std::filesystem::path map_dir = std::filesystem::temp_directory_path() / "leo-cooked-map-test";
+    std::filesystem::create_directories(map_dir);
+    WriteBytes(map_dir / "valid.tmx", CookMapWithLayer(2, 2, 4, 0));
+    WriteBytes(map_dir / "narrow.tmx", CookMapWithLayer(1, 2, 2, 0));
+    WriteBytes(map_dir / "tall.tmx", CookMapWithLayer(2, 3, 6, 0));
+    WriteBytes(map_dir / "short.tmx", CookMapWithLayer(2, 2, 3, 0));
+    WriteBytes(map_dir / "offset.tmx", CookMapWithLayer(2, 2, 4, 1 << 30));
+    {
+        engine::Config config = MakeConfig(map_dir.string().c_str());
+        engine::VFS vfs(config);
+        REQUIRE(engine::TiledMap::LoadFromVfs(vfs, renderer, "valid.tmx").GetLayerCount() == 1);
+        for (const char *path : {"narrow.tmx", "tall.tmx", "short.tmx", "offset.tmx"})
+        {
+            REQUIRE_THROWS_AS(engine::TiledMap::LoadFromVfs(vfs, renderer, path), std::runtime_error);
+        }
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    std::filesystem::remove_all(map_dir);
+}
@@ -0,0 +1,112 @@
+#include "leo/asset_loader.h"
+#include "leo/job_system.h"
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("AssetLoader without workers decodes inline in submission order", "[asset_loader]")
+{
+    engine::AssetLoader loader(0);
+    std::vector<int> order;
+
+    std::shared_ptr<engine::AssetRequest> first =
+        loader.Submit([&order]() { order.push_back(1); }, [&order]() { order.push_back(2); });
+    std::shared_ptr<engine::AssetRequest> second =
+        loader.Submit([&order]() { order.push_back(3); }, [&order]() { order.push_back(4); });
+    REQUIRE(loader.GetPendingCount() == 2);
+    REQUIRE(first->GetStatus() == engine::AssetStatus::Pending);
+    REQUIRE(order.empty());
+
+    // A zero budget still finishes one request per update.
+    REQUIRE(loader.Update(0) == 1);
+    REQUIRE(first->GetStatus() == engine::AssetStatus::Ready);
+    REQUIRE_FALSE(second->IsDone());
+
+    REQUIRE(loader.Update(1000000000) == 1);
+    REQUIRE(second->GetStatus() == engine::AssetStatus::Ready);
+    std::vector<int> expected = {1, 2, 3, 4};
+    REQUIRE(order == expected);
+    REQUIRE(loader.GetPendingCount() == 0);
+}
+
+TEST_CASE("AssetLoader reports failures from either step", "[asset_loader]")
+{
+    engine::AssetLoader loader(0);
+    bool finished = false;
+
+    std::shared_ptr<engine::AssetRequest> bad_decode = loader.Submit(
+        []() { throw std::runtime_error("decode failed"); }, [&finished]() { finished = true; });
+    std::shared_ptr<engine::AssetRequest> bad_finish =
+        loader.Submit([]() {}, []() { throw std::runtime_error("upload failed"); });
+
+    loader.Wait(bad_finish);
+    REQUIRE(bad_finish->GetStatus() == engine::AssetStatus::Failed);
+    REQUIRE(bad_finish->GetError() == "upload failed");
+    REQUIRE_FALSE(bad_decode->IsDone());
+
+    loader.Update(1000000000);
+    REQUIRE(bad_decode->GetStatus() == engine::AssetStatus::Failed);
+    REQUIRE(bad_decode->GetError() == "decode failed");
+    REQUIRE_FALSE(finished);
+}
+
+TEST_CASE("AssetLoader decodes on workers and finishes on the caller", "[asset_loader]")
+{
+    engine::AssetLoader loader(2);
+    REQUIRE(loader.GetWorkerCount() == 2);
+
+    std::atomic<int> decoded{0};
+    int finished = 0;
+    std::vector<std::shared_ptr<engine::AssetRequest>> requests;
+    for (int i = 0; i < 16; ++i)
+    {
+        requests.push_back(loader.Submit([&decoded]() { decoded++; }, [&finished]() { finished++; }));
+    }
+
+    for (const std::shared_ptr<engine::AssetRequest> &request : requests)
+    {
+        loader.Wait(request);
+        REQUIRE(request->GetStatus() == engine::AssetStatus::Ready);
+    }
+    REQUIRE(decoded == 16);
+    REQUIRE(finished == 16);
+    REQUIRE(loader.GetPendingCount() == 0);
+    REQUIRE(loader.Update(1000000) == 0);
+}
+
+TEST_CASE("AssetLoader decodes on a shared JobSystem", "[asset_loader]")
+{
+    engine::JobSystem jobs(2);
+    std::atomic<int> decoded{0};
+    int finished = 0;
+    std::vector<std::shared_ptr<engine::AssetRequest>> requests;
+    {
+        engine::AssetLoader loader(jobs);
+        REQUIRE(loader.GetWorkerCount() == 2);
+        for (int i = 0; i < 16; ++i)
+        {
+            requests.push_back(loader.Submit([&decoded]() { decoded++; }, [&finished]() { finished++; }));
+        }
+
+        // Finishes still wait for the caller; decodes run on the pool meanwhile.
+        for (const std::shared_ptr<engine::AssetRequest> &request : requests)
+        {
+            loader.Wait(request);
+            REQUIRE(request->GetStatus() == engine::AssetStatus::Ready);
+        }
+        REQUIRE(decoded == 16);
+        REQUIRE(finished == 16);
+        REQUIRE(loader.GetPendingCount() == 0);
+
+        // Loads still queued at shutdown fail instead of running against a destroyed loader.
+        requests.push_back(loader.Submit([&decoded]() { decoded++; }, [&finished]() { finished++; }));
+    }
+    REQUIRE(requests.back()->IsDone());
+    REQUIRE(finished == 16);
+
+    // The pool is still usable once the loader is gone.
+    bool ran = false;
+    jobs.Wait(jobs.Schedule([&ran]() { ran = true; }));
+    REQUIRE(ran);
+}
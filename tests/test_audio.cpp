@@ -3,6 +3,8 @@
 #include "leo/vfs.h"
 #include <catch2/catch_test_macros.hpp>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -35,6 +37,86 @@ TEST_CASE("Sound loads from VFS and can be configured", "[audio]")
     sound.Stop();
 }
 
+TEST_CASE("Sound plays overlapping voices from a shared sample", "[audio]")
+{
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    engine::Sound first = engine::Sound::LoadFromVfs(vfs, "resources/sound/coin.wav");
+    engine::Sound second = engine::Sound::LoadFromVfs(vfs, "resources/sound/coin.wav");
+    engine::VoiceStats stats = engine::GetVoiceStats();
+    REQUIRE(stats.cached_samples >= 1);
+    int active_before = stats.active_voices;
+
+    first.Play();
+    first.Play();
+    second.Play();
+    REQUIRE(first.IsPlaying());
+    REQUIRE(engine::GetVoiceStats().active_voices == active_before + 3);
+
+    first.SetMaxVoices(2);
+    first.Play();
+    REQUIRE(engine::GetVoiceStats().active_voices == active_before + 3);
+
+    first.Pause();
+    REQUIRE_FALSE(first.IsPlaying());
+    REQUIRE(second.IsPlaying());
+    first.Play();
+    REQUIRE(first.IsPlaying());
+
+    first.Stop();
+    second.Stop();
+    REQUIRE_FALSE(first.IsPlaying());
+    REQUIRE(engine::GetVoiceStats().active_voices == active_before);
+}
+
+TEST_CASE("Sound stays paused with no voices playing", "[audio]")
+{
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    engine::Sound sound = engine::Sound::LoadFromVfs(vfs, "resources/sound/coin.wav");
+    sound.SetLooping(true);
+
+    // Pausing before the first play is kept: the voice starts paused and the next play resumes it.
+    sound.Pause();
+    sound.Play();
+    REQUIRE_FALSE(sound.IsPlaying());
+    sound.Play();
+    REQUIRE(sound.IsPlaying());
+
+    sound.Stop();
+    sound.Play();
+    REQUIRE(sound.IsPlaying());
+    sound.Stop();
+}
+
+TEST_CASE("Voice pool applies the steal policy when full", "[audio]")
+{
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    engine::Sound sound = engine::Sound::LoadFromVfs(vfs, "resources/sound/coin.wav");
+    sound.SetLooping(true);
+    engine::VoiceStats before = engine::GetVoiceStats();
+    for (int i = 0; i < before.voice_count; ++i)
+    {
+        sound.Play();
+    }
+    REQUIRE(engine::GetVoiceStats().active_voices == before.voice_count);
+
+    engine::SetVoiceStealPolicy(engine::VoiceStealPolicy::Skip);
+    sound.Play();
+    REQUIRE(engine::GetVoiceStats().skipped == before.skipped + 1);
+
+    engine::SetVoiceStealPolicy(engine::VoiceStealPolicy::Oldest);
+    sound.Play();
+    REQUIRE(engine::GetVoiceStats().active_voices == before.voice_count);
+
+    sound.Reset();
+    REQUIRE(engine::GetVoiceStats().active_voices == 0);
+}
+
 TEST_CASE("Music loads from VFS and can be configured", "[audio]")
 {
     engine::Config config = MakeConfig();
@@ -49,6 +131,54 @@ TEST_CASE("Music loads from VFS and can be configured", "[audio]")
     music.Stop();
 }
 
+TEST_CASE("Music streams from VFS and can restart", "[audio]")
+{
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    engine::Music music = engine::Music::LoadFromVfs(vfs, "resources/music/music.wav");
+    REQUIRE(music.IsReady());
+
+    music.SetLooping(true);
+    music.Play();
+    music.Pause();
+    music.Play();
+    music.Stop();
+    REQUIRE_FALSE(music.IsPlaying());
+
+    engine::Music moved = std::move(music);
+    REQUIRE_FALSE(music.IsReady());
+    REQUIRE(moved.IsReady());
+    moved.Reset();
+    REQUIRE_FALSE(moved.IsReady());
+}
+
+TEST_CASE("Several Music streams play at once", "[audio]")
+{
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    std::vector<engine::Music> tracks;
+    for (int i = 0; i < 4; ++i)
+    {
+        tracks.push_back(engine::Music::LoadFromVfs(vfs, "resources/music/music.wav"));
+        tracks.back().SetLooping(true);
+        tracks.back().Play();
+    }
+    REQUIRE(tracks[0].IsPlaying());
+    REQUIRE(tracks[3].IsPlaying());
+
+    // Streams leave the shared feeder in any order while the others keep playing.
+    tracks.erase(tracks.begin() + 1);
+    tracks[0].Stop();
+    REQUIRE(tracks[2].IsPlaying());
+    tracks.clear();
+
+    engine::Music music = engine::Music::LoadFromVfs(vfs, "resources/music/music.wav");
+    music.Play();
+    REQUIRE(music.IsPlaying());
+}
+
 TEST_CASE("Audio loaders throw when file is missing", "[audio]")
 {
     engine::Config config = MakeConfig();
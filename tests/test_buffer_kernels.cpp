@@ -0,0 +1,71 @@
+#include "leo/buffer_kernels.h"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+
+TEST_CASE("Buffer kernels integrate, clamp and wrap in place", "[buffer_kernels]")
+{
+    float xs[4] = {0.0f, 10.0f, -5.0f, 300.0f};
+    const float vx[4] = {10.0f, -20.0f, 0.0f, 40.0f};
+
+    leo::BufferKernels::Integrate(xs, vx, 4, 0.5f);
+    REQUIRE(xs[0] == 5.0f);
+    REQUIRE(xs[1] == 0.0f);
+    REQUIRE(xs[2] == -5.0f);
+    REQUIRE(xs[3] == 320.0f);
+
+    float clamped[4] = {-1.0f, 0.5f, 2.0f, 1.0f};
+    leo::BufferKernels::Clamp(clamped, 4, 0.0f, 1.0f);
+    REQUIRE(clamped[0] == 0.0f);
+    REQUIRE(clamped[1] == 0.5f);
+    REQUIRE(clamped[2] == 1.0f);
+    REQUIRE(clamped[3] == 1.0f);
+
+    leo::BufferKernels::Wrap(xs, 4, 0.0f, 320.0f);
+    REQUIRE(xs[0] == 5.0f);
+    REQUIRE(xs[1] == 0.0f);
+    REQUIRE(xs[2] == 315.0f);
+    REQUIRE(xs[3] == 0.0f);
+
+    float far_out[2] = {-650.0f, 1290.0f};
+    leo::BufferKernels::Wrap(far_out, 2, 0.0f, 320.0f);
+    REQUIRE(far_out[0] == 310.0f);
+    REQUIRE(far_out[1] == 10.0f);
+}
+
+TEST_CASE("Buffer kernels answer distance queries", "[buffer_kernels]")
+{
+    const float xs[4] = {0.0f, 3.0f, 10.0f, -4.0f};
+    const float ys[4] = {0.0f, 4.0f, 0.0f, 3.0f};
+    const SDL_FPoint origin = {0.0f, 0.0f};
+
+    float distances[4] = {};
+    leo::BufferKernels::DistanceToPoint(xs, ys, 4, origin, distances);
+    REQUIRE(distances[0] == 0.0f);
+    REQUIRE(distances[1] == 5.0f);
+    REQUIRE(distances[2] == 10.0f);
+    REQUIRE(distances[3] == 5.0f);
+
+    float distance = -1.0f;
+    REQUIRE(leo::BufferKernels::Nearest(xs, ys, 4, {9.0f, 1.0f}, std::numeric_limits<float>::infinity(),
+                                        &distance) == 2);
+    REQUIRE(std::fabs(distance - std::sqrt(2.0f)) < 1.0e-6f);
+    // Equidistant entries resolve to the lower index; nothing within range gives count.
+    REQUIRE(leo::BufferKernels::Nearest(xs + 1, ys + 1, 3, origin, 5.0f, &distance) == 0);
+    REQUIRE(leo::BufferKernels::Nearest(xs + 1, ys + 1, 3, origin, 4.0f, &distance) == 3);
+
+    Sint32 hits[4] = {};
+    REQUIRE(leo::BufferKernels::WithinRadius(xs, ys, 4, origin, 5.0f, hits, 4) == 3);
+    REQUIRE(hits[0] == 0);
+    REQUIRE(hits[1] == 1);
+    REQUIRE(hits[2] == 3);
+    REQUIRE(leo::BufferKernels::WithinRadius(xs, ys, 4, origin, 5.0f, hits, 2) == 2);
+
+    const SDL_FRect rect = {2.0f, 2.0f, 10.0f, 10.0f};
+    REQUIRE(leo::BufferKernels::OverlapRect(xs, ys, 4, 2.5f, 2.5f, rect, hits, 4) == 3);
+    REQUIRE(hits[0] == 0);
+    REQUIRE(hits[1] == 1);
+    REQUIRE(hits[2] == 2);
+    REQUIRE(leo::BufferKernels::OverlapRect(xs, ys, 4, 1.0f, 1.0f, rect, hits, 4) == 1);
+    REQUIRE(hits[0] == 1);
+}
@@ -0,0 +1,112 @@
+#include "leo/canvas.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+
+struct SDLVideoGuard
+{
+    SDLVideoGuard()
+    {
+        SDL_Init(SDL_INIT_VIDEO);
+    }
+
+    ~SDLVideoGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+SDL_Color ReadPixel(SDL_Renderer *renderer, int x, int y)
+{
+    SDL_Rect rect = {x, y, 1, 1};
+    SDL_Surface *pixels = SDL_RenderReadPixels(renderer, &rect);
+    REQUIRE(pixels != nullptr);
+    SDL_Color color = {0, 0, 0, 0};
+    SDL_ReadSurfacePixel(pixels, 0, 0, &color.r, &color.g, &color.b, &color.a);
+    SDL_DestroySurface(pixels);
+    return color;
+}
+
+void PaintCanvas(SDL_Renderer *renderer, engine::Canvas &canvas)
+{
+    REQUIRE(SDL_SetRenderTarget(renderer, canvas.GetTexture().handle));
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    if (canvas.IsPreserved())
+    {
+        canvas.Snapshot();
+    }
+    REQUIRE(SDL_SetRenderTarget(renderer, nullptr));
+}
+
+} // namespace
+
+TEST_CASE("Canvas starts transparent and draws like a texture", "[canvas]")
+{
+    SDLVideoGuard sdl;
+    SDL_Surface *surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::Canvas canvas(renderer, 16, 16, true);
+        REQUIRE(canvas.GetTexture().width == 16);
+        REQUIRE(canvas.GetTexture().height == 16);
+        REQUIRE(SDL_GetRenderTarget(renderer) == nullptr);
+
+        SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
+        SDL_RenderClear(renderer);
+        SDL_RenderTexture(renderer, canvas.GetTexture().handle, nullptr, nullptr);
+        REQUIRE(ReadPixel(renderer, 4, 4).b == 255);
+
+        PaintCanvas(renderer, canvas);
+        SDL_FRect dst = {0.0f, 0.0f, 16.0f, 16.0f};
+        SDL_RenderTexture(renderer, canvas.GetTexture().handle, nullptr, &dst);
+        SDL_Color color = ReadPixel(renderer, 4, 4);
+        REQUIRE(color.r == 255);
+        REQUIRE(color.b == 0);
+        REQUIRE(ReadPixel(renderer, 20, 20).b == 255);
+    }
+
+    REQUIRE_THROWS(engine::Canvas(renderer, 0, 16, true));
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
+
+TEST_CASE("Canvas restores preserved contents after a reset", "[canvas]")
+{
+    SDLVideoGuard sdl;
+    SDL_Surface *surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::Canvas preserved(renderer, 8, 8, true);
+        engine::Canvas scratch(renderer, 8, 8, false);
+        PaintCanvas(renderer, preserved);
+        PaintCanvas(renderer, scratch);
+
+        const engine::Texture *texture = &preserved.GetTexture();
+        preserved.Restore(true);
+        scratch.Restore(false);
+        REQUIRE(&preserved.GetTexture() == texture);
+        REQUIRE(preserved.GetTexture().handle != nullptr);
+        REQUIRE(SDL_GetRenderTarget(renderer) == nullptr);
+
+        REQUIRE(SDL_SetRenderTarget(renderer, preserved.GetTexture().handle));
+        SDL_Color kept = ReadPixel(renderer, 2, 2);
+        REQUIRE(kept.r == 255);
+        REQUIRE(kept.a == 255);
+        REQUIRE(SDL_SetRenderTarget(renderer, scratch.GetTexture().handle));
+        REQUIRE(ReadPixel(renderer, 2, 2).a == 0);
+        REQUIRE(SDL_SetRenderTarget(renderer, nullptr));
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
@@ -1,5 +1,112 @@
 #include "leo/engine_core.h"
+#include "leo/input_recording.h"
+#include "leo/vfs.h"
 #include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+// Folds every tick's random draw and input into a hash and saves it on shutdown, so two runs that saw the same
+// seed and input end with the same file.
+constexpr const char *kReplayScript = R"(
+local ticks, hash = 0, 17
+function leo.update(dt, input)
+    ticks = ticks + 1
+    local value = math.random(1, 1000000)
+    if input.keyboard:isDown("space") then
+        value = value * 3
+    end
+    if input.keyboard:isPressed("a") then
+        value = value + 7
+    end
+    hash = (hash * 31 + value + input.frame) % 2147483647
+end
+function leo.shutdown()
+    leo.fs.write("replay_state.txt", ticks .. ":" .. hash)
+end
+)";
+
+// Notes the tick each async load resolves on, polled and awaited, so a replay that resolves it later differs.
+constexpr const char *kAsyncReplayScript = R"(
+local ticks, future, polled_tick, awaited_tick = 0, nil, 0, 0
+function leo.update(dt, input)
+    ticks = ticks + 1
+    if ticks == 1 then
+        future = leo.graphics.newImageAsync("hero.png")
+        leo.task.spawn(function()
+            local image = leo.task.await(leo.graphics.newImageAsync("hero.png"))
+            assert(image ~= nil, "awaited image failed to load")
+            awaited_tick = ticks
+        end)
+    elseif polled_tick == 0 and future:isDone() then
+        assert(future:isReady(), future:getError())
+        polled_tick = ticks
+    end
+end
+function leo.shutdown()
+    leo.fs.write("replay_state.txt", ticks .. ":" .. polled_tick .. ":" .. awaited_tick)
+end
+)";
+
+engine::Config MakeReplayConfig(const char *resource_path)
+{
+    return {.argv0 = "test",
+            .resource_path = resource_path,
+            .script_path = "main.lua",
+            .organization = "bluesentinelsec",
+            .app_name = "leo-engine",
+            .window_title = "Leo Engine Test",
+            .window_width = 64,
+            .window_height = 64,
+            .logical_width = 0,
+            .logical_height = 0,
+            .window_mode = engine::WindowMode::Windowed,
+            .tick_hz = 60,
+            .NumFrameTicks = 0,
+            .render_hz = 0,
+            .max_catchup_ticks = 0,
+            .asset_budget_us = 0,
+            .gc_budget_us = 0,
+            .gc_mode = engine::GcMode::Incremental,
+            .job_workers = -1,
+            .disable_script_cache = true,
+            .headless = true,
+            .benchmark_path = nullptr,
+            .profile_path = nullptr,
+            .profile_overlay = false,
+            .record_path = nullptr,
+            .replay_path = nullptr,
+            .malloc_fn = SDL_malloc,
+            .realloc_fn = SDL_realloc,
+            .free_fn = SDL_free};
+}
+
+// Runs the simulation and returns the state the script saved on shutdown.
+std::string RunForState(engine::Config &config)
+{
+    {
+        engine::VFS vfs(config);
+        vfs.WriteAll("replay_state.txt", "", 0);
+    }
+    {
+        leo::Engine::Simulation game(config);
+        REQUIRE(game.Run() == 0);
+    }
+
+    engine::VFS vfs(config);
+    void *data = nullptr;
+    size_t size = 0;
+    vfs.ReadAllWriteDir("replay_state.txt", &data, &size);
+    std::string state(static_cast<const char *>(data), size);
+    SDL_free(data);
+    return state;
+}
+
+} // namespace
 
 TEST_CASE("Simulation runs requested frame ticks", "[engine_core]")
 {
@@ -23,3 +130,120 @@ TEST_CASE("Simulation runs requested frame ticks", "[engine_core]")
     leo::Engine::Simulation game(config);
     REQUIRE(game.Run() == 0);
 }
+
+TEST_CASE("Simulation runs frame ticks with a separate render rate", "[engine_core]")
+{
+    engine::Config config = {.argv0 = "test",
+                             .resource_path = nullptr,
+                             .script_path = nullptr,
+                             .organization = "bluesentinelsec",
+                             .app_name = "leo-engine",
+                             .window_title = "Leo Engine Test",
+                             .window_width = 64,
+                             .window_height = 64,
+                             .logical_width = 0,
+                             .logical_height = 0,
+                             .window_mode = engine::WindowMode::Windowed,
+                             .tick_hz = 120,
+                             .NumFrameTicks = 3,
+                             .render_hz = 30,
+                             .max_catchup_ticks = 2,
+                             .malloc_fn = SDL_malloc,
+                             .realloc_fn = SDL_realloc,
+                             .free_fn = SDL_free};
+
+    leo::Engine::Simulation game(config);
+    REQUIRE(game.Run() == 0);
+}
+
+TEST_CASE("Replaying a recording reproduces the recorded run", "[engine_core]")
+{
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "leo-replay-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    std::ofstream(root / "main.lua", std::ios::binary) << kReplayScript;
+    const std::string resources = root.string();
+    const std::string scripted_path = (root / "scripted.leoinput").string();
+    const std::string recorded_path = (root / "recorded.leoinput").string();
+
+    // A live run records its seed; replaying it draws the same random numbers on the same ticks.
+    engine::Config config = MakeReplayConfig(resources.c_str());
+    config.NumFrameTicks = 20;
+    config.record_path = recorded_path.c_str();
+    const std::string recorded = RunForState(config);
+    REQUIRE(recorded.rfind("20:", 0) == 0);
+
+    config = MakeReplayConfig(resources.c_str());
+    config.replay_path = recorded_path.c_str();
+    REQUIRE(RunForState(config) == recorded);
+
+    // Live devices cannot be driven from a test, so replay scripted input while recording it, then replay what the
+    // engine recorded.
+    {
+        engine::InputRecorder recorder(scripted_path.c_str(), 60, 0x5EEDull);
+        leo::Engine::InputFrame frame = {};
+        frame.keyboard.Reset();
+        frame.mouse.Reset();
+        for (engine::GamepadState &gamepad : frame.gamepads)
+        {
+            gamepad.Reset();
+        }
+        for (Uint32 i = 0; i < 30; ++i)
+        {
+            frame.keyboard.BeginFrame();
+            if (i % 10 == 2)
+            {
+                frame.keyboard.SetKeyDown(engine::Key::A);
+            }
+            else if (i % 10 == 3)
+            {
+                frame.keyboard.SetKeyUp(engine::Key::A);
+            }
+            if (i == 5)
+            {
+                frame.keyboard.SetKeyDown(engine::Key::Space);
+            }
+            else if (i == 15)
+            {
+                frame.keyboard.SetKeyUp(engine::Key::Space);
+            }
+            recorder.Write(frame);
+        }
+    }
+
+    config = MakeReplayConfig(resources.c_str());
+    config.replay_path = scripted_path.c_str();
+    config.record_path = recorded_path.c_str();
+    const std::string scripted = RunForState(config);
+    REQUIRE(scripted.rfind("30:", 0) == 0);
+
+    config = MakeReplayConfig(resources.c_str());
+    config.replay_path = recorded_path.c_str();
+    REQUIRE(RunForState(config) == scripted);
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Replays finish async loads on the recorded tick", "[engine_core]")
+{
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "leo-async-replay-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    std::ofstream(root / "main.lua", std::ios::binary) << kAsyncReplayScript;
+    std::filesystem::copy_file("resources/images/hero_32x32.png", root / "hero.png");
+    const std::string resources = root.string();
+    const std::string recorded_path = (root / "recorded.leoinput").string();
+
+    // Loads submitted on a tick are finished before the next one, whatever the decode takes.
+    engine::Config config = MakeReplayConfig(resources.c_str());
+    config.NumFrameTicks = 10;
+    config.record_path = recorded_path.c_str();
+    const std::string recorded = RunForState(config);
+    REQUIRE(recorded == "10:2:2");
+
+    config = MakeReplayConfig(resources.c_str());
+    config.replay_path = recorded_path.c_str();
+    REQUIRE(RunForState(config) == recorded);
+
+    std::filesystem::remove_all(root);
+}
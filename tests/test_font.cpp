@@ -97,3 +97,41 @@ TEST_CASE("Font loader throws when file is missing", "[font]")
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
 }
+
+TEST_CASE("Font caches glyph runs by string and size with LRU eviction", "[font]")
+{
+    SDLVideoGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    SDL_Window *window = CreateTestWindow();
+    REQUIRE(window != nullptr);
+    SDL_Renderer *renderer = SDL_CreateRenderer(window, nullptr);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::Font font = engine::Font::LoadFromVfs(vfs, renderer, "resources/font/font.ttf", 24);
+        font.SetRunCacheCapacity(2);
+        REQUIRE(font.GetRunCacheCapacity() == 2);
+
+        const SDL_Color white = {255, 255, 255, 255};
+        font.DrawText(renderer, "Score: 10", 24, {0.0f, 0.0f}, white);
+        font.DrawText(renderer, "Score: 10", 24, {8.0f, 8.0f}, white);
+        REQUIRE(font.GetCachedRunCount() == 1);
+
+        font.DrawText(renderer, "Score: 10", 12, {0.0f, 0.0f}, white);
+        REQUIRE(font.GetCachedRunCount() == 2);
+
+        font.DrawText(renderer, "Lives: 3", 24, {0.0f, 0.0f}, white);
+        REQUIRE(font.GetCachedRunCount() == 2);
+
+        font.SetRunCacheCapacity(1);
+        REQUIRE(font.GetCachedRunCount() == 1);
+
+        font.Reset();
+        REQUIRE(font.GetCachedRunCount() == 0);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+}
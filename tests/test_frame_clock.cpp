@@ -0,0 +1,125 @@
+#include "leo/frame_clock.h"
+#include <SDL3/SDL_timer.h>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+namespace
+{
+
+struct LoopCounts
+{
+    Uint32 ticks = 0;
+    Uint32 renders = 0;
+    std::vector<Uint32> ticks_per_frame;
+};
+
+// Mirrors Simulation::Run's throttled loop on a synthetic clock: each frame adds the time since the previous one,
+// runs the due ticks, takes work_ns, then waits for the frame deadline.
+LoopCounts RunLoop(engine::FrameClock &clock, Uint64 duration_ns, Uint64 work_ns)
+{
+    LoopCounts counts;
+    Uint64 now = 0;
+    Uint64 previous = 0;
+    while (now < duration_ns)
+    {
+        const Uint64 frame_start = now;
+        clock.AddElapsed(frame_start - previous);
+        previous = frame_start;
+
+        Uint32 ticks = 0;
+        while (clock.ConsumeTick())
+        {
+            ticks++;
+        }
+        counts.ticks += ticks;
+        counts.renders++;
+        counts.ticks_per_frame.push_back(ticks);
+
+        now = frame_start + work_ns;
+        if (now < clock.GetFrameDeadline(frame_start))
+        {
+            now = clock.GetFrameDeadline(frame_start);
+        }
+    }
+    return counts;
+}
+
+} // namespace
+
+TEST_CASE("FrameClock runs one tick per frame at the tick rate", "[frame_clock]")
+{
+    engine::FrameClock clock(60, 0, 0);
+    REQUIRE(clock.GetFrameNs() == clock.GetTickNs());
+    REQUIRE(clock.GetMaxCatchupTicks() == engine::FrameClock::kDefaultMaxCatchupTicks);
+
+    LoopCounts counts = RunLoop(clock, 60 * clock.GetFrameNs(), 0);
+    REQUIRE(counts.renders == 60);
+    // The first frame has no elapsed time yet; every later frame covers exactly one tick.
+    REQUIRE(counts.ticks == 59);
+    for (size_t i = 1; i < counts.ticks_per_frame.size(); ++i)
+    {
+        REQUIRE(counts.ticks_per_frame[i] == 1);
+    }
+}
+
+TEST_CASE("FrameClock caps rendering at render_hz", "[frame_clock]")
+{
+    engine::FrameClock clock(120, 30, 0);
+    LoopCounts counts = RunLoop(clock, 30 * clock.GetFrameNs(), 0);
+    REQUIRE(counts.renders == 30);
+    REQUIRE(counts.ticks == 116);
+    for (size_t i = 1; i < counts.ticks_per_frame.size(); ++i)
+    {
+        REQUIRE(counts.ticks_per_frame[i] == 4);
+    }
+}
+
+TEST_CASE("FrameClock catches up on slow frames", "[frame_clock]")
+{
+    // Each frame takes 2.5 ticks of work, so ticks alternate between 2 and 3 and the simulation keeps pace.
+    engine::FrameClock clock(100, 0, 0);
+    const Uint64 tick_ns = clock.GetTickNs();
+    LoopCounts counts = RunLoop(clock, 100 * tick_ns, tick_ns * 5 / 2);
+    REQUIRE(counts.renders == 40);
+    REQUIRE(counts.ticks == 97);
+    REQUIRE(counts.ticks_per_frame[1] == 2);
+    REQUIRE(counts.ticks_per_frame[2] == 3);
+}
+
+TEST_CASE("FrameClock clamps catch-up after a stall", "[frame_clock]")
+{
+    engine::FrameClock clock(60, 0, 3);
+    const Uint64 tick_ns = clock.GetTickNs();
+
+    clock.AddElapsed(SDL_NS_PER_SECOND);
+    Uint32 ticks = 0;
+    while (clock.ConsumeTick())
+    {
+        ticks++;
+    }
+    REQUIRE(ticks == 3);
+    REQUIRE(clock.GetAlpha() == 0.0f);
+
+    // The dropped time is gone for good: the next normal frame runs a single tick.
+    clock.AddElapsed(tick_ns);
+    REQUIRE(clock.ConsumeTick());
+    REQUIRE_FALSE(clock.ConsumeTick());
+
+    // A partial tick carries over as the interpolation alpha.
+    clock.AddElapsed(tick_ns / 4);
+    REQUIRE_FALSE(clock.ConsumeTick());
+    REQUIRE(clock.GetAlpha() > 0.24f);
+    REQUIRE(clock.GetAlpha() < 0.26f);
+}
+
+TEST_CASE("FrameClock adds one tick per frame when unpaced", "[frame_clock]")
+{
+    engine::FrameClock clock(60, 30, 2);
+    for (int i = 0; i < 10; ++i)
+    {
+        clock.AddTick();
+        REQUIRE(clock.ConsumeTick());
+        REQUIRE_FALSE(clock.ConsumeTick());
+    }
+    REQUIRE(clock.GetAlpha() == 0.0f);
+}
@@ -0,0 +1,49 @@
+#include "leo/frame_stats.h"
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+TEST_CASE("FrameStats reports frame percentiles", "[frame_stats]")
+{
+    engine::FrameStats stats;
+    for (Uint64 i = 1; i <= 100; ++i)
+    {
+        stats.EndFrame(i * 1000000);
+    }
+
+    REQUIRE(stats.GetFrameCount() == 100);
+    REQUIRE(stats.GetFramePercentileMs(50.0) == 50.0);
+    REQUIRE(stats.GetFramePercentileMs(95.0) == 95.0);
+    REQUIRE(stats.GetFramePercentileMs(99.0) == 99.0);
+    REQUIRE(stats.GetFramePercentileMs(100.0) == 100.0);
+}
+
+TEST_CASE("FrameStats accumulates phases per frame", "[frame_stats]")
+{
+    engine::FrameStats stats;
+    stats.AddTicks(2);
+    stats.AddPhase(engine::FramePhase::Update, 3000000);
+    stats.AddPhase(engine::FramePhase::Update, 1000000);
+    stats.AddPhase(engine::FramePhase::Draw, 2000000);
+    stats.EndFrame(8000000);
+    stats.AddTicks(1);
+    stats.AddPhase(engine::FramePhase::Present, 500000);
+    stats.AddPhase(engine::FramePhase::Gc, 250000);
+    stats.EndFrame(1000000);
+
+    REQUIRE(stats.GetTickCount() == 3);
+    REQUIRE(stats.GetPhaseTotalNs(engine::FramePhase::Update) == 4000000);
+    REQUIRE(stats.GetPhaseTotalNs(engine::FramePhase::Draw) == 2000000);
+    REQUIRE(stats.GetPhaseTotalNs(engine::FramePhase::Present) == 500000);
+    REQUIRE(stats.GetPhaseTotalNs(engine::FramePhase::Gc) == 250000);
+
+    std::string json = stats.ToJson();
+    REQUIRE(json.find("\"frames\": 2") != std::string::npos);
+    REQUIRE(json.find("\"ticks\": 3") != std::string::npos);
+    REQUIRE(json.find("\"update\": {\"total\": 4.000") != std::string::npos);
+    REQUIRE(json.find("\"gc\": {\"total\": 0.250") != std::string::npos);
+    REQUIRE(json.find("\"p99\"") != std::string::npos);
+
+    stats.Reset();
+    REQUIRE(stats.GetFrameCount() == 0);
+    REQUIRE(stats.GetFramePercentileMs(50.0) == 0.0);
+}
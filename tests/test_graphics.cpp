@@ -0,0 +1,109 @@
+#include "leo/graphics.h"
+#include "leo/sprite_batch.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+
+struct SDLVideoGuard
+{
+    SDLVideoGuard()
+    {
+        SDL_Init(SDL_INIT_VIDEO);
+    }
+
+    ~SDLVideoGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+SDL_Color ReadPixel(SDL_Renderer *renderer, int x, int y)
+{
+    SDL_Rect rect = {x, y, 1, 1};
+    SDL_Surface *pixels = SDL_RenderReadPixels(renderer, &rect);
+    REQUIRE(pixels != nullptr);
+    SDL_Color color = {0, 0, 0, 0};
+    SDL_ReadSurfacePixel(pixels, 0, 0, &color.r, &color.g, &color.b, &color.a);
+    SDL_DestroySurface(pixels);
+    return color;
+}
+
+} // namespace
+
+TEST_CASE("Graphics shapes share one geometry submission", "[graphics]")
+{
+    SDLVideoGuard sdl;
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::SpriteBatch batch(renderer);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+
+        leo::Graphics::DrawCircleFilled(batch, 16.0f, 16.0f, 10.0f, {255, 0, 0, 255});
+        leo::Graphics::DrawRectangleRoundedOutline(batch, 32.0f, 32.0f, 24.0f, 16.0f, 4.0f, {0, 255, 0, 255});
+        leo::Graphics::DrawLine(batch, 0.0f, 60.0f, 20.0f, 60.0f, {0, 0, 255, 255});
+        REQUIRE(batch.GetFlushCount() == 0);
+        batch.Flush();
+        REQUIRE(batch.GetFlushCount() == 1);
+
+        SDL_Color center = ReadPixel(renderer, 16, 16);
+        REQUIRE(center.r == 255);
+        REQUIRE(center.g == 0);
+        SDL_Color corner = ReadPixel(renderer, 7, 7);
+        REQUIRE(corner.r == 0);
+        SDL_Color edge = ReadPixel(renderer, 44, 32);
+        REQUIRE(edge.g == 255);
+        SDL_Color inside = ReadPixel(renderer, 44, 40);
+        REQUIRE(inside.g == 0);
+        SDL_Color line = ReadPixel(renderer, 10, 60);
+        REQUIRE(line.b == 255);
+
+        // Shapes carry their color per vertex; the renderer's draw color is left alone.
+        Uint8 r = 0;
+        Uint8 g = 0;
+        Uint8 b = 0;
+        Uint8 a = 0;
+        REQUIRE(SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a));
+        REQUIRE(r == 0);
+        REQUIRE(g == 0);
+        REQUIRE(b == 0);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
+
+TEST_CASE("Graphics shapes blend with what is underneath", "[graphics]")
+{
+    SDLVideoGuard sdl;
+    SDL_Surface *surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::SpriteBatch batch(renderer);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+
+        leo::Graphics::DrawRectangleFilled(batch, 0.0f, 0.0f, 16.0f, 16.0f, {255, 255, 255, 128});
+        batch.Flush();
+
+        SDL_Color color = ReadPixel(renderer, 8, 8);
+        REQUIRE(color.r > 100);
+        REQUIRE(color.r < 160);
+
+        SDL_BlendMode mode = SDL_BLENDMODE_BLEND;
+        REQUIRE(SDL_GetRenderDrawBlendMode(renderer, &mode));
+        REQUIRE(mode == SDL_BLENDMODE_NONE);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
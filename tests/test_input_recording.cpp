@@ -0,0 +1,139 @@
+#include "leo/input_recording.h"
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <stdexcept>
+
+namespace
+{
+
+constexpr const char *kRecordingPath = "test_input_recording.leoinput";
+
+struct RecordingFileGuard
+{
+    ~RecordingFileGuard()
+    {
+        std::remove(kRecordingPath);
+    }
+};
+
+long FileSize(const char *path)
+{
+    std::FILE *file = std::fopen(path, "rb");
+    REQUIRE(file != nullptr);
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    return size;
+}
+
+leo::Engine::InputFrame MakeIdleFrame()
+{
+    leo::Engine::InputFrame frame = {};
+    frame.keyboard.Reset();
+    frame.mouse.Reset();
+    for (engine::GamepadState &gamepad : frame.gamepads)
+    {
+        gamepad.Reset();
+    }
+    return frame;
+}
+
+} // namespace
+
+TEST_CASE("Input recordings replay every tick's state", "[input_recording]")
+{
+    RecordingFileGuard guard;
+
+    leo::Engine::InputFrame first = MakeIdleFrame();
+    first.keyboard.SetKeyDown(engine::Key::W);
+    first.mouse.SetButtonDown(engine::MouseButton::Left);
+    first.mouse.SetPosition(120.5f, 64.0f);
+    first.mouse.AddDelta(3.0f, -2.0f);
+    first.gamepads[1].SetConnected(true);
+    first.gamepads[1].SetButtonDown(engine::GamepadButton::South);
+    first.gamepads[1].SetAxis(engine::GamepadAxis::LeftX, -0.5f);
+
+    leo::Engine::InputFrame second = first;
+    second.keyboard.BeginFrame();
+    second.mouse.BeginFrame();
+    second.gamepads[1].BeginFrame();
+    second.keyboard.SetKeyUp(engine::Key::W);
+    second.keyboard.SetKeyDown(engine::Key::Space);
+    second.keyboard.SetKeyUp(engine::Key::Space);
+    second.mouse.AddWheel(0.0f, 1.0f);
+    second.gamepads[1].SetAxis(engine::GamepadAxis::LeftX, 0.75f);
+
+    {
+        engine::InputRecorder recorder(kRecordingPath, 120, 0x1234ABCDull);
+        recorder.Write(first);
+        recorder.Write(second);
+        REQUIRE(recorder.GetFrameCount() == 2);
+    }
+
+    engine::InputPlayback playback(kRecordingPath);
+    REQUIRE(playback.GetTickHz() == 120);
+    REQUIRE(playback.GetSeed() == 0x1234ABCDull);
+
+    leo::Engine::InputFrame frame = MakeIdleFrame();
+    REQUIRE(playback.Read(frame));
+    REQUIRE(frame.frame_index == 0);
+    REQUIRE(frame.keyboard.IsPressed(engine::Key::W));
+    REQUIRE(frame.mouse.IsButtonDown(engine::MouseButton::Left));
+    REQUIRE(frame.mouse.GetX() == 120.5f);
+    REQUIRE(frame.mouse.GetDeltaY() == -2.0f);
+    REQUIRE_FALSE(frame.gamepads[0].IsConnected());
+    REQUIRE(frame.gamepads[1].IsButtonPressed(engine::GamepadButton::South));
+    REQUIRE(frame.gamepads[1].GetAxis(engine::GamepadAxis::LeftX) == -0.5f);
+
+    REQUIRE(playback.Read(frame));
+    REQUIRE(frame.frame_index == 1);
+    REQUIRE(frame.keyboard.IsReleased(engine::Key::W));
+    REQUIRE(frame.keyboard.IsPressed(engine::Key::Space));
+    REQUIRE(frame.keyboard.IsReleased(engine::Key::Space));
+    REQUIRE(frame.keyboard.IsUp(engine::Key::Space));
+    REQUIRE(frame.mouse.IsButtonDown(engine::MouseButton::Left));
+    REQUIRE_FALSE(frame.mouse.IsButtonPressed(engine::MouseButton::Left));
+    REQUIRE(frame.mouse.GetDeltaX() == 0.0f);
+    REQUIRE(frame.mouse.GetWheelY() == 1.0f);
+    REQUIRE(frame.gamepads[1].IsAxisPressed(engine::GamepadAxis::LeftX, 0.5f, engine::AxisDirection::Positive));
+
+    REQUIRE_FALSE(playback.Read(frame));
+}
+
+TEST_CASE("Input recordings store idle ticks in one byte", "[input_recording]")
+{
+    RecordingFileGuard guard;
+    long header_size = 0;
+    {
+        engine::InputRecorder recorder(kRecordingPath, 60, 1);
+        std::fflush(nullptr);
+        header_size = FileSize(kRecordingPath);
+        leo::Engine::InputFrame idle = MakeIdleFrame();
+        for (int i = 0; i < 100; ++i)
+        {
+            recorder.Write(idle);
+        }
+    }
+    REQUIRE(FileSize(kRecordingPath) == header_size + 100);
+
+    engine::InputPlayback playback(kRecordingPath);
+    leo::Engine::InputFrame frame = MakeIdleFrame();
+    int count = 0;
+    while (playback.Read(frame))
+    {
+        count++;
+    }
+    REQUIRE(count == 100);
+}
+
+TEST_CASE("Input playback rejects files that are not recordings", "[input_recording]")
+{
+    RecordingFileGuard guard;
+    std::FILE *file = std::fopen(kRecordingPath, "wb");
+    REQUIRE(file != nullptr);
+    std::fputs("not an input recording", file);
+    std::fclose(file);
+
+    REQUIRE_THROWS_AS(engine::InputPlayback{kRecordingPath}, std::runtime_error);
+    REQUIRE_THROWS_AS(engine::InputPlayback{"missing.leoinput"}, std::runtime_error);
+}
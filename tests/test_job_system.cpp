@@ -0,0 +1,88 @@
+#include "leo/job_system.h"
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("JobSystem without workers runs jobs inline in order", "[job_system]")
+{
+    engine::JobSystem jobs(0);
+    REQUIRE(jobs.GetWorkerCount() == 0);
+
+    std::vector<int> order;
+    engine::JobHandle first = jobs.Schedule([&order]() { order.push_back(1); });
+    REQUIRE(first.IsDone());
+    engine::JobHandle second = jobs.Schedule([&order]() { order.push_back(2); }, {first});
+    jobs.Wait(second);
+
+    std::vector<int> expected = {1, 2};
+    REQUIRE(order == expected);
+    REQUIRE(engine::JobHandle().IsDone());
+}
+
+TEST_CASE("JobSystem runs dependents after their dependencies", "[job_system]")
+{
+    engine::JobSystem jobs(3);
+    REQUIRE(jobs.GetWorkerCount() == 3);
+
+    for (int round = 0; round < 50; ++round)
+    {
+        std::atomic<int> stage{0};
+        std::atomic<bool> ordered{true};
+        std::vector<engine::JobHandle> producers;
+        for (int i = 0; i < 8; ++i)
+        {
+            producers.push_back(jobs.Schedule([&stage]() { stage.fetch_add(1); }));
+        }
+        engine::JobHandle consumer = jobs.Schedule(
+            [&stage, &ordered]() {
+                if (stage.load() != 8)
+                {
+                    ordered = false;
+                }
+            },
+            producers);
+        jobs.Wait(consumer);
+        REQUIRE(ordered.load());
+    }
+}
+
+TEST_CASE("JobSystem ParallelFor covers every index once", "[job_system]")
+{
+    for (Uint32 workers : {0u, 4u})
+    {
+        engine::JobSystem jobs(workers);
+        std::vector<int> hits(1000, 0);
+        jobs.ParallelFor(hits.size(), 64, [&hits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                hits[i]++;
+            }
+        });
+        REQUIRE(std::accumulate(hits.begin(), hits.end(), 0) == 1000);
+        REQUIRE(std::find(hits.begin(), hits.end(), 0) == hits.end());
+    }
+}
+
+TEST_CASE("JobSystem rethrows job exceptions from Wait", "[job_system]")
+{
+    engine::JobSystem jobs(2);
+    engine::JobHandle failing = jobs.Schedule([]() { throw std::runtime_error("job failed"); });
+    REQUIRE_THROWS_AS(jobs.Wait(failing), std::runtime_error);
+
+    bool ran = false;
+    engine::JobHandle dependent = jobs.Schedule([&ran]() { ran = true; }, {failing});
+    jobs.Wait(dependent);
+    REQUIRE(ran);
+
+    REQUIRE_THROWS_AS(jobs.ParallelFor(8, 1,
+                                       [](size_t begin, size_t) {
+                                           if (begin == 5)
+                                           {
+                                               throw std::runtime_error("chunk failed");
+                                           }
+                                       }),
+                      std::runtime_error);
+}
@@ -0,0 +1,100 @@
+#include "leo/lua_allocator.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+engine::Config MakeConfig()
+{
+    return engine::Config{.malloc_fn = SDL_malloc, .realloc_fn = SDL_realloc, .free_fn = SDL_free};
+}
+
+void *Alloc(engine::LuaAllocator &allocator, void *ptr, size_t old_size, size_t new_size)
+{
+    return engine::LuaAllocator::Allocate(&allocator, ptr, old_size, new_size);
+}
+
+} // namespace
+
+TEST_CASE("Lua allocator reuses freed small blocks", "[lua_allocator]")
+{
+    engine::LuaAllocator allocator(MakeConfig());
+
+    void *first = Alloc(allocator, nullptr, 5, 40);
+    REQUIRE(first != nullptr);
+    Alloc(allocator, first, 40, 0);
+    void *second = Alloc(allocator, nullptr, 5, 48);
+    REQUIRE(second == first);
+
+    engine::LuaMemoryStats stats = allocator.GetStats();
+    REQUIRE(stats.live_bytes == 48);
+    REQUIRE(stats.live_blocks == 1);
+    REQUIRE(stats.allocation_count == 2);
+    REQUIRE(stats.allocated_bytes == 88);
+    REQUIRE(stats.pool_bytes > 0);
+
+    Alloc(allocator, second, 48, 0);
+    REQUIRE(allocator.GetStats().live_bytes == 0);
+    REQUIRE(allocator.GetStats().live_blocks == 0);
+}
+
+TEST_CASE("Lua allocator keeps contents across size classes", "[lua_allocator]")
+{
+    engine::LuaAllocator allocator(MakeConfig());
+
+    unsigned char *block = static_cast<unsigned char *>(Alloc(allocator, nullptr, 0, 24));
+    REQUIRE(block != nullptr);
+    for (int i = 0; i < 24; ++i)
+    {
+        block[i] = static_cast<unsigned char>(i);
+    }
+
+    // Same class: the block stays put. Then grow into a pooled class, a large block, and back down.
+    REQUIRE(Alloc(allocator, block, 24, 32) == block);
+    const size_t sizes[] = {32, 200, 4096, 100000, 64};
+    for (size_t i = 1; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        block = static_cast<unsigned char *>(Alloc(allocator, block, sizes[i - 1], sizes[i]));
+        REQUIRE(block != nullptr);
+        for (int j = 0; j < 24; ++j)
+        {
+            REQUIRE(block[j] == static_cast<unsigned char>(j));
+        }
+    }
+
+    engine::LuaMemoryStats stats = allocator.GetStats();
+    REQUIRE(stats.live_bytes == 64);
+    REQUIRE(stats.live_blocks == 1);
+    Alloc(allocator, block, 64, 0);
+    REQUIRE(allocator.GetStats().live_bytes == 0);
+}
+
+TEST_CASE("Lua allocator hands out distinct blocks across slabs", "[lua_allocator]")
+{
+    engine::LuaAllocator allocator(MakeConfig());
+
+    std::vector<void *> blocks;
+    for (int i = 0; i < 10000; ++i)
+    {
+        size_t size = 16 + static_cast<size_t>(i % 7) * 48;
+        void *block = Alloc(allocator, nullptr, 0, size);
+        REQUIRE(block != nullptr);
+        std::memset(block, i & 0xFF, size);
+        blocks.push_back(block);
+    }
+    REQUIRE(allocator.GetStats().live_blocks == 10000);
+    REQUIRE(allocator.GetStats().pool_bytes > 64 * 1024);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        size_t size = 16 + static_cast<size_t>(i % 7) * 48;
+        const unsigned char *bytes = static_cast<const unsigned char *>(blocks[static_cast<size_t>(i)]);
+        REQUIRE(bytes[0] == static_cast<unsigned char>(i & 0xFF));
+        REQUIRE(bytes[size - 1] == static_cast<unsigned char>(i & 0xFF));
+        Alloc(allocator, blocks[static_cast<size_t>(i)], size, 0);
+    }
+    REQUIRE(allocator.GetStats().live_bytes == 0);
+}
@@ -0,0 +1,469 @@
+#include "leo/engine_core.h"
+#include "leo/lua_runtime.h"
+#include "leo/profiler.h"
+#include "leo/vfs.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+using ScriptFiles = std::initializer_list<std::pair<const char *, const char *>>;
+
+struct SDLVideoGuard
+{
+    SDLVideoGuard()
+    {
+        SDL_Init(SDL_INIT_VIDEO);
+    }
+
+    ~SDLVideoGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+// Writes the scripts to a scratch directory that the harness mounts as its resources.
+std::string WriteScripts(const ScriptFiles &files)
+{
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "leo-lua-runtime-test";
+    std::filesystem::remove_all(root);
+    for (const auto &[name, source] : files)
+    {
+        const std::filesystem::path path = root / name;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary) << source;
+    }
+    return root.string();
+}
+
+engine::Config MakeConfig(const char *resource_path)
+{
+    return {.argv0 = "test",
+            .resource_path = resource_path,
+            .script_path = "main.lua",
+            .organization = "bluesentinelsec",
+            .app_name = "leo-engine",
+            .window_title = "Leo Engine Test",
+            .window_width = 64,
+            .window_height = 64,
+            .logical_width = 0,
+            .logical_height = 0,
+            .window_mode = engine::WindowMode::Windowed,
+            .tick_hz = 60,
+            .NumFrameTicks = 0,
+            .render_hz = 0,
+            .max_catchup_ticks = 0,
+            .asset_budget_us = 0,
+            .gc_budget_us = 0,
+            .gc_mode = engine::GcMode::Incremental,
+            .job_workers = -1,
+            .disable_script_cache = true,
+            .malloc_fn = SDL_malloc,
+            .realloc_fn = SDL_realloc,
+            .free_fn = SDL_free};
+}
+
+// A LuaRuntime on a software renderer over a scratch resource directory. Scripts report failures with error(),
+// which surfaces as an exception from the Call* method that ran them.
+struct LuaHarness
+{
+    explicit LuaHarness(const ScriptFiles &files)
+        : sdl(), root(WriteScripts(files)), config(MakeConfig(root.c_str())), vfs(config),
+          surface(SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32)),
+          renderer(surface ? SDL_CreateSoftwareRenderer(surface) : nullptr),
+          lua(std::make_unique<engine::LuaRuntime>())
+    {
+        REQUIRE(renderer != nullptr);
+        lua->Init(vfs, nullptr, renderer, config);
+    }
+
+    ~LuaHarness()
+    {
+        lua.reset();
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroySurface(surface);
+        std::filesystem::remove_all(root);
+    }
+
+    // Copies a file from the repository's resources into the scratch directory under name.
+    void AddResource(const char *source, const char *name)
+    {
+        std::filesystem::copy_file(source, std::filesystem::path(root) / name);
+    }
+
+    void Update(const leo::Engine::InputFrame &input)
+    {
+        lua->SetFrameInfo(input.frame_index, 1.0f / 60.0f);
+        lua->CallUpdate(1.0f / 60.0f, input);
+    }
+
+    void Update()
+    {
+        leo::Engine::InputFrame input = {};
+        input.keyboard.Reset();
+        input.mouse.Reset();
+        Update(input);
+    }
+
+    SDLVideoGuard sdl;
+    std::string root;
+    engine::Config config;
+    engine::VFS vfs;
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    std::unique_ptr<engine::LuaRuntime> lua;
+};
+
+} // namespace
+
+TEST_CASE("LuaRuntime reuses the input table across ticks", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+local first, keyboard, mouse, gamepads
+function leo.update(dt, input)
+    if input.frame == 0 then
+        first, keyboard, mouse, gamepads = input, input.keyboard, input.mouse, input.gamepads
+        assert(input.keyboard:isDown("space"), "held key not reported")
+        assert(input.mouse.x == 10, "mouse position not reported")
+        return
+    end
+    assert(rawequal(input, first), "input table was reallocated")
+    assert(rawequal(input.keyboard, keyboard), "keyboard was reallocated")
+    assert(rawequal(input.mouse, mouse), "mouse was reallocated")
+    assert(rawequal(input.gamepads, gamepads), "gamepads table was reallocated")
+    assert(not input.keyboard:isDown("space"), "released key still down")
+    assert(input.mouse.x == 20, "mouse position not updated")
+    if input.frame == 1 then
+        assert(input.keyboard:isReleased("space"), "release edge not reported")
+    else
+        assert(not input.keyboard:isReleased("space"), "release edge not cleared")
+    end
+end
+)"}});
+    harness.lua->LoadScript("main.lua");
+
+    leo::Engine::InputFrame input = {};
+    input.keyboard.Reset();
+    input.mouse.Reset();
+    input.keyboard.SetKeyDown(engine::Key::Space);
+    input.mouse.SetPosition(10.0f, 10.0f);
+    REQUIRE_NOTHROW(harness.Update(input));
+
+    input.keyboard.BeginFrame();
+    input.keyboard.SetKeyUp(engine::Key::Space);
+    input.mouse.SetPosition(20.0f, 20.0f);
+    input.frame_index = 1;
+    REQUIRE_NOTHROW(harness.Update(input));
+
+    input.keyboard.BeginFrame();
+    input.frame_index = 2;
+    REQUIRE_NOTHROW(harness.Update(input));
+    harness.lua->EndFrame();
+
+    // Steady-state ticks only overwrite state in place. A GC step may still trim Lua's call-info list between
+    // frames, so allow a stray allocation, but nothing close to one per tick.
+    constexpr Uint32 kTicks = 30;
+    for (Uint32 i = 0; i < kTicks; ++i)
+    {
+        input.frame_index = 3 + i;
+        harness.Update(input);
+    }
+    harness.lua->EndFrame();
+    REQUIRE(harness.lua->GetFrameAllocationCount() < kTicks);
+}
+
+TEST_CASE("leo.profile.finish cannot close engine zones", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+function leo.update()
+    leo.profile.finish()
+end
+)"}});
+    harness.lua->LoadScript("main.lua");
+    engine::Profiler &profiler = engine::Profiler::Get();
+    profiler.SetEnabled(true);
+
+    REQUIRE(profiler.BeginZone("engine"));
+    REQUIRE_THROWS(harness.Update());
+    // The engine's zone is still the one open.
+    REQUIRE(profiler.EndZone());
+    REQUIRE_FALSE(profiler.EndZone());
+
+    profiler.SetEnabled(false);
+    profiler.Clear();
+}
+
+TEST_CASE("Zones left open by a failing script are closed", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+function leo.update()
+    leo.profile.begin("outer")
+    leo.profile.begin("inner")
+    error("boom")
+end
+)"}});
+    harness.lua->LoadScript("main.lua");
+    engine::Profiler &profiler = engine::Profiler::Get();
+    profiler.SetEnabled(true);
+
+    // Enough failing ticks to hit the profiler's depth limit if the zones piled up.
+    for (Uint32 i = 0; i < engine::Profiler::kMaxDepth; ++i)
+    {
+        REQUIRE_THROWS(harness.Update());
+    }
+    REQUIRE_FALSE(profiler.EndZone());
+    REQUIRE(profiler.BeginZone("probe"));
+    REQUIRE(profiler.EndZone());
+
+    profiler.SetEnabled(false);
+    profiler.Clear();
+}
+
+TEST_CASE("Async loads resolve through their futures", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+local futures = {
+    leo.graphics.newImageAsync("hero.png"),
+    leo.font.newAsync("font.ttf", 16),
+    leo.audio.newSoundAsync("coin.wav"),
+}
+local missing = leo.graphics.newImageAsync("missing.png")
+
+function leo.update()
+    for _, future in ipairs(futures) do
+        -- Outside a coroutine, await blocks until the load has finished.
+        local value, err = future:await()
+        assert(value ~= nil, err)
+        assert(future:isDone() and future:isReady(), "future not ready after await")
+        assert(future:getError() == nil, "ready future reported an error")
+        assert(rawequal(future:get(), value), "get returned a different object than await")
+        assert(rawequal(future:get(), future:get()), "get returned a new object")
+    end
+
+    local value, err = missing:await()
+    assert(value == nil, "missing image loaded")
+    assert(type(err) == "string" and err ~= "", "missing image reported no error")
+    assert(missing:isDone() and not missing:isReady(), "failed future reported ready")
+    assert(missing:getError() == err, "getError disagrees with await")
+    local again, again_err = missing:get()
+    assert(again == nil and again_err == err, "get on a failed future did not return the error")
+end
+)"}});
+    harness.AddResource("resources/images/hero_32x32.png", "hero.png");
+    harness.AddResource("resources/font/font.ttf", "font.ttf");
+    harness.AddResource("resources/sound/coin.wav", "coin.wav");
+    harness.lua->LoadScript("main.lua");
+
+    REQUIRE_NOTHROW(harness.Update());
+    // Later ticks hand back the same objects.
+    REQUIRE_NOTHROW(harness.Update());
+}
+
+TEST_CASE("Tasks await async loads across ticks", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+leo.task.spawn(function()
+    local image, image_err = leo.task.await(leo.graphics.newImageAsync("hero.png"))
+    assert(image ~= nil, image_err)
+    local width, height = image:getSize()
+    assert(width == 32 and height == 32, "awaited image has the wrong size")
+
+    local missing, err = leo.task.await(leo.graphics.newImageAsync("missing.png"))
+    assert(missing == nil and type(err) == "string", "failed load did not return an error")
+    leo.quit()
+end)
+
+function leo.update()
+end
+)"}});
+    harness.AddResource("resources/images/hero_32x32.png", "hero.png");
+    harness.lua->LoadScript("main.lua");
+
+    // The task yields until the loader finishes each load; uploads only happen in UpdateAssets.
+    for (int i = 0; i < 600 && !harness.lua->WantsQuit(); ++i)
+    {
+        harness.lua->UpdateAssets();
+        REQUIRE_NOTHROW(harness.Update());
+        SDL_Delay(1);
+    }
+    REQUIRE(harness.lua->WantsQuit());
+}
+
+TEST_CASE("require loads modules through the VFS", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+local util = require("lib.util")
+assert(util.answer == 42, "module from the VFS not loaded")
+assert(rawequal(require("lib.util"), util), "second require returned a new table")
+assert(rawequal(package.loaded["lib.util"], util), "module not cached in package.loaded")
+assert(util_loads == 1, "module body ran more than once")
+
+assert(require("lib").name == "lib", "init.lua module not found")
+
+local ok, err = pcall(require, "no.such.module")
+assert(not ok, "missing module loaded")
+assert(err:find("module 'no.such.module' not found", 1, true), err)
+assert(err:find("no file 'no/such/module.lua'", 1, true), err)
+assert(err:find("no file 'no/such/module/init.lua'", 1, true), err)
+
+local broken_ok, broken_err = pcall(require, "lib.broken")
+assert(not broken_ok, "module with a syntax error loaded")
+assert(broken_err:find("error loading module 'lib.broken' from file 'lib/broken.lua'", 1, true), broken_err)
+)"},
+                        {"lib/util.lua", "util_loads = (util_loads or 0) + 1\nreturn { answer = 42 }\n"},
+                        {"lib/init.lua", "return { name = 'lib' }\n"},
+                        {"lib/broken.lua", "return {\n"}});
+    REQUIRE_NOTHROW(harness.lua->LoadScript("main.lua"));
+}
+
+TEST_CASE("leo.lazyRequire defers the require and resolves once", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+local real_require = require
+local requires = 0
+function require(name)
+    requires = requires + 1
+    return real_require(name)
+end
+
+local scene = leo.lazyRequire("scenes.boss")
+assert(boss_loads == nil, "lazyRequire loaded the module up front")
+assert(scene.hp == 100, "field not forwarded to the module")
+assert(boss_loads == 1 and requires == 1, "first access did not load the module once")
+scene.hp = 50
+assert(real_require("scenes.boss").hp == 50, "assignment not forwarded to the module")
+assert(scene.hp == 50 and requires == 1, "later accesses went through require")
+
+-- Modules that are not tables are kept as well instead of being required on every access.
+local make = leo.lazyRequire("scenes.factory")
+assert(make(2) == 4 and make(3) == 6, "function module not callable through the proxy")
+assert(requires == 2, "function module required more than once")
+
+assert(rawequal(leo.lazyRequire("scenes.boss"), real_require("scenes.boss")),
+       "loaded module not returned directly")
+)"},
+                        {"scenes/boss.lua", "boss_loads = (boss_loads or 0) + 1\nreturn { hp = 100 }\n"},
+                        {"scenes/factory.lua", "return function(n) return n * 2 end\n"}});
+    REQUIRE_NOTHROW(harness.lua->LoadScript("main.lua"));
+}
+
+TEST_CASE("Lua GC pacing does a bounded amount of work per call", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+do
+    local garbage = {}
+    for i = 1, 200000 do
+        garbage[i] = { i }
+    end
+end
+)"}});
+    harness.lua->LoadScript("main.lua");
+    const size_t before = harness.lua->GetMemoryUsage();
+
+    // No slack leaves no budget, so each call runs exactly one incremental step and the cycle spans many calls.
+    harness.lua->CollectGarbage(0);
+    REQUIRE(harness.lua->GetMemoryUsage() > before / 2);
+
+    Uint32 calls = 1;
+    while (harness.lua->GetMemoryUsage() > before / 2 && calls < 1000000)
+    {
+        harness.lua->CollectGarbage(0);
+        calls++;
+    }
+    REQUIRE(harness.lua->GetMemoryUsage() <= before / 2);
+    REQUIRE(calls > 10);
+}
+
+TEST_CASE("Lua GC pacing keeps a backstop for heavy frames", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+function leo.update(dt, input)
+    local last
+    for i = 1, 2000000 do
+        last = { i }
+    end
+end
+)"}});
+    harness.lua->LoadScript("main.lua");
+    harness.lua->CollectGarbage(0);
+    const size_t before = harness.lua->GetMemoryUsage();
+
+    // The tick drops far more garbage than the heap holds; without a backstop it would all still be live here.
+    harness.Update();
+    REQUIRE(harness.lua->GetMemoryUsage() < before * 8);
+}
+
+TEST_CASE("Non-string script errors are reported by type", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+function leo.update(dt, input)
+    if input.frame == 0 then
+        leo.task.spawn(function()
+            error({ code = 1 })
+        end)
+    else
+        error(nil)
+    end
+end
+)"}});
+    harness.lua->LoadScript("main.lua");
+
+    leo::Engine::InputFrame input = {};
+    input.keyboard.Reset();
+    input.mouse.Reset();
+    REQUIRE_THROWS_WITH(harness.Update(input), "(error object is a table value)");
+    input.frame_index = 1;
+    REQUIRE_THROWS_WITH(harness.Update(input), "(error object is a nil value)");
+}
+
+TEST_CASE("Canvases are only preserved on request and cannot draw into themselves", "[lua_runtime]")
+{
+    LuaHarness harness({{"main.lua", R"(
+local scratch, baked
+local frame = 0
+function leo.draw()
+    frame = frame + 1
+    if frame == 1 then
+        scratch = leo.graphics.newCanvas(8, 8)
+        baked = leo.graphics.newCanvas(8, 8, {preserve = true})
+        for _, canvas in ipairs({scratch, baked}) do
+            leo.graphics.setCanvas(canvas)
+            leo.graphics.clear(255, 0, 0, 255)
+            local ok, err = pcall(leo.graphics.draw, canvas, 0, 0)
+            assert(not ok and err:find("cannot draw the active canvas into itself"), tostring(err))
+            ok = pcall(leo.graphics.drawEx, canvas, 0, 0, 8, 8, 0, 0)
+            assert(not ok, "drawEx drew the active canvas")
+        end
+        leo.graphics.setCanvas()
+    else
+        leo.graphics.draw(scratch, 0, 0)
+        leo.graphics.draw(baked, 16, 0)
+    end
+end
+)"}});
+    harness.lua->LoadScript("main.lua");
+    harness.lua->CallDraw(0.0f);
+
+    // Only the canvas that asked for it gets its pixels back after a device reset.
+    harness.lua->RestoreCanvases(true);
+    harness.lua->CallDraw(0.0f);
+
+    SDL_Rect rect = {0, 0, 32, 1};
+    SDL_Surface *pixels = SDL_RenderReadPixels(harness.renderer, &rect);
+    REQUIRE(pixels != nullptr);
+    SDL_Color scratch = {0, 0, 0, 0};
+    SDL_Color baked = {0, 0, 0, 0};
+    SDL_ReadSurfacePixel(pixels, 4, 0, &scratch.r, &scratch.g, &scratch.b, &scratch.a);
+    SDL_ReadSurfacePixel(pixels, 20, 0, &baked.r, &baked.g, &baked.b, &baked.a);
+    SDL_DestroySurface(pixels);
+    REQUIRE(scratch.r == 0);
+    REQUIRE(baked.r == 255);
+    REQUIRE(baked.a == 255);
+}
@@ -0,0 +1,78 @@
+#include "leo/profiler.h"
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+namespace
+{
+
+struct ProfilerGuard
+{
+    ProfilerGuard()
+    {
+        engine::Profiler::Get().Clear();
+        engine::Profiler::Get().SetEnabled(true);
+    }
+
+    ~ProfilerGuard()
+    {
+        engine::Profiler::Get().SetEnabled(false);
+        engine::Profiler::Get().Clear();
+    }
+};
+
+} // namespace
+
+TEST_CASE("Profiler summarizes nested zones per frame", "[profiler]")
+{
+    ProfilerGuard guard;
+    engine::Profiler &profiler = engine::Profiler::Get();
+    profiler.EndFrame();
+
+    {
+        LEO_PROFILE_SCOPE("outer");
+        for (int i = 0; i < 3; ++i)
+        {
+            LEO_PROFILE_SCOPE("inner");
+        }
+    }
+    profiler.EndFrame();
+
+    const std::vector<engine::ProfileZoneSummary> &summary = profiler.GetFrameSummary();
+    REQUIRE(summary.size() == 2);
+    REQUIRE(std::string(summary[0].name) == "outer");
+    REQUIRE(summary[0].depth == 0);
+    REQUIRE(summary[0].calls == 1);
+    REQUIRE(std::string(summary[1].name) == "inner");
+    REQUIRE(summary[1].depth == 1);
+    REQUIRE(summary[1].calls == 3);
+    REQUIRE(summary[0].total_ms >= summary[1].total_ms);
+}
+
+TEST_CASE("Profiler writes Chrome trace events", "[profiler]")
+{
+    ProfilerGuard guard;
+    engine::Profiler &profiler = engine::Profiler::Get();
+
+    const char *name = profiler.InternName("script \"zone\"");
+    REQUIRE(profiler.BeginZone(name));
+    REQUIRE(profiler.EndZone());
+    REQUIRE_FALSE(profiler.EndZone());
+
+    std::string trace = profiler.ToChromeTrace();
+    REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"script \\\"zone\\\"\",\"cat\":\"leo\",\"ph\":\"X\"") != std::string::npos);
+
+    profiler.Clear();
+    REQUIRE(profiler.ToChromeTrace().find("\"ph\":\"X\"") == std::string::npos);
+}
+
+TEST_CASE("Profiler ignores zones while disabled", "[profiler]")
+{
+    engine::Profiler &profiler = engine::Profiler::Get();
+    profiler.SetEnabled(false);
+    REQUIRE_FALSE(profiler.BeginZone("ignored"));
+    {
+        LEO_PROFILE_SCOPE("ignored");
+    }
+    REQUIRE(profiler.ToChromeTrace().find("ignored") == std::string::npos);
+}
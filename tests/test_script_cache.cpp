@@ -0,0 +1,192 @@
+#include "leo/engine_config.h"
+#include "leo/script_cache.h"
+#include "leo/vfs.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <lua.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct SDLGuard
+{
+    SDLGuard()
+    {
+        SDL_Init(0);
+    }
+
+    ~SDLGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+engine::Config MakeConfig()
+{
+    return {.argv0 = "test",
+            .resource_path = ".",
+            .script_path = nullptr,
+            .organization = "bluesentinelsec",
+            .app_name = "leo-engine",
+            .malloc_fn = SDL_malloc,
+            .realloc_fn = SDL_realloc,
+            .free_fn = SDL_free};
+}
+
+size_t CountWriteDirEntries(engine::VFS &vfs, const char *dir)
+{
+    char **entries = nullptr;
+    vfs.ListWriteDir(dir, &entries);
+    size_t count = 0;
+    for (char **it = entries; *it; ++it)
+    {
+        count++;
+    }
+    vfs.FreeList(entries);
+    return count;
+}
+
+lua_Integer RunChunk(lua_State *L)
+{
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    lua_Integer value = lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    return value;
+}
+
+} // namespace
+
+TEST_CASE("ScriptCache reuses compiled bytecode for unchanged source", "[script_cache]")
+{
+    SDLGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+    engine::ScriptCache cache(vfs);
+    lua_State *L = luaL_newstate();
+    REQUIRE(L != nullptr);
+
+    const char *source = "local a, b = 20, 22\nreturn a + b -- script_cache test";
+    const char *chunk_name = "@tests/script_cache_test.lua";
+    std::string entry = engine::ScriptCache::GetEntryPath(source, std::strlen(source), chunk_name);
+    try
+    {
+        vfs.DeleteFile(entry.c_str());
+    }
+    catch (const std::exception &)
+    {
+    }
+
+    REQUIRE(cache.Load(L, source, std::strlen(source), chunk_name) == LUA_OK);
+    REQUIRE(RunChunk(L) == 42);
+    REQUIRE(cache.GetMissCount() == 1);
+
+    REQUIRE(cache.Load(L, source, std::strlen(source), chunk_name) == LUA_OK);
+    REQUIRE(RunChunk(L) == 42);
+    REQUIRE(cache.GetHitCount() == 1);
+
+    const char *edited = "local a, b = 20, 23\nreturn a + b -- script_cache test";
+    REQUIRE(engine::ScriptCache::GetEntryPath(edited, std::strlen(edited), chunk_name) != entry);
+    REQUIRE(engine::ScriptCache::GetEntryPath(source, std::strlen(source), "@other.lua") != entry);
+
+    vfs.DeleteFile(entry.c_str());
+    lua_close(L);
+}
+
+TEST_CASE("ScriptCache ignores entries it did not write for this source", "[script_cache]")
+{
+    SDLGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+    engine::ScriptCache cache(vfs);
+    lua_State *L = luaL_newstate();
+    REQUIRE(L != nullptr);
+
+    // Valid bytecode for other code, planted under this script's entry name without the cache header.
+    const char *planted = "return 7";
+    REQUIRE(luaL_loadstring(L, planted) == LUA_OK);
+    std::string bytecode;
+    lua_dump(
+        L,
+        [](lua_State *, const void *data, size_t size, void *out) {
+            static_cast<std::string *>(out)->append(static_cast<const char *>(data), size);
+            return 0;
+        },
+        &bytecode, 0);
+    lua_pop(L, 1);
+
+    const char *source = "return 42 -- script_cache planted test";
+    const char *chunk_name = "@tests/script_cache_planted.lua";
+    std::string entry = engine::ScriptCache::GetEntryPath(source, std::strlen(source), chunk_name);
+    vfs.WriteAll(entry.c_str(), bytecode.data(), bytecode.size());
+
+    REQUIRE(cache.Load(L, source, std::strlen(source), chunk_name) == LUA_OK);
+    REQUIRE(RunChunk(L) == 42);
+    REQUIRE(cache.GetMissCount() == 1);
+
+    // The overwritten entry now carries the header and is used.
+    REQUIRE(cache.Load(L, source, std::strlen(source), chunk_name) == LUA_OK);
+    REQUIRE(RunChunk(L) == 42);
+    REQUIRE(cache.GetHitCount() == 1);
+
+    vfs.DeleteFile(entry.c_str());
+    lua_close(L);
+}
+
+TEST_CASE("ScriptCache reports syntax errors like luaL_loadbuffer", "[script_cache]")
+{
+    SDLGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+    engine::ScriptCache cache(vfs);
+    lua_State *L = luaL_newstate();
+    REQUIRE(L != nullptr);
+
+    const char *source = "return +";
+    REQUIRE(cache.Load(L, source, std::strlen(source), "@broken.lua") == LUA_ERRSYNTAX);
+    std::string message = lua_tostring(L, -1);
+    REQUIRE(message.find("broken.lua") != std::string::npos);
+    lua_close(L);
+}
+
+TEST_CASE("ScriptCache prunes the oldest entries past its cap", "[script_cache]")
+{
+    SDLGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    std::vector<std::string> stale;
+    for (size_t i = 0; i < engine::ScriptCache::kMaxEntries + 8; ++i)
+    {
+        stale.push_back("cache/lua/prune-test-" + std::to_string(i) + ".luac");
+        vfs.WriteAll(stale.back().c_str(), "x", 1);
+    }
+    REQUIRE(CountWriteDirEntries(vfs, "cache/lua") > engine::ScriptCache::kMaxEntries);
+
+    {
+        engine::ScriptCache cache(vfs);
+        REQUIRE(CountWriteDirEntries(vfs, "cache/lua") <= engine::ScriptCache::kMaxEntries);
+
+        // Cache entries live in the write directory and never show up as resources.
+        char **entries = nullptr;
+        vfs.ListFiles("", &entries);
+        for (char **it = entries; *it; ++it)
+        {
+            REQUIRE(std::strncmp(*it, "cache/", 6) != 0);
+        }
+        vfs.FreeList(entries);
+    }
+
+    for (const std::string &path : stale)
+    {
+        try
+        {
+            vfs.DeleteFile(path.c_str());
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+}
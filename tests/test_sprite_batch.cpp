@@ -0,0 +1,119 @@
+#include "leo/sprite_batch.h"
+#include "leo/texture_loader.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+namespace
+{
+
+struct SDLVideoGuard
+{
+    SDLVideoGuard()
+    {
+        SDL_Init(SDL_INIT_VIDEO);
+    }
+
+    ~SDLVideoGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+engine::Texture CreateWhiteTexture(SDL_Renderer *renderer, int width, int height)
+{
+    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height);
+    REQUIRE(texture != nullptr);
+    std::vector<Uint32> pixels(static_cast<size_t>(width) * static_cast<size_t>(height), 0xFFFFFFFFu);
+    REQUIRE(SDL_UpdateTexture(texture, nullptr, pixels.data(), width * static_cast<int>(sizeof(Uint32))));
+    return engine::Texture(texture, width, height);
+}
+
+engine::SpriteDesc MakeSprite(float x, float y, SDL_Color color)
+{
+    return {.src = {0.0f, 0.0f, 8.0f, 8.0f},
+            .dst = {x, y, 8.0f, 8.0f},
+            .center = {0.0f, 0.0f},
+            .angle = 0.0,
+            .flip = SDL_FLIP_NONE,
+            .color = color};
+}
+
+SDL_Color ReadPixel(SDL_Renderer *renderer, int x, int y)
+{
+    SDL_Rect rect = {x, y, 1, 1};
+    SDL_Surface *pixels = SDL_RenderReadPixels(renderer, &rect);
+    REQUIRE(pixels != nullptr);
+    SDL_Color color = {0, 0, 0, 0};
+    SDL_ReadSurfacePixel(pixels, 0, 0, &color.r, &color.g, &color.b, &color.a);
+    SDL_DestroySurface(pixels);
+    return color;
+}
+
+} // namespace
+
+TEST_CASE("SpriteBatch merges consecutive draws of the same texture", "[sprite_batch]")
+{
+    SDLVideoGuard sdl;
+    SDL_Surface *surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::Texture first = CreateWhiteTexture(renderer, 8, 8);
+        engine::Texture second = CreateWhiteTexture(renderer, 8, 8);
+        engine::SpriteBatch batch(renderer);
+
+        batch.Draw(first, MakeSprite(0.0f, 0.0f, {255, 255, 255, 255}));
+        batch.Draw(first, MakeSprite(8.0f, 0.0f, {255, 255, 255, 255}));
+        REQUIRE(batch.GetPendingSprites() == 2);
+        REQUIRE(batch.GetFlushCount() == 0);
+
+        batch.Draw(second, MakeSprite(16.0f, 0.0f, {255, 255, 255, 255}));
+        REQUIRE(batch.GetFlushCount() == 1);
+        REQUIRE(batch.GetPendingSprites() == 1);
+
+        batch.Flush();
+        REQUIRE(batch.GetFlushCount() == 2);
+        REQUIRE(batch.GetPendingSprites() == 0);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
+
+TEST_CASE("SpriteBatch bakes the tint into vertex colors", "[sprite_batch]")
+{
+    SDLVideoGuard sdl;
+    SDL_Surface *surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::Texture texture = CreateWhiteTexture(renderer, 8, 8);
+        engine::SpriteBatch batch(renderer);
+
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        batch.Draw(texture, MakeSprite(4.0f, 4.0f, {255, 0, 0, 255}));
+        batch.Flush();
+
+        SDL_Color color = ReadPixel(renderer, 8, 8);
+        REQUIRE(color.r == 255);
+        REQUIRE(color.g == 0);
+        REQUIRE(color.b == 0);
+
+        Uint8 r = 0;
+        Uint8 g = 0;
+        Uint8 b = 0;
+        REQUIRE(SDL_GetTextureColorMod(texture.handle, &r, &g, &b));
+        REQUIRE(r == 255);
+        REQUIRE(g == 255);
+        REQUIRE(b == 255);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
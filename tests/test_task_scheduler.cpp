@@ -0,0 +1,82 @@
+#include "leo/task_scheduler.h"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+std::vector<engine::TaskId> Advance(engine::TaskScheduler &scheduler, double dt)
+{
+    std::vector<engine::TaskId> due;
+    scheduler.Advance(dt, due);
+    return due;
+}
+
+} // namespace
+
+TEST_CASE("Task scheduler wakes sleepers in time order", "[task_scheduler]")
+{
+    engine::TaskScheduler scheduler;
+    engine::TaskId slow = scheduler.Spawn();
+    engine::TaskId fast = scheduler.Spawn();
+    REQUIRE(slow != 0);
+    REQUIRE(Advance(scheduler, 0.25) == std::vector<engine::TaskId>{slow, fast});
+
+    scheduler.Sleep(slow, 1.0);
+    scheduler.Sleep(fast, 0.5);
+    REQUIRE(Advance(scheduler, 0.25).empty());
+    REQUIRE(Advance(scheduler, 0.25) == std::vector<engine::TaskId>{fast});
+    scheduler.Sleep(fast, 0.5);
+    REQUIRE(Advance(scheduler, 0.25).empty());
+    // Both are due on the same tick; the earlier wake time goes first.
+    REQUIRE(Advance(scheduler, 0.5) == std::vector<engine::TaskId>{slow, fast});
+    REQUIRE(scheduler.GetTime() == 1.5);
+}
+
+TEST_CASE("Task scheduler counts whole ticks without float drift", "[task_scheduler]")
+{
+    engine::TaskScheduler scheduler;
+    engine::TaskId timer = scheduler.Spawn();
+    engine::TaskId frames = scheduler.Spawn();
+    Advance(scheduler, 1.0 / 60.0);
+    scheduler.Sleep(timer, 1.0);
+    scheduler.SleepTicks(frames, 3);
+
+    int timer_ticks = 0;
+    int frame_ticks = 0;
+    for (int i = 1; i <= 60; ++i)
+    {
+        for (engine::TaskId id : Advance(scheduler, 1.0 / 60.0))
+        {
+            (id == timer ? timer_ticks : frame_ticks) = i;
+        }
+    }
+    REQUIRE(timer_ticks == 60);
+    REQUIRE(frame_ticks == 3);
+}
+
+TEST_CASE("Task scheduler polls conditions and drops cancelled tasks", "[task_scheduler]")
+{
+    engine::TaskScheduler scheduler;
+    engine::TaskId waiter = scheduler.Spawn();
+    engine::TaskId sleeper = scheduler.Spawn();
+    engine::TaskId yielder = scheduler.Spawn();
+    Advance(scheduler, 0.1);
+
+    bool loaded = false;
+    scheduler.WaitUntil(waiter, [&loaded]() { return loaded; });
+    scheduler.Sleep(sleeper, 0.1);
+    scheduler.Suspend(yielder);
+    REQUIRE_THROWS_AS(scheduler.Sleep(waiter, 1.0), std::runtime_error);
+
+    REQUIRE(scheduler.Cancel(sleeper));
+    REQUIRE_FALSE(scheduler.Cancel(sleeper));
+    REQUIRE_FALSE(scheduler.IsAlive(sleeper));
+    REQUIRE(Advance(scheduler, 0.1) == std::vector<engine::TaskId>{yielder});
+
+    scheduler.Suspend(yielder);
+    loaded = true;
+    REQUIRE(Advance(scheduler, 0.1) == std::vector<engine::TaskId>{yielder, waiter});
+    REQUIRE(scheduler.GetTaskCount() == 2);
+}
@@ -0,0 +1,200 @@
+#include "leo/engine_config.h"
+#include "leo/sprite_batch.h"
+#include "leo/texture_atlas.h"
+#include "leo/texture_cache.h"
+#include "leo/vfs.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct SDLVideoGuard
+{
+    SDLVideoGuard()
+    {
+        SDL_Init(SDL_INIT_VIDEO);
+    }
+
+    ~SDLVideoGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+engine::Config MakeConfig()
+{
+    return {.argv0 = "test",
+            .resource_path = ".",
+            .script_path = nullptr,
+            .organization = "bluesentinelsec",
+            .app_name = "leo-engine",
+            .malloc_fn = SDL_malloc,
+            .realloc_fn = SDL_realloc,
+            .free_fn = SDL_free};
+}
+
+engine::SpriteDesc MakeSprite(const engine::Texture &texture, float x, float y)
+{
+    return {.src = {0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height)},
+            .dst = {x, y, static_cast<float>(texture.width), static_cast<float>(texture.height)},
+            .center = {0.0f, 0.0f},
+            .angle = 0.0,
+            .flip = SDL_FLIP_NONE,
+            .color = {255, 255, 255, 255}};
+}
+
+SDL_Color ReadPixel(SDL_Renderer *renderer, int x, int y)
+{
+    SDL_Rect rect = {x, y, 1, 1};
+    SDL_Surface *pixels = SDL_RenderReadPixels(renderer, &rect);
+    REQUIRE(pixels != nullptr);
+    SDL_Color color = {0, 0, 0, 0};
+    SDL_ReadSurfacePixel(pixels, 0, 0, &color.r, &color.g, &color.b, &color.a);
+    SDL_DestroySurface(pixels);
+    return color;
+}
+
+bool Overlaps(const SDL_Rect &a, const SDL_Rect &b)
+{
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+const std::vector<std::string> kSprites = {"resources/images/hero_32x32.png", "resources/images/enemy_32x32.png",
+                                           "resources/images/tree_32x32.png", "resources/images/dirt_32x32.png",
+                                           "resources/images/character_64x64.png"};
+
+} // namespace
+
+TEST_CASE("SkylinePacker places rectangles without overlap", "[texture_atlas]")
+{
+    engine::SkylinePacker packer(64, 64);
+    std::vector<SDL_Rect> placed;
+    const int sizes[][2] = {{32, 24}, {16, 16}, {16, 30}, {40, 8}, {8, 8}, {24, 20}, {8, 40}, {12, 12}};
+    for (const auto &size : sizes)
+    {
+        SDL_Point at = {0, 0};
+        REQUIRE(packer.Insert(size[0], size[1], &at));
+        SDL_Rect rect = {at.x, at.y, size[0], size[1]};
+        REQUIRE(rect.x >= 0);
+        REQUIRE(rect.y >= 0);
+        REQUIRE(rect.x + rect.w <= 64);
+        REQUIRE(rect.y + rect.h <= 64);
+        for (const SDL_Rect &other : placed)
+        {
+            REQUIRE_FALSE(Overlaps(rect, other));
+        }
+        placed.push_back(rect);
+    }
+
+    // The first rectangle lands in the corner and the next one fills in beside it rather than above.
+    REQUIRE(placed[0].x == 0);
+    REQUIRE(placed[0].y == 0);
+    REQUIRE(placed[1].y == 0);
+
+    SDL_Point at = {0, 0};
+    REQUIRE_FALSE(packer.Insert(65, 1, &at));
+    REQUIRE_FALSE(packer.Insert(64, 64, &at));
+}
+
+TEST_CASE("TextureAtlas draws sub-images like the source textures", "[texture_atlas]")
+{
+    SDLVideoGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    SDL_Surface *surface = SDL_CreateSurface(64, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::TextureAtlas atlas = engine::TextureAtlas::Build(vfs, renderer, kSprites);
+        REQUIRE(atlas.GetPages().size() == 1);
+        REQUIRE(atlas.GetImages().size() == kSprites.size());
+        REQUIRE(atlas.Find("resources/images/missing.png") == nullptr);
+
+        std::shared_ptr<engine::Texture> hero = atlas.Find("resources/images/hero_32x32.png");
+        std::shared_ptr<engine::Texture> tree = atlas.Find("resources/images/tree_32x32.png");
+        REQUIRE(hero != nullptr);
+        REQUIRE(hero->width == 32);
+        REQUIRE(hero->height == 32);
+        REQUIRE(hero->handle == atlas.GetPages()[0]->handle);
+        REQUIRE(tree->handle == hero->handle);
+
+        engine::TextureLoader loader(vfs, renderer);
+        engine::Texture source = loader.Load("resources/images/hero_32x32.png");
+        engine::SpriteBatch batch(renderer);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        batch.Draw(*hero, MakeSprite(*hero, 0.0f, 0.0f));
+        batch.Draw(*tree, MakeSprite(*tree, 32.0f, 0.0f));
+        batch.Flush();
+        // Both sprites came from one page, so they went out in one call.
+        REQUIRE(batch.GetFlushCount() == 1);
+
+        std::vector<SDL_Color> packed;
+        for (int i = 0; i < 32; i += 3)
+        {
+            packed.push_back(ReadPixel(renderer, i, i));
+        }
+        SDL_RenderClear(renderer);
+        batch.Draw(source, MakeSprite(source, 0.0f, 0.0f));
+        batch.Flush();
+        for (int i = 0, k = 0; i < 32; i += 3, ++k)
+        {
+            SDL_Color expected = ReadPixel(renderer, i, i);
+            REQUIRE(packed[k].r == expected.r);
+            REQUIRE(packed[k].g == expected.g);
+            REQUIRE(packed[k].b == expected.b);
+            REQUIRE(packed[k].a == expected.a);
+        }
+
+        // Registered in the cache, the sub-image is what later loads of the path get.
+        engine::TextureCache cache(vfs, renderer);
+        cache.Insert("resources/images/hero_32x32.png", hero);
+        REQUIRE(cache.Acquire("resources/images/hero_32x32.png") == hero);
+
+        // Sub-images keep their page alive after the atlas is gone.
+        atlas = engine::TextureAtlas();
+        REQUIRE(hero->page != nullptr);
+        REQUIRE(hero->handle == hero->page->handle);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
+
+TEST_CASE("TextureAtlas spills onto new pages and rejects oversized images", "[texture_atlas]")
+{
+    SDLVideoGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    SDL_Surface *surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    engine::TextureAtlasOptions options;
+    options.page_size = 64;
+    REQUIRE_THROWS_AS(engine::TextureAtlas::Build(vfs, renderer, {"resources/images/background_320x200.png"}, options),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(engine::TextureAtlas::Build(vfs, renderer, {"resources/images/missing.png"}), std::runtime_error);
+
+    // Without padding the 64x64 image fills a page by itself and the four 32x32 images share a second one.
+    {
+        options.padding = 0;
+        engine::TextureAtlas atlas = engine::TextureAtlas::Build(vfs, renderer, kSprites, options);
+        REQUIRE(atlas.GetPages().size() == 2);
+        REQUIRE(atlas.GetPages()[0]->width == 64);
+        REQUIRE(atlas.GetPages()[0]->height == 64);
+        REQUIRE(atlas.Find("resources/images/dirt_32x32.png")->handle == atlas.GetPages()[1]->handle);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
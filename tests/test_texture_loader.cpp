@@ -1,4 +1,5 @@
 #include "leo/engine_config.h"
+#include "leo/texture_cache.h"
 #include "leo/texture_loader.h"
 #include "leo/vfs.h"
 #include <SDL3/SDL.h>
@@ -115,3 +116,67 @@ TEST_CASE("TextureLoader throws when file is missing", "[texture_loader]")
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
 }
+
+TEST_CASE("TextureCache shares one texture per VFS path", "[texture_loader]")
+{
+    SDLVideoGuard sdl;
+    engine::Config config = MakeConfig();
+
+    engine::VFS vfs(config);
+
+    SDL_Window *window = CreateTestWindow();
+    REQUIRE(window != nullptr);
+
+    SDL_Renderer *renderer = SDL_CreateRenderer(window, nullptr);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::TextureCache cache(vfs, renderer);
+        engine::TextureLoader loader(vfs, renderer, &cache);
+
+        std::shared_ptr<engine::Texture> first = loader.Acquire("resources/images/character_64x64.png");
+        std::shared_ptr<engine::Texture> second = cache.Acquire("resources/images/character_64x64.png");
+        REQUIRE(first != nullptr);
+        REQUIRE(first == second);
+        REQUIRE(first->handle == second->handle);
+
+        engine::TextureCacheStats stats = cache.GetStats();
+        REQUIRE(stats.entries == 1);
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.bytes == 64 * 64 * 4);
+
+        REQUIRE(cache.Purge() == 0);
+        first.reset();
+        second.reset();
+        REQUIRE(cache.GetStats().unused_entries == 1);
+        REQUIRE(cache.Purge() == 1);
+        REQUIRE_FALSE(cache.Contains("resources/images/character_64x64.png"));
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+}
+
+TEST_CASE("TextureCache reports missing files", "[texture_loader]")
+{
+    SDLVideoGuard sdl;
+    engine::Config config = MakeConfig();
+
+    engine::VFS vfs(config);
+
+    SDL_Window *window = CreateTestWindow();
+    REQUIRE(window != nullptr);
+
+    SDL_Renderer *renderer = SDL_CreateRenderer(window, nullptr);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::TextureCache cache(vfs, renderer);
+        REQUIRE_THROWS_AS(cache.Acquire("resources/images/does_not_exist.png"), std::runtime_error);
+        REQUIRE(cache.GetStats().entries == 0);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+}
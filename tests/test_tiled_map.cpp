@@ -0,0 +1,299 @@
+#include "leo/camera.h"
+#include "leo/engine_config.h"
+#include "leo/job_system.h"
+#include "leo/profiler.h"
+#include "leo/tiled_map.h"
+#include "leo/vfs.h"
+#include <SDL3/SDL.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct SDLVideoGuard
+{
+    SDLVideoGuard()
+    {
+        SDL_Init(SDL_INIT_VIDEO);
+    }
+
+    ~SDLVideoGuard()
+    {
+        SDL_Quit();
+    }
+};
+
+engine::Config MakeConfig()
+{
+    return {.argv0 = "test",
+            .resource_path = ".",
+            .script_path = nullptr,
+            .organization = "bluesentinelsec",
+            .app_name = "leo-engine",
+            .malloc_fn = SDL_malloc,
+            .realloc_fn = SDL_realloc,
+            .free_fn = SDL_free};
+}
+
+SDL_Color ReadPixel(SDL_Renderer *renderer, int x, int y)
+{
+    SDL_Rect rect = {x, y, 1, 1};
+    SDL_Surface *pixels = SDL_RenderReadPixels(renderer, &rect);
+    REQUIRE(pixels != nullptr);
+    SDL_Color color = {0, 0, 0, 0};
+    SDL_ReadSurfacePixel(pixels, 0, 0, &color.r, &color.g, &color.b, &color.a);
+    SDL_DestroySurface(pixels);
+    return color;
+}
+
+constexpr int kTile = 8;
+constexpr int kStripColumns = 40;
+constexpr SDL_Color kRed = {255, 0, 0, 255};
+constexpr SDL_Color kGreen = {0, 255, 0, 255};
+constexpr SDL_Color kBlue = {0, 0, 255, 255};
+constexpr SDL_Color kWhite = {255, 255, 255, 255};
+constexpr SDL_Color kYellow = {255, 255, 0, 255};
+
+bool SameColor(SDL_Color a, SDL_Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Two 8x8 tiles side by side: tile 1 has a different colour in each quadrant so flips are visible, tile 2 is
+// solid yellow.
+void WriteQuadrantTileset(const std::filesystem::path &path)
+{
+    SDL_Surface *image = SDL_CreateSurface(2 * kTile, kTile, SDL_PIXELFORMAT_RGB24);
+    REQUIRE(image != nullptr);
+    const int half = kTile / 2;
+    const struct
+    {
+        SDL_Rect rect;
+        SDL_Color color;
+    } fills[] = {{{0, 0, half, half}, kRed},
+                 {{half, 0, half, half}, kGreen},
+                 {{0, half, half, half}, kBlue},
+                 {{half, half, half, half}, kWhite},
+                 {{kTile, 0, kTile, kTile}, kYellow}};
+    for (const auto &fill : fills)
+    {
+        SDL_FillSurfaceRect(image, &fill.rect, SDL_MapSurfaceRGB(image, fill.color.r, fill.color.g, fill.color.b));
+    }
+    REQUIRE(SDL_SaveBMP(image, path.string().c_str()));
+    SDL_DestroySurface(image);
+}
+
+// A 40x2 map, so its tiles span two chunks. Row 0 holds tile 1 plain and with each flip bit, then tile 2; row 1 is
+// empty.
+void WriteStripMap(const std::filesystem::path &path)
+{
+    std::string csv;
+    const std::uint32_t first_row[4] = {1u, 0x80000001u, 0x40000001u, 0x20000001u};
+    for (int col = 0; col < kStripColumns; ++col)
+    {
+        csv += std::to_string(col < 4 ? first_row[col] : 2u) + ",";
+    }
+    for (int col = 0; col < kStripColumns; ++col)
+    {
+        csv += col + 1 < kStripColumns ? "0," : "0";
+    }
+
+    std::ofstream(path, std::ios::binary)
+        << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<map version=\"1.10\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"" << kStripColumns
+        << "\" height=\"2\" tilewidth=\"8\" tileheight=\"8\" infinite=\"0\">\n"
+        << " <tileset firstgid=\"1\" name=\"quadrants\" tilewidth=\"8\" tileheight=\"8\" tilecount=\"2\""
+        << " columns=\"2\">\n"
+        << "  <image source=\"tiles.bmp\" width=\"16\" height=\"8\"/>\n"
+        << " </tileset>\n"
+        << " <layer id=\"1\" name=\"strip\" width=\"" << kStripColumns << "\" height=\"2\">\n"
+        << "  <data encoding=\"csv\">" << csv << "</data>\n"
+        << " </layer>\n"
+        << "</map>\n";
+}
+
+// The top-left w x h pixels of the render target as tightly packed RGBA32.
+std::vector<Uint8> ReadRegion(SDL_Renderer *renderer, int w, int h)
+{
+    SDL_Rect rect = {0, 0, w, h};
+    SDL_Surface *read = SDL_RenderReadPixels(renderer, &rect);
+    REQUIRE(read != nullptr);
+    SDL_Surface *pixels = SDL_ConvertSurface(read, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(read);
+    REQUIRE(pixels != nullptr);
+    std::vector<Uint8> result(static_cast<size_t>(w) * static_cast<size_t>(h) * 4);
+    for (int y = 0; y < h; ++y)
+    {
+        SDL_memcpy(result.data() + static_cast<size_t>(y) * static_cast<size_t>(w) * 4,
+                   static_cast<const Uint8 *>(pixels->pixels) + static_cast<size_t>(y) * pixels->pitch,
+                   static_cast<size_t>(w) * 4);
+    }
+    SDL_DestroySurface(pixels);
+    return result;
+}
+
+Uint32 CountZoneCalls(const char *name)
+{
+    Uint32 calls = 0;
+    for (const engine::ProfileZoneSummary &zone : engine::Profiler::Get().GetFrameSummary())
+    {
+        if (std::string(zone.name) == name)
+        {
+            calls += zone.calls;
+        }
+    }
+    return calls;
+}
+
+} // namespace
+
+TEST_CASE("TiledMap loads map dimensions from VFS", "[tiled_map]")
+{
+    SDLVideoGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::TiledMap map = engine::TiledMap::LoadFromVfs(vfs, renderer, "resources/maps/map.tmx");
+        REQUIRE(map.IsReady());
+        REQUIRE(map.GetWidth() == 130);
+        REQUIRE(map.GetHeight() == 80);
+        REQUIRE(map.GetTileWidth() == 32);
+        REQUIRE(map.GetTileHeight() == 32);
+        REQUIRE(map.GetLayerCount() > 0);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
+
+TEST_CASE("TiledMap draws tiles, flips and chunk seams", "[tiled_map]")
+{
+    SDLVideoGuard sdl;
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "leo-tiled-draw-test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    WriteQuadrantTileset(root / "tiles.bmp");
+    WriteStripMap(root / "strip.tmx");
+
+    const std::string resource_path = root.string();
+    engine::Config config = MakeConfig();
+    config.resource_path = resource_path.c_str();
+    engine::VFS vfs(config);
+
+    SDL_Surface *surface = SDL_CreateSurface(kStripColumns * kTile, 2 * kTile, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::TiledMap map = engine::TiledMap::LoadFromVfs(vfs, renderer, "strip.tmx");
+        REQUIRE(map.IsReady());
+
+        engine::Profiler &profiler = engine::Profiler::Get();
+        profiler.Clear();
+        profiler.SetEnabled(true);
+        profiler.EndFrame();
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        map.Draw(renderer);
+        profiler.EndFrame();
+        const Uint32 full_chunks = CountZoneCalls("TiledMap::DrawChunk");
+
+        // Tile 1 unflipped, then flipped horizontally, vertically and diagonally; quadrant centers are sampled.
+        const SDL_Color expected[4][4] = {{kRed, kGreen, kBlue, kWhite},
+                                          {kGreen, kRed, kWhite, kBlue},
+                                          {kBlue, kWhite, kRed, kGreen},
+                                          {kRed, kBlue, kGreen, kWhite}};
+        for (int tile = 0; tile < 4; ++tile)
+        {
+            const int x = tile * kTile;
+            REQUIRE(SameColor(ReadPixel(renderer, x + 1, 1), expected[tile][0]));
+            REQUIRE(SameColor(ReadPixel(renderer, x + 6, 1), expected[tile][1]));
+            REQUIRE(SameColor(ReadPixel(renderer, x + 1, 6), expected[tile][2]));
+            REQUIRE(SameColor(ReadPixel(renderer, x + 6, 6), expected[tile][3]));
+        }
+
+        // Tile 2 is solid yellow on both sides of the seam between the two 32-tile chunks; the empty row stays clear.
+        REQUIRE(SameColor(ReadPixel(renderer, 32 * kTile - 1, 4), kYellow));
+        REQUIRE(SameColor(ReadPixel(renderer, 32 * kTile, 4), kYellow));
+        REQUIRE(SameColor(ReadPixel(renderer, kStripColumns * kTile - 1, 4), kYellow));
+        REQUIRE(SameColor(ReadPixel(renderer, 4, kTile + 4), SDL_Color{0, 0, 0, 255}));
+
+        // Shifted so the first chunk lies left of the screen, only the second is drawn.
+        SDL_RenderClear(renderer);
+        map.Draw(renderer, -32.0f * kTile, 0.0f);
+        profiler.EndFrame();
+        const Uint32 partial_chunks = CountZoneCalls("TiledMap::DrawChunk");
+        profiler.SetEnabled(false);
+        profiler.Clear();
+
+        REQUIRE(full_chunks == 2);
+        REQUIRE(partial_chunks == 1);
+        REQUIRE(SameColor(ReadPixel(renderer, 1, 4), kYellow));
+        REQUIRE(SameColor(ReadPixel(renderer, 8 * kTile + 4, 4), SDL_Color{0, 0, 0, 255}));
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("TiledMap decodes tile images on the job system", "[tiled_map]")
+{
+    SDLVideoGuard sdl;
+    engine::Config config = MakeConfig();
+    engine::VFS vfs(config);
+    engine::JobSystem jobs(2);
+
+    SDL_Surface *surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    {
+        engine::TiledMap serial = engine::TiledMap::LoadFromVfs(vfs, renderer, "resources/maps/map.tmx");
+        engine::TiledMap parallel =
+            engine::TiledMap::LoadFromVfs(vfs, renderer, "resources/maps/map.tmx", nullptr, &jobs);
+        REQUIRE(parallel.IsReady());
+        REQUIRE(parallel.GetLayerCount() == serial.GetLayerCount());
+
+        // The default camera centers the world origin; look at the map's top-left 64x64 pixels instead.
+        leo::Camera::Camera2D camera = leo::Camera::CreateDefault(64.0f, 64.0f);
+        camera.position = {32.0f, 32.0f};
+        camera.target = camera.position;
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        serial.Draw(renderer, 0.0f, 0.0f, &camera);
+        const std::vector<Uint8> expected = ReadRegion(renderer, 64, 64);
+        SDL_RenderClear(renderer);
+        parallel.Draw(renderer, 0.0f, 0.0f, &camera);
+        const std::vector<Uint8> drawn = ReadRegion(renderer, 64, 64);
+
+        // The map must actually cover the region, or two blank reads would match. At least a quarter of the pixels
+        // must differ from the clear colour.
+        size_t drawn_pixels = 0;
+        for (size_t i = 0; i < drawn.size(); i += 4)
+        {
+            if (drawn[i] != 0 || drawn[i + 1] != 0 || drawn[i + 2] != 0)
+            {
+                drawn_pixels++;
+            }
+        }
+        REQUIRE(drawn_pixels * 4 > drawn.size() / 4);
+        REQUIRE(drawn == expected);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+}
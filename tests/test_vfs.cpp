@@ -2,7 +2,12 @@
 #include "leo/vfs.h"
 #include <SDL3/SDL.h>
 #include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
 #include <physfs.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -32,6 +37,90 @@ engine::Config MakeConfig(const char *resource_path = ".")
             .free_fn = SDL_free};
 }
 
+void Put16(std::vector<unsigned char> &out, Uint32 value)
+{
+    out.push_back(static_cast<unsigned char>(value));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+}
+
+void Put32(std::vector<unsigned char> &out, Uint32 value)
+{
+    Put16(out, value & 0xFFFF);
+    Put16(out, value >> 16);
+}
+
+Uint32 Crc32(const std::string &data)
+{
+    Uint32 crc = 0xFFFFFFFFu;
+    for (unsigned char byte : data)
+    {
+        crc ^= byte;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// A zip whose entries are deflated (method 8) as a single uncompressed deflate block: any inflater reads them, but
+// the VFS cannot map them in place.
+std::vector<unsigned char> MakeDeflatedZip(const std::vector<std::pair<std::string, std::string>> &entries)
+{
+    std::vector<unsigned char> zip;
+    std::vector<unsigned char> directory;
+    for (const auto &[name, data] : entries)
+    {
+        std::vector<unsigned char> payload;
+        payload.push_back(0x01); // final block, stored
+        Put16(payload, static_cast<Uint32>(data.size()));
+        Put16(payload, static_cast<Uint32>(~data.size() & 0xFFFF));
+        payload.insert(payload.end(), data.begin(), data.end());
+
+        const Uint32 offset = static_cast<Uint32>(zip.size());
+        Put32(zip, 0x04034b50);
+        for (Uint32 value : {20u, 0u, 8u, 0u, 0u})
+        {
+            Put16(zip, value);
+        }
+        Put32(zip, Crc32(data));
+        Put32(zip, static_cast<Uint32>(payload.size()));
+        Put32(zip, static_cast<Uint32>(data.size()));
+        Put16(zip, static_cast<Uint32>(name.size()));
+        Put16(zip, 0);
+        zip.insert(zip.end(), name.begin(), name.end());
+        zip.insert(zip.end(), payload.begin(), payload.end());
+
+        Put32(directory, 0x02014b50);
+        for (Uint32 value : {20u, 20u, 0u, 8u, 0u, 0u})
+        {
+            Put16(directory, value);
+        }
+        Put32(directory, Crc32(data));
+        Put32(directory, static_cast<Uint32>(payload.size()));
+        Put32(directory, static_cast<Uint32>(data.size()));
+        for (Uint32 value : {static_cast<Uint32>(name.size()), 0u, 0u, 0u, 0u})
+        {
+            Put16(directory, value);
+        }
+        Put32(directory, 0);
+        Put32(directory, offset);
+        directory.insert(directory.end(), name.begin(), name.end());
+    }
+
+    const Uint32 directory_offset = static_cast<Uint32>(zip.size());
+    zip.insert(zip.end(), directory.begin(), directory.end());
+    Put32(zip, 0x06054b50);
+    for (Uint32 value : {0u, 0u, static_cast<Uint32>(entries.size()), static_cast<Uint32>(entries.size())})
+    {
+        Put16(zip, value);
+    }
+    Put32(zip, static_cast<Uint32>(directory.size()));
+    Put32(zip, directory_offset);
+    Put16(zip, 0);
+    return zip;
+}
+
 } // namespace
 
 TEST_CASE("VFS mounts configured resource root", "[vfs]")
@@ -77,6 +166,121 @@ TEST_CASE("VFS ReadAll throws when file is missing", "[vfs]")
     }
 }
 
+TEST_CASE("VFS OpenRead streams the same bytes as ReadAll", "[vfs]")
+{
+    SDLGuard sdl;
+    engine::Config config = MakeConfig();
+
+    {
+        engine::VFS vfs(config);
+
+        void *data = nullptr;
+        size_t size = 0;
+        vfs.ReadAll("resources/maps/map.json", &data, &size);
+
+        engine::VfsReader reader = vfs.OpenRead("resources/maps/map.json");
+        REQUIRE(reader.IsOpen());
+        REQUIRE(reader.GetLength() == size);
+
+        std::vector<unsigned char> streamed;
+        unsigned char chunk[100];
+        size_t read = 0;
+        while ((read = reader.Read(chunk, sizeof(chunk))) > 0)
+        {
+            streamed.insert(streamed.end(), chunk, chunk + read);
+        }
+        REQUIRE(streamed.size() == size);
+        REQUIRE(SDL_memcmp(streamed.data(), data, size) == 0);
+
+        reader.Seek(1);
+        REQUIRE(reader.Tell() == 1);
+        REQUIRE(reader.Read(chunk, 1) == 1);
+        REQUIRE(chunk[0] == static_cast<unsigned char *>(data)[1]);
+        SDL_free(data);
+
+        engine::VfsReader moved = std::move(reader);
+        REQUIRE_FALSE(reader.IsOpen());
+        REQUIRE(moved.IsOpen());
+        REQUIRE_THROWS_AS(vfs.OpenRead("missing.file"), std::runtime_error);
+    }
+}
+
+TEST_CASE("VFS ReadView maps directory files and matches ReadAll", "[vfs]")
+{
+    SDLGuard sdl;
+    engine::Config config = MakeConfig();
+
+    {
+        engine::VFS vfs(config);
+
+        void *data = nullptr;
+        size_t size = 0;
+        vfs.ReadAll("resources/maps/map.json", &data, &size);
+
+        engine::VfsView view = vfs.ReadView("resources/maps/map.json");
+        REQUIRE(view.IsMapped());
+        REQUIRE(view.GetSize() == size);
+        REQUIRE(SDL_memcmp(view.GetData(), data, size) == 0);
+        SDL_free(data);
+
+        // Copies share the mapping, which outlives the original.
+        engine::VfsView copy = view;
+        view.Reset();
+        REQUIRE(view.GetData() == nullptr);
+        REQUIRE(copy.GetSize() == size);
+        REQUIRE(copy.GetData()[0] == '{');
+
+        REQUIRE_THROWS_AS(vfs.ReadView("missing.file"), std::runtime_error);
+    }
+}
+
+TEST_CASE("VFS ReadView buffers compressed zip entries", "[vfs]")
+{
+    SDLGuard sdl;
+    const std::filesystem::path zip_path = std::filesystem::temp_directory_path() / "leo-vfs-deflate-test.zip";
+    const std::string text = "compressed entries are inflated into a buffer";
+    {
+        const std::vector<unsigned char> zip = MakeDeflatedZip({{"packed.txt", text}});
+        std::ofstream out(zip_path, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(zip.data()), static_cast<std::streamsize>(zip.size()));
+    }
+
+    {
+        const std::string resource_path = zip_path.string();
+        engine::Config config = MakeConfig(resource_path.c_str());
+        engine::VFS vfs(config);
+        engine::VfsView view = vfs.ReadView("packed.txt");
+        REQUIRE_FALSE(view.IsMapped());
+        REQUIRE(std::string(reinterpret_cast<const char *>(view.GetData()), view.GetSize()) == text);
+    }
+    std::filesystem::remove(zip_path);
+}
+
+TEST_CASE("VFS ListFiles returns nested resource paths", "[vfs]")
+{
+    SDLGuard sdl;
+    engine::Config config = MakeConfig();
+
+    {
+        engine::VFS vfs(config);
+
+        char **entries = nullptr;
+        vfs.ListFiles("resources", &entries);
+        REQUIRE(entries != nullptr);
+
+        bool found_script = false;
+        bool found_map = false;
+        for (char **it = entries; *it; ++it)
+        {
+            found_script = found_script || SDL_strcmp(*it, "resources/scripts/game.lua") == 0;
+            found_map = found_map || SDL_strcmp(*it, "resources/maps/map.json") == 0;
+        }
+        vfs.FreeList(entries);
+        REQUIRE(found_script);
+        REQUIRE(found_map);
+    }
+}
+
 TEST_CASE("VFS can write, list, and read from write dir", "[vfs]")
 {
     SDLGuard sdl;